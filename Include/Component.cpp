@@ -30,7 +30,9 @@
 #include "./Font.h"
 #include "./SelectionManager.h"
 #include "./FocusManager.h"
+#include "./NotificationManager.h"
 #include "./GlyphContext.h"
+#include "./UiContext.h"
 #include "./util/Point.h"
 #include "./util/Color.h"
 #include "./util/Rectangle.h"
@@ -64,13 +66,14 @@ namespace ui
 		  enabled(true),
 		  // vectors missing here
 		  parent(0),				// no parent
+		  context(&UiContext::getCurrent()),	// bound to the current context
 		  theme(0),
 		  background(0),
 		  foreground(0),
 		  rec(),					// no size
 		  border(0),				// no border
 		  insets(),					// no insets
-		  font(-1),					// font
+		  font(GlyphContext::noFont),	// font
 		  depth(static_cast<float>(1/Component::NORMAL)), // normal depth
 		  // componentList missing
 		  preferredSize(-1,-1),		// invalid size cache
@@ -90,11 +93,13 @@ namespace ui
 			transparency(rhs.transparency),
 			enabled(rhs.enabled),
 			mouseListeners(rhs.mouseListeners),
+			mouseDelegates(rhs.mouseDelegates),
 			focusListeners(rhs.focusListeners),
 			keyListeners(rhs.keyListeners),
 			propertyListeners(rhs.propertyListeners),
 			interpolators(rhs.interpolators),
 			parent(rhs.parent),
+			context(rhs.context),
 			background(rhs.background),
 			foreground(rhs.foreground),
 			rec(rhs.rec),
@@ -126,11 +131,13 @@ namespace ui
 		std::swap(transparency,rhs.transparency);
 		std::swap(enabled,rhs.enabled);
 		std::swap(mouseListeners,rhs.mouseListeners);
+		std::swap(mouseDelegates,rhs.mouseDelegates);
 		std::swap(focusListeners,rhs.focusListeners);
 		std::swap(keyListeners,rhs.keyListeners);
 		std::swap(propertyListeners,rhs.propertyListeners);
 		std::swap(interpolators,rhs.interpolators);
 		std::swap(parent,rhs.parent);
+		std::swap(context,rhs.context);
 		std::swap(background,rhs.background);
 		std::swap(foreground,rhs.foreground);
 		std::swap(rec,rhs.rec);
@@ -145,7 +152,18 @@ namespace ui
 
 	Component::~Component()
 	{
-		removeFocusListeners();
+		// not removeFocusListeners, the FocusManager
+		// may already be gone when this runs at exit.
+		focusListeners.clear();
+		// a root, Container or not, may have a cached FocusRing.
+		if(context->findFocusManager() != 0)
+		{
+			context->findFocusManager()->removeFocusRing(this);
+		}
+		if(context->findNotificationManager() != 0)
+		{
+			context->findNotificationManager()->cancel(this);
+		}
 		removeInterpolators();
 		removeInterpolators();
 		removeKeyListeners();
@@ -166,7 +184,18 @@ namespace ui
 
 	void Component::setVisible(bool visibleBool)
 	{
+		if(visible == visibleBool)
+		{
+			return;
+		}
 		visible = visibleBool;
+
+		// a FocusRing only looks at the visibility of Components
+		// with FocusListeners, and of the Windows a root owns.
+		if(hasFocusListener() || isRootContainer())
+		{
+			context->getFocusManager().invalidateFocusRing(this);
+		}
 		event::PropertyEvent e(this,event::PropertyEvent::CORE,event::PropertyEvent::VISIBLE);
 		processPropertyEvent(e);
 		invalidate();
@@ -184,6 +213,7 @@ namespace ui
 	void Component::invalidate()
 	{
 		valid = false;
+		context->getSelectionManager().componentsChanged();
 
 		//isDisplayListCompiled = false;
 		//util::DisplayList::deleteIndex(displayList);
@@ -220,6 +250,11 @@ namespace ui
 		return parent;
 	}
 
+	UiContext* Component::getContext() const
+	{
+		return context;
+	}
+
 /**
  * State
  */
@@ -273,7 +308,7 @@ namespace ui
 				validate();
 			}
 
-			if(SelectionManager::getInstance().getRenderMode() == SelectionManager::NORMAL)
+			if(context->getSelectionManager().getRenderMode() == SelectionManager::NORMAL)
 			{
 				// we're in the normal render mode, so check for transparency,
 				// and paint everything
@@ -281,6 +316,11 @@ namespace ui
 
 				storeTransparency = g.pushTransparency(transparency);
 
+				// there is no depth test between Components of the
+				// same layer, so queued text of the Components painted
+				// before this one would be drawn over it.
+				g.flushOverlapping(0,0,getBounds().width,getBounds().height);
+
 				//displayList = g.
 				//if(!isDisplayListCompiled)
 				//{
@@ -432,7 +472,7 @@ namespace ui
 	void Component::setThemeName(const std::string &n)
 	{
 		name = n;
-		setTheme(ThemeManager::getInstance().getTheme()->getThemeComponent(name));
+		setTheme(context->getThemeManager().getTheme()->getThemeComponent(name));
 	}
 
 	const std::string & Component::getThemeName() const
@@ -466,6 +506,11 @@ namespace ui
  */
 	void Component::setLocation(int x, int y)
 	{
+		if(rec.x != x || rec.y != y)
+		{
+			context->getFocusManager().invalidateFocusGeometry(this);
+			context->getSelectionManager().componentsChanged();
+		}
 		rec.x = x;
 		rec.y = y;
 
@@ -505,6 +550,10 @@ namespace ui
 
 	void Component::setBounds(int x, int y, int width, int height)
 	{
+		if(rec.x != x || rec.y != y || rec.width != width || rec.height != height)
+		{
+			context->getFocusManager().invalidateFocusGeometry(this);
+		}
 		rec.width = (width >= 0) ? width : 0;
 		rec.height = (height >= 0) ? height : 0;
 		rec.x = x;
@@ -558,6 +607,10 @@ namespace ui
 
 	void Component::setSize(int width, int height)
 	{
+		if(rec.width != width || rec.height != height)
+		{
+			context->getFocusManager().invalidateFocusGeometry(this);
+		}
 		rec.width = (width >= 0) ? width : 0;
 		rec.height = (height >= 0) ? height : 0;
 
@@ -567,13 +620,15 @@ namespace ui
 	void Component::setDepth(int type)
 	{
 		depth = 1.0f/static_cast<float>(type);
+		context->getFocusManager().invalidateFocusRing(this);
 	}
 
 	int Component::getDepth() const
 	{
 		if(depth == 0.0f)
 		{
-			// throw exception
+			// the default depth, which is drawn as normal.
+			return Component::NORMAL;
 		}
 		return static_cast<int>(1.0f/depth);
 	}
@@ -665,24 +720,60 @@ namespace ui
 	{
 		// we only store a font index here to prevent the GUI
 		// from using hundreds of the same fonts.
-		font = GlyphContext::getInstance().setFont(f);
+		font = context->getGlyphContext().setFont(f);
+		invalidate();
+	}
+
+	void Component::setFont(FontHandle handle)
+	{
+		font = handle;
 		invalidate();
 	}
 
 	Font* Component::getFont() const
 	{
-		return GlyphContext::getInstance().getFont(font);;
+		return context->getGlyphContext().getFont(font);;
+	}
+
+	FontHandle Component::getFontHandle() const
+	{
+		return font;
 	}
 
 /**
  * MouseListeners
  */
 
+	event::MouseDelegate Component::getMouseListenerDelegate(int id, event::MouseListener* l)
+	{
+		switch(id)
+		{
+			case event::MouseEvent::MOUSE_PRESSED:
+				return event::MouseDelegate::fromMethod<event::MouseListener,&event::MouseListener::mousePressed>(l);
+			case event::MouseEvent::MOUSE_RELEASED:
+				return event::MouseDelegate::fromMethod<event::MouseListener,&event::MouseListener::mouseReleased>(l);
+			case event::MouseEvent::MOUSE_CLICKED:
+				return event::MouseDelegate::fromMethod<event::MouseListener,&event::MouseListener::mouseClicked>(l);
+			case event::MouseEvent::MOUSE_EXITED:
+				return event::MouseDelegate::fromMethod<event::MouseListener,&event::MouseListener::mouseExited>(l);
+			case event::MouseEvent::MOUSE_DRAGGED:
+				return event::MouseDelegate::fromMethod<event::MouseListener,&event::MouseListener::mouseDragged>(l);
+			case event::MouseEvent::MOUSE_ENTERED:
+				return event::MouseDelegate::fromMethod<event::MouseListener,&event::MouseListener::mouseEntered>(l);
+			default:
+				return event::MouseDelegate::fromMethod<event::MouseListener,&event::MouseListener::mouseMotion>(l);
+		}
+	}
+
 	void Component::removeMouseListener(event::MouseListener* l)
 	{
 		assert(l);
 		
 		mouseListeners.erase(std::remove(mouseListeners.begin(),mouseListeners.end(),l),mouseListeners.end());
+		for(int id = event::MouseEvent::MOUSE_PRESSED; id <= event::MouseEvent::MOUSE_MOTION; ++id)
+		{
+			mouseDelegates.remove(id,getMouseListenerDelegate(id,l));
+		}
 		/*
 		event::MouseListenerList::iterator pos = std::find(mouseListeners.begin(),mouseListeners.end(),l);
 
@@ -695,19 +786,40 @@ namespace ui
 
 	void Component::removeMouseListeners()
 	{
-		mouseListeners.clear();
+		while(!mouseListeners.empty())
+		{
+			removeMouseListener(mouseListeners.back());
+		}
 	}
 
-	void Component::addMouseListener(event::MouseListener* l)
+	void Component::addMouseListener(event::MouseListener* l, int events)
 	{
 		assert(l);
 		mouseListeners.push_back(l);
-		SelectionManager::getInstance().addComponent(this);
+		for(int id = event::MouseEvent::MOUSE_PRESSED; id <= event::MouseEvent::MOUSE_MOTION; ++id)
+		{
+			if(events & (1 << id))
+			{
+				mouseDelegates.add(id,getMouseListenerDelegate(id,l));
+			}
+		}
+		context->getSelectionManager().addComponent(this);
+	}
+
+	void Component::addMouseDelegate(int id, const event::MouseDelegate &delegate)
+	{
+		mouseDelegates.add(id,delegate);
+		context->getSelectionManager().addComponent(this);
+	}
+
+	void Component::removeMouseDelegate(int id, const event::MouseDelegate &delegate)
+	{
+		mouseDelegates.remove(id,delegate);
 	}
 
 	bool Component::hasMouseListener() const
 	{
-		if(mouseListeners.size() > 0)
+		if(mouseListeners.size() > 0 || !mouseDelegates.isEmpty())
 		{
 			return true;
 		}
@@ -724,55 +836,13 @@ namespace ui
 			return;
 		}
 
-		event::MouseListenerList::iterator iterator;
-								
-		for(iterator = mouseListeners.begin(); iterator != mouseListeners.end(); ++iterator)
-		{
-			switch(e.getID())
-			{
-				case event::MouseEvent::MOUSE_PRESSED:
-				{
-					(*iterator)->mousePressed(e);
-					break;
-				}
-				case event::MouseEvent::MOUSE_RELEASED:
-				{
-					(*iterator)->mouseReleased(e);
-					break;
-				}
-				case event::MouseEvent::MOUSE_ENTERED:
-				{
-					(*iterator)->mouseEntered(e);
-					break;
-				}
-				case event::MouseEvent::MOUSE_EXITED:
-				{
-					(*iterator)->mouseExited(e);
-					break;
-				}
-				case event::MouseEvent::MOUSE_CLICKED:
-				{
-					(*iterator)->mouseClicked(e);
-					break;
-				}
-				case event::MouseEvent::MOUSE_DRAGGED:
-				{
-					(*iterator)->mouseDragged(e);
-					break;
-				}
-				case event::MouseEvent::MOUSE_MOTION:
-				{
-					(*iterator)->mouseMotion(e);
-					break;
-				}
-			}
-		}
+		mouseDelegates.dispatch(e);
 	}
 
 /**
  * Focus Listener code.
  */
-	const event::FocusListenerList Component::getFocusListeners() const
+	const event::FocusListenerList& Component::getFocusListeners() const
 	{
 		return focusListeners;
 	}
@@ -780,11 +850,13 @@ namespace ui
 	void Component::removeFocusListeners()
 	{
 		focusListeners.clear();
+		context->getFocusManager().invalidateFocusRing(this);
 	}
 
 	void Component::addFocusListener(event::FocusListener* l)
 	{
 		focusListeners.push_back(l);
+		context->getFocusManager().invalidateFocusRing(this);
 	}
 
 	void Component::removeFocusListener(event::FocusListener* l)
@@ -792,6 +864,7 @@ namespace ui
 		assert(l);
 
 		focusListeners.erase(std::remove(focusListeners.begin(),focusListeners.end(),l),focusListeners.end());
+		context->getFocusManager().invalidateFocusRing(this);
 		/*
 		event::FocusListenerList::iterator pos = std::find(focusListeners.begin(),focusListeners.end(),l);
 
@@ -868,7 +941,7 @@ namespace ui
 /**
  * KeyListener code.
  */
-	const event::KeyListenerList Component::getKeyListeners() const
+	const event::KeyListenerList& Component::getKeyListeners() const
 	{
 		return keyListeners;
 	}
@@ -947,20 +1020,20 @@ namespace ui
 			// if tab was pressed
 			if(e.getKeyCode() == event::KeyEvent::VKUI_TAB && e.getModifier() == event::KeyEvent::MOD_NONE)
 			{
-				FocusManager::getInstance().focusRightComponent();
+				context->getFocusManager().focusRightComponent();
 			}
 			else if(e.getKeyCode() == event::KeyEvent::VKUI_TAB && (e.getModifier() == event::KeyEvent::MOD_LSHIFT || e.getModifier() == event::KeyEvent::MOD_RSHIFT))
 			{
-				FocusManager::getInstance().focusLeftComponent();
+				context->getFocusManager().focusLeftComponent();
 			}
 			/*
 			else if(e.getKeyCode() == event::KeyEvent::VKUI_RIGHT)
 			{
-				FocusManager::getInstance().focusRightComponent();
+				context->getFocusManager().focusRightComponent();
 			}
 			else if(e.getKeyCode() == event::KeyEvent::VKUI_LEFT)
 			{
-				FocusManager::getInstance().focusLeftComponent();
+				context->getFocusManager().focusLeftComponent();
 			}
 			*/
 		}
@@ -969,7 +1042,7 @@ namespace ui
 /**
  * PropertyListeners
  */
-	const event::PropertyListenerList Component::getPropertyListeners() const
+	const event::PropertyListenerList& Component::getPropertyListeners() const
 	{
 		return propertyListeners;
 	}
@@ -1014,6 +1087,19 @@ namespace ui
 	}
 
 	void Component::processPropertyEvent(const event::PropertyEvent& e)
+	{
+		NotificationManager &notifications = context->getNotificationManager();
+		if(notifications.isDeferred())
+		{
+			notifications.postPropertyEvent(this,e);
+		}
+		else
+		{
+			deliverPropertyEvent(e);
+		}
+	}
+
+	void Component::deliverPropertyEvent(const event::PropertyEvent& e)
 	{
 		event::PropertyListenerList::iterator iter;
 
@@ -1023,6 +1109,23 @@ namespace ui
 		}
 	}
 
+	void Component::postNotification(int id)
+	{
+		NotificationManager &notifications = context->getNotificationManager();
+		if(notifications.isDeferred())
+		{
+			notifications.postNotification(this,id);
+		}
+		else
+		{
+			deliverNotification(id);
+		}
+	}
+
+	void Component::deliverNotification(int id)
+	{
+	}
+
 
 	
 /**
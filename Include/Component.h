@@ -35,6 +35,7 @@
 #include "./util/Point.h"
 #include "./util/Insets.h"
 #include "./util/Color.h"
+#include "./event/MouseEvent.h"
 
 namespace ui
 {
@@ -153,6 +154,14 @@ namespace ui
 		 */
 		Component* getParent() const;
 
+		/**
+		 * Returns the UiContext this Component is bound to, which
+		 * is the context that was current when it was constructed.
+		 * The Component may only be used while that context is
+		 * current.
+		 */
+		UiContext* getContext() const;
+
 		/**
 		 * Paint method called by the Component's parent. 
 		 * Do not call this method manually, as it's used
@@ -164,6 +173,14 @@ namespace ui
 		void paint(Graphics& g) const;
 
 	protected:
+		/**
+		 * Calls deliverNotification(id) now or, when the
+		 * NotificationManager defers notifications, once at the end
+		 * of input processing however often it was posted. Range
+		 * models use this so listeners see only the last value.
+		 */
+		void postNotification(int id);
+
 		/**
 		 * Custom Component painting.
 		 * Overload to implement custom drawing.
@@ -528,6 +545,14 @@ namespace ui
 		 */
 		void setFont(Font* font);
 
+		/**
+		 * Sets the Font for this Component by its handle.
+		 * Unlike setFont(Font*) this does not look the Font up.
+		 * @param
+		 *	handle a handle returned by GlyphContext.
+		 */
+		void setFont(FontHandle handle);
+
 		/**
 		 * Returns the current Font for this Component.
 		 * @return
@@ -535,6 +560,11 @@ namespace ui
 		 */
 		Font* getFont() const;
 
+		/**
+		 * Returns the handle of the current Font.
+		 */
+		FontHandle getFontHandle() const;
+
 		/**
 		 * Constants for general use in Components.
 		 */
@@ -560,7 +590,8 @@ namespace ui
 
 		/**
 		 * Receives a MouseEvent for this Component and forwards
-		 * it to all registered MouseListeners.
+		 * it to the MouseListeners and MouseDelegates registered
+		 * for its type.
 		 * @param
 		 *	e the MouseEvent to process.
 		 */
@@ -577,8 +608,12 @@ namespace ui
 		 * Add a event::MouseListener to the Component.
 		 * @param
 		 *	l MouseListener to be registered for the Component.
+		 * @param
+		 *	events the MouseEvent masks of the events the listener
+		 *	is called for. Events it has no use for are then never
+		 *	dispatched to it.
 		 */
-		void addMouseListener(event::MouseListener* l);
+		void addMouseListener(event::MouseListener* l, int events = event::MouseEvent::MOUSE_ALL_MASK);
 
 		/**
 		 * Remove the selected MouseListener.
@@ -592,6 +627,20 @@ namespace ui
 		 */
 		void removeMouseListeners();
 
+		/**
+		 * Add a delegate that is called for one type of MouseEvent.
+		 * @param
+		 *	id the MouseEvent type, such as MouseEvent::MOUSE_PRESSED.
+		 * @param
+		 *	delegate the delegate to call.
+		 */
+		void addMouseDelegate(int id, const event::MouseDelegate &delegate);
+
+		/**
+		 * Remove a delegate added with addMouseDelegate.
+		 */
+		void removeMouseDelegate(int id, const event::MouseDelegate &delegate);
+
 		/**
 		 * Check to see if the Component has focus.
 		 * @return
@@ -637,7 +686,7 @@ namespace ui
 		 * @return
 		 *	return a list of all registered FocusListeners.
 		 */
-		const event::FocusListenerList getFocusListeners() const;
+		const event::FocusListenerList& getFocusListeners() const;
 
 		/**
 		 * Check wether the Component has a FocusListener.
@@ -679,7 +728,7 @@ namespace ui
 		 * @return
 		 *	returns a list of all registered KeyListeners for this Component.
 		 */
-		const event::KeyListenerList getKeyListeners() const;
+		const event::KeyListenerList& getKeyListeners() const;
 
 		/**
 		 * Check wether the Component has a KeyListener.
@@ -697,11 +746,26 @@ namespace ui
 
 		/**
 		 * Forward the PropertyEvent to all registered Listeners.
+		 * When the NotificationManager defers notifications, the
+		 * event is queued and delivered at the end of input processing.
 		 * @param
 		 *	e the PropertyEvent to be processed by this Component.	
 		 */
 		void processPropertyEvent(const event::PropertyEvent& e);
 
+		/**
+		 * Sends the PropertyEvent to all registered Listeners
+		 * right away.
+		 */
+		void deliverPropertyEvent(const event::PropertyEvent& e);
+
+		/**
+		 * Sends notification id to the listeners of this Component.
+		 * Called by postNotification, or by the NotificationManager
+		 * when it was queued. Does nothing by default.
+		 */
+		virtual void deliverNotification(int id);
+
 		/**
 		 * Add a event::PropertyListener to the Component.
 		 * @param
@@ -726,7 +790,7 @@ namespace ui
 		 * @return
 		 *	returns a list of all registered PropertyListeners for this Component.
 		 */
-		const event::PropertyListenerList getPropertyListeners() const;
+		const event::PropertyListenerList& getPropertyListeners() const;
 
 		/**
 		 * Check wether the Component has a PropertyListener.
@@ -794,6 +858,12 @@ namespace ui
 		float getRotation() const;
 
 	private:
+		/**
+		 * Returns the delegate calling the method of l
+		 * for the mouse event type id.
+		 */
+		static event::MouseDelegate getMouseListenerDelegate(int id, event::MouseListener* l);
+
 		bool visible, borderPainted, focus,enabled;
 
 		mutable bool valid;
@@ -809,6 +879,12 @@ namespace ui
 		 */
 		event::MouseListenerList mouseListeners;
 
+		/**
+		 * Delegates per mouse event type, for the MouseListeners
+		 * as well as the delegates added on their own.
+		 */
+		event::DelegateTable<event::MouseEvent> mouseDelegates;
+
 		/**
 		 * List that holds all registered focus listeners.
 		 */
@@ -835,6 +911,11 @@ namespace ui
 		 */
 		Component*			parent;
 
+		/**
+		 * The context this Component belongs to.
+		 */
+		UiContext*			context;
+
 		/**
 		 * This Components background color.
 		 */
@@ -863,7 +944,7 @@ namespace ui
 		/**
 		 * An integer pointing to the Font.
 		 */
-		std::size_t						font;
+		FontHandle						font;
 
 		/**
 		 * The theme component.
@@ -30,6 +30,8 @@
 #include "./util/Dimension.h"
 #include "./util/Rectangle.h"
 #include "./layout/LayoutManager.h"
+#include "./FocusManager.h"
+#include "./SelectionManager.h"
 
 namespace ui
 {
@@ -61,7 +63,8 @@ namespace ui
 
 	Container::~Container()
 	{
-		removeAll();
+		// not removeAll, see ~Component.
+		componentList.clear();
 	}
 
 /**
@@ -166,6 +169,9 @@ namespace ui
 		// a component cannot be null.
 		assert(component);
 
+		// and has to live in the same UiContext.
+		assert(component->getContext() == getContext());
+
 		// make this Container the added Components parent.
 		component->setParent(this);
 
@@ -175,6 +181,9 @@ namespace ui
 
 		// finally, add the Component.
 		componentList.push_back(component);
+		// the Component is no longer a root of its own.
+		getContext()->getFocusManager().removeFocusRing(component);
+		getContext()->getFocusManager().invalidateFocusRing(this);
 
 		// and invalidate the Container.
 		if(isValid())
@@ -221,6 +230,7 @@ namespace ui
 				layout->removeLayoutComponent((*iter));
 			}
 			componentList.erase(iter);
+			getContext()->getFocusManager().invalidateFocusRing(this);
 		}
 		if(isValid())
 		{
@@ -231,6 +241,8 @@ namespace ui
 	void Container::removeAll()
 	{
 		componentList.clear();
+		getContext()->getFocusManager().invalidateFocusRing(this);
+		getContext()->getSelectionManager().componentsChanged();
 	}
 
 /**
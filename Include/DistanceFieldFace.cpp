@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./DistanceFieldFace.h"
+
+namespace ui
+{
+	const std::size_t DistanceFieldFace::headerSize = 20;
+
+	DistanceFieldFace::DistanceFieldFace()
+		:	pixels(0),
+			width(0),
+			height(0),
+			fieldSize(0),
+			lineHeight(0),
+			texture(0)
+	{
+		missingGlyph.present = false;
+		missingGlyph.x = missingGlyph.y = 0;
+		missingGlyph.width = missingGlyph.height = 0;
+		missingGlyph.left = missingGlyph.top = 0;
+		missingGlyph.advance = 0;
+
+		for(int i = 0; i < 256; ++i)
+		{
+			glyphs[i] = missingGlyph;
+		}
+	}
+
+	DistanceFieldFace::~DistanceFieldFace()
+	{
+		releaseTexture();
+	}
+
+	int DistanceFieldFace::readUnsigned16(const unsigned char *data)
+	{
+		return data[0] | (data[1] << 8);
+	}
+
+	int DistanceFieldFace::readSigned16(const unsigned char *data)
+	{
+		int value = readUnsigned16(data);
+		return value >= 0x8000 ? value - 0x10000 : value;
+	}
+
+	int DistanceFieldFace::readSigned32(const unsigned char *data)
+	{
+		unsigned long value = data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<unsigned long>(data[3]) << 24);
+		if(value & 0x80000000UL)
+		{
+			return -static_cast<int>(0xffffffffUL - value) - 1;
+		}
+		return static_cast<int>(value);
+	}
+
+	bool DistanceFieldFace::load(const std::string &fileName)
+	{
+		releaseTexture();
+		pixels = 0;
+
+		if(!file.open(fileName))
+		{
+			return false;
+		}
+
+		const unsigned char *data = file.getData();
+		std::size_t size = file.getSize();
+
+		int version = size < headerSize ? 0 : readUnsigned16(data + 4);
+
+		if(size < headerSize || data[0] != 'U' || data[1] != 'I' || data[2] != 'D' || data[3] != 'F' || (version != 1 && version != 2))
+		{
+			file.close();
+			return false;
+		}
+
+		width = readUnsigned16(data + 6);
+		height = readUnsigned16(data + 8);
+		fieldSize = readUnsigned16(data + 10);
+		lineHeight = readSigned32(data + 14);
+
+		std::size_t glyphCount = readUnsigned16(data + 18);
+		std::size_t glyphSize = version == 1 ? 18 : 20;
+		std::size_t pixelOffset = headerSize + glyphCount * glyphSize;
+
+		if(fieldSize == 0 || size < pixelOffset + static_cast<std::size_t>(width) * height)
+		{
+			file.close();
+			return false;
+		}
+
+		for(int i = 0; i < 256; ++i)
+		{
+			glyphs[i].present = false;
+		}
+		otherGlyphs.clear();
+
+		const unsigned char *record = data + headerSize;
+		for(std::size_t i = 0; i < glyphCount; ++i, record += glyphSize)
+		{
+			unsigned int codepoint = record[0];
+			const unsigned char *metrics = record + 2;
+
+			if(version == 2)
+			{
+				codepoint = static_cast<unsigned int>(readSigned32(record));
+				metrics = record + 4;
+			}
+
+			Glyph &glyph = codepoint < 256 ? glyphs[codepoint] : otherGlyphs[codepoint];
+			glyph.present = true;
+			glyph.x = readUnsigned16(metrics);
+			glyph.y = readUnsigned16(metrics + 2);
+			glyph.width = readUnsigned16(metrics + 4);
+			glyph.height = readUnsigned16(metrics + 6);
+			glyph.left = readSigned16(metrics + 8);
+			glyph.top = readSigned16(metrics + 10);
+			glyph.advance = readSigned32(metrics + 12);
+
+			if(glyph.x + glyph.width > width || glyph.y + glyph.height > height)
+			{
+				file.close();
+				return false;
+			}
+		}
+
+		pixels = data + pixelOffset;
+		return true;
+	}
+
+	int DistanceFieldFace::getFieldSize() const
+	{
+		return fieldSize;
+	}
+
+	int DistanceFieldFace::getLineHeight() const
+	{
+		return lineHeight;
+	}
+
+	int DistanceFieldFace::getWidth() const
+	{
+		return width;
+	}
+
+	int DistanceFieldFace::getHeight() const
+	{
+		return height;
+	}
+
+	const DistanceFieldFace::Glyph & DistanceFieldFace::getGlyph(unsigned int codepoint) const
+	{
+		if(codepoint < 256)
+		{
+			if(glyphs[codepoint].present)
+			{
+				return glyphs[codepoint];
+			}
+		}
+		else
+		{
+			std::map<unsigned int,Glyph>::const_iterator found = otherGlyphs.find(codepoint);
+			if(found != otherGlyphs.end())
+			{
+				return found->second;
+			}
+		}
+		return glyphs['?'].present ? glyphs['?'] : missingGlyph;
+	}
+
+	void DistanceFieldFace::bind()
+	{
+		if(texture == 0 && pixels != 0)
+		{
+			glGenTextures(1,&texture);
+			glBindTexture(GL_TEXTURE_2D,texture);
+
+			// linear filtering interpolates the distances, which
+			// is what keeps the edges sharp at every size.
+			glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_S,GL_CLAMP);
+			glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_T,GL_CLAMP);
+			glPixelStorei(GL_UNPACK_ALIGNMENT,1);
+			glTexImage2D(GL_TEXTURE_2D,0,GL_ALPHA,width,height,0,GL_ALPHA,GL_UNSIGNED_BYTE,pixels);
+		}
+		else
+		{
+			glBindTexture(GL_TEXTURE_2D,texture);
+		}
+	}
+
+	void DistanceFieldFace::releaseTexture()
+	{
+		if(texture != 0)
+		{
+			glDeleteTextures(1,&texture);
+			texture = 0;
+		}
+	}
+}
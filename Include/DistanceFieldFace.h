@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DISTANCEFIELDFACE_H
+#define DISTANCEFIELDFACE_H
+
+#include <map>
+#include "./Config.h"
+#include "./Pointers.h"
+#include "./util/MappedFile.h"
+
+namespace ui
+{
+	/**
+	 * A font face stored as a signed distance field.
+	 * <p>
+	 * Every glyph of the face is stored once in an atlas which
+	 * holds, for every pixel, the distance to the nearest edge of
+	 * the glyph: 128 is on the edge, larger values are inside.
+	 * Because distances interpolate well the atlas can be drawn
+	 * at any size with linear filtering and an alpha test, so a
+	 * single face serves every DistanceFieldFont created from it.
+	 * </p>
+	 * The atlas is generated offline and loaded from a memory
+	 * mapped file, so no glyphs are rasterized at startup. All
+	 * numbers are little endian. The file starts with a header:
+	 * <pre>
+	 *	char[4]	magic, "UIDF"
+	 *	uint16	version, 1 or 2
+	 *	uint16	width of the atlas in pixels
+	 *	uint16	height of the atlas in pixels
+	 *	uint16	field size, the pixel size the field was made for
+	 *	uint16	spread, the distance in pixels that maps to 0 and 255
+	 *	int32	line height in 1/64 pixels at the field size
+	 *	uint16	number of glyphs
+	 * </pre>
+	 * followed by one record per glyph:
+	 * <pre>
+	 *	uint32	unicode code point, in version 2 files
+	 *	uint8	character in ISO 8859-1, in version 1 files
+	 *	uint8	reserved, 0, in version 1 files
+	 *	uint16	x, y, width, height of the glyph in the atlas
+	 *	int16	left, top offset from the pen, which is at the
+	 *		top of the line, in pixels at the field size
+	 *	int32	advance in 1/64 pixels at the field size
+	 * </pre>
+	 * followed by width * height bytes of distances, row by row
+	 * from the top.
+	 */
+	class DistanceFieldFace
+	{
+	public:
+		/**
+		 * Where a glyph is stored in the atlas, and its metrics
+		 * at the field size.
+		 */
+		struct Glyph
+		{
+			bool present;
+			int x, y;
+			int width, height;
+			int left, top;
+			int advance;
+		};
+
+		/**
+		 * Creates an empty face.
+		 */
+		DistanceFieldFace();
+
+		/**
+		 * Destroys the atlas texture and unmaps the file.
+		 */
+		~DistanceFieldFace();
+
+		/**
+		 * Maps and validates an atlas file.
+		 * @return
+		 *	false if the file could not be mapped or
+		 *	is not a valid atlas.
+		 */
+		bool load(const std::string &fileName);
+
+		/**
+		 * Returns the pixel size the field was made for.
+		 */
+		int getFieldSize() const;
+
+		/**
+		 * Returns the line height in 1/64 pixels at
+		 * the field size.
+		 */
+		int getLineHeight() const;
+
+		/**
+		 * Returns the width of the atlas.
+		 */
+		int getWidth() const;
+
+		/**
+		 * Returns the height of the atlas.
+		 */
+		int getHeight() const;
+
+		/**
+		 * Returns the glyph for a code point. Code points which
+		 * are not in the atlas are drawn as a question mark if
+		 * it is, and take no space otherwise.
+		 */
+		const Glyph & getGlyph(unsigned int codepoint) const;
+
+		/**
+		 * Binds the atlas texture, uploading it from the
+		 * mapped file the first time.
+		 */
+		void bind();
+
+		/**
+		 * Destroys the atlas texture, it is uploaded again on
+		 * the next bind. Use this when the OpenGL context is lost.
+		 */
+		void releaseTexture();
+	private:
+		DistanceFieldFace(const DistanceFieldFace &rhs);
+		DistanceFieldFace& operator=(const DistanceFieldFace &rhs);
+
+		static int readUnsigned16(const unsigned char *data);
+		static int readSigned16(const unsigned char *data);
+		static int readSigned32(const unsigned char *data);
+
+		static const std::size_t headerSize;
+
+		util::MappedFile file;
+		const unsigned char *pixels;
+
+		int width, height;
+		int fieldSize;
+		int lineHeight;
+
+		/**
+		 * Glyphs of the first 256 code points are looked up
+		 * directly, the others in a map.
+		 */
+		Glyph glyphs[256];
+		std::map<unsigned int,Glyph> otherGlyphs;
+		Glyph missingGlyph;
+
+		GLuint texture;
+	};
+}
+
+#endif
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./DistanceFieldFont.h"
+#include "./util/Utf8.h"
+
+namespace ui
+{
+	DistanceFieldFont::DistanceFieldFont(DistanceFieldFace *f, const std::string &n, std::size_t s)
+		:	face(f),
+			name(n),
+			size(s)
+	{
+	}
+
+	const std::string DistanceFieldFont::getFontName() const
+	{
+		return name;
+	}
+
+	std::size_t DistanceFieldFont::getSize() const
+	{
+		return size;
+	}
+
+	DistanceFieldFace * DistanceFieldFont::getFace() const
+	{
+		return face;
+	}
+
+	int DistanceFieldFont::scale(long length) const
+	{
+		long unit = 64L * face->getFieldSize();
+		long scaled = length * static_cast<long>(size);
+
+		// round half away from zero.
+		return static_cast<int>(scaled >= 0 ? (scaled + unit / 2) / unit : -((-scaled + unit / 2) / unit));
+	}
+
+	util::Dimension DistanceFieldFont::getStringBoundingBox(const std::string &text) const
+	{
+		long pen = 0;
+		std::size_t index = 0;
+		while(index < text.length())
+		{
+			pen += face->getGlyph(util::Utf8::decode(text,index)).advance;
+		}
+		return util::Dimension(scale(pen),scale(face->getLineHeight()));
+	}
+
+	void DistanceFieldFont::getGlyphAdvances(const std::string &text, std::vector<int> &advances) const
+	{
+		advances.assign(text.length(),0);
+
+		// the pen is kept unrounded, every advance is the difference
+		// between two rounded pen positions.
+		long pen = 0;
+		int width = 0;
+		std::size_t index = 0;
+		while(index < text.length())
+		{
+			std::size_t start = index;
+			pen += face->getGlyph(util::Utf8::decode(text,index)).advance;
+
+			int penWidth = scale(pen);
+			advances[start] = penWidth - width;
+			width = penWidth;
+		}
+	}
+
+	void DistanceFieldFont::drawString(int x, int y, const std::string &text)
+	{
+		GLfloat glyphScale = static_cast<GLfloat>(size) / face->getFieldSize();
+		GLfloat uScale = 1.0f / face->getWidth();
+		GLfloat vScale = 1.0f / face->getHeight();
+
+		vertices.clear();
+
+		long pen = 0;
+		std::size_t index = 0;
+		while(index < text.length())
+		{
+			const DistanceFieldFace::Glyph &glyph = face->getGlyph(util::Utf8::decode(text,index));
+
+			if(glyph.width > 0 && glyph.height > 0)
+			{
+				GLfloat x0 = x + scale(pen) + glyph.left * glyphScale;
+				GLfloat y0 = y + glyph.top * glyphScale;
+				GLfloat x1 = x0 + glyph.width * glyphScale;
+				GLfloat y1 = y0 + glyph.height * glyphScale;
+
+				GLfloat u0 = glyph.x * uScale;
+				GLfloat v0 = glyph.y * vScale;
+				GLfloat u1 = (glyph.x + glyph.width) * uScale;
+				GLfloat v1 = (glyph.y + glyph.height) * vScale;
+
+				GLfloat quad[16] = {x0,y0,u0,v0, x1,y0,u1,v0, x1,y1,u1,v1, x0,y1,u0,v1};
+				vertices.insert(vertices.end(),quad,quad + 16);
+			}
+			pen += glyph.advance;
+		}
+
+		if(vertices.empty())
+		{
+			return;
+		}
+
+		// the texture holds the distance to the glyph edge, which is
+		// at 0.5. The alpha test keeps the inside of the glyphs, the
+		// texture alpha is multiplied by the current color so the
+		// threshold is as well.
+		GLfloat color[4];
+		glGetFloatv(GL_CURRENT_COLOR,color);
+
+		glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT);
+		glEnable(GL_TEXTURE_2D);
+		glEnable(GL_ALPHA_TEST);
+		glAlphaFunc(GL_GEQUAL,0.5f * color[3]);
+		face->bind();
+
+		const GLsizei stride = 4 * sizeof(GLfloat);
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+		glVertexPointer(2,GL_FLOAT,stride,&vertices[0]);
+		glTexCoordPointer(2,GL_FLOAT,stride,&vertices[2]);
+		glDrawArrays(GL_QUADS,0,static_cast<GLsizei>(vertices.size() / 4));
+		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+		glDisableClientState(GL_VERTEX_ARRAY);
+
+		glPopAttrib();
+	}
+
+	DistanceFieldFontFactory::DistanceFieldFontFactory()
+	{
+	}
+
+	DistanceFieldFontFactory::~DistanceFieldFontFactory()
+	{
+		SizeMap::iterator font;
+		for(font = fonts.begin(); font != fonts.end(); ++font)
+		{
+			delete font->second;
+		}
+
+		FaceMap::iterator face;
+		for(face = faces.begin(); face != faces.end(); ++face)
+		{
+			delete face->second;
+		}
+	}
+
+	bool DistanceFieldFontFactory::addFace(const std::string &name, const std::string &fileName)
+	{
+		FaceMap::iterator found = faces.find(name);
+		if(found != faces.end())
+		{
+			return found->second->load(fileName);
+		}
+
+		DistanceFieldFace *face = new DistanceFieldFace();
+		if(!face->load(fileName))
+		{
+			delete face;
+			return false;
+		}
+		faces[name] = face;
+		return true;
+	}
+
+	DistanceFieldFace * DistanceFieldFontFactory::getFace(const std::string &name) const
+	{
+		FaceMap::const_iterator found = faces.find(name);
+		return found != faces.end() ? found->second : 0;
+	}
+
+	Font * DistanceFieldFontFactory::createFont(const std::string &font, std::size_t size)
+	{
+		std::pair<std::string,std::size_t> key(font,size);
+
+		SizeMap::iterator found = fonts.find(key);
+		if(found != fonts.end())
+		{
+			return found->second;
+		}
+
+		DistanceFieldFace *face = getFace(font);
+		if(face == 0)
+		{
+			return 0;
+		}
+
+		DistanceFieldFont *result = new DistanceFieldFont(face,font,size);
+		fonts[key] = result;
+		return result;
+	}
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DISTANCEFIELDFONT_H
+#define DISTANCEFIELDFONT_H
+
+#include <map>
+#include "./Config.h"
+#include "./Font.h"
+#include "./DistanceFieldFace.h"
+
+namespace ui
+{
+	/**
+	 * A Font drawn from a DistanceFieldFace.
+	 * Any number of sizes share the atlas of their face, a
+	 * DistanceFieldFont only stores its size. Metrics are the
+	 * face metrics scaled to the size and rounded once per string,
+	 * so the advances of a string always add up to its width.
+	 */
+	class DistanceFieldFont : public Font
+	{
+	public:
+		/**
+		 * Creates a DistanceFieldFont.
+		 * @param
+		 *	face the face to draw, which must outlive the font.
+		 * @param
+		 *	name the name of the face.
+		 * @param
+		 *	size the pixel size to draw the face at.
+		 */
+		DistanceFieldFont(DistanceFieldFace *face, const std::string &name, std::size_t size);
+
+		const std::string getFontName() const;
+		std::size_t getSize() const;
+		util::Dimension getStringBoundingBox(const std::string &text) const;
+		void getGlyphAdvances(const std::string &text, std::vector<int> &advances) const;
+		void drawString(int x, int y, const std::string &text);
+
+		/**
+		 * Returns the face of this font.
+		 */
+		DistanceFieldFace * getFace() const;
+	private:
+		/**
+		 * Scales a length in 1/64 pixels at the field size
+		 * to whole pixels at the size of this font.
+		 */
+		int scale(long length) const;
+
+		DistanceFieldFace *face;
+		std::string name;
+		std::size_t size;
+
+		std::vector<GLfloat> vertices;
+	};
+
+	/**
+	 * Creates DistanceFieldFonts from faces registered by name.
+	 * <p>
+	 * Register the faces once with addFace and pass the factory to
+	 * Gui::setFontFactory. Fonts of any size can then be created
+	 * without rasterizing anything. The factory owns the faces and
+	 * the fonts it created, and deletes them when it is destroyed.
+	 * </p>
+	 */
+	class DistanceFieldFontFactory : public AbstractFontFactory
+	{
+	public:
+		DistanceFieldFontFactory();
+		~DistanceFieldFontFactory();
+
+		/**
+		 * Loads a face from a distance field atlas file. If a face
+		 * was already registered under the name it is reloaded, and
+		 * the fonts created from it draw the new atlas.
+		 * @param
+		 *	name the font name the face is created under.
+		 * @param
+		 *	fileName the atlas file, see DistanceFieldFace.
+		 * @return
+		 *	false if the file could not be loaded.
+		 */
+		bool addFace(const std::string &name, const std::string &fileName);
+
+		/**
+		 * Returns the face registered under name, or NULL.
+		 */
+		DistanceFieldFace * getFace(const std::string &name) const;
+
+		/**
+		 * Returns a font of the given face and size, or NULL if
+		 * no face was registered under that name. Asking twice
+		 * for the same font returns the same instance.
+		 */
+		Font * createFont(const std::string &font, std::size_t size);
+	private:
+		DistanceFieldFontFactory(const DistanceFieldFontFactory &rhs);
+		DistanceFieldFontFactory& operator=(const DistanceFieldFontFactory &rhs);
+
+		typedef std::map<std::string,DistanceFieldFace*> FaceMap;
+		typedef std::map<std::pair<std::string,std::size_t>,DistanceFieldFont*> SizeMap;
+
+		FaceMap faces;
+		SizeMap fonts;
+	};
+}
+
+#endif
@@ -117,67 +117,18 @@ namespace ui
 		return focusOwner;
 	}
 
-	void FocusManager::buildStack(Component *node, bool backward)
-	{
-		ComponentList list = node->getChildren();
-		ComponentList::iterator iter;
-
-		if(!backward)
-		{
-			if(node->isVisible() && node->hasFocusListener())
-			{
-				stack.push_back(node);
-			}
-		}
-
-
-		for(iter = list.begin(); iter != list.end(); ++iter)
-		{
-			buildStack((*iter),backward);
-		}
-
-		if(node->isRootContainer())
-		{
-			// Rather nasty hack, since windows are not part
-			// of the normal component hierarchy. Luckely,
-			// all root containers are derived from Window (Frame and Dialog).
-			// Sigh.
-			Window * tmp = static_cast<Window *>(node);
-			if(tmp)
-			{
-				WindowList children = tmp->getOwnedWindows();
-				WindowList::const_iterator iter;
-				for(iter = children.begin(); iter != children.end(); ++iter)
-				{
-					if((*iter)->isVisible())
-					{
-						buildStack((*iter),backward);
-					}
-				}
-			}
-		}
-
-		if(backward)
-		{
-			if(node->isVisible() && node->hasFocusListener())
-			{
-				stack.push_back(node);
-			}
-		}
-	}
-
-	void FocusManager::keyPressed(int keyCode, int modifier)
+	void FocusManager::keyPressed(int keyCode, int modifier, unsigned int character)
 	{
 		if(permanentFocusOwner != 0 && focusOwner != 0)
 		{
 			if(permanentFocusOwner != focusOwner)
 			{
-				event::KeyEvent keyEvent(focusOwner,event::KeyEvent::KEY_PRESSED,keyCode,modifier);
+				event::KeyEvent keyEvent(focusOwner,event::KeyEvent::KEY_PRESSED,keyCode,modifier,character);
 				focusOwner->processKeyEvent(keyEvent);
 			}
 			else
 			{
-				event::KeyEvent keyEvent(permanentFocusOwner,event::KeyEvent::KEY_PRESSED,keyCode,modifier);
+				event::KeyEvent keyEvent(permanentFocusOwner,event::KeyEvent::KEY_PRESSED,keyCode,modifier,character);
 				permanentFocusOwner->processKeyEvent(keyEvent);
 			}
 		}
@@ -207,155 +158,121 @@ namespace ui
 		}
 	}
 
-	void FocusManager::focusRightComponent()
+	Component * FocusManager::getRoot(Component *c)
 	{
-		//fprintf(stderr,"focus next called\n");
-		Component * root(permanentFocusOwner);
-		Component * goal(permanentFocusOwner);
+		Component *root = c;
+		while(root->getParent() != 0)
+		{
+			root = root->getParent();
+		}
+		return root;
+	}
+
+	const FocusRing & FocusManager::getFocusRing(Component *c)
+	{
+		Component *root = getRoot(c);
 
-		if(permanentFocusOwner != focusOwner)
+		FocusRing &ring = rings[root];
+		if(!ring.isBuilt())
 		{
-			goal = focusOwner;
+			ring.build(root);
+		}
+		return ring;
+	}
+
+	void FocusManager::invalidateFocusRings()
+	{
+		rings.clear();
+	}
+
+	void FocusManager::invalidateFocusRing(Component *c)
+	{
+		// most of the time no ring has been asked for.
+		if(!rings.empty())
+		{
+			rings.erase(getRoot(c));
 		}
-		
+	}
+
+	void FocusManager::removeFocusRing(Component *root)
+	{
+		rings.erase(root);
+	}
 
-		if(permanentFocusOwner->getParent() != 0)
+	void FocusManager::invalidateFocusGeometry(Component *c)
+	{
+		if(!rings.empty())
 		{
-			for(root = permanentFocusOwner->getParent(); root->getParent() != 0;)
+			std::map<Component*,FocusRing>::iterator ring = rings.find(getRoot(c));
+			if(ring != rings.end())
 			{
-				root = root->getParent();
+				ring->second.invalidateGeometry();
 			}
 		}
+	}
 
-		buildStack(root,false);
-/*
-		std::deque<Component *>::iterator iter;
+	void FocusManager::moveFocus(Component *c)
+	{
+		if(c == 0)
+		{
+			return;
+		}
 
-		for(iter = stack.begin(); iter != stack.end(); ++iter)
+		if(c->canHoldPermanentFocus())
 		{
-				if((*iter)->getThemeName() == "Menu")
-				{
-					fprintf(stderr,"%s: %s",(*iter)->getThemeName().c_str(),static_cast<Menu *>((*iter))->getText().c_str());
-				}
-				else if((*iter)->getThemeName() == "MenuItem")
-				{
-					fprintf(stderr,"%s: %s",(*iter)->getThemeName().c_str(),static_cast<MenuItem *>((*iter))->getText().c_str());
-				}
+			setPermanentFocusOwner(c);
+		}
+		else
+		{
+			setFocusOwner(c);
+		}
+	}
 
-				if((*iter) == goal)
-				{
-					fprintf(stderr,"<---\n");
-				}
-				else
-				{
-					fprintf(stderr,"\n");
-				}		
+	void FocusManager::focusRightComponent()
+	{
+		if(permanentFocusOwner == 0)
+		{
+			return;
 		}
-*/
-		std::deque<Component *> back(stack);
 
-		while(!stack.empty())
+		Component * goal(permanentFocusOwner);
+		if(permanentFocusOwner != focusOwner && focusOwner != 0)
 		{
-			if(stack.front() == goal)
-			{
-				if(stack.size() != 1)
-				{
-					stack.pop_front();
-
-					/*
-					if(stack.front()->getThemeName() == "Menu")
-					{
-						fprintf(stderr,"-->%s: %s",stack.front()->getThemeName().c_str(),static_cast<Menu *>(stack.front())->getText().c_str());
-					}
-					else if(stack.front()->getThemeName() == "MenuItem")
-					{
-						fprintf(stderr,"-->%s: %s",stack.front()->getThemeName().c_str(),static_cast<MenuItem *>(stack.front())->getText().c_str());
-					}
-					*/
-					if(stack.front()->canHoldPermanentFocus())
-					{
-						setPermanentFocusOwner(stack.front());
-					}
-					else
-					{
-						setFocusOwner(stack.front());
-					}
-				}
-				else
-				{
-					if(back.back()->canHoldPermanentFocus())
-					{
-						setPermanentFocusOwner(back.back());
-					}
-					else
-					{
-						setFocusOwner(back.back());
-					}
-				}
-				break;
-			}
-			stack.pop_front();
-			back.pop_back();
+			goal = focusOwner;
 		}
-		
-		stack.clear();
+
+		moveFocus(getFocusRing(permanentFocusOwner).getNext(goal));
 	}
 
 	void FocusManager::focusLeftComponent()
 	{
-		Component * root(permanentFocusOwner);
-		Component * goal(permanentFocusOwner);
-
-		if(permanentFocusOwner != focusOwner)
+		if(permanentFocusOwner == 0)
 		{
-			goal = focusOwner;
+			return;
 		}
 
-		if(permanentFocusOwner->getParent() != 0)
+		Component * goal(permanentFocusOwner);
+		if(permanentFocusOwner != focusOwner && focusOwner != 0)
 		{
-			for(root = permanentFocusOwner->getParent(); root->getParent() != 0;)
-			{
-				root = root->getParent();
-			}
+			goal = focusOwner;
 		}
 
-		buildStack(root, true);
+		moveFocus(getFocusRing(permanentFocusOwner).getPrevious(goal));
+	}
 
-		std::deque<Component *> back(stack);
+	void FocusManager::focusComponent(int direction)
+	{
+		if(permanentFocusOwner == 0)
+		{
+			return;
+		}
 
-		while(!stack.empty())
+		Component * goal(permanentFocusOwner);
+		if(permanentFocusOwner != focusOwner && focusOwner != 0)
 		{
-			if(stack.back() == goal)
-			{
-				if(stack.size() != 1)
-				{
-					stack.pop_back();
-
-					if(stack.back()->canHoldPermanentFocus())
-					{
-						setPermanentFocusOwner(stack.back());
-					}
-					else
-					{
-						setFocusOwner(stack.back());
-					}
-				}
-				else
-				{
-					if(back.front()->canHoldPermanentFocus())
-					{
-						setPermanentFocusOwner(back.front());
-					}
-					else
-					{
-						setFocusOwner(back.front());
-					}
-				}
-				break;
-			}
-			stack.pop_back();
-			back.pop_front();
+			goal = focusOwner;
 		}
-		stack.clear();
+
+		moveFocus(getFocusRing(permanentFocusOwner).getNearest(goal,direction));
 	}
 }
\ No newline at end of file
@@ -30,6 +30,9 @@
 #define FOCUSMANAGER_H
 
 #include "./Pointers.h"
+#include "./FocusRing.h"
+#include "./UiContext.h"
+#include <map>
 
 namespace ui
 {
@@ -46,8 +49,7 @@ namespace ui
 
 		static FocusManager & getInstance()
 		{
-			static FocusManager obj;
-			return obj;
+			return UiContext::getCurrent().getFocusManager();
 		}
 
 		/**
@@ -90,7 +92,7 @@ namespace ui
 		 * Sends keypresses to the currently focused
 		 * Component.
 		 */
-		void keyPressed(int keyCode, int modifier);
+		void keyPressed(int keyCode, int modifier, unsigned int character = 0);
 
 		/**
 		 * Sends keyreleases to the currently focused
@@ -112,9 +114,59 @@ namespace ui
 		 */
 		void focusLeftComponent();
 
+		/**
+		 * Move focus to the nearest Component in a direction
+		 * on screen, for d-pad and keyboard navigation. If there
+		 * is no current focus owner, or nothing in that direction,
+		 * nothing happens.
+		 * @param
+		 *	direction FocusTree::UP, DOWN, LEFT or RIGHT.
+		 * @see
+		 *	FocusTree
+		 */
+		void focusComponent(int direction);
+
+		/**
+		 * Returns the FocusRing of the root Component above c.
+		 * Rings are built when they are first asked for, and kept
+		 * until they are invalidated.
+		 */
+		const FocusRing & getFocusRing(Component *c);
+
+		/**
+		 * Throws away all FocusRings.
+		 */
+		void invalidateFocusRings();
+
+		/**
+		 * Throws away the FocusRing of the root above c, leaving
+		 * the rings of other roots alone. Components call this
+		 * when the hierarchy below that root changes, when they
+		 * are shown or hidden, and when their FocusListeners or
+		 * depth change.
+		 */
+		void invalidateFocusRing(Component *c);
+
+		/**
+		 * Throws away the FocusRing of root, if there is one.
+		 * Components call this when they are destroyed, so a
+		 * new root at the same address does not get the ring
+		 * of the old one.
+		 */
+		void removeFocusRing(Component *root);
+
+		/**
+		 * Drops the spatial index of the FocusRing of the root
+		 * above c but keeps its order. Components call this when
+		 * they move or change size.
+		 */
+		void invalidateFocusGeometry(Component *c);
+
 	private:
-		void buildStack(Component *node, bool backward);
-		std::deque<Component *> stack;
+		void moveFocus(Component *c);
+		static Component * getRoot(Component *c);
+
+		std::map<Component*,FocusRing> rings;
 		Component* focusOwner, *permanentFocusOwner, *oppositeComponent;
 	};
 }
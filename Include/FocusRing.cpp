@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./FocusRing.h"
+#include "./Component.h"
+#include "./component/Window.h"
+#include "./util/Rectangle.h"
+#include "./util/Point.h"
+
+namespace ui
+{
+	FocusRing::FocusRing()
+		:	modalLayer(0),
+			hint(0),
+			built(false)
+	{
+	}
+
+	void FocusRing::build(Component *root)
+	{
+		components.clear();
+		layers.clear();
+		trees.clear();
+		modalLayer = 0;
+		hint = 0;
+		collect(root);
+		built = true;
+	}
+
+	bool FocusRing::isBuilt() const
+	{
+		return built;
+	}
+
+	void FocusRing::collect(Component *node)
+	{
+		if(node->isVisible() && node->hasFocusListener())
+		{
+			int layer = getLayer(node);
+			if(isModal(layer) && (modalLayer == 0 || layer < modalLayer))
+			{
+				modalLayer = layer;
+			}
+			components.push_back(node);
+			layers.push_back(layer);
+		}
+
+		const ComponentList &list = node->getChildren();
+		ComponentList::const_iterator iter;
+		for(iter = list.begin(); iter != list.end(); ++iter)
+		{
+			collect((*iter));
+		}
+
+		if(node->isRootContainer())
+		{
+			// windows are not part of the normal component
+			// hierarchy, but all root containers are derived
+			// from Window (Frame and Dialog).
+			Window * window = static_cast<Window *>(node);
+			const WindowList &children = window->getOwnedWindows();
+			WindowList::const_iterator iter;
+			for(iter = children.begin(); iter != children.end(); ++iter)
+			{
+				if((*iter)->isVisible())
+				{
+					collect((*iter));
+				}
+			}
+		}
+	}
+
+	int FocusRing::indexOf(Component *c) const
+	{
+		int size = static_cast<int>(components.size());
+
+		if(hint < size && components[hint] == c)
+		{
+			return hint;
+		}
+
+		for(int i = 0; i < size; ++i)
+		{
+			if(components[i] == c)
+			{
+				hint = i;
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	Component * FocusRing::getNext(Component *c) const
+	{
+		int index = indexOf(c);
+		if(index == -1)
+		{
+			return 0;
+		}
+
+		hint = (index + 1) % static_cast<int>(components.size());
+		return components[hint];
+	}
+
+	Component * FocusRing::getPrevious(Component *c) const
+	{
+		int index = indexOf(c);
+		if(index == -1)
+		{
+			return 0;
+		}
+
+		int size = static_cast<int>(components.size());
+		hint = (index + size - 1) % size;
+		return components[hint];
+	}
+
+	int FocusRing::getLayer(Component *c)
+	{
+		// a Component is drawn in the topmost layer of
+		// itself and its parents, lower depths are on top.
+		int layer = c->getDepth();
+		for(Component *parent = c->getParent(); parent != 0; parent = parent->getParent())
+		{
+			layer = std::min(layer,parent->getDepth());
+		}
+		return layer;
+	}
+
+	bool FocusRing::isModal(int layer)
+	{
+		return layer == Component::NORMAL_MODAL || layer == Component::POPUP_MODAL;
+	}
+
+	Component * FocusRing::getNearest(Component *c, int direction) const
+	{
+		int index = indexOf(c);
+		int layer = (index != -1) ? layers[index] : getLayer(c);
+		if(modalLayer != 0 && modalLayer < layer)
+		{
+			layer = modalLayer;
+		}
+
+		std::map<int,FocusTree>::iterator pos = trees.find(layer);
+		if(pos == trees.end())
+		{
+			std::vector<Component*> candidates;
+			for(std::size_t i = 0; i < components.size(); ++i)
+			{
+				if(layers[i] == layer)
+				{
+					candidates.push_back(components[i]);
+				}
+			}
+			pos = trees.insert(std::make_pair(layer,FocusTree())).first;
+			pos->second.build(candidates);
+		}
+
+		const util::Point location = c->getLocationOnScreen();
+		const util::Rectangle &bounds = c->getBounds();
+		return pos->second.getNearest(util::Rectangle(location.x,location.y,bounds.width,bounds.height),c,direction);
+	}
+
+	void FocusRing::invalidateGeometry()
+	{
+		trees.clear();
+	}
+
+	const std::vector<Component*> & FocusRing::getComponents() const
+	{
+		return components;
+	}
+}
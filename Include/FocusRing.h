@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FOCUSRING_H
+#define FOCUSRING_H
+
+#include "./Pointers.h"
+#include "./FocusTree.h"
+#include <map>
+
+namespace ui
+{
+	/**
+	 * The order in which focus moves through the Components
+	 * under a root Component. It holds every visible Component
+	 * with a FocusListener, each one before its children and the
+	 * windows it owns, and wraps around at both ends.
+	 * <p>
+	 * The ring remembers where the last Component it was asked
+	 * about was found, so repeatedly moving focus from the
+	 * Component the ring itself returned takes constant time.
+	 * Any other Component is searched for.
+	 * </p>
+	 * <p>
+	 * For directional navigation the ring keeps a FocusTree per
+	 * layer, built from the screen bounds when first needed and
+	 * dropped when the geometry changes. Components in a popup or
+	 * modal layer only move within it, and an open modal layer
+	 * above the starting Component is the only place focus can go.
+	 * </p>
+	 * @see
+	 *	FocusManager::getFocusRing
+	 */
+	class FocusRing
+	{
+	public:
+		FocusRing();
+
+		/**
+		 * Collects the Components under root. 
+		 */
+		void build(Component *root);
+
+		/**
+		 * Returns true once build has been called.
+		 */
+		bool isBuilt() const;
+
+		/**
+		 * Returns the Component after c, or the first one
+		 * when c is the last. Returns 0 if c is not in the ring.
+		 */
+		Component * getNext(Component *c) const;
+
+		/**
+		 * Returns the Component before c, or the last one
+		 * when c is the first. Returns 0 if c is not in the ring.
+		 */
+		Component * getPrevious(Component *c) const;
+
+		/**
+		 * Returns the nearest Component in direction from c,
+		 * or 0 if there is none.
+		 * @param
+		 *	direction one of the FocusTree directions.
+		 */
+		Component * getNearest(Component *c, int direction) const;
+
+		/**
+		 * Drops the FocusTrees, after Components have moved.
+		 */
+		void invalidateGeometry();
+
+		/**
+		 * Returns the position of c in the ring, or -1.
+		 */
+		int indexOf(Component *c) const;
+
+		/**
+		 * Returns all Components in the ring, in order.
+		 */
+		const std::vector<Component*> & getComponents() const;
+	private:
+		void collect(Component *node);
+		static int getLayer(Component *c);
+		static bool isModal(int layer);
+
+		std::vector<Component*> components;
+		std::vector<int> layers;
+		int modalLayer;
+		mutable std::map<int,FocusTree> trees;
+		mutable int hint;
+		bool built;
+	};
+}
+
+#endif
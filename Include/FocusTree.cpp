@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./FocusTree.h"
+#include "./Component.h"
+#include "./util/Rectangle.h"
+#include "./util/Point.h"
+#include <cstdlib>
+
+namespace ui
+{
+	bool FocusTree::CompareX::operator()(const Node &a, const Node &b) const
+	{
+		return a.x < b.x;
+	}
+
+	bool FocusTree::CompareY::operator()(const Node &a, const Node &b) const
+	{
+		return a.y < b.y;
+	}
+
+// ---------------------------------------------------------------------------
+
+	FocusTree::FocusTree()
+	{
+	}
+
+	void FocusTree::build(const std::vector<Component*> &components)
+	{
+		nodes.clear();
+		nodes.reserve(components.size());
+
+		std::vector<Component*>::const_iterator iter;
+		for(iter = components.begin(); iter != components.end(); ++iter)
+		{
+			const util::Point location = (*iter)->getLocationOnScreen();
+			const util::Rectangle &bounds = (*iter)->getBounds();
+
+			Node node;
+			node.component = (*iter);
+			node.x = location.x + bounds.width / 2;
+			node.y = location.y + bounds.height / 2;
+			nodes.push_back(node);
+		}
+		build(0,static_cast<int>(nodes.size()),true);
+	}
+
+	void FocusTree::build(int begin, int end, bool splitX)
+	{
+		if(begin >= end)
+		{
+			return;
+		}
+
+		// the median goes in the middle of the range, the
+		// subtrees on either side of it.
+		int middle = (begin + end) / 2;
+		if(splitX)
+		{
+			std::nth_element(nodes.begin() + begin,nodes.begin() + middle,nodes.begin() + end,CompareX());
+		}
+		else
+		{
+			std::nth_element(nodes.begin() + begin,nodes.begin() + middle,nodes.begin() + end,CompareY());
+		}
+
+		Node &node = nodes[middle];
+		node.minX = node.maxX = node.x;
+		node.minY = node.maxY = node.y;
+		for(int i = begin; i < end; ++i)
+		{
+			node.minX = std::min(node.minX,nodes[i].x);
+			node.maxX = std::max(node.maxX,nodes[i].x);
+			node.minY = std::min(node.minY,nodes[i].y);
+			node.maxY = std::max(node.maxY,nodes[i].y);
+		}
+
+		build(begin,middle,!splitX);
+		build(middle + 1,end,!splitX);
+	}
+
+	Component * FocusTree::getNearest(const util::Rectangle &bounds, Component *exclude, int direction) const
+	{
+		Query query;
+		query.x = bounds.x + bounds.width / 2;
+		query.y = bounds.y + bounds.height / 2;
+		query.direction = direction;
+		query.exclude = exclude;
+		query.best = 0;
+		query.bestScore = 0;
+
+		search(0,static_cast<int>(nodes.size()),query);
+		return query.best;
+	}
+
+	void FocusTree::search(int begin, int end, Query &query) const
+	{
+		if(begin >= end)
+		{
+			return;
+		}
+
+		int middle = (begin + end) / 2;
+		const Node &node = nodes[middle];
+
+		int bound = getLowerBound(query,node);
+		if(bound < 0 || (query.best != 0 && bound >= query.bestScore))
+		{
+			return;
+		}
+
+		if(node.component != query.exclude)
+		{
+			int score = getScore(query,node.x,node.y);
+			if(score >= 0 && (query.best == 0 || score < query.bestScore))
+			{
+				query.best = node.component;
+				query.bestScore = score;
+			}
+		}
+
+		search(begin,middle,query);
+		search(middle + 1,end,query);
+	}
+
+	void FocusTree::toDirection(int direction, int dx, int dy, int &along, int &across)
+	{
+		switch(direction)
+		{
+			case UP:
+				along = -dy;
+				across = dx;
+				break;
+			case DOWN:
+				along = dy;
+				across = dx;
+				break;
+			case LEFT:
+				along = -dx;
+				across = dy;
+				break;
+			default:
+				along = dx;
+				across = dy;
+				break;
+		}
+	}
+
+	int FocusTree::getScore(const Query &query, int x, int y)
+	{
+		int along, across;
+		toDirection(query.direction,x - query.x,y - query.y,along,across);
+
+		if(along <= 0)
+		{
+			return -1;
+		}
+		return along + 2 * std::abs(across);
+	}
+
+	int FocusTree::getLowerBound(const Query &query, const Node &node)
+	{
+		// the box in direction space; mirroring swaps min and max.
+		int alongMin, alongMax, acrossMin, acrossMax;
+		toDirection(query.direction,node.minX - query.x,node.minY - query.y,alongMin,acrossMin);
+		toDirection(query.direction,node.maxX - query.x,node.maxY - query.y,alongMax,acrossMax);
+
+		if(alongMin > alongMax)
+		{
+			std::swap(alongMin,alongMax);
+		}
+		if(acrossMin > acrossMax)
+		{
+			std::swap(acrossMin,acrossMax);
+		}
+
+		if(alongMax <= 0)
+		{
+			// nothing in this subtree lies in the direction
+			return -1;
+		}
+
+		int across = 0;
+		if(acrossMin > 0)
+		{
+			across = acrossMin;
+		}
+		else if(acrossMax < 0)
+		{
+			across = -acrossMax;
+		}
+		return std::max(alongMin,1) + 2 * across;
+	}
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FOCUSTREE_H
+#define FOCUSTREE_H
+
+#include "./Pointers.h"
+
+namespace ui
+{
+	/**
+	 * A kd-tree over the screen bounds of focusable Components,
+	 * used to find the nearest Component in a direction, for
+	 * example when a d-pad moves focus. Each node stores the
+	 * centre of a Component and the box around all centres in
+	 * its subtree, so whole subtrees that cannot be closer than
+	 * the best Component found so far are skipped.
+	 * <p>
+	 * A Component lies in a direction when its centre is beyond
+	 * the centre of the starting bounds along that direction. Of
+	 * those, the one with the lowest distance along the direction
+	 * plus twice the distance across it wins, which prefers
+	 * Components that are lined up over ones that are closer
+	 * but off to the side.
+	 * </p>
+	 */
+	class FocusTree
+	{
+	public:
+		enum DIRECTIONS
+		{
+			UP,
+			DOWN,
+			LEFT,
+			RIGHT
+		};
+
+		FocusTree();
+
+		/**
+		 * Builds the tree over the current screen bounds of
+		 * components.
+		 */
+		void build(const std::vector<Component*> &components);
+
+		/**
+		 * Returns the nearest Component in direction from the
+		 * centre of bounds, or 0 if there is none.
+		 * @param
+		 *	bounds the screen bounds to start from.
+		 * @param
+		 *	exclude a Component that is never returned, usually
+		 *	the one bounds belongs to.
+		 * @param
+		 *	direction one of UP, DOWN, LEFT or RIGHT.
+		 */
+		Component * getNearest(const util::Rectangle &bounds, Component *exclude, int direction) const;
+	private:
+		class Node
+		{
+		public:
+			Component *component;
+			int x, y;
+			int minX, minY, maxX, maxY;
+		};
+
+		class Query
+		{
+		public:
+			int x, y;
+			int direction;
+			Component *exclude;
+			Component *best;
+			int bestScore;
+		};
+
+		class CompareX
+		{
+		public:
+			bool operator()(const Node &a, const Node &b) const;
+		};
+
+		class CompareY
+		{
+		public:
+			bool operator()(const Node &a, const Node &b) const;
+		};
+
+		void build(int begin, int end, bool splitX);
+		void search(int begin, int end, Query &query) const;
+
+		static void toDirection(int direction, int dx, int dy, int &along, int &across);
+		static int getScore(const Query &query, int x, int y);
+		static int getLowerBound(const Query &query, const Node &node);
+
+		std::vector<Node> nodes;
+	};
+}
+
+#endif
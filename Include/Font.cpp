@@ -26,9 +26,18 @@
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include "./Font.h"
+#include "./util/Utf8.h"
 
 namespace ui
 {
+	GlyphBitmap::GlyphBitmap()
+		:	width(0),
+			height(0),
+			left(0),
+			top(0)
+	{
+	}
+
 	bool Font::operator ==(const Font &rhs)
 	{
 		return (getFontName() == rhs.getFontName() && getSize() && rhs.getSize());
@@ -38,6 +47,40 @@ namespace ui
 	{
 	}
 
+	void Font::getGlyphAdvances(const std::string &text, std::vector<int> &advances) const
+	{
+		advances.assign(text.length(),0);
+
+		// every code point is measured once, so the time is
+		// linear in the length of the text.
+		unsigned int previous = 0;
+		std::size_t index = 0;
+		while(index < text.length())
+		{
+			std::size_t start = index;
+			unsigned int codepoint = util::Utf8::decode(text,index);
+			glyph.assign(text,start,index - start);
+
+			advances[start] = getStringBoundingBox(glyph).width;
+
+			if(start != 0)
+			{
+				advances[start] += getKerning(previous,codepoint);
+			}
+			previous = codepoint;
+		}
+	}
+
+	int Font::getKerning(unsigned int left, unsigned int right) const
+	{
+		return 0;
+	}
+
+	bool Font::getGlyphBitmap(unsigned int codepoint, GlyphBitmap &bitmap) const
+	{
+		return false;
+	}
+
 	AbstractFontFactory::~AbstractFontFactory()
 	{
 	}
@@ -29,10 +29,38 @@
 #ifndef FONT_H
 #define FONT_H
 
+#include <vector>
 #include "./util/Dimension.h"
 
 namespace ui
 {
+	/**
+	 * The coverage and metrics of a single glyph, as supplied
+	 * by Font::getGlyphBitmap.
+	 */
+	class GlyphBitmap
+	{
+	public:
+		GlyphBitmap();
+
+		/**
+		 * Size of the bitmap in pixels.
+		 */
+		int width, height;
+
+		/**
+		 * Offset of the top left corner of the bitmap from the
+		 * pen position, where the pen is at the top of the line.
+		 */
+		int left, top;
+
+		/**
+		 * One byte of coverage per pixel, row by row from the
+		 * top, 0 is transparent and 255 is opaque.
+		 */
+		std::vector<unsigned char> pixels;
+	};
+
 	/**
 	 * Defines a Font to be used by the GUI.
 	 * Font is an abstract base class for writing
@@ -58,6 +86,65 @@ namespace ui
 		 */
 		virtual util::Dimension getStringBoundingBox(const std::string &text) const = 0;
 
+		/**
+		 * Stores the horizontal advance of every character of
+		 * text in advances, including the kerning between the
+		 * character and the one before it. The advances add up to
+		 * the width of the text, so the width of any prefix can be
+		 * found without measuring it again.
+		 * <p>
+		 * Text is UTF-8, and advances has one entry per byte. The
+		 * advance of a code point is stored at its first byte and
+		 * the other bytes get 0, so a prefix which ends inside a
+		 * code point is as wide as the code point itself, and the
+		 * longest prefix fitting a width never splits one.
+		 * </p>
+		 * <p>
+		 * The default implementation measures every code point on
+		 * its own with getStringBoundingBox, and adds getKerning
+		 * between every pair. Fonts which know their glyph metrics
+		 * should override it.
+		 * </p>
+		 * @param
+		 *	text the text to measure.
+		 * @param
+		 *	advances receives one advance per character, the
+		 *	vector is reused and only grows when it is too small.
+		 */
+		virtual void getGlyphAdvances(const std::string &text, std::vector<int> &advances) const;
+
+		/**
+		 * Returns the kerning between two code points, which is
+		 * added to the advance of right when it follows left.
+		 * The default implementation returns 0, Fonts which have
+		 * kerning should override it.
+		 * @param
+		 *	left the code point before right.
+		 * @param
+		 *	right the code point which is moved.
+		 * @return
+		 *	the kerning in pixels, negative to move right closer.
+		 */
+		virtual int getKerning(unsigned int left, unsigned int right) const;
+
+		/**
+		 * Rasterizes the glyph of a single code point.
+		 * <p>
+		 * Fonts which implement this are drawn by Graphics itself:
+		 * their glyphs are packed into the texture pages of a
+		 * GlyphAtlas and all text on screen is drawn with one call
+		 * per page. Fonts which do not implement it are drawn with
+		 * drawString. The default implementation returns false.
+		 * </p>
+		 * @param
+		 *	codepoint the unicode code point to rasterize.
+		 * @param
+		 *	bitmap receives the coverage and metrics of the glyph.
+		 * @return
+		 *	true if the Font supplied the glyph.
+		 */
+		virtual bool getGlyphBitmap(unsigned int codepoint, GlyphBitmap &bitmap) const;
+
 		/**
 		 * Draws a string at the specified location.
 		 */
@@ -72,6 +159,8 @@ namespace ui
 		 * Compare two fonts.
 		 */
 		bool operator==(const Font &rhs);
+	private:
+		mutable std::string glyph;
 	};
 
 	/**
@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./GlyphAtlas.h"
+#include "./GlyphContext.h"
+#include "./util/Utf8.h"
+#include <algorithm>
+
+namespace ui
+{
+	const int GlyphAtlas::cellSize = 64;
+	const int GlyphAtlas::gridSize = 16;
+
+	GlyphAtlas::GlyphAtlas(GlyphContext &context, int size)
+		:	glyphContext(context),
+			pageSize(size),
+			drawCount(0),
+			totalDrawCount(0),
+			buckets(gridSize * gridSize)
+	{
+	}
+
+	GlyphAtlas::~GlyphAtlas()
+	{
+		clear();
+	}
+
+	bool GlyphAtlas::addString(Font *font, const std::string &text, int x, int y, float z, const GLfloat color[4])
+	{
+		// make sure every glyph is available before queueing
+		// anything, the string is either batched as a whole or
+		// drawn by the Font.
+		std::size_t index = 0;
+		while(index < text.length())
+		{
+			if(!getGlyph(font,util::Utf8::decode(text,index)).supported)
+			{
+				return false;
+			}
+		}
+
+		glyphContext.getGlyphAdvances(font,text,advances);
+
+		int left = 0, top = 0, right = 0, bottom = 0;
+		bool covered = false;
+
+		int pen = x;
+		index = 0;
+		while(index < text.length())
+		{
+			// the advance of a code point is stored at its first byte.
+			std::size_t start = index;
+			const Glyph &glyph = getGlyph(font,util::Utf8::decode(text,index));
+
+			if(glyph.width > 0 && glyph.height > 0)
+			{
+				Page &page = pages[glyph.page];
+
+				GLfloat x0 = static_cast<GLfloat>(pen + glyph.left);
+				GLfloat y0 = static_cast<GLfloat>(y + glyph.top);
+				GLfloat x1 = x0 + glyph.width;
+				GLfloat y1 = y0 + glyph.height;
+
+				addVertex(page,x0,y0,z,glyph.u0,glyph.v0,color);
+				addVertex(page,x1,y0,z,glyph.u1,glyph.v0,color);
+				addVertex(page,x1,y1,z,glyph.u1,glyph.v1,color);
+				addVertex(page,x0,y1,z,glyph.u0,glyph.v1,color);
+
+				int glyphLeft = pen + glyph.left;
+				int glyphTop = y + glyph.top;
+
+				left = covered ? std::min(left,glyphLeft) : glyphLeft;
+				top = covered ? std::min(top,glyphTop) : glyphTop;
+				right = covered ? std::max(right,glyphLeft + glyph.width) : glyphLeft + glyph.width;
+				bottom = covered ? std::max(bottom,glyphTop + glyph.height) : glyphTop + glyph.height;
+				covered = true;
+			}
+			pen += advances[start];
+		}
+
+		if(covered)
+		{
+			if(queued.empty())
+			{
+				queuedExtent = util::Rectangle(left,top,right - left,bottom - top);
+			}
+			else
+			{
+				int extentRight = std::max(queuedExtent.x + queuedExtent.width,right);
+				int extentBottom = std::max(queuedExtent.y + queuedExtent.height,bottom);
+				queuedExtent.x = std::min(queuedExtent.x,left);
+				queuedExtent.y = std::min(queuedExtent.y,top);
+				queuedExtent.width = extentRight - queuedExtent.x;
+				queuedExtent.height = extentBottom - queuedExtent.y;
+			}
+			queued.push_back(util::Rectangle(left,top,right - left,bottom - top));
+			addToGrid(queued.size() - 1);
+		}
+		return true;
+	}
+
+	void GlyphAtlas::getCells(int position, int size, int &first, int &count)
+	{
+		// rounds down for negative positions as well.
+		int last = position + std::max(size,1) - 1;
+		first = position >= 0 ? position / cellSize : -((cellSize - 1 - position) / cellSize);
+		last = last >= 0 ? last / cellSize : -((cellSize - 1 - last) / cellSize);
+		count = std::min(last - first + 1,gridSize);
+	}
+
+	void GlyphAtlas::addToGrid(std::size_t index)
+	{
+		const util::Rectangle &bounds = queued[index];
+		int column, columns, row, rows;
+		getCells(bounds.x,bounds.width,column,columns);
+		getCells(bounds.y,bounds.height,row,rows);
+
+		for(int j = 0; j < rows; ++j)
+		{
+			int bucketRow = ((row + j) % gridSize + gridSize) % gridSize;
+			for(int i = 0; i < columns; ++i)
+			{
+				std::size_t bucket = bucketRow * gridSize + ((column + i) % gridSize + gridSize) % gridSize;
+				if(buckets[bucket].empty())
+				{
+					usedBuckets.push_back(bucket);
+				}
+				buckets[bucket].push_back(index);
+			}
+		}
+	}
+
+	void GlyphAtlas::clearQueued()
+	{
+		// clear keeps the memory of the buckets for the next frame.
+		std::vector<std::size_t>::const_iterator bucket;
+		for(bucket = usedBuckets.begin(); bucket != usedBuckets.end(); ++bucket)
+		{
+			buckets[*bucket].clear();
+		}
+		usedBuckets.clear();
+		queued.clear();
+	}
+
+	void GlyphAtlas::addVertex(Page &page, GLfloat x, GLfloat y, GLfloat z, GLfloat u, GLfloat v, const GLfloat color[4])
+	{
+		page.vertices.push_back(x);
+		page.vertices.push_back(y);
+		page.vertices.push_back(z);
+		page.vertices.push_back(u);
+		page.vertices.push_back(v);
+		page.vertices.push_back(color[0]);
+		page.vertices.push_back(color[1]);
+		page.vertices.push_back(color[2]);
+		page.vertices.push_back(color[3]);
+	}
+
+	void GlyphAtlas::flush()
+	{
+		drawCount = 0;
+
+		if(isEmpty())
+		{
+			return;
+		}
+
+		// every vertex is x, y, z, u, v, red, green, blue, alpha.
+		const GLsizei stride = 9 * sizeof(GLfloat);
+
+		glEnable(GL_TEXTURE_2D);
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+		glEnableClientState(GL_COLOR_ARRAY);
+
+		std::vector<Page>::iterator page;
+		for(page = pages.begin(); page != pages.end(); ++page)
+		{
+			if(!page->vertices.empty())
+			{
+				glBindTexture(GL_TEXTURE_2D,page->texture);
+				glVertexPointer(3,GL_FLOAT,stride,&page->vertices[0]);
+				glTexCoordPointer(2,GL_FLOAT,stride,&page->vertices[3]);
+				glColorPointer(4,GL_FLOAT,stride,&page->vertices[5]);
+				glDrawArrays(GL_QUADS,0,static_cast<GLsizei>(page->vertices.size() / 9));
+
+				// clear keeps the memory for the next frame.
+				page->vertices.clear();
+				++drawCount;
+				++totalDrawCount;
+			}
+		}
+
+		glDisableClientState(GL_COLOR_ARRAY);
+		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+		glDisableClientState(GL_VERTEX_ARRAY);
+		glDisable(GL_TEXTURE_2D);
+
+		clearQueued();
+	}
+
+	bool GlyphAtlas::isEmpty() const
+	{
+		std::vector<Page>::const_iterator page;
+		for(page = pages.begin(); page != pages.end(); ++page)
+		{
+			if(!page->vertices.empty())
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool GlyphAtlas::overlaps(int x, int y, int width, int height) const
+	{
+		// most of the time the rectangle is nowhere near the text,
+		// which the extent of all strings tells right away.
+		if(queued.empty() || !intersects(queuedExtent,x,y,width,height))
+		{
+			return false;
+		}
+
+		int column, columns, row, rows;
+		getCells(x,width,column,columns);
+		getCells(y,height,row,rows);
+
+		for(int j = 0; j < rows; ++j)
+		{
+			int bucketRow = ((row + j) % gridSize + gridSize) % gridSize;
+			for(int i = 0; i < columns; ++i)
+			{
+				const std::vector<std::size_t> &bucket = buckets[bucketRow * gridSize + ((column + i) % gridSize + gridSize) % gridSize];
+
+				std::vector<std::size_t>::const_iterator index;
+				for(index = bucket.begin(); index != bucket.end(); ++index)
+				{
+					if(intersects(queued[*index],x,y,width,height))
+					{
+						return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+	bool GlyphAtlas::intersects(const util::Rectangle &bounds, int x, int y, int width, int height)
+	{
+		return bounds.x < x + width && x < bounds.x + bounds.width && bounds.y < y + height && y < bounds.y + bounds.height;
+	}
+
+	void GlyphAtlas::clear()
+	{
+		std::vector<Page>::iterator page;
+		for(page = pages.begin(); page != pages.end(); ++page)
+		{
+			glDeleteTextures(1,&page->texture);
+		}
+		pages.clear();
+		glyphs.clear();
+		clearQueued();
+	}
+
+	std::size_t GlyphAtlas::getPageCount() const
+	{
+		return pages.size();
+	}
+
+	std::size_t GlyphAtlas::getGlyphCount() const
+	{
+		return glyphs.size();
+	}
+
+	std::size_t GlyphAtlas::getDrawCount() const
+	{
+		return drawCount;
+	}
+
+	std::size_t GlyphAtlas::getTotalDrawCount() const
+	{
+		return totalDrawCount;
+	}
+
+	const GlyphAtlas::Glyph & GlyphAtlas::getGlyph(Font *font, unsigned int codepoint)
+	{
+		GlyphKey key(font,codepoint);
+		GlyphMap::iterator found = glyphs.find(key);
+
+		if(found != glyphs.end())
+		{
+			return found->second;
+		}
+
+		Glyph &glyph = glyphs[key];
+		glyph.supported = font->getGlyphBitmap(codepoint,bitmap);
+		glyph.page = 0;
+		glyph.width = glyph.supported ? bitmap.width : 0;
+		glyph.height = glyph.supported ? bitmap.height : 0;
+		glyph.left = bitmap.left;
+		glyph.top = bitmap.top;
+		glyph.u0 = glyph.v0 = glyph.u1 = glyph.v1 = 0.0f;
+
+		if(glyph.width > 0 && glyph.height > 0)
+		{
+			int x, y;
+			if(allocate(glyph.width,glyph.height,glyph.page,x,y))
+			{
+				glBindTexture(GL_TEXTURE_2D,pages[glyph.page].texture);
+				glPixelStorei(GL_UNPACK_ALIGNMENT,1);
+				glTexSubImage2D(GL_TEXTURE_2D,0,x,y,glyph.width,glyph.height,GL_ALPHA,GL_UNSIGNED_BYTE,&bitmap.pixels[0]);
+
+				GLfloat scale = 1.0f / pageSize;
+				glyph.u0 = x * scale;
+				glyph.v0 = y * scale;
+				glyph.u1 = (x + glyph.width) * scale;
+				glyph.v1 = (y + glyph.height) * scale;
+			}
+			else
+			{
+				// larger than a page, let the Font draw it.
+				glyph.supported = false;
+			}
+		}
+		return glyph;
+	}
+
+	bool GlyphAtlas::allocate(int width, int height, std::size_t &page, int &x, int &y)
+	{
+		// one pixel of padding keeps neighbouring glyphs
+		// from bleeding into each other when filtered.
+		int paddedWidth = width + 1;
+		int paddedHeight = height + 1;
+
+		if(paddedWidth > pageSize || paddedHeight > pageSize)
+		{
+			return false;
+		}
+
+		if(pages.empty())
+		{
+			addPage();
+		}
+
+		Page *last = &pages.back();
+
+		if(last->shelfX + paddedWidth > pageSize)
+		{
+			// start a new shelf.
+			last->shelfY += last->shelfHeight;
+			last->shelfX = 0;
+			last->shelfHeight = 0;
+		}
+
+		if(last->shelfY + paddedHeight > pageSize)
+		{
+			addPage();
+			last = &pages.back();
+		}
+
+		page = pages.size() - 1;
+		x = last->shelfX;
+		y = last->shelfY;
+
+		last->shelfX += paddedWidth;
+		last->shelfHeight = std::max(last->shelfHeight,paddedHeight);
+		return true;
+	}
+
+	void GlyphAtlas::addPage()
+	{
+		Page page;
+		page.shelfX = 0;
+		page.shelfY = 0;
+		page.shelfHeight = 0;
+
+		glGenTextures(1,&page.texture);
+		glBindTexture(GL_TEXTURE_2D,page.texture);
+		glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_NEAREST);
+		glTexImage2D(GL_TEXTURE_2D,0,GL_ALPHA,pageSize,pageSize,0,GL_ALPHA,GL_UNSIGNED_BYTE,0);
+
+		pages.push_back(page);
+	}
+}
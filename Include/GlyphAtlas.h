@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <map>
+#include "./Config.h"
+#include "./Pointers.h"
+#include "./Font.h"
+#include "./util/Rectangle.h"
+
+namespace ui
+{
+	/**
+	 * Draws text in batches.
+	 * <p>
+	 * Glyphs rasterized by Font::getGlyphBitmap are packed into
+	 * texture pages the first time they are used. Strings are queued
+	 * as textured quads, one vertex array per page, and flush draws
+	 * all queued text with a single call per page. The quads are in
+	 * the coordinate system of the Graphics that queued them, it is
+	 * responsible for flushing whenever state the text depends on,
+	 * such as the scissor area, changes.
+	 * </p>
+	 * Glyphs are packed on shelves, rows of glyphs as high as the
+	 * highest glyph in the row. Pages are never repacked, a new page
+	 * is started when a glyph does not fit in the last one.
+	 */
+	class GlyphAtlas
+	{
+	public:
+		/**
+		 * Creates a new GlyphAtlas.
+		 * @param
+		 *	glyphs the GlyphContext strings are measured with.
+		 * @param
+		 *	pageSize width and height of the texture pages.
+		 */
+		GlyphAtlas(GlyphContext &glyphs, int pageSize);
+
+		/**
+		 * Destroys the texture pages.
+		 */
+		~GlyphAtlas();
+
+		/**
+		 * Queues a UTF-8 string.
+		 * @param
+		 *	font the Font to draw the string in.
+		 * @param
+		 *	x horizontal location of the string.
+		 * @param
+		 *	y location of the top of the string.
+		 * @param
+		 *	z depth of the string.
+		 * @param
+		 *	color red, green, blue and alpha of the string.
+		 * @return
+		 *	false if the Font does not supply glyph bitmaps,
+		 *	nothing is queued in that case.
+		 */
+		bool addString(Font *font, const std::string &text, int x, int y, float z, const GLfloat color[4]);
+
+		/**
+		 * Draws and empties the queue.
+		 */
+		void flush();
+
+		/**
+		 * Returns true if no text is queued.
+		 */
+		bool isEmpty() const;
+
+		/**
+		 * Returns true if any of the queued text overlaps a
+		 * rectangle. Anything painted over the text has to wait
+		 * for a flush, or it ends up below it.
+		 */
+		bool overlaps(int x, int y, int width, int height) const;
+
+		/**
+		 * Removes all glyphs and destroys the texture pages,
+		 * for example after the OpenGL context was lost.
+		 */
+		void clear();
+
+		/**
+		 * Returns the number of texture pages.
+		 */
+		std::size_t getPageCount() const;
+
+		/**
+		 * Returns the number of glyphs in the pages.
+		 */
+		std::size_t getGlyphCount() const;
+
+		/**
+		 * Returns the number of draw calls made by
+		 * the last flush.
+		 */
+		std::size_t getDrawCount() const;
+
+		/**
+		 * Returns the number of draw calls made by all
+		 * flushes so far.
+		 */
+		std::size_t getTotalDrawCount() const;
+	private:
+		GlyphAtlas(const GlyphAtlas &rhs);
+		GlyphAtlas& operator=(const GlyphAtlas &rhs);
+
+		/**
+		 * Where a glyph is stored.
+		 */
+		struct Glyph
+		{
+			bool supported;
+			std::size_t page;
+			int width, height;
+			int left, top;
+			GLfloat u0, v0, u1, v1;
+		};
+
+		/**
+		 * A texture and the quads queued for it.
+		 */
+		struct Page
+		{
+			GLuint texture;
+			int shelfX, shelfY, shelfHeight;
+			std::vector<GLfloat> vertices;
+		};
+
+		typedef std::pair<Font*,unsigned int> GlyphKey;
+		typedef std::map<GlyphKey,Glyph> GlyphMap;
+
+		const Glyph & getGlyph(Font *font, unsigned int codepoint);
+		bool allocate(int width, int height, std::size_t &page, int &x, int &y);
+		void addPage();
+		void addVertex(Page &page, GLfloat x, GLfloat y, GLfloat z, GLfloat u, GLfloat v, const GLfloat color[4]);
+		static bool intersects(const util::Rectangle &bounds, int x, int y, int width, int height);
+		void addToGrid(std::size_t index);
+		void clearQueued();
+		static void getCells(int position, int size, int &first, int &count);
+
+		GlyphContext &glyphContext;
+		int pageSize;
+		std::vector<Page> pages;
+		GlyphMap glyphs;
+		std::size_t drawCount;
+		std::size_t totalDrawCount;
+
+		GlyphBitmap bitmap;
+		std::vector<int> advances;
+
+		/**
+		 * The area covered by every queued string, and by
+		 * all of them.
+		 */
+		std::vector<util::Rectangle> queued;
+		util::Rectangle queuedExtent;
+
+		/**
+		 * The queued strings by the cells of a coarse grid they
+		 * cover, so overlaps only looks at the strings near the
+		 * rectangle. The grid wraps around: cells far apart share
+		 * a bucket, and are told apart by the bounds.
+		 */
+		static const int cellSize;
+		static const int gridSize;
+		std::vector<std::vector<std::size_t> > buckets;
+		std::vector<std::size_t> usedBuckets;
+	};
+}
+
+#endif
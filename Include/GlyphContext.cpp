@@ -27,12 +27,18 @@
  */
 #include "./GlyphContext.h"
 #include "./Font.h"
+#include "./util/Clock.h"
 
 namespace ui
 {
-	
+	const FontHandle GlyphContext::noFont = static_cast<FontHandle>(-1);
+
 	GlyphContext::GlyphContext()
-		:	fontFactory(0)
+		:	fontFactory(0),
+			measurementCache(4096),
+			lastFont(0),
+			lastHandle(noFont),
+			textTimer(0)
 	{
 	}
 
@@ -42,7 +48,7 @@ namespace ui
 	}
 	
 
-	Font* GlyphContext::getFont(std::size_t index) const
+	Font* GlyphContext::getFont(FontHandle index) const
 	{
 		// If your debugger points to this, it is most
 		// likely you are trying to use a font without
@@ -58,14 +64,44 @@ namespace ui
 		// See the documentation for more information.
 		assert(fontFactory);
 
-		for(std::size_t i = 0; i < fontList.size(); ++i)
+		FontHandle handle = getFontHandle(fontname,size);
+		return handle != noFont ? fontList[handle] : 0;
+	}
+
+	FontHandle GlyphContext::getFontHandle(const std::string &fontname, std::size_t size)
+	{
+		std::pair<std::size_t,std::size_t> key(getFontKey(fontname,size));
+
+		FontKeyMap::const_iterator found = fontKeys.find(key);
+		if(found != fontKeys.end())
+		{
+			return found->second;
+		}
+
+		assert(fontFactory);
+
+		Font *font = fontFactory->createFont(fontname,size);
+		if(font == 0)
 		{
-			if(fontList[i]->getFontName() == fontname && fontList[i]->getSize() == size)
-			{
-				return fontList.at(i);
-			}
+			return noFont;
 		}
-		return fontFactory->createFont(fontname,size);
+
+		FontHandle handle = setFont(font);
+		fontKeys[key] = handle;
+		return handle;
+	}
+
+	std::pair<std::size_t,std::size_t> GlyphContext::getFontKey(const std::string &fontname, std::size_t size)
+	{
+		FontNameMap::const_iterator found = fontNames.find(fontname);
+		if(found != fontNames.end())
+		{
+			return std::make_pair(found->second,size);
+		}
+
+		std::size_t id = fontNames.size();
+		fontNames[fontname] = id;
+		return std::make_pair(id,size);
 	}
 
 	void GlyphContext::setFontFactory(AbstractFontFactory *factory)
@@ -78,17 +114,72 @@ namespace ui
 		return fontFactory;
 	}
 
-	std::size_t GlyphContext::setFont(Font* font)
+	const util::Dimension GlyphContext::getStringBoundingBox(Font *font, const std::string &text)
+	{
+		util::ScopedTimer timer(textTimer);
+		return measurementCache.getStringBoundingBox(setFont(font),font,text);
+	}
+
+	const util::Dimension GlyphContext::getStringBoundingBox(FontHandle font, const std::string &text)
+	{
+		util::ScopedTimer timer(textTimer);
+		return measurementCache.getStringBoundingBox(font,fontList[font],text);
+	}
+
+	void GlyphContext::getGlyphAdvances(Font *font, const std::string &text, std::vector<int> &advances)
+	{
+		util::ScopedTimer timer(textTimer);
+		measurementCache.getGlyphAdvances(setFont(font),font,text,advances);
+	}
+
+	void GlyphContext::getGlyphAdvances(FontHandle font, const std::string &text, std::vector<int> &advances)
+	{
+		util::ScopedTimer timer(textTimer);
+		measurementCache.getGlyphAdvances(font,fontList[font],text,advances);
+	}
+
+	MeasurementCache & GlyphContext::getMeasurementCache()
+	{
+		return measurementCache;
+	}
+
+	void GlyphContext::setTextTimer(double *total)
 	{
-		for(std::size_t i = 0; i < fontList.size(); ++i)
+		textTimer = total;
+	}
+
+	double * GlyphContext::getTextTimer() const
+	{
+		return textTimer;
+	}
+
+	FontHandle GlyphContext::setFont(Font* font)
+	{
+		if(font == lastFont && font != 0)
 		{
-			if(fontList[i] == font)
-			{
-				return i;
-			}
+			return lastHandle;
 		}
+
+		FontHandleMap::const_iterator found = fontHandles.find(font);
+		if(found != fontHandles.end())
+		{
+			lastFont = font;
+			lastHandle = found->second;
+			return lastHandle;
+		}
+
+		FontHandle handle = fontList.size();
 		fontList.push_back(font);
-		
-		return fontList.size() - 1;
+		fontHandles[font] = handle;
+		lastFont = font;
+		lastHandle = handle;
+
+		// fonts set directly are found by createFont as well,
+		// unless another font was registered under the same key.
+		if(font != 0)
+		{
+			fontKeys.insert(std::make_pair(getFontKey(font->getFontName(),font->getSize()),handle));
+		}
+		return handle;
 	}
 }
\ No newline at end of file
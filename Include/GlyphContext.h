@@ -29,8 +29,11 @@
 #ifndef GLYPHCONTEXT_H
 #define GLYPHCONTEXT_H
 
+#include <map>
 #include "./Pointers.h"
 #include "./Font.h"
+#include "./MeasurementCache.h"
+#include "./UiContext.h"
 
 namespace ui
 {
@@ -39,6 +42,13 @@ namespace ui
 	 * A singleton class which manages the Font
 	 * instances. This is to prevent the Components
 	 * from creating their own Font class each time.
+	 * <p>
+	 * Every Font is registered once and identified by a FontHandle,
+	 * its index in the registry. Font names are interned, so a Font
+	 * is found by name and size without comparing names more than
+	 * a few times. Components store handles, and code which sets the
+	 * same Font often should look its handle up once and keep it.
+	 * </p>
 	 */
 	class GlyphContext
 	{
@@ -50,7 +60,7 @@ namespace ui
 		 * @return
 		 * the index used for this Font, or a new index if the Font wasn't used before.
 		 */
-		std::size_t setFont(Font* font);
+		FontHandle setFont(Font* font);
 
 		/**
 		 * Returns the indexed Font.
@@ -59,7 +69,7 @@ namespace ui
 		 * @return
 		 *	the Font stored on the index.
 		 */
-		Font* getFont(std::size_t index) const;
+		Font* getFont(FontHandle index) const;
 
 		/**
 		 * Creates a new Font, based on a fontname, style and size.
@@ -72,6 +82,24 @@ namespace ui
 		 */
 		Font* createFont(const std::string &fontname, std::size_t size);
 
+		/**
+		 * Returns the handle of a Font, creating and registering
+		 * the Font with the FontFactory the first time.
+		 * @param
+		 *	fontname Font family name, such as 'Arial'
+		 * @param
+		 *	size the Font size in points.
+		 * @return
+		 *	the handle of the Font, or noFont if the
+		 *	FontFactory could not create it.
+		 */
+		FontHandle getFontHandle(const std::string &fontname, std::size_t size);
+
+		/**
+		 * The handle of no Font.
+		 */
+		static const FontHandle noFont;
+
 		/**
 		 * Sets the FontFactory to be used by GlyphContext.
 		 * A FontFactory creates font based on certain parameters.
@@ -84,21 +112,84 @@ namespace ui
 		AbstractFontFactory * getFontFactory() const;
 
 		/**
-		 * Returns an instance of this class.
+		 * Returns the bounding box of text in font. The result
+		 * is cached, see MeasurementCache.
+		 */
+		const util::Dimension getStringBoundingBox(Font *font, const std::string &text);
+
+		/**
+		 * Returns the bounding box of text in the Font with the
+		 * given handle, without looking the Font up.
+		 */
+		const util::Dimension getStringBoundingBox(FontHandle font, const std::string &text);
+
+		/**
+		 * Stores the glyph advances of text in font in advances.
+		 * The result is cached, see MeasurementCache.
+		 */
+		void getGlyphAdvances(Font *font, const std::string &text, std::vector<int> &advances);
+
+		/**
+		 * Stores the glyph advances of text in the Font with the
+		 * given handle in advances, without looking the Font up.
+		 */
+		void getGlyphAdvances(FontHandle font, const std::string &text, std::vector<int> &advances);
+
+		/**
+		 * Returns the cache used for measuring strings.
+		 */
+		MeasurementCache & getMeasurementCache();
+
+		/**
+		 * Sets the total that the time spent measuring strings
+		 * is added to, or 0 to stop timing. Used by Gui when
+		 * profiling.
+		 */
+		void setTextTimer(double *total);
+
+		/**
+		 * Returns the total set with setTextTimer.
+		 */
+		double * getTextTimer() const;
+
+		/**
+		 * Returns the instance of the current UiContext.
 		 * @note this is part of the Singleton.
 		 */
 		static GlyphContext &getInstance()
 		{
-			static GlyphContext obj;
-			return obj;
+			return UiContext::getCurrent().getGlyphContext();
 		}
 	private:
 		GlyphContext();
 		~GlyphContext();
 		GlyphContext(const GlyphContext&);
 		GlyphContext& operator=(const GlyphContext&);
+		friend class ui::UiContext;
+		typedef std::map<Font*,FontHandle> FontHandleMap;
+		typedef std::map<std::string,std::size_t> FontNameMap;
+		typedef std::map<std::pair<std::size_t,std::size_t>,FontHandle> FontKeyMap;
+
+		/**
+		 * Returns the key of a font name and size, interning
+		 * the name if it was not seen before.
+		 */
+		std::pair<std::size_t,std::size_t> getFontKey(const std::string &fontname, std::size_t size);
+
 		FontList fontList;
+		FontHandleMap fontHandles;
+		FontNameMap fontNames;
+		FontKeyMap fontKeys;
 		AbstractFontFactory *fontFactory;
+		MeasurementCache measurementCache;
+
+		/**
+		 * The Font set last and its handle, text is usually
+		 * measured in the same Font many times in a row.
+		 */
+		Font *lastFont;
+		FontHandle lastHandle;
+		double *textTimer;
 	};
 }
 #endif
\ No newline at end of file
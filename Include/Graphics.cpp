@@ -29,6 +29,7 @@
 #include "./GlyphContext.h"
 #include "./Font.h"
 #include "./Component.h"
+#include "./SelectionManager.h"
 
 namespace ui
 {
@@ -37,12 +38,30 @@ namespace ui
  */
 #define FASTGRAPHICS
 
+	const int Graphics::atlasPageSize = 256;
+
 	Graphics::Graphics(void)
-		:	currentPaint(0),
-			depth(static_cast<float>(1/Component::NORMAL)),
-			transparency(1.0f)
+		:	depth(static_cast<float>(1/Component::NORMAL)),
+			transparency(1.0f),
+			currentPaint(0),
+			glyphContext(UiContext::getCurrent().getGlyphContext()),
+			glyphAtlas(glyphContext,atlasPageSize)
 	{
-		glEnable(GL_POINT_SMOOTH);
+		transform.x = 0;
+		transform.y = 0;
+		transform.rotated = false;
+	}
+
+	Graphics::Graphics(GlyphContext &glyphs)
+		:	depth(static_cast<float>(1/Component::NORMAL)),
+			transparency(1.0f),
+			currentPaint(0),
+			glyphContext(glyphs),
+			glyphAtlas(glyphs,atlasPageSize)
+	{
+		transform.x = 0;
+		transform.y = 0;
+		transform.rotated = false;
 	}
 
 	Graphics::~Graphics(void)
@@ -58,22 +77,38 @@ namespace ui
 		glColor4f(currentPaint->getRed(0), currentPaint->getGreen(0), currentPaint->getBlue(0), getCurrentTransparency());
 	}
 
+	void Graphics::beginFrame()
+	{
+		transform.x = 0;
+		transform.y = 0;
+		transform.rotated = false;
+		while(!transformStack.empty())
+		{
+			transformStack.pop();
+		}
+	}
+
 	void Graphics::translate(int x, int y)
 	{
 		if(x != 0 || y != 0)
 		{
 			glTranslatef(static_cast<GLfloat>(x),static_cast<GLfloat>(y),0);
+			transform.x += x;
+			transform.y += y;
 		}
 	}
 
 	void Graphics::popMatrix()
 	{
 		glPopMatrix();
+		transform = transformStack.top();
+		transformStack.pop();
 	}
 
 	void Graphics::pushMatrix()
 	{
 		glPushMatrix();
+		transformStack.push(transform);
 	}
 
 	void Graphics::setDepth(float newDepth)
@@ -173,7 +208,12 @@ namespace ui
 
 	void Graphics::setFont(Font* f)
 	{
-		currentFont = static_cast<int>(GlyphContext::getInstance().setFont(f));
+		currentFont = glyphContext.setFont(f);
+	}
+
+	void Graphics::setFont(FontHandle handle)
+	{
+		currentFont = handle;
 	}
 
 	void Graphics::fillCircle(int x, int y, int radius)
@@ -192,18 +232,60 @@ namespace ui
 		glLineWidth(static_cast<GLfloat>(width));
 	}
 
-	void Graphics::drawString(int x, int y, std::string str)
+	void Graphics::drawString(int x, int y, const std::string &str)
 	{
+		Font* f = glyphContext.getFont(currentFont);
+
+		if(!transform.rotated)
+		{
+			GLfloat color[4] = {currentPaint->getRed(0), currentPaint->getGreen(0), currentPaint->getBlue(0), getCurrentTransparency()};
+			if(glyphAtlas.addString(f,str,transform.x + x,transform.y + y,depth,color))
+			{
+				return;
+			}
+		}
+
+		// the font draws itself, anything queued before
+		// must end up below it.
+		flush();
 		applyCurrentColor();
-		Font* f = GlyphContext::getInstance().getFont(currentFont);
 		pushMatrix();
 		glTranslatef(0,0,depth);
 		f->drawString(x,y,str);
 		popMatrix();
 	}
 
+	void Graphics::flush()
+	{
+		if(!glyphAtlas.isEmpty())
+		{
+			// queued text is in window coordinates, and is never
+			// queued while the coordinate system is rotated.
+			glPushMatrix();
+			glTranslatef(static_cast<GLfloat>(-transform.x),static_cast<GLfloat>(-transform.y),0);
+			glyphAtlas.flush();
+			glPopMatrix();
+		}
+	}
+
+	void Graphics::flushOverlapping(int x, int y, int width, int height)
+	{
+		// nothing is queued while rotated, and the queue is
+		// in window coordinates.
+		if(!transform.rotated && glyphAtlas.overlaps(transform.x + x,transform.y + y,width,height))
+		{
+			flush();
+		}
+	}
+
+	GlyphAtlas & Graphics::getGlyphAtlas()
+	{
+		return glyphAtlas;
+	}
+
 	void Graphics::popDepth(float d)
 	{
+		flush();
 		depthStack.pop();
 		if(depthStack.size() != 0)
 		{
@@ -266,6 +348,7 @@ namespace ui
 	{
 		if(d > getDepth())
 		{
+			flush();
 			depthStack.push(getDepth());
 			setDepth(d);
 			return true;
@@ -282,6 +365,8 @@ namespace ui
 		GLint viewport[4];
 		glGetIntegerv(GL_VIEWPORT,viewport);
 
+		flush();
+
 		// adjust from OpenGL coordinate system to ours..
 		y = viewport[3] - y - height;
 
@@ -291,11 +376,15 @@ namespace ui
 
 	void Graphics::disableScissor()
 	{
+		flush();
 		glDisable(GL_SCISSOR_TEST);
 	}
 
 	void Graphics::enableBlending()
 	{
+		// not in the constructor, a Gui may be made on a thread
+		// without an OpenGL context.
+		glEnable(GL_POINT_SMOOTH);
 		glEnable(GL_BLEND);
 	}
 
@@ -338,11 +427,8 @@ namespace ui
 			setDepth(calc); // = -1
 		}
 
-		srand(index*2);
-
-		GLubyte red = rand() % 255;
-		GLubyte green = rand() % 255;
-		GLubyte blue = rand() % 255;
+		GLubyte red, green, blue;
+		SelectionManager::getUniqueColor(index,red,green,blue);
 
 		glColor3ub(red,green,blue);
 
@@ -358,6 +444,8 @@ namespace ui
 
 	void Graphics::rotate(float degrees)
 	{
+		flush();
+		transform.rotated = true;
 		glRotatef(degrees,0.0f,0.0f,1.0f);
 	}
 }
\ No newline at end of file
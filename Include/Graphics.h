@@ -34,6 +34,7 @@
 #include "./Pointers.h"
 #include "./util/Color.h"
 #include "./util/Paint.h"
+#include "./GlyphAtlas.h"
 
 namespace ui
 {
@@ -46,10 +47,17 @@ namespace ui
 	{
 	public:
 		/**
-		 * Creates a Graphics instance.
+		 * Creates a Graphics instance which draws with the fonts
+		 * of the current UiContext.
 		 * For normal use you'll only want one of these.
 		 */
 		Graphics();
+
+		/**
+		 * Creates a Graphics instance which draws with the fonts
+		 * of the given GlyphContext.
+		 */
+		explicit Graphics(GlyphContext &glyphs);
 		
 		/**
 		 * Destroys the Graphics instance, and returns
@@ -57,6 +65,13 @@ namespace ui
 		 */
 		~Graphics();
 
+		/**
+		 * Starts a frame in the coordinate system the caller set
+		 * up: forgets translations and rotations left over from
+		 * the last frame, without touching the OpenGL matrices.
+		 */
+		void beginFrame();
+
 		/**
 		 * Translate the orientation.
 		 */
@@ -117,10 +132,38 @@ namespace ui
 		 */
 		void setFont(Font* f);
 
+		/**
+		 * Sets the current font by its handle.
+		 */
+		void setFont(FontHandle handle);
+
 		/**
 		 * Draws a string in the current font.
+		 * If the font supplies glyph bitmaps the string is
+		 * queued in the GlyphAtlas and drawn on the next flush.
+		 */
+		void drawString(int x, int y, const std::string &str);
+
+		/**
+		 * Draws all queued strings. This is called whenever
+		 * state the queued text depends on changes, and must
+		 * be called once at the end of each frame.
 		 */
-		void drawString(int x, int y, std::string str);
+		void flush();
+
+		/**
+		 * Draws all queued strings if any of them overlaps a
+		 * rectangle, so that what is painted there next ends up
+		 * above the text. Components call this before they paint
+		 * themselves, text which does not overlap a later sibling
+		 * stays queued.
+		 */
+		void flushOverlapping(int x, int y, int width, int height);
+
+		/**
+		 * Returns the GlyphAtlas used for batching text.
+		 */
+		GlyphAtlas & getGlyphAtlas();
 
 		/**
 		 * Fills a circle at the given location with given radius.
@@ -197,6 +240,11 @@ namespace ui
 		void setTransparency(float f);
 		float getTransparency();
 	private:
+		/**
+		 * Width and height of the GlyphAtlas pages.
+		 */
+		static const int atlasPageSize;
+
 		/**
 		 * Apply the current color.
 		 */
@@ -206,9 +254,24 @@ namespace ui
 		float depth, transparency;
 		FloatStack depthStack, transparencyStack;
 	//	util::Color currentColor;
-		int currentFont;
+		FontHandle currentFont;
 
 		const util::Paint *currentPaint;
+		GlyphContext &glyphContext;
+
+		/**
+		 * The translation applied by translate(), tracked
+		 * so queued text can be stored in window coordinates.
+		 */
+		struct Transform
+		{
+			int x, y;
+			bool rotated;
+		};
+
+		Transform transform;
+		std::stack<Transform> transformStack;
+		GlyphAtlas glyphAtlas;
 	};
 }
 #endif
\ No newline at end of file
@@ -1,52 +1,362 @@
 #include "./Gui.h"
 #include "./SelectionManager.h"
 #include "./FocusManager.h"
+#include "./NotificationManager.h"
+#include "./UiContext.h"
+#include "./util/Clock.h"
 #include "./event/KeyEvent.h"
 #include "./event/MouseEvent.h"
+#include <algorithm>
 
 namespace ui
 {
 	Gui::Gui()
+		:	context(&UiContext::getCurrent()),
+			g(context->getGlyphContext()),
+			time(0.0f),
+			frame(0),
+			inputLog(0),
+			profiling(false),
+			selectionRendered(false),
+			selectionRevision(0),
+			picksValid(false),
+			pickRevision(0),
+			dispatching(0)
+	{
+		// the mouse is always there.
+		pointers[0];
+	}
+
+	Gui::Gui(UiContext &c)
+		:	context(&c),
+			g(c.getGlyphContext()),
+			time(0.0f),
+			frame(0),
+			inputLog(0),
+			profiling(false),
+			selectionRendered(false),
+			selectionRevision(0),
+			picksValid(false),
+			pickRevision(0),
+			dispatching(0)
+	{
+		pointers[0];
+	}
+
+	Gui::Pointer::Pointer()
+		:	x(0),
+			y(0),
+			pickedX(0),
+			pickedY(0),
+			picked(false),
+			moved(false)
 	{
-		mouseX = mouseY = 0;
 	}
 
 	void Gui::addFrame(Frame *frame)
 	{
+		// the frame has to be created in the context of this Gui.
+		assert(frame->getContext() == context);
 		frameList.push_back(frame);
 	}
 
 	void Gui::removeFrame(Frame *frame)
 	{
 		frameList.erase(std::remove(frameList.begin(),frameList.end(),frame),frameList.end());
+		context->getFocusManager().removeFocusRing(frame);
 	}
 
 	void Gui::paint()
 	{
-		SelectionManager::getInstance().setRenderMode(SelectionManager::SELECTION);
-		SelectionManager::getInstance().mouseMotion(mouseX,mouseY); // for mouse clicks, enter,exit, etc
+		UiContext::Scope scope(*context);
+
+		frameTiming = FrameTiming();
+		frameTiming.frame = frame;
+		util::ScopedTimer totalTimer(profiling ? &frameTiming.total : 0);
+		GlyphContext::getInstance().setTextTimer(profiling ? &frameTiming.text : 0);
+
+		// commands posted by other threads change the Components,
+		// so they go before anything is drawn.
+		posted.take(inputQueue,time);
+
+		std::vector<Frame*>::const_iterator iter;
+		{
+			// painting validates as well, but doing it up front
+			// keeps layout out of the picking time.
+			util::ScopedTimer timer(profiling ? &frameTiming.layout : 0);
+			for(iter = frameList.begin(); iter != frameList.end(); ++iter)
+			{
+				const util::Rectangle &bounds = (*iter)->getBounds();
+				if((*iter)->isVisible() && bounds.width > 0 && bounds.height > 0 && !(*iter)->isValid())
+				{
+					(*iter)->validate();
+				}
+			}
+		}
+
+		{
+			util::ScopedTimer timer(profiling ? &frameTiming.picking : 0);
+
+			// the picking image is drawn by the first event that needs
+			// it, which is never while a Component holds the capture.
+			selectionRendered = false;
+			dispatchInput();
+
+			// and the notifications it caused, once each.
+			NotificationManager::getInstance().flush();
+		}
+
+		{
+			util::ScopedTimer timer(profiling ? &frameTiming.paint : 0);
+
+			g.beginFrame();
+			g.enableBlending();
+			//glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+			for(iter = frameList.begin(); iter != frameList.end(); ++iter)
+			{
+				(*iter)->paint(g);
+			}
+			//glPolygonMode (GL_FRONT_AND_BACK, GL_FILL);
+			g.flush();
+			g.disableBlending();
+		}
+
+		GlyphContext::getInstance().setTextTimer(0);
+		++frame;
+	}
+
+	void Gui::dispatchInput()
+	{
+		inputStatistics = inputQueue.getStatistics();
+		inputQueue.resetStatistics();
+		inputQueue.drain(input);
+
+		std::map<int,Pointer>::iterator pointer;
+		for(pointer = pointers.begin(); pointer != pointers.end(); ++pointer)
+		{
+			pointer->second.moved = false;
+		}
+
+		// nothing is picked until an event needs it.
+		picksValid = false;
+
+		for(dispatching = 0; dispatching < input.size(); ++dispatching)
+		{
+			const InputEvent &e = input[dispatching];
+			inputStatistics.latency = std::max(inputStatistics.latency,time - e.time);
+
+			switch(e.type)
+			{
+				case InputEvent::MOUSE_MOTION:
+				{
+					// posted motion moves the pointer too
+					Pointer &p = pointers[e.pointer];
+					p.x = e.x;
+					p.y = e.y;
+					moveMouse(e.pointer,e.x,e.y);
+					p.moved = true;
+					break;
+				}
+				case InputEvent::MOUSE_PRESSED:
+				case InputEvent::MOUSE_RELEASED:
+				{
+					Pointer &p = pointers[e.pointer];
+
+					// a release ends the capture, so what was only a
+					// bounds check has to be picked again.
+					bool stale = !p.picked && !SelectionManager::getInstance().isCaptured(e.pointer);
+					if(!p.moved || stale || e.x != p.pickedX || e.y != p.pickedY)
+					{
+						moveMouse(e.pointer,e.x,e.y);
+						p.moved = true;
+					}
+
+					if(e.type == InputEvent::MOUSE_PRESSED)
+					{
+						SelectionManager::getInstance().mousePressed(e.pointer,e.button);
+					}
+					else
+					{
+						SelectionManager::getInstance().mouseReleased(e.pointer,e.button);
+					}
+					break;
+				}
+				case InputEvent::POINTER_REMOVED:
+				{
+					SelectionManager::getInstance().removePointer(e.pointer);
+					pointers.erase(e.pointer);
+					break;
+				}
+				case InputEvent::KEY_PRESSED:
+				{
+					FocusManager::getInstance().keyPressed(e.keyCode,e.modifier,e.character);
+					break;
+				}
+				case InputEvent::KEY_RELEASED:
+				{
+					FocusManager::getInstance().keyReleased(e.keyCode,e.modifier);
+					break;
+				}
+			}
+			++inputStatistics.dispatched;
+		}
+
+		// Components move under the pointers as well, and the Component
+		// holding a pointer gets a motion event every frame.
+		for(pointer = pointers.begin(); pointer != pointers.end(); ++pointer)
+		{
+			if(!pointer->second.moved)
+			{
+				moveMouse(pointer->first,pointer->second.x,pointer->second.y);
+			}
+		}
+
+		SelectionManager::getInstance().clearPicks();
+		picksValid = false;
+	}
+
+	void Gui::pickInput()
+	{
+		SelectionManager &selection = SelectionManager::getInstance();
+		pickLocations.clear();
+
+		// the picking image has to show the Components as they are
+		// now, which dispatching the events before may have changed.
+		if(!selectionRendered || selection.getRevision() != selectionRevision)
+		{
+			renderSelection();
+		}
+
+		// a pointer released in this frame is picked again after the
+		// release, so its locations are needed even while captured.
+		std::vector<int> &released = releasedPointers;
+		released.clear();
+		InputEventList::const_iterator first = input.begin() + std::min(dispatching,input.size());
+		InputEventList::const_iterator iter;
+		for(iter = first; iter != input.end(); ++iter)
+		{
+			if((*iter).type == InputEvent::MOUSE_RELEASED)
+			{
+				released.push_back((*iter).pointer);
+			}
+		}
+
+		for(iter = first; iter != input.end(); ++iter)
+		{
+			const InputEvent &e = *iter;
+			if(e.type == InputEvent::MOUSE_MOTION || e.type == InputEvent::MOUSE_PRESSED || e.type == InputEvent::MOUSE_RELEASED)
+			{
+				if(!selection.isCaptured(e.pointer) || std::find(released.begin(),released.end(),e.pointer) != released.end())
+				{
+					pickLocations.push_back(util::Point(e.x,e.y));
+				}
+			}
+		}
+
+		std::map<int,Pointer>::const_iterator pointer;
+		for(pointer = pointers.begin(); pointer != pointers.end(); ++pointer)
+		{
+			if(!selection.isCaptured(pointer->first) || std::find(released.begin(),released.end(),pointer->first) != released.end())
+			{
+				pickLocations.push_back(util::Point(pointer->second.x,pointer->second.y));
+			}
+		}
+
+		selection.pickAll(pickLocations);
+		picksValid = true;
+		pickRevision = selection.getRevision();
+	}
+
+	void Gui::moveMouse(int pointer, int x, int y)
+	{
+		SelectionManager &selection = SelectionManager::getInstance();
+		Pointer &p = pointers[pointer];
+
+		if(!selection.isCaptured(pointer))
+		{
+			// the first event that needs a pick picks the rest of
+			// the frame's events with it, and they are picked again
+			// when an event in between changed the Components.
+			if(!picksValid || selection.getRevision() != pickRevision)
+			{
+				pickInput();
+			}
+			++inputStatistics.picks;
+			p.picked = true;
+		}
+		else
+		{
+			p.picked = false;
+		}
+
+		selection.beginUpdate(pointer,x,y);
+		selection.mouseMotion(pointer,x,y);
+
+		p.pickedX = x;
+		p.pickedY = y;
+	}
+
+	void Gui::renderSelection()
+	{
 		std::vector<Frame*>::const_iterator iter;
+
+		SelectionManager::getInstance().setRenderMode(SelectionManager::SELECTION);
+		g.beginFrame();
 		for(iter = frameList.begin(); iter != frameList.end(); ++iter)
 		{
 			(*iter)->paint(g);
 		}
 		//Container::paint(g); // draw the components a second time.. *sigh*
-		SelectionManager::getInstance().beginUpdate(mouseX,mouseY); // for mousemotion
+		g.flush();
 		SelectionManager::getInstance().setRenderMode(SelectionManager::NORMAL);
-		
-		g.enableBlending();
-		//glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-		for(iter = frameList.begin(); iter != frameList.end(); ++iter)
+
+		// painting validates, which may have changed the revision.
+		selectionRendered = true;
+		selectionRevision = SelectionManager::getInstance().getRevision();
+	}
+
+	void Gui::queueInput(int type, int pointer, int button, int keyCode, int modifier, unsigned int character)
+	{
+		InputEvent e;
+		e.type = type;
+		e.pointer = pointer;
+		if(type != InputEvent::KEY_PRESSED && type != InputEvent::KEY_RELEASED)
 		{
-			(*iter)->paint(g);
+			const Pointer &p = pointers[pointer];
+			e.x = p.x;
+			e.y = p.y;
 		}
-		//glPolygonMode (GL_FRONT_AND_BACK, GL_FILL);
-		g.disableBlending();
-	
+		e.button = button;
+		e.keyCode = keyCode;
+		e.modifier = modifier;
+		e.character = character;
+		e.time = time;
+		inputQueue.push(e);
+	}
+
+	void Gui::record(int type, int pointer, int a, int b, unsigned int character, float deltaTime)
+	{
+		InputLog::Record r;
+		r.frame = frame;
+		r.type = type;
+		r.pointer = pointer;
+		r.a = a;
+		r.b = b;
+		r.character = character;
+		r.deltaTime = deltaTime;
+		inputLog->add(r);
 	}
 
 	void Gui::importUpdate(float deltaTime)
 	{
+		if(inputLog != 0)
+		{
+			record(InputLog::UPDATE,0,0,0,0,deltaTime);
+		}
+
+		time += deltaTime;
+
+		UiContext::Scope scope(*context);
 		std::vector<Frame*>::const_iterator iter;
 		for(iter = frameList.begin(); iter != frameList.end(); ++iter)
 		{
@@ -56,42 +366,142 @@ namespace ui
 
 	void Gui::importMouseMotion(int x, int y)
 	{
+		// some windowing systems report 0,0 for a mouse outside
+		// the window, which the mouse has always ignored. Other
+		// pointers, like touches, can be at 0,0.
 		if(x == 0 && y == 0)
 			return;
 
-		mouseX = x;
-		mouseY = y;
+		importPointerMotion(0,x,y);
 	}
 
 	void Gui::importMousePressed(int button)
 	{
-		// forward it to the pickingmanager
-		SelectionManager::getInstance().mousePressed(button);
+		importPointerPressed(0,button);
 	}
 
 	void Gui::importMouseReleased(int button)
 	{
-		// forward it to the pickingmanager
-		SelectionManager::getInstance().mouseReleased(button);
+		importPointerReleased(0,button);
 	}
 
-	void Gui::importKeyPressed(int keyCode, int modifier)
+	void Gui::importPointerMotion(int pointer, int x, int y)
 	{
-		FocusManager::getInstance().keyPressed(keyCode,modifier);
+		if(inputLog != 0)
+		{
+			record(pointer == 0 ? InputLog::MOUSE_MOTION : InputLog::POINTER_MOTION,pointer,x,y,0,0.0f);
+		}
+
+		Pointer &p = pointers[pointer];
+		p.x = x;
+		p.y = y;
+		queueInput(InputEvent::MOUSE_MOTION,pointer,0,0,0,0);
+	}
+
+	void Gui::importPointerPressed(int pointer, int button)
+	{
+		if(inputLog != 0)
+		{
+			record(pointer == 0 ? InputLog::MOUSE_PRESSED : InputLog::POINTER_PRESSED,pointer,button,0,0,0.0f);
+		}
+		queueInput(InputEvent::MOUSE_PRESSED,pointer,button,0,0,0);
+	}
+
+	void Gui::importPointerReleased(int pointer, int button)
+	{
+		if(inputLog != 0)
+		{
+			record(pointer == 0 ? InputLog::MOUSE_RELEASED : InputLog::POINTER_RELEASED,pointer,button,0,0,0.0f);
+		}
+		queueInput(InputEvent::MOUSE_RELEASED,pointer,button,0,0,0);
+	}
+
+	void Gui::importPointerRemoved(int pointer)
+	{
+		if(inputLog != 0)
+		{
+			record(InputLog::POINTER_REMOVED,pointer,0,0,0,0.0f);
+		}
+		queueInput(InputEvent::POINTER_REMOVED,pointer,0,0,0,0);
+	}
+
+	void Gui::importKeyPressed(int keyCode, int modifier, unsigned int character)
+	{
+		if(inputLog != 0)
+		{
+			record(InputLog::KEY_PRESSED,0,keyCode,modifier,character,0.0f);
+		}
+		queueInput(InputEvent::KEY_PRESSED,0,0,keyCode,modifier,character);
 	}
 
 	void Gui::importKeyReleased(int keyCode, int modifier)
 	{
-		FocusManager::getInstance().keyReleased(keyCode,modifier);
+		if(inputLog != 0)
+		{
+			record(InputLog::KEY_RELEASED,0,keyCode,modifier,0,0.0f);
+		}
+		queueInput(InputEvent::KEY_RELEASED,0,0,keyCode,modifier,0);
 	}
 
 	void Gui::setFontFactory(AbstractFontFactory *factory)
 	{
+		UiContext::Scope scope(*context);
 		GlyphContext::getInstance().setFontFactory(factory);
 	}
 
 	AbstractFontFactory * Gui::getFontFactory() const
 	{
+		UiContext::Scope scope(*context);
 		return GlyphContext::getInstance().getFontFactory();
 	}
+
+	void Gui::postInput(const InputEvent &e)
+	{
+		posted.post(e);
+	}
+
+	void Gui::postCommand(util::Command *command)
+	{
+		posted.post(command);
+	}
+
+	float Gui::getTime() const
+	{
+		return time;
+	}
+
+	const InputStatistics & Gui::getInputStatistics() const
+	{
+		return inputStatistics;
+	}
+
+	void Gui::setInputLog(InputLog *log)
+	{
+		inputLog = log;
+	}
+
+	int Gui::getFrame() const
+	{
+		return frame;
+	}
+
+	void Gui::setProfiling(bool p)
+	{
+		profiling = p;
+	}
+
+	bool Gui::isProfiling() const
+	{
+		return profiling;
+	}
+
+	const FrameTiming & Gui::getFrameTiming() const
+	{
+		return frameTiming;
+	}
+
+	UiContext & Gui::getContext() const
+	{
+		return *context;
+	}
 }
\ No newline at end of file
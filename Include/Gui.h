@@ -31,6 +31,10 @@
 #include "./Graphics.h"
 #include "./component/Frame.h"
 #include "./GlyphContext.h"
+#include "./InputQueue.h"
+#include "./PostQueue.h"
+#include "./InputLog.h"
+#include <map>
 
 namespace ui
 {
@@ -38,16 +42,67 @@ namespace ui
 	 * The Gui class manages everything related to the Gui.
 	 * It has several methods which need to be called in order
 	 * for the Gui to fully work. There should only be one Gui
-	 * in your whole program. This does not mean you cannot have
+	 * per UiContext. This does not mean you cannot have
 	 * more than one user interface, just only one Gui instance.
 	 * To create more than one interface, use multiple Frame instances
-	 * and register them with your Gui instance.
+	 * and register them with your Gui instance, or give every
+	 * interface a UiContext and Gui of its own.
+	 * <p>
+	 * Input is not dispatched when it is imported. The import functions
+	 * add the input to an InputQueue, with the location of the mouse and
+	 * the Gui time, and paint dispatches all of it once the picking image
+	 * of the frame has been drawn. Every press and release is picked at
+	 * the location it happened, and mouse motion imported between other
+	 * events is coalesced into a single dispatch.
+	 * </p>
+	 * <p>
+	 * Besides the mouse, any number of pointers can be imported, such
+	 * as touches or the mice of a split screen, each with an id of its
+	 * own. The mouse is pointer 0. Every pointer hovers, presses and
+	 * captures on its own, and the locations of all of them are picked
+	 * together, with one picking image and one pass over the Components.
+	 * </p>
+	 * <p>
+	 * While a Component holds the mouse capture (see SelectionManager),
+	 * the picking image is not drawn at all, so dragging a Slider or
+	 * resizing a Dialog only costs the normal paint.
+	 * </p>
+	 * <p>
+	 * None of the Gui, its managers and its Components are safe to use
+	 * from more than one thread. Other threads use postInput and
+	 * postCommand instead, which never block. What they post is taken
+	 * at the start of paint, on the thread that paints.
+	 * </p>
+	 * <p>
+	 * The managers belong to a UiContext. Guis created in different
+	 * contexts share no state, so each of them can be updated on a
+	 * thread of its own, see UiContext.
+	 * </p>
+	 * <p>
+	 * When the NotificationManager defers notifications, paint delivers
+	 * them right after the input has been dispatched.
+	 * </p>
+	 * <p>
+	 * Every import can be recorded into an InputLog, which can be
+	 * replayed later to compare builds on the same workload. With
+	 * profiling on, paint measures how long layout, picking, text and
+	 * painting took, see getFrameTiming.
+	 * </p>
 	 */
 	class Gui
 	{
 	public:
+		/**
+		 * Creates a Gui in the current UiContext.
+		 */
 		Gui();
 
+		/**
+		 * Creates a Gui in the given context. Its frames have to
+		 * be constructed while that context is current.
+		 */
+		explicit Gui(UiContext &context);
+
 		/**
 		 * Add a frame instance to the Gui manager. 
 		 * @param
@@ -73,6 +128,9 @@ namespace ui
 		 * Draw the Gui.
 		 * This should be called every frame,
 		 * and if possible when in orthographic mode.
+		 * The input imported since the last frame is dispatched
+		 * after the picking image has been drawn, and before the
+		 * Gui is drawn on screen.
 		 */
 		void paint();
 
@@ -84,7 +142,8 @@ namespace ui
 		 * Send mouse coordinates to the Gui.
 		 * This should be done everyframe, as
 		 * the mouse coordinates are used by the 
-		 * picking engine.
+		 * picking engine. A motion to 0,0 is ignored,
+		 * importPointerMotion with pointer 0 is not.
 		 */
 		void importMouseMotion(int x, int y);
 
@@ -126,14 +185,49 @@ namespace ui
 		 */
 		void importMouseReleased(int button);
 
+		/**
+		 * Send the location of a pointer to the Gui. Pointers
+		 * are created when they are first imported.
+		 * @param
+		 *	pointer Id of the pointer, 0 is the mouse.
+		 */
+		void importPointerMotion(int pointer, int x, int y);
+
+		/**
+		 * Send a button press of a pointer to the Gui, at its
+		 * last imported location.
+		 * @see
+		 *	importMousePressed
+		 */
+		void importPointerPressed(int pointer, int button);
+
+		/**
+		 * Send a button release of a pointer to the Gui.
+		 * @see
+		 *	importMouseReleased
+		 */
+		void importPointerReleased(int pointer, int button);
+
+		/**
+		 * Tells the Gui a pointer is gone, like a touch which
+		 * ended. It is no longer picked, and the Component under
+		 * it gets an exited event.
+		 */
+		void importPointerRemoved(int pointer);
+
 		/**
 		 * Send a key press to the Gui.
 		 * Possible values for the parameters can
 		 * be found in KeyEvent
+		 * @param
+		 *	character the unicode code point the key press
+		 *	produces after keyboard layout and modifiers have been
+		 *	applied, or 0 if it produces none. Text components insert
+		 *	this instead of guessing it from the key code.
 		 * @see
 		 *	KeyEvent
 		 */
-		void importKeyPressed(int keyCode, int modifier);
+		void importKeyPressed(int keyCode, int modifier, unsigned int character = 0);
 
 		/**
 		 * Send a key release to the Gui.
@@ -167,10 +261,143 @@ namespace ui
 		 * Returns the FontFactory currently in use.
 		 */
 		AbstractFontFactory * getFontFactory() const;
+
+		/**
+		 * Posts an input event from any thread. It is dispatched
+		 * as if it had been imported at the start of the next
+		 * paint, at the location stored in the event.
+		 */
+		void postInput(const InputEvent &e);
+
+		/**
+		 * Posts a command from any thread, for example to update
+		 * a ProgressBar from a loader thread. The command is
+		 * executed and deleted at the start of the next paint.
+		 * @param
+		 *	command the command to execute. The Gui takes ownership.
+		 */
+		void postCommand(util::Command *command);
+
+		/**
+		 * Returns the Gui time, the sum of all delta times
+		 * passed to importUpdate. Input is stamped with it.
+		 */
+		float getTime() const;
+
+		/**
+		 * Returns the counts of the input dispatched by
+		 * the last call to paint.
+		 */
+		const InputStatistics & getInputStatistics() const;
+
+		/**
+		 * Records every import into log, stamped with the current
+		 * frame, until it is called again with 0.
+		 * @see
+		 *	InputLog::replay
+		 */
+		void setInputLog(InputLog *log);
+
+		/**
+		 * Returns the number of times paint has been called.
+		 */
+		int getFrame() const;
+
+		/**
+		 * Turns measuring the parts of a frame on or off.
+		 * It is off by default, as it reads the clock several
+		 * times per frame and for every string measured.
+		 */
+		void setProfiling(bool profiling);
+
+		bool isProfiling() const;
+
+		/**
+		 * Returns the timing of the last call to paint,
+		 * when profiling is on.
+		 */
+		const FrameTiming & getFrameTiming() const;
+
+		/**
+		 * Returns the context this Gui works in. It is made
+		 * current for the duration of every call that reaches
+		 * the Components.
+		 */
+		UiContext & getContext() const;
 	private:
+		/**
+		 * What the Gui knows of one pointer.
+		 */
+		class Pointer
+		{
+		public:
+			Pointer();
+			int x, y;
+			int pickedX, pickedY;
+			bool picked;
+			bool moved;
+		};
+
+		/**
+		 * Dispatches the queued input. Events are picked when
+		 * they are dispatched, not before: the first one that
+		 * needs a pick picks all the others with it, and if
+		 * dispatching an event changes the Components, the
+		 * picking image is drawn again and the events after it
+		 * are picked again, so every event sees the Components
+		 * the events before it left.
+		 */
+		void dispatchInput();
+
+		/**
+		 * Picks the locations of the events from the one being
+		 * dispatched on, and of all pointers which are not
+		 * captured, in one go. Draws the picking image first if
+		 * the Components changed since it was drawn.
+		 */
+		void pickInput();
+
+		/**
+		 * Picks the Component at x,y and sends the motion
+		 * to get there. While a Component holds the capture
+		 * of the pointer, only its bounds are checked.
+		 */
+		void moveMouse(int pointer, int x, int y);
+
+		/**
+		 * Draws the picking image of all frames into the
+		 * frame buffer.
+		 */
+		void renderSelection();
+
+		void queueInput(int type, int pointer, int button, int keyCode, int modifier, unsigned int character);
+		void record(int type, int pointer, int a, int b, unsigned int character, float deltaTime);
+
+		UiContext *context;
 		Graphics g;
-		int mouseX,mouseY;
+		std::map<int,Pointer> pointers;
+		std::vector<util::Point> pickLocations;
+		std::vector<int> releasedPointers;
+		float time;
+		int frame;
 		std::vector<Frame*> frameList;
+
+		InputLog *inputLog;
+		bool profiling;
+		FrameTiming frameTiming;
+		bool selectionRendered;
+		std::size_t selectionRevision;
+
+		// the picks of the events from dispatching on, valid
+		// while the SelectionManager is at pickRevision.
+		bool picksValid;
+		std::size_t pickRevision;
+		std::size_t dispatching;
+
+		PostQueue posted;
+		InputQueue inputQueue;
+		InputEventList input;
+		InputStatistics inputStatistics;
 	};
 }
 
@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./InputLog.h"
+#include "./Gui.h"
+#include <istream>
+#include <ostream>
+#include <cstring>
+
+namespace ui
+{
+	FrameTiming::FrameTiming()
+		:	frame(0),
+			layout(0.0),
+			picking(0.0),
+			text(0.0),
+			paint(0.0),
+			total(0.0)
+	{
+	}
+
+// ---------------------------------------------------------------------------
+
+	InputLog::Record::Record()
+		:	frame(0),
+			type(MOUSE_MOTION),
+			pointer(0),
+			a(0),
+			b(0),
+			character(0),
+			deltaTime(0.0f)
+	{
+	}
+
+// ---------------------------------------------------------------------------
+
+	InputLog::InputLog()
+	{
+	}
+
+	void InputLog::add(const Record &r)
+	{
+		assert(records.empty() || records.back().frame <= r.frame);
+		records.push_back(r);
+	}
+
+	void InputLog::clear()
+	{
+		records.clear();
+	}
+
+	std::size_t InputLog::size() const
+	{
+		return records.size();
+	}
+
+	const InputLog::Record & InputLog::get(std::size_t index) const
+	{
+		return records[index];
+	}
+
+	void InputLog::writeUnsigned(std::ostream &out, unsigned int value)
+	{
+		// seven bits at a time, the high bit says more follow
+		while(value >= 0x80)
+		{
+			out.put(static_cast<char>((value & 0x7f) | 0x80));
+			value >>= 7;
+		}
+		out.put(static_cast<char>(value));
+	}
+
+	void InputLog::writeSigned(std::ostream &out, int value)
+	{
+		// zig-zag, so small negative numbers stay short
+		unsigned int bits = static_cast<unsigned int>(value);
+		writeUnsigned(out,(bits << 1) ^ (value < 0 ? 0xffffffffu : 0u));
+	}
+
+	bool InputLog::readUnsigned(std::istream &in, unsigned int &value)
+	{
+		value = 0;
+		for(int shift = 0; shift < 35; shift += 7)
+		{
+			int c = in.get();
+			if(c == EOF)
+			{
+				return false;
+			}
+			value |= static_cast<unsigned int>(c & 0x7f) << shift;
+			if((c & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool InputLog::readSigned(std::istream &in, int &value)
+	{
+		unsigned int bits = 0;
+		if(!readUnsigned(in,bits))
+		{
+			return false;
+		}
+		value = static_cast<int>((bits >> 1) ^ (0u - (bits & 1u)));
+		return true;
+	}
+
+	bool InputLog::save(std::ostream &out) const
+	{
+		out.write("UILG",4);
+		out.put(static_cast<char>(version));
+
+		int frame = 0;
+		std::vector<Record>::const_iterator iter;
+		for(iter = records.begin(); iter != records.end(); ++iter)
+		{
+			const Record &r = *iter;
+			out.put(static_cast<char>(r.type));
+			writeUnsigned(out,static_cast<unsigned int>(r.frame - frame));
+			frame = r.frame;
+
+			switch(r.type)
+			{
+				case MOUSE_MOTION:
+					writeSigned(out,r.a);
+					writeSigned(out,r.b);
+					break;
+				case MOUSE_PRESSED:
+				case MOUSE_RELEASED:
+					writeSigned(out,r.a);
+					break;
+				case KEY_PRESSED:
+					writeSigned(out,r.a);
+					writeSigned(out,r.b);
+					writeUnsigned(out,r.character);
+					break;
+				case KEY_RELEASED:
+					writeSigned(out,r.a);
+					writeSigned(out,r.b);
+					break;
+				case UPDATE:
+				{
+					unsigned int bits;
+					std::memcpy(&bits,&r.deltaTime,sizeof(bits));
+					for(int i = 0; i < 4; ++i)
+					{
+						out.put(static_cast<char>((bits >> (i * 8)) & 0xff));
+					}
+					break;
+				}
+				case POINTER_MOTION:
+					writeUnsigned(out,static_cast<unsigned int>(r.pointer));
+					writeSigned(out,r.a);
+					writeSigned(out,r.b);
+					break;
+				case POINTER_PRESSED:
+				case POINTER_RELEASED:
+					writeUnsigned(out,static_cast<unsigned int>(r.pointer));
+					writeSigned(out,r.a);
+					break;
+				case POINTER_REMOVED:
+					writeUnsigned(out,static_cast<unsigned int>(r.pointer));
+					break;
+			}
+		}
+		return out.good();
+	}
+
+	bool InputLog::load(std::istream &in)
+	{
+		records.clear();
+
+		char magic[4];
+		in.read(magic,4);
+		if(!in || std::memcmp(magic,"UILG",4) != 0 || in.get() != version)
+		{
+			return false;
+		}
+
+		int frame = 0;
+		for(int type = in.get(); type != EOF; type = in.get())
+		{
+			Record r;
+			r.type = type;
+
+			unsigned int frames = 0;
+			bool ok = readUnsigned(in,frames);
+			frame += static_cast<int>(frames);
+			r.frame = frame;
+
+			switch(type)
+			{
+				case MOUSE_MOTION:
+					ok = ok && readSigned(in,r.a) && readSigned(in,r.b);
+					break;
+				case MOUSE_PRESSED:
+				case MOUSE_RELEASED:
+					ok = ok && readSigned(in,r.a);
+					break;
+				case KEY_PRESSED:
+					ok = ok && readSigned(in,r.a) && readSigned(in,r.b) && readUnsigned(in,r.character);
+					break;
+				case KEY_RELEASED:
+					ok = ok && readSigned(in,r.a) && readSigned(in,r.b);
+					break;
+				case UPDATE:
+				{
+					unsigned int bits = 0;
+					for(int i = 0; i < 4 && ok; ++i)
+					{
+						int c = in.get();
+						ok = (c != EOF);
+						bits |= static_cast<unsigned int>(c & 0xff) << (i * 8);
+					}
+					std::memcpy(&r.deltaTime,&bits,sizeof(bits));
+					break;
+				}
+				case POINTER_MOTION:
+				case POINTER_PRESSED:
+				case POINTER_RELEASED:
+				case POINTER_REMOVED:
+				{
+					unsigned int pointer = 0;
+					ok = ok && readUnsigned(in,pointer);
+					r.pointer = static_cast<int>(pointer);
+
+					if(type == POINTER_MOTION)
+					{
+						ok = ok && readSigned(in,r.a) && readSigned(in,r.b);
+					}
+					else if(type != POINTER_REMOVED)
+					{
+						ok = ok && readSigned(in,r.a);
+					}
+					break;
+				}
+				default:
+					ok = false;
+					break;
+			}
+
+			if(!ok)
+			{
+				records.clear();
+				return false;
+			}
+			records.push_back(r);
+		}
+		return true;
+	}
+
+	void InputLog::replay(Gui &gui, FrameTimingList *timings) const
+	{
+		if(records.empty())
+		{
+			return;
+		}
+
+		int first = records.front().frame;
+		int last = records.back().frame;
+		std::vector<Record>::const_iterator iter = records.begin();
+
+		for(int frame = first; frame <= last; ++frame)
+		{
+			for(; iter != records.end() && iter->frame == frame; ++iter)
+			{
+				const Record &r = *iter;
+				switch(r.type)
+				{
+					case MOUSE_MOTION:
+						// recorded past the check importMouseMotion
+						// makes, so 0,0 has to come through as well.
+						gui.importPointerMotion(0,r.a,r.b);
+						break;
+					case MOUSE_PRESSED:
+						gui.importMousePressed(r.a);
+						break;
+					case MOUSE_RELEASED:
+						gui.importMouseReleased(r.a);
+						break;
+					case KEY_PRESSED:
+						gui.importKeyPressed(r.a,r.b,r.character);
+						break;
+					case KEY_RELEASED:
+						gui.importKeyReleased(r.a,r.b);
+						break;
+					case UPDATE:
+						gui.importUpdate(r.deltaTime);
+						break;
+					case POINTER_MOTION:
+						gui.importPointerMotion(r.pointer,r.a,r.b);
+						break;
+					case POINTER_PRESSED:
+						gui.importPointerPressed(r.pointer,r.a);
+						break;
+					case POINTER_RELEASED:
+						gui.importPointerReleased(r.pointer,r.a);
+						break;
+					case POINTER_REMOVED:
+						gui.importPointerRemoved(r.pointer);
+						break;
+				}
+			}
+
+			gui.paint();
+			if(timings != 0)
+			{
+				timings->push_back(gui.getFrameTiming());
+			}
+		}
+	}
+}
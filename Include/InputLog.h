@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INPUTLOG_H
+#define INPUTLOG_H
+
+#include "./Pointers.h"
+#include <iosfwd>
+
+namespace ui
+{
+	class Gui;
+
+	/**
+	 * How long the parts of one Gui frame took, in seconds.
+	 * Text is the time spent measuring strings, which is
+	 * also part of layout and paint.
+	 */
+	class FrameTiming
+	{
+	public:
+		FrameTiming();
+
+		int frame;
+		double layout;
+		double picking;
+		double text;
+		double paint;
+		double total;
+	};
+
+	typedef std::vector<FrameTiming> FrameTimingList;
+
+	/**
+	 * A log of everything imported into a Gui, with the frame
+	 * it was imported in. Gui::setInputLog records into one, and
+	 * replay feeds it back, so two builds can be compared on the
+	 * same workload. Replaying also replays the update deltas, so
+	 * animations and Gui time come out the same.
+	 * <p>
+	 * The binary form starts with "UILG" and a version byte, then
+	 * one record after the other: a type byte, the number of frames
+	 * since the previous record, and the arguments, which start with
+	 * the pointer id for the pointer records. Integers are
+	 * stored as variable length, zig-zag encoded where they can be
+	 * negative, and deltas as the four bytes of the float, least
+	 * significant first.
+	 * </p>
+	 */
+	class InputLog
+	{
+	public:
+		enum TYPES
+		{
+			MOUSE_MOTION,
+			MOUSE_PRESSED,
+			MOUSE_RELEASED,
+			KEY_PRESSED,
+			KEY_RELEASED,
+			UPDATE,
+			POINTER_MOTION,
+			POINTER_PRESSED,
+			POINTER_RELEASED,
+			POINTER_REMOVED
+		};
+
+		class Record
+		{
+		public:
+			Record();
+
+			int frame;
+			int type;
+
+			/**
+			 * The pointer id of the pointer records, the mouse
+			 * records are pointer 0.
+			 */
+			int pointer;
+
+			/**
+			 * x and button, or the key code.
+			 */
+			int a;
+
+			/**
+			 * y, or the modifier.
+			 */
+			int b;
+			unsigned int character;
+			float deltaTime;
+		};
+
+		InputLog();
+
+		/**
+		 * Adds a record. Records have to be added in frame order.
+		 */
+		void add(const Record &r);
+
+		void clear();
+
+		std::size_t size() const;
+
+		const Record & get(std::size_t index) const;
+
+		/**
+		 * Writes the log in its binary form.
+		 * @return
+		 *	false if the stream failed.
+		 */
+		bool save(std::ostream &out) const;
+
+		/**
+		 * Replaces the log with the one read from in.
+		 * @return
+		 *	false if in does not hold a valid log, in which
+		 *	case the log is left empty.
+		 */
+		bool load(std::istream &in);
+
+		/**
+		 * Feeds the log into gui as fast as possible, painting
+		 * once for every recorded frame, including frames in which
+		 * nothing was imported.
+		 * @param
+		 *	timings if not 0, receives the FrameTiming of every
+		 *	replayed frame.
+		 */
+		void replay(Gui &gui, FrameTimingList *timings = 0) const;
+	private:
+		static void writeUnsigned(std::ostream &out, unsigned int value);
+		static void writeSigned(std::ostream &out, int value);
+		static bool readUnsigned(std::istream &in, unsigned int &value);
+		static bool readSigned(std::istream &in, int &value);
+
+		std::vector<Record> records;
+		static const unsigned char version = 1;
+	};
+}
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./InputQueue.h"
+
+namespace ui
+{
+	InputEvent::InputEvent()
+		:	type(MOUSE_MOTION),
+			pointer(0),
+			x(0),
+			y(0),
+			button(0),
+			keyCode(0),
+			modifier(0),
+			character(0),
+			time(0.0f)
+	{
+	}
+
+// ---------------------------------------------------------------------------
+
+	InputStatistics::InputStatistics()
+		:	received(0),
+			coalesced(0),
+			dispatched(0),
+			picks(0),
+			latency(0.0f)
+	{
+	}
+
+// ---------------------------------------------------------------------------
+
+	InputQueue::InputQueue()
+	{
+	}
+
+	void InputQueue::push(const InputEvent &e)
+	{
+		++statistics.received;
+
+		if(e.type == InputEvent::MOUSE_MOTION)
+		{
+			// only the latest location matters, drags are
+			// computed from the difference between locations.
+			InputEventList::reverse_iterator iter;
+			for(iter = events.rbegin(); iter != events.rend() && (*iter).type == InputEvent::MOUSE_MOTION; ++iter)
+			{
+				if((*iter).pointer == e.pointer)
+				{
+					*iter = e;
+					++statistics.coalesced;
+					return;
+				}
+			}
+		}
+		events.push_back(e);
+	}
+
+	void InputQueue::drain(InputEventList &list)
+	{
+		list.clear();
+		list.swap(events);
+	}
+
+	std::size_t InputQueue::size() const
+	{
+		return events.size();
+	}
+
+	const InputStatistics & InputQueue::getStatistics() const
+	{
+		return statistics;
+	}
+
+	void InputQueue::resetStatistics()
+	{
+		statistics = InputStatistics();
+	}
+}
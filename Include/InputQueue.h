@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INPUTQUEUE_H
+#define INPUTQUEUE_H
+
+#include "./Pointers.h"
+
+namespace ui
+{
+	/**
+	 * An input event imported into the Gui, waiting to be
+	 * dispatched. Mouse events carry the id and the location of
+	 * their pointer at the time they were imported. The mouse is
+	 * pointer 0.
+	 */
+	class InputEvent
+	{
+	public:
+		enum TYPES
+		{
+			MOUSE_MOTION,
+			MOUSE_PRESSED,
+			MOUSE_RELEASED,
+			KEY_PRESSED,
+			KEY_RELEASED,
+			POINTER_REMOVED
+		};
+
+		InputEvent();
+
+		int type;
+		int pointer;
+		int x, y;
+		int button;
+		int keyCode;
+		int modifier;
+		unsigned int character;
+
+		/**
+		 * The time the event was imported at, in seconds of Gui
+		 * time, which is the sum of all delta times passed to
+		 * Gui::importUpdate.
+		 */
+		float time;
+	};
+
+	typedef std::vector<InputEvent> InputEventList;
+
+	/**
+	 * Counts of the input handled by the Gui in a frame.
+	 */
+	class InputStatistics
+	{
+	public:
+		InputStatistics();
+
+		/**
+		 * The number of events imported.
+		 */
+		std::size_t received;
+
+		/**
+		 * The number of mouse motion events which were merged
+		 * into the motion event after them.
+		 */
+		std::size_t coalesced;
+
+		/**
+		 * The number of events dispatched to Components.
+		 */
+		std::size_t dispatched;
+
+		/**
+		 * The number of times the picking engine was asked
+		 * for the Component under the mouse.
+		 */
+		std::size_t picks;
+
+		/**
+		 * The time between importing the oldest event and
+		 * dispatching it, in seconds.
+		 */
+		float latency;
+	};
+
+	/**
+	 * Holds the input imported into the Gui until it is
+	 * dispatched, once per frame.
+	 * <p>
+	 * Mouse motion is coalesced: a motion event replaces the motion
+	 * of the same pointer when only motion was pushed after it, so a
+	 * burst of motion from a mouse polled at a high rate, or from ten
+	 * fingers moving at once, costs a single dispatch per pointer. Presses,
+	 * releases and key events are never merged, and keep their order
+	 * relative to each other and to the motion between them, so each
+	 * press and release is dispatched at the location it happened.
+	 * </p>
+	 * The queue swaps its storage with the list it is drained into,
+	 * so it does not allocate once both have grown large enough.
+	 */
+	class InputQueue
+	{
+	public:
+		/**
+		 * Creates an empty InputQueue.
+		 */
+		InputQueue();
+
+		/**
+		 * Adds an event to the end of the queue, merging it
+		 * with the motion of the same pointer if nothing but
+		 * motion follows that.
+		 */
+		void push(const InputEvent &e);
+
+		/**
+		 * Moves all events into events, in the order they were
+		 * pushed, and empties the queue. The previous contents
+		 * of events are discarded.
+		 */
+		void drain(InputEventList &events);
+
+		/**
+		 * Returns the number of events waiting.
+		 */
+		std::size_t size() const;
+
+		/**
+		 * Returns the counts since the last call to
+		 * resetStatistics.
+		 */
+		const InputStatistics & getStatistics() const;
+
+		/**
+		 * Returns the counts to zero.
+		 */
+		void resetStatistics();
+	private:
+		InputEventList events;
+		InputStatistics statistics;
+	};
+}
+
+#endif
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./MeasurementCache.h"
+#include "./Font.h"
+
+namespace ui
+{
+	MeasurementCache::MeasurementCache(std::size_t c)
+		:	capacity(c),
+			hits(0),
+			misses(0),
+			evictions(0)
+	{
+	}
+
+	const util::Dimension MeasurementCache::getStringBoundingBox(std::size_t fontIndex, const Font *font, const std::string &text)
+	{
+		Entry &entry = lookup(fontIndex,text);
+
+		if(entry.hasBoundingBox)
+		{
+			++hits;
+		}
+		else
+		{
+			++misses;
+			entry.boundingBox = font->getStringBoundingBox(text);
+			entry.hasBoundingBox = true;
+		}
+		return entry.boundingBox;
+	}
+
+	void MeasurementCache::getGlyphAdvances(std::size_t fontIndex, const Font *font, const std::string &text, std::vector<int> &advances)
+	{
+		Entry &entry = lookup(fontIndex,text);
+
+		if(entry.hasAdvances)
+		{
+			++hits;
+		}
+		else
+		{
+			++misses;
+			font->getGlyphAdvances(text,entry.advances);
+			entry.hasAdvances = true;
+		}
+		advances.assign(entry.advances.begin(),entry.advances.end());
+	}
+
+	void MeasurementCache::setCapacity(std::size_t c)
+	{
+		capacity = c;
+
+		for(std::size_t i = 0; i < shardCount; ++i)
+		{
+			evict(shards[i],(capacity + shardCount - 1) / shardCount);
+		}
+	}
+
+	std::size_t MeasurementCache::getCapacity() const
+	{
+		return capacity;
+	}
+
+	std::size_t MeasurementCache::getSize() const
+	{
+		std::size_t size = 0;
+		for(std::size_t i = 0; i < shardCount; ++i)
+		{
+			size += shards[i].index.size();
+		}
+		return size;
+	}
+
+	std::size_t MeasurementCache::getHits() const
+	{
+		return hits;
+	}
+
+	std::size_t MeasurementCache::getMisses() const
+	{
+		return misses;
+	}
+
+	std::size_t MeasurementCache::getEvictions() const
+	{
+		return evictions;
+	}
+
+	void MeasurementCache::resetStatistics()
+	{
+		hits = 0;
+		misses = 0;
+		evictions = 0;
+	}
+
+	void MeasurementCache::clear()
+	{
+		for(std::size_t i = 0; i < shardCount; ++i)
+		{
+			shards[i].entries.clear();
+			shards[i].index.clear();
+		}
+	}
+
+	MeasurementCache::Entry& MeasurementCache::lookup(std::size_t fontIndex, const std::string &text)
+	{
+		std::size_t h = hash(text);
+		Shard &shard = shards[(h ^ fontIndex) % shardCount];
+		Key key(fontIndex,h);
+
+		EntryMap::iterator found = shard.index.find(key);
+
+		if(found != shard.index.end())
+		{
+			EntryList::iterator entry = found->second;
+			shard.entries.splice(shard.entries.begin(),shard.entries,entry);
+
+			if(entry->text == text)
+			{
+				return *entry;
+			}
+
+			// two strings with the same hash, the newest one
+			// takes over the entry.
+			entry->text = text;
+			entry->hasBoundingBox = false;
+			entry->hasAdvances = false;
+			return *entry;
+		}
+
+		std::size_t shardCapacity = std::max((capacity + shardCount - 1) / shardCount,static_cast<std::size_t>(1));
+
+		if(shard.index.size() >= shardCapacity)
+		{
+			// reuse the least recently used entry, which keeps the
+			// memory of its string and advances.
+			EntryList::iterator last = --shard.entries.end();
+			shard.index.erase(Key(last->fontIndex,last->hash));
+			shard.entries.splice(shard.entries.begin(),shard.entries,last);
+			++evictions;
+		}
+		else
+		{
+			shard.entries.push_front(Entry());
+		}
+
+		Entry &entry = shard.entries.front();
+		entry.fontIndex = fontIndex;
+		entry.hash = h;
+		entry.text = text;
+		entry.hasBoundingBox = false;
+		entry.hasAdvances = false;
+
+		shard.index.insert(std::make_pair(key,shard.entries.begin()));
+		return entry;
+	}
+
+	void MeasurementCache::evict(Shard &shard, std::size_t size)
+	{
+		while(shard.index.size() > size)
+		{
+			Entry &last = shard.entries.back();
+			shard.index.erase(Key(last.fontIndex,last.hash));
+			shard.entries.pop_back();
+			++evictions;
+		}
+	}
+
+	std::size_t MeasurementCache::hash(const std::string &text)
+	{
+		// FNV-1a
+		std::size_t h = 2166136261U;
+		for(std::string::size_type i = 0; i < text.length(); ++i)
+		{
+			h ^= static_cast<unsigned char>(text[i]);
+			h *= 16777619U;
+		}
+		return h;
+	}
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MEASUREMENTCACHE_H
+#define MEASUREMENTCACHE_H
+
+#include <map>
+#include "./Pointers.h"
+#include "./util/Dimension.h"
+
+namespace ui
+{
+	/**
+	 * Remembers the bounding boxes and glyph advances of strings
+	 * measured with a Font.
+	 * <p>
+	 * Font engines walk the glyphs of a string every time it is
+	 * measured, while a user interface measures the same few hundred
+	 * strings over and over. The cache maps a font index and a string
+	 * to its measurements. It is split in shards on the hash of the
+	 * string, each of which holds a bounded number of strings in least
+	 * recently used order, so a lookup or an eviction only touches a
+	 * small map and list.
+	 * </p>
+	 * Use the cache through GlyphContext::getStringBoundingBox and
+	 * GlyphContext::getGlyphAdvances.
+	 */
+	class MeasurementCache
+	{
+	public:
+		/**
+		 * Creates a new MeasurementCache.
+		 * @param
+		 *	capacity the number of strings the cache holds.
+		 */
+		MeasurementCache(std::size_t capacity);
+
+		/**
+		 * Returns the bounding box of text in font, measuring
+		 * it only if it is not in the cache.
+		 */
+		const util::Dimension getStringBoundingBox(std::size_t fontIndex, const Font *font, const std::string &text);
+
+		/**
+		 * Stores the glyph advances of text in font in advances,
+		 * measuring them only if they are not in the cache.
+		 */
+		void getGlyphAdvances(std::size_t fontIndex, const Font *font, const std::string &text, std::vector<int> &advances);
+
+		/**
+		 * Sets the number of strings the cache holds.
+		 */
+		void setCapacity(std::size_t capacity);
+
+		/**
+		 * Returns the number of strings the cache holds.
+		 */
+		std::size_t getCapacity() const;
+
+		/**
+		 * Returns the number of strings in the cache.
+		 */
+		std::size_t getSize() const;
+
+		/**
+		 * Returns the number of measurements found in the cache.
+		 */
+		std::size_t getHits() const;
+
+		/**
+		 * Returns the number of measurements which were not
+		 * in the cache.
+		 */
+		std::size_t getMisses() const;
+
+		/**
+		 * Returns the number of strings removed to make room
+		 * for others.
+		 */
+		std::size_t getEvictions() const;
+
+		/**
+		 * Sets the hit, miss and eviction counters to zero.
+		 */
+		void resetStatistics();
+
+		/**
+		 * Removes all strings from the cache.
+		 */
+		void clear();
+	private:
+		MeasurementCache(const MeasurementCache &rhs);
+		MeasurementCache& operator=(const MeasurementCache &rhs);
+
+		/**
+		 * The measurements of a string, which are filled in
+		 * when they are first asked for.
+		 */
+		struct Entry
+		{
+			std::size_t fontIndex;
+			std::size_t hash;
+			std::string text;
+			bool hasBoundingBox;
+			util::Dimension boundingBox;
+			bool hasAdvances;
+			std::vector<int> advances;
+		};
+
+		typedef std::list<Entry> EntryList;
+		typedef std::pair<std::size_t,std::size_t> Key;
+		typedef std::map<Key,EntryList::iterator> EntryMap;
+
+		/**
+		 * A part of the cache, the most recently used entries
+		 * are at the front of the list.
+		 */
+		struct Shard
+		{
+			EntryList entries;
+			EntryMap index;
+		};
+
+		static const std::size_t shardCount = 16;
+
+		Entry& lookup(std::size_t fontIndex, const std::string &text);
+		void evict(Shard &shard, std::size_t size);
+		static std::size_t hash(const std::string &text);
+
+		Shard shards[shardCount];
+		std::size_t capacity;
+		std::size_t hits;
+		std::size_t misses;
+		std::size_t evictions;
+	};
+}
+
+#endif
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./NotificationManager.h"
+#include "./Component.h"
+#include "./util/Observable.h"
+
+namespace ui
+{
+	NotificationManager::Notification::Notification(int k, void *o, const event::PropertyEvent &event)
+		:	kind(k),
+			owner(o),
+			e(event)
+	{
+	}
+
+	NotificationManager::Key::Key(int k, void *o, int c, int i)
+		:	kind(k),
+			owner(o),
+			classID(c),
+			id(i)
+	{
+	}
+
+	bool NotificationManager::Key::operator<(const Key &rhs) const
+	{
+		if(owner != rhs.owner)
+		{
+			return owner < rhs.owner;
+		}
+		if(kind != rhs.kind)
+		{
+			return kind < rhs.kind;
+		}
+		if(classID != rhs.classID)
+		{
+			return classID < rhs.classID;
+		}
+		return id < rhs.id;
+	}
+
+// ---------------------------------------------------------------------------
+
+	NotificationManager::NotificationManager()
+		:	deferred(false),
+			flushing(false),
+			queued(0)
+	{
+	}
+
+	NotificationManager::~NotificationManager()
+	{
+		queued = 0;
+	}
+
+	void NotificationManager::setDeferred(bool d)
+	{
+		if(!d)
+		{
+			flush();
+		}
+		deferred = d;
+	}
+
+	bool NotificationManager::isDeferred() const
+	{
+		return deferred && !flushing;
+	}
+
+	bool NotificationManager::post(const Notification &n)
+	{
+		Key key(n.kind,n.owner,n.e.getClassID(),n.e.getID());
+		std::map<Key,std::size_t>::iterator pos = index.find(key);
+		if(pos != index.end())
+		{
+			// last one wins
+			pending[pos->second] = n;
+			return false;
+		}
+
+		index.insert(std::make_pair(key,pending.size()));
+		pending.push_back(n);
+		++queued;
+		return true;
+	}
+
+	bool NotificationManager::postPropertyEvent(Component *c, const event::PropertyEvent &e)
+	{
+		return post(Notification(PROPERTY,c,e));
+	}
+
+	bool NotificationManager::postNotification(Component *c, int id)
+	{
+		return post(Notification(NOTIFICATION,c,event::PropertyEvent(c,0,id)));
+	}
+
+	bool NotificationManager::postObservable(util::Observable *o)
+	{
+		return post(Notification(OBSERVABLE,o,event::PropertyEvent(0,0,0)));
+	}
+
+	void NotificationManager::cancel(Component *c)
+	{
+		cancel(static_cast<void*>(c));
+	}
+
+	void NotificationManager::cancel(util::Observable *o)
+	{
+		cancel(static_cast<void*>(o));
+	}
+
+	void NotificationManager::cancel(void *owner)
+	{
+		std::vector<Notification>::iterator iter;
+		for(iter = pending.begin(); iter != pending.end(); ++iter)
+		{
+			if(iter->owner == owner)
+			{
+				iter->owner = 0;
+			}
+		}
+		for(iter = delivering.begin(); iter != delivering.end(); ++iter)
+		{
+			if(iter->owner == owner)
+			{
+				iter->owner = 0;
+			}
+		}
+	}
+
+	void NotificationManager::flush()
+	{
+		if(flushing || pending.empty())
+		{
+			return;
+		}
+
+		flushing = true;
+		delivering.swap(pending);
+		pending.clear();
+		index.clear();
+
+		// by index, a listener may cancel notifications
+		// of Components it deletes.
+		for(std::size_t i = 0; i < delivering.size(); ++i)
+		{
+			Notification n = delivering[i];
+			if(n.owner == 0)
+			{
+				continue;
+			}
+
+			switch(n.kind)
+			{
+				case PROPERTY:
+				{
+					static_cast<Component*>(n.owner)->deliverPropertyEvent(n.e);
+					break;
+				}
+				case NOTIFICATION:
+				{
+					static_cast<Component*>(n.owner)->deliverNotification(n.e.getID());
+					break;
+				}
+				case OBSERVABLE:
+				{
+					static_cast<util::Observable*>(n.owner)->deliverNotification();
+					break;
+				}
+			}
+		}
+
+		queued -= delivering.size();
+		delivering.clear();
+		flushing = false;
+	}
+
+	bool NotificationManager::hasPendingNotifications()
+	{
+		const NotificationManager *manager = UiContext::getCurrent().findNotificationManager();
+		return manager != 0 && manager->queued > 0;
+	}
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef NOTIFICATIONMANAGER_H
+#define NOTIFICATIONMANAGER_H
+
+#include "./Pointers.h"
+#include "./event/PropertyEvent.h"
+#include "./UiContext.h"
+#include <map>
+
+namespace ui
+{
+	/**
+	 * Singleton class which holds back notifications until
+	 * the end of input processing, when deferring is turned on.
+	 * <p>
+	 * By default PropertyEvents, Observable notifications and
+	 * Component notifications such as the ChangeEvents of range
+	 * models are sent the moment they happen. With deferring on,
+	 * they are queued instead, and the Gui delivers them once per
+	 * frame, after the input has been dispatched. A notification
+	 * posted again before that replaces the queued one, so a drag
+	 * that changes a Scroller twenty times in a frame notifies its
+	 * listeners once, and they read the last value.
+	 * </p>
+	 * <p>
+	 * Notifications posted while the queue is being delivered are
+	 * sent right away, so a chain of listeners settles within
+	 * the same frame.
+	 * </p>
+	 */
+	class NotificationManager
+	{
+	public:
+		NotificationManager();
+
+		~NotificationManager();
+
+		static NotificationManager & getInstance()
+		{
+			return UiContext::getCurrent().getNotificationManager();
+		}
+
+		/**
+		 * Turns deferring on or off. Turning it off delivers
+		 * everything still queued.
+		 */
+		void setDeferred(bool deferred);
+
+		/**
+		 * Returns true if notifications posted now are queued
+		 * instead of sent.
+		 */
+		bool isDeferred() const;
+
+		/**
+		 * Queues a PropertyEvent for c, replacing a queued event
+		 * of the same class and id.
+		 * @return
+		 *	true if this added a new notification for c.
+		 */
+		bool postPropertyEvent(Component *c, const event::PropertyEvent &e);
+
+		/**
+		 * Queues the notification id of c, see Component::postNotification.
+		 * @return
+		 *	true if this added a new notification for c.
+		 */
+		bool postNotification(Component *c, int id);
+
+		/**
+		 * Queues the notification of an Observable.
+		 * @return
+		 *	true if this added a new notification for o.
+		 */
+		bool postObservable(util::Observable *o);
+
+		/**
+		 * Drops everything queued for c, which is going away.
+		 */
+		void cancel(Component *c);
+
+		/**
+		 * Drops everything queued for o, which is going away.
+		 */
+		void cancel(util::Observable *o);
+
+		/**
+		 * Delivers everything queued, in the order it was
+		 * first posted.
+		 */
+		void flush();
+
+		/**
+		 * Returns true if anything is queued in the current
+		 * UiContext. This does not create the instance, so
+		 * Components and Observables can ask when they are
+		 * destroyed, even after the NotificationManager.
+		 */
+		static bool hasPendingNotifications();
+	private:
+		enum KINDS
+		{
+			PROPERTY,
+			NOTIFICATION,
+			OBSERVABLE
+		};
+
+		class Notification
+		{
+		public:
+			Notification(int kind, void *owner, const event::PropertyEvent &e);
+
+			int kind;
+			void *owner;
+			event::PropertyEvent e;
+		};
+
+		class Key
+		{
+		public:
+			Key(int kind, void *owner, int classID, int id);
+			bool operator<(const Key &rhs) const;
+
+			int kind;
+			void *owner;
+			int classID, id;
+		};
+
+		bool post(const Notification &n);
+		void cancel(void *owner);
+
+		std::vector<Notification> pending;
+		std::vector<Notification> delivering;
+		std::map<Key,std::size_t> index;
+		bool deferred, flushing;
+		std::size_t queued;
+	};
+}
+
+#endif
@@ -59,13 +59,18 @@ namespace ui
 	class ColorTheme;
 	class ColorFactory;
 	class Icon;
+	class Scrollable;
+	class ListModel;
+	class TableModel;
 
 	namespace theme
 	{
 		class ThemeComponent;
+		class TextLayout;
 	}
 
 	class Window;
+	class UiContext;
 
 	namespace border
 	{
@@ -83,6 +88,8 @@ namespace ui
 		class WindowListener;
 		class PropertyListener;
 		class ChangeListener;
+		class ListDataListener;
+		class TableModelListener;
 
 		class Event;
 		class MouseEvent;
@@ -92,6 +99,8 @@ namespace ui
 		class WindowEvent;
 		class PropertyEvent;
 		class ChangeEvent;
+		class ListDataEvent;
+		class TableModelEvent;
 
 		typedef std::vector<MouseListener*> MouseListenerList;
 
@@ -106,6 +115,10 @@ namespace ui
 		typedef std::vector<PropertyListener*> PropertyListenerList;
 
 		typedef std::vector<ChangeListener*> ChangeListenerList;
+
+		typedef std::vector<ListDataListener*> ListDataListenerList;
+
+		typedef std::vector<TableModelListener*> TableModelListenerList;
 	}
 
 	/**
@@ -125,6 +138,7 @@ namespace ui
 		class Observable;
 		
 		class Interpolator;
+		class PrefixSumTree;
 
 		typedef std::vector<Observer*> ObserverList;
 		typedef std::vector<Interpolator*> InterpolatorList;
@@ -133,6 +147,7 @@ namespace ui
 	namespace layout
 	{
 		class LayoutManager;
+		class BoxLayout;
 		class GridLayout;
 		class FlowLayout;
 		class PopupLayout;
@@ -142,6 +157,12 @@ namespace ui
 
 	typedef std::vector<Font*> FontList;
 
+	/**
+	 * Index of a Font in GlyphContext. A handle stays
+	 * valid for the lifetime of the GlyphContext.
+	 */
+	typedef std::size_t FontHandle;
+
 	typedef std::stack<float> FloatStack;
 	typedef std::vector<Window*> WindowList;
 }
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./PostQueue.h"
+#include "./util/Atomic.h"
+
+namespace ui
+{
+	PostQueue::PostQueue()
+		:	head(0),
+			freeList(0)
+	{
+	}
+
+	PostQueue::~PostQueue()
+	{
+		Node *node = static_cast<Node*>(util::Atomic::exchange(reinterpret_cast<void * volatile *>(&head),0));
+		while(node != 0)
+		{
+			Node *next = node->next;
+			delete node->command;
+			delete node;
+			node = next;
+		}
+		destroy(static_cast<Node*>(util::Atomic::exchange(reinterpret_cast<void * volatile *>(&freeList),0)));
+	}
+
+	void PostQueue::post(const InputEvent &e)
+	{
+		Node *node = allocate();
+		node->event = e;
+		node->command = 0;
+		push(node);
+	}
+
+	void PostQueue::post(util::Command *command)
+	{
+		Node *node = allocate();
+		node->command = command;
+		push(node);
+	}
+
+	PostQueue::Node * PostQueue::allocate()
+	{
+		void * volatile *target = reinterpret_cast<void * volatile *>(&freeList);
+
+		Node *node = static_cast<Node*>(util::Atomic::exchange(target,0));
+		if(node == 0)
+		{
+			return new Node();
+		}
+
+		if(node->next != 0)
+		{
+			// nodes handed back while we held the list are pushed
+			// out by the rest, and linked back on after it.
+			Node *returned = static_cast<Node*>(util::Atomic::exchange(target,node->next));
+			if(returned != 0)
+			{
+				Node *last = returned;
+				while(last->next != 0)
+				{
+					last = last->next;
+				}
+				link(target,returned,last);
+			}
+		}
+		return node;
+	}
+
+	void PostQueue::recycle(Node *first, Node *last)
+	{
+		link(reinterpret_cast<void * volatile *>(&freeList),first,last);
+	}
+
+	void PostQueue::destroy(Node *list)
+	{
+		while(list != 0)
+		{
+			Node *next = list->next;
+			delete list;
+			list = next;
+		}
+	}
+
+	void PostQueue::push(Node *node)
+	{
+		link(reinterpret_cast<void * volatile *>(&head),node,node);
+	}
+
+	void PostQueue::link(void * volatile *target, Node *first, Node *last)
+	{
+		// the first compare and swap fails unless the list is
+		// empty, and reads the current head atomically. Lists are
+		// only ever taken as a whole, so a head that comes back
+		// between the read and the swap is still the right one.
+		Node *expected = 0;
+		for(;;)
+		{
+			last->next = expected;
+			Node *found = static_cast<Node*>(util::Atomic::compareExchange(target,first,expected));
+			if(found == expected)
+			{
+				break;
+			}
+			expected = found;
+		}
+	}
+
+	PostQueue::Node * PostQueue::reverse(Node *list)
+	{
+		Node *result = 0;
+		while(list != 0)
+		{
+			Node *next = list->next;
+			list->next = result;
+			result = list;
+			list = next;
+		}
+		return result;
+	}
+
+	int PostQueue::take(InputQueue &input, float time)
+	{
+		// swapping 0 for 0 reads head atomically
+		void * volatile *target = reinterpret_cast<void * volatile *>(&head);
+		if(util::Atomic::compareExchange(target,0,0) == 0)
+		{
+			return 0;
+		}
+
+		Node *first = reverse(static_cast<Node*>(util::Atomic::exchange(target,0)));
+		Node *last = first;
+
+		int taken = 0;
+		for(Node *node = first; node != 0; node = node->next)
+		{
+			if(node->command != 0)
+			{
+				node->command->execute();
+				delete node->command;
+				node->command = 0;
+			}
+			else
+			{
+				node->event.time = time;
+				input.push(node->event);
+			}
+			last = node;
+			++taken;
+		}
+
+		// the list is still linked, so it goes back as a whole.
+		recycle(first,last);
+		return taken;
+	}
+}
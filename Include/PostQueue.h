@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef POSTQUEUE_H
+#define POSTQUEUE_H
+
+#include "./Pointers.h"
+#include "./InputQueue.h"
+#include "./util/Command.h"
+
+namespace ui
+{
+	/**
+	 * A queue any thread can post input and commands to, with
+	 * a single thread taking them off. Posting never blocks: a
+	 * post links a node onto the head of a list with a compare
+	 * and exchange, retrying only when another thread posted
+	 * in between. The consumer takes the whole list with one
+	 * exchange and reverses it, so items come off in the order
+	 * they were posted by each thread. Since nodes are never
+	 * taken off one by one, a recycled node cannot be mistaken
+	 * for the head it replaced.
+	 * <p>
+	 * Nodes are recycled on a free list in the same way: the
+	 * consumer links the nodes it took back on as a whole, and a
+	 * poster takes the whole free list with one exchange, keeps
+	 * one node and puts the rest back, linking on again whatever
+	 * was handed back in between. A poster which finds the list
+	 * empty, because another one holds it, allocates a node.
+	 * Once the list has grown to the number of posts in flight,
+	 * posting does not allocate.
+	 * </p>
+	 */
+	class PostQueue
+	{
+	public:
+		PostQueue();
+
+		/**
+		 * Deletes everything that was posted but not taken.
+		 */
+		~PostQueue();
+
+		/**
+		 * Posts an input event. Safe to call from any thread.
+		 */
+		void post(const InputEvent &e);
+
+		/**
+		 * Posts a command. The queue owns the command until it
+		 * has been taken. Safe to call from any thread.
+		 */
+		void post(util::Command *command);
+
+		/**
+		 * Takes everything posted so far. Input is stamped with
+		 * time and pushed onto input, and commands are executed
+		 * and deleted, all in posting order. Only one thread may
+		 * call this.
+		 * @return
+		 *	the number of items taken.
+		 */
+		int take(InputQueue &input, float time);
+	private:
+		PostQueue(const PostQueue &rhs);
+		PostQueue& operator=(const PostQueue &rhs);
+
+		class Node
+		{
+		public:
+			Node *next;
+			InputEvent event;
+			util::Command *command;
+		};
+
+		Node * allocate();
+		void recycle(Node *first, Node *last);
+		void push(Node *node);
+		static void link(void * volatile *target, Node *first, Node *last);
+		static Node * reverse(Node *list);
+		static void destroy(Node *list);
+
+		Node * volatile head;
+		Node * volatile freeList;
+	};
+}
+
+#endif
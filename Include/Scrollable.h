@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SCROLLABLE_H
+#define SCROLLABLE_H
+
+#include "./Pointers.h"
+#include "./util/Dimension.h"
+#include "./util/Rectangle.h"
+
+namespace ui
+{
+	/**
+	 * Scrollable interface.
+	 * Components implementing this interface can be shown in a
+	 * ScrollPane without being laid out and painted in full. The
+	 * ScrollPane asks the Scrollable for the (estimated) size of its
+	 * content to size the scrollbars, and tells it which part of the
+	 * content is visible. The Scrollable is then expected to only lay
+	 * out and paint the Components intersecting that viewport.
+	 */
+	class Scrollable
+	{
+	public:
+		/**
+		 * Returns the size of the complete content. This
+		 * may be an estimate, it is only used to size the
+		 * scrollbars and to translate scroll values into offsets.
+		 */
+		virtual const util::Dimension getScrollableSize() const = 0;
+
+		/**
+		 * Returns the size the viewport on this content
+		 * would like to have. This is used instead of the
+		 * preferred size of the content.
+		 */
+		virtual const util::Dimension getPreferredViewportSize() const = 0;
+
+		/**
+		 * Sets the visible part of the content. 
+		 * @param
+		 *	viewport the visible rectangle, in the coordinate
+		 *	space of the content.
+		 */
+		virtual void setViewport(const util::Rectangle &viewport) = 0;
+
+		virtual ~Scrollable() {};
+	};
+}
+
+#endif
@@ -30,6 +30,7 @@
 #include "./Component.h"
 #include "./event/MouseEvent.h"
 #include "./FocusManager.h"
+#include <cstring>
 
 namespace ui
 {
@@ -43,19 +44,48 @@ namespace ui
 		// you have specified an invalid render mode.
 		assert(m == NORMAL || m == SELECTION);
 
+		// the picking image is drawn with the OpenGL context
+		// current, so this is where new colors are read back.
+		if(m == SELECTION && unmeasured)
+		{
+			measureColors();
+		}
 		mode = m;
 	}
 
-	void SelectionManager::beginUpdate(int x, int y)
+	void SelectionManager::beginUpdate(int pointer, int x, int y)
 	{
-		mouseX = x;
-		mouseY = y;
+		PointerState &state = pointers[pointer];
+		state.x = x;
+		state.y = y;
+
+		if(state.captureComponent != 0)
+		{
+			// the captured Component gets everything anyway, so the
+			// picking image is not needed to know if we're still in it.
+			const util::Point screen(state.captureComponent->getLocationOnScreen());
+			const util::Rectangle &bounds = state.captureComponent->getBounds();
+			util::Rectangle rec(screen.x,screen.y,bounds.width,bounds.height);
+
+			state.tempComponent = rec.contains(x,y) ? state.captureComponent : 0;
+			return;
+		}
+
+		std::vector<Pick>::const_iterator iter;
+		for(iter = picks.begin(); iter != picks.end(); ++iter)
+		{
+			if((*iter).x == x && (*iter).y == y)
+			{
+				state.tempComponent = (*iter).comp;
+				return;
+			}
+		}
 
 	//	if(tempComponent != 0)
 	//	{
 	//		if(!tempComponent->getBounds().contains(x,y))
 	//		{
-				tempComponent = getComponentAt(x,y);
+				state.tempComponent = getComponentAt(x,y);
 	//		}
 	//	}
 	//	else
@@ -64,28 +94,29 @@ namespace ui
 	//	}
 	}
 
-	SelectionManager::SelectionManager()
-		:	mouseX(0),
-			mouseY(0),
-			lastX(0),
-			lastY(0),
-			foundComponent(0),
+	SelectionManager::PointerState::PointerState()
+		:	foundComponent(0),
 			tempComponent(0),
 			hoverOverComponent(0),
-			pressed(false)
+			captureComponent(0),
+			pressed(false),
+			buttonPressed(-1),
+			x(0),
+			y(0),
+			lastX(0),
+			lastY(0)
 	{
+	}
 
-		glGenTextures(1,&textureId);
-		glBindTexture(GL_TEXTURE_2D,textureId);
-			
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, textureWidth, textureHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, texture);
-			
-		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
-		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
-//		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,GL_NEAREST);
-//		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,GL_LINEAR);
-		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	SelectionManager::SelectionManager()
+		:	revision(0),
+			idCounter(0),
+			mode(NORMAL),
+			textureId(0),
+			unmeasured(false)
+	{
+		// no OpenGL here, the texture is made by measureColors.
+		std::memset(texture,0,sizeof(texture));
 	}
 
 	SelectionManager::~SelectionManager()
@@ -99,7 +130,8 @@ namespace ui
 
 		glGetIntegerv(GL_VIEWPORT,viewport);
 
-		glReadPixels(x,viewport[3]-y,1,1,GL_RGB,GL_UNSIGNED_BYTE,static_cast<void *>(pixel));
+		// the row of pixels y is the one below viewport[3] - y.
+		glReadPixels(x,viewport[3]-1-y,1,1,GL_RGB,GL_UNSIGNED_BYTE,static_cast<void *>(pixel));
 
 		std::vector<ColorRegisterValue>::const_iterator iter;
 
@@ -140,101 +172,232 @@ namespace ui
 	}
 
 	
-	void SelectionManager::mouseMotion(int x, int y)
+	void SelectionManager::pickAll(const std::vector<util::Point> &locations)
+	{
+		picks.clear();
+
+		GLint viewport[4];
+		glGetIntegerv(GL_VIEWPORT,viewport);
+
+		std::vector<IntegerColor> &pixels = pickColors;
+		pixels.clear();
+
+		std::vector<util::Point>::const_iterator location;
+		for(location = locations.begin(); location != locations.end(); ++location)
+		{
+			std::vector<Pick>::const_iterator pick;
+			for(pick = picks.begin(); pick != picks.end(); ++pick)
+			{
+				if((*pick).x == (*location).x && (*pick).y == (*location).y)
+				{
+					break;
+				}
+			}
+
+			if(pick == picks.end())
+			{
+				GLubyte pixel[3];
+				glReadPixels((*location).x,viewport[3]-1-(*location).y,1,1,GL_RGB,GL_UNSIGNED_BYTE,static_cast<void *>(pixel));
+
+				picks.push_back(Pick((*location).x,(*location).y));
+				pixels.push_back(IntegerColor(pixel[0],pixel[1],pixel[2]));
+			}
+		}
+
+		// one pass over the register for all pointers, instead of one for each.
+		std::size_t found = 0;
+		std::vector<ColorRegisterValue>::const_iterator iter;
+		for(iter = colorRegister.begin(); iter != colorRegister.end() && found < picks.size(); ++iter)
+		{
+			for(std::size_t i = 0; i < picks.size(); ++i)
+			{
+				const IntegerColor &pixel = pixels[i];
+				if(picks[i].comp == 0 &&
+					(((*iter).color.red == pixel.red && (*iter).color.green == pixel.green && (*iter).color.blue == pixel.blue) ||
+					((*iter).textureColor.red == pixel.red && (*iter).textureColor.green == pixel.green && (*iter).textureColor.blue == pixel.blue)))
+				{
+					picks[i].comp = (*iter).comp;
+					++found;
+				}
+			}
+		}
+	}
+
+	void SelectionManager::clearPicks()
+	{
+		picks.clear();
+	}
+
+	void SelectionManager::componentsChanged()
+	{
+		++revision;
+	}
+
+	std::size_t SelectionManager::getRevision() const
+	{
+		return revision;
+	}
+	
+	void SelectionManager::mouseMotion(int pointer, int x, int y)
 	{
-		if(foundComponent != 0 && pressed)
+		PointerState &state = pointers[pointer];
+
+		if(state.foundComponent != 0 && state.pressed)
 		{
-			if(lastX == 0 && lastY == 0)
+			if(state.lastX == 0 && state.lastY == 0)
 			{
-				lastX = x;
-				lastY = y;
+				state.lastX = x;
+				state.lastY = y;
 			}
 
-			int draggedX = x - lastX;
-			int draggedY = y - lastY;
+			int draggedX = x - state.lastX;
+			int draggedY = y - state.lastY;
 
-			event::MouseEvent dragEvent(foundComponent,event::MouseEvent::MOUSE_DRAGGED,draggedX,draggedY,buttonPressed);
-			foundComponent->processMouseEvent(dragEvent);
+			event::MouseEvent dragEvent(state.foundComponent,event::MouseEvent::MOUSE_DRAGGED,draggedX,draggedY,state.buttonPressed,pointer);
+			state.foundComponent->processMouseEvent(dragEvent);
 
-			lastX = x;
-			lastY = y;
+			state.lastX = x;
+			state.lastY = y;
 		}
 
-		if(foundComponent != 0)
+		if(state.foundComponent != 0)
 		{
-			event::MouseEvent motionEvent(foundComponent,event::MouseEvent::MOUSE_MOTION,x,y,0);
-			foundComponent->processMouseEvent(motionEvent);
+			event::MouseEvent motionEvent(state.foundComponent,event::MouseEvent::MOUSE_MOTION,x,y,0,pointer);
+			state.foundComponent->processMouseEvent(motionEvent);
 		}
 
 		
 
-		if(tempComponent != hoverOverComponent)
+		if(state.tempComponent != state.hoverOverComponent)
 		{
-			if(hoverOverComponent != 0)
+			if(state.hoverOverComponent != 0)
 			{
-				event::MouseEvent exitEvent(hoverOverComponent,event::MouseEvent::MOUSE_EXITED,mouseX,mouseY,0);
-				hoverOverComponent->processMouseEvent(exitEvent);
+				event::MouseEvent exitEvent(state.hoverOverComponent,event::MouseEvent::MOUSE_EXITED,state.x,state.y,0,pointer);
+				state.hoverOverComponent->processMouseEvent(exitEvent);
 			}
 
-			if(tempComponent != 0)
+			if(state.tempComponent != 0)
 			{
 				// send enter to f
-				event::MouseEvent enterEvent(tempComponent,event::MouseEvent::MOUSE_ENTERED,mouseX,mouseY,0);
-				tempComponent->processMouseEvent(enterEvent);
+				event::MouseEvent enterEvent(state.tempComponent,event::MouseEvent::MOUSE_ENTERED,state.x,state.y,0,pointer);
+				state.tempComponent->processMouseEvent(enterEvent);
 			}
 
-			hoverOverComponent = tempComponent;
+			state.hoverOverComponent = state.tempComponent;
 		}
-		else if(tempComponent == 0)
+		else if(state.tempComponent == 0)
 		{
-			if(hoverOverComponent != 0)
+			if(state.hoverOverComponent != 0)
 			{
-				event::MouseEvent exitEvent(hoverOverComponent,event::MouseEvent::MOUSE_EXITED,mouseX,mouseY,0);
-				hoverOverComponent->processMouseEvent(exitEvent);
+				event::MouseEvent exitEvent(state.hoverOverComponent,event::MouseEvent::MOUSE_EXITED,state.x,state.y,0,pointer);
+				state.hoverOverComponent->processMouseEvent(exitEvent);
 			}
 		}
 	}
 	
-	void SelectionManager::mousePressed(int button)
+	void SelectionManager::mousePressed(int pointer, int button)
 	{
-		foundComponent = tempComponent;
+		PointerState &state = pointers[pointer];
+
+		state.foundComponent = state.tempComponent;
+		// set before the event goes out, so the Component can capture the pointer.
+		state.pressed = true;
+		state.buttonPressed = button;
 		
-		if(foundComponent != 0)
+		if(state.foundComponent != 0)
 		{
-			event::MouseEvent event(foundComponent,event::MouseEvent::MOUSE_PRESSED,mouseX,mouseY,button);
-			foundComponent->processMouseEvent(event);
+			event::MouseEvent event(state.foundComponent,event::MouseEvent::MOUSE_PRESSED,state.x,state.y,button,pointer);
+			state.foundComponent->processMouseEvent(event);
 
 			// also set focus
-			if(foundComponent->hasFocusListener())
-				FocusManager::getInstance().setPermanentFocusOwner(foundComponent);
+			if(state.foundComponent->hasFocusListener())
+				FocusManager::getInstance().setPermanentFocusOwner(state.foundComponent);
 		}
 		else
 		{
 			FocusManager::getInstance().setPermanentFocusOwner(0);
 		}
-		pressed = true;
-		buttonPressed = button;
 	}
 	
-	void SelectionManager::mouseReleased(int button)
+	void SelectionManager::mouseReleased(int pointer, int button)
 	{
-		if(foundComponent != 0)
+		PointerState &state = pointers[pointer];
+
+		if(state.foundComponent != 0)
 		{
-			event::MouseEvent event(foundComponent,event::MouseEvent::MOUSE_RELEASED,mouseX,mouseY,button);
-			foundComponent->processMouseEvent(event);
+			event::MouseEvent event(state.foundComponent,event::MouseEvent::MOUSE_RELEASED,state.x,state.y,button,pointer);
+			state.foundComponent->processMouseEvent(event);
 
 			// check if we're still in the Component by comparing the hoverOverComponent with foundComponent.
-			if(foundComponent == hoverOverComponent)
+			if(state.foundComponent == state.hoverOverComponent)
 			{
 				// yes, we count this as an official click!
-				event::MouseEvent mouseClickEvent(foundComponent,event::MouseEvent::MOUSE_CLICKED,mouseX,mouseY,button);
-				foundComponent->processMouseEvent(mouseClickEvent);
+				event::MouseEvent mouseClickEvent(state.foundComponent,event::MouseEvent::MOUSE_CLICKED,state.x,state.y,button,pointer);
+				state.foundComponent->processMouseEvent(mouseClickEvent);
 			}
 		}
-		pressed = false;
-		lastX = 0;
-		lastY = 0;
-		buttonPressed = -1;
+		state.pressed = false;
+		state.lastX = 0;
+		state.lastY = 0;
+		state.buttonPressed = -1;
+		state.captureComponent = 0;
+	}
+
+	void SelectionManager::removePointer(int pointer)
+	{
+		std::map<int,PointerState>::iterator iter = pointers.find(pointer);
+
+		if(iter != pointers.end())
+		{
+			PointerState &state = iter->second;
+			if(state.hoverOverComponent != 0)
+			{
+				event::MouseEvent exitEvent(state.hoverOverComponent,event::MouseEvent::MOUSE_EXITED,state.x,state.y,0,pointer);
+				state.hoverOverComponent->processMouseEvent(exitEvent);
+			}
+			pointers.erase(iter);
+		}
+	}
+
+	void SelectionManager::setCapture(int pointer, Component* comp)
+	{
+		std::map<int,PointerState>::iterator iter = pointers.find(pointer);
+
+		// capturing without a button held would never be released.
+		if(iter != pointers.end() && iter->second.pressed)
+		{
+			iter->second.captureComponent = comp;
+			if(comp != 0)
+			{
+				iter->second.foundComponent = comp;
+			}
+		}
+	}
+
+	void SelectionManager::releaseCapture(int pointer)
+	{
+		std::map<int,PointerState>::iterator iter = pointers.find(pointer);
+
+		if(iter != pointers.end())
+		{
+			iter->second.captureComponent = 0;
+		}
+	}
+
+	Component* SelectionManager::getCapture(int pointer) const
+	{
+		std::map<int,PointerState>::const_iterator iter = pointers.find(pointer);
+
+		if(iter != pointers.end())
+		{
+			return iter->second.captureComponent;
+		}
+		return 0;
+	}
+
+	bool SelectionManager::isCaptured(int pointer) const
+	{
+		return getCapture(pointer) != 0;
 	}
 
 	void SelectionManager::addComponent(Component* comp)
@@ -247,6 +410,39 @@ namespace ui
 			val.comp = comp;
 		//	pickingList.push_back(std::make_pair<int, Component*>(idCounter,comp));
 
+			// the colors are read back when the picking image
+			// is drawn next, see measureColors.
+			colorRegister.push_back(val);
+			unmeasured = true;
+
+			idCounter++;
+		}
+	}
+
+	void SelectionManager::measureColors()
+	{
+		if(textureId == 0)
+		{
+			glGenTextures(1,&textureId);
+			glBindTexture(GL_TEXTURE_2D,textureId);
+				
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, textureWidth, textureHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, texture);
+				
+			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,GL_LINEAR);
+			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		}
+
+		std::vector<ColorRegisterValue>::iterator iter;
+		for(iter = colorRegister.begin(); iter != colorRegister.end(); ++iter)
+		{
+			ColorRegisterValue &val = *iter;
+			if(val.measured)
+			{
+				continue;
+			}
+
 			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 			glLoadIdentity();
 
@@ -262,11 +458,8 @@ namespace ui
 				
 				//gluOrtho2D(0,800,600,0);
 
-				srand(idCounter*2);
-
-				GLubyte red = rand() % 255;
-				GLubyte green = rand() % 255;
-				GLubyte blue = rand() % 255;
+				GLubyte red, green, blue;
+				getUniqueColor(val.index,red,green,blue);
 
 				glColor3ub(red,green,blue);
 
@@ -342,14 +535,33 @@ namespace ui
 			glPopMatrix();
 			glPopAttrib();
 
-			colorRegister.push_back(val);
-
-			idCounter++;
+			val.measured = true;
 		}
+		unmeasured = false;
+	}
+
+	void SelectionManager::getUniqueColor(int id, GLubyte &red, GLubyte &green, GLubyte &blue)
+	{
+		// an odd factor scatters neighbouring ids over the colors
+		// and maps 24 bits onto 24 bits one to one. One is added
+		// first, so no id gets black, the empty background.
+		unsigned int color = ((static_cast<unsigned int>(id) + 1) * 2654435761u) & 0xffffff;
+		red = static_cast<GLubyte>(color >> 16);
+		green = static_cast<GLubyte>(color >> 8);
+		blue = static_cast<GLubyte>(color);
 	}
 
 	void SelectionManager::removeComponent(Component* comp)
 	{
+		std::map<int,PointerState>::iterator pointer;
+		for(pointer = pointers.begin(); pointer != pointers.end(); ++pointer)
+		{
+			if(pointer->second.captureComponent == comp)
+			{
+				pointer->second.captureComponent = 0;
+			}
+		}
+
 		std::vector<ColorRegisterValue>::iterator iter;
 
 		for(iter = colorRegister.begin(); iter != colorRegister.end(); ++iter)
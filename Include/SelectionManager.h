@@ -31,6 +31,9 @@
 
 #include "./Pointers.h"
 #include "./Config.h"
+#include "./util/Point.h"
+#include "./UiContext.h"
+#include <map>
 
 namespace ui
 {
@@ -51,8 +54,26 @@ namespace ui
 	 * MouseClicked, MousePressed, MouseReleased:
 	 * when a mouse is pressed, the current location is probed for a Component,
 	 * and if found, events are sent.
+	 * Capture:
+	 * while a button is held, the Component that was pressed can capture
+	 * the mouse. Until the button is released, it receives every drag,
+	 * motion and release event, and the Component under the mouse is no
+	 * longer picked. Only the bounds of the captured Component are checked
+	 * to send entered and exited events, so Gui can skip the picking pass
+	 * for as long as the capture lasts.
+	 * Pointers:
+	 * all of the above is kept per pointer, identified by an integer which
+	 * the MouseEvents carry. The mouse is pointer 0, touches and the mice
+	 * of a split screen use ids of their own, and each of them hovers,
+	 * presses and captures independently. pickAll resolves the locations
+	 * of all pointers in a single pass over the registered Components.
+	 * Colors:
+	 * the color of a Component follows from its id through getUniqueColor.
+	 * What OpenGL makes of it is only read back the first time the picking
+	 * image is drawn after the Component was registered, so registering
+	 * makes no OpenGL calls and Components can be built on any thread.
 	 * @note
-	 *	This is a Singleton object.
+	 *	This is a Singleton object, one per UiContext.
 	 */
 
 	class SelectionManager
@@ -109,12 +130,23 @@ namespace ui
 		 */
 		int getComponentId(const Component* comp) const;
 
+		/**
+		 * Returns the color the Component with the given id is
+		 * drawn with in the picking image. Different ids below
+		 * 2^24 - 1 get different colors, and none of them is black.
+		 * @param
+		 *	id identifier returned by getComponentId.
+		 */
+		static void getUniqueColor(int id, GLubyte &red, GLubyte &green, GLubyte &blue);
 
 		/**
-		 * Begins the update.
-		 * Should be called at the start of a frame.
+		 * Begins the update of a pointer.
+		 * Should be called at the start of a frame, and for every
+		 * location the pointer moved to.
+		 * @param
+		 *	pointer Id of the pointer, 0 is the mouse.
 		 */
-		void beginUpdate(int x, int y);
+		void beginUpdate(int pointer, int x, int y);
 
 		/**
 		 * Returns the Component located at x,y.
@@ -122,37 +154,103 @@ namespace ui
 		 */
 		Component* getComponentAt(int x, int y) const;
 
+		/**
+		 * Picks the Components at all locations in one pass,
+		 * reading the picking image once for each location and
+		 * going over the registered Components only once. The
+		 * results are used by beginUpdate until clearPicks is
+		 * called, which has to be done before the picking image
+		 * changes.
+		 */
+		void pickAll(const std::vector<util::Point> &locations);
+
+		/**
+		 * Forgets the Components found by pickAll.
+		 */
+		void clearPicks();
+
+		/**
+		 * Tells the SelectionManager that Components moved,
+		 * changed size, or were added, removed, shown or hidden,
+		 * so the picking image drawn before is out of date.
+		 * Components call this from invalidate and setLocation.
+		 */
+		void componentsChanged();
+
+		/**
+		 * Returns a number which changes with every call to
+		 * componentsChanged, so a picking image and the picks
+		 * made from it can be checked for being up to date.
+		 */
+		std::size_t getRevision() const;
+
 		/**
 		 * Input feeds.
-		 * Inputs mouse motion to the SelectionManager.
+		 * Inputs pointer motion to the SelectionManager.
 		 */
-		void mouseMotion(int x, int y);
+		void mouseMotion(int pointer, int x, int y);
 		
 		/**
 		 * Input feeds.
-		 * A mouse button went down.
+		 * A button of the pointer went down.
 		 */
-		void mousePressed(int button);
+		void mousePressed(int pointer, int button);
 		
 		/**
 		 * Input feeds.
-		 * A mouse button was released (up).
+		 * A button of the pointer was released (up).
+		 */
+		void mouseReleased(int pointer, int button);
+
+		/**
+		 * Input feeds.
+		 * The pointer is gone, like a touch which ended. The
+		 * Component it hovered over gets an exited event.
+		 */
+		void removePointer(int pointer);
+
+		/**
+		 * Captures the pointer for the given Component until
+		 * its button is released or releaseCapture is called.
+		 * This only has effect while a button of the pointer
+		 * is held.
+		 * @param
+		 *	pointer Id of the pointer, see MouseEvent::getPointer.
+		 * @param
+		 *	comp Component which receives the pointer's events.
+		 */
+		void setCapture(int pointer, Component* comp);
+
+		/**
+		 * Releases the capture of the pointer, if any. The next
+		 * update picks the Component under it again.
+		 */
+		void releaseCapture(int pointer);
+
+		/**
+		 * Returns the Component which captured the pointer, or
+		 * NULL(0) if there is none.
+		 */
+		Component* getCapture(int pointer) const;
+
+		/**
+		 * Returns true if a Component captured the pointer.
 		 */
-		void mouseReleased(int button);
+		bool isCaptured(int pointer) const;
 
 		/**
 		 * Returns an instance of the SelectionManager.
 		 */
 		static SelectionManager& getInstance()
 		{
-			static SelectionManager obj;
-			return obj;
+			return UiContext::getCurrent().getSelectionManager();
 		}
 	private:
 		SelectionManager();
 		~SelectionManager();
 		SelectionManager(const SelectionManager&);
 		SelectionManager& operator=(const SelectionManager&);
+		friend class ui::UiContext;
 
 		class IntegerColor
 		{
@@ -166,29 +264,60 @@ namespace ui
 		class ColorRegisterValue
 		{
 		public:
-			ColorRegisterValue() : color(0,0,0), textureColor(0,0,0) {};
+			ColorRegisterValue() : color(0,0,0), textureColor(0,0,0), measured(false) {};
 			int index;
 			Component *comp;
 			IntegerColor color;
 			IntegerColor textureColor;
+			bool measured;
+		};
+
+		/**
+		 * Reads back the colors of the Components registered
+		 * since the last time, with the OpenGL context current.
+		 */
+		void measureColors();
+
+		/**
+		 * What the SelectionManager knows of one pointer.
+		 */
+		class PointerState
+		{
+		public:
+			PointerState();
+			Component *foundComponent, *tempComponent, *hoverOverComponent;
+			Component *captureComponent;
+			bool pressed;
+			int buttonPressed;
+			int x, y;
+			int lastX, lastY;
+		};
+
+		class Pick
+		{
+		public:
+			Pick(int px, int py) : x(px), y(py), comp(0) {};
+			int x;
+			int y;
+			Component *comp;
 		};
 
 		std::vector<ColorRegisterValue> colorRegister;
+		std::map<int,PointerState> pointers;
+		std::vector<Pick> picks;
+		std::vector<IntegerColor> pickColors;
+		std::size_t revision;
 
 		//std::vector< std::pair<int, Component*> > pickingList;
 		//std::vector< std::pair<util::Color, util::Color> > colorRegister;
 		int idCounter;
 		int mode;
-		Component* foundComponent,*tempComponent, *hoverOverComponent;
-		bool pressed;
-		int buttonPressed;
-		int mouseX, mouseY;
-		int lastX, lastY;
 
 		static const int textureWidth = 64;
 		static const int textureHeight = 64;
 		GLubyte texture[textureWidth][textureHeight][3];
 		GLuint textureId;
+		bool unmeasured;
 	};
 }
 
@@ -32,6 +32,7 @@
 #include "./theme/Theme.h"
 #include "./theme/DefaultTheme.h"
 #include "./theme/BasicTheme.h"
+#include "./UiContext.h"
 
 namespace ui
 {
@@ -51,19 +52,19 @@ namespace ui
 		const theme::Theme* getTheme() const;
 
 		/**
-		 * Returns an instance of this class.
+		 * Returns the instance of the current UiContext.
 		 * @note this is part of the Singleton.
 		 */
 		static ThemeManager &getInstance()
 		{
-			static ThemeManager obj;
-			return obj;
+			return UiContext::getCurrent().getThemeManager();
 		}
 	private:
 		ThemeManager();
 		~ThemeManager();
 		ThemeManager(const ThemeManager&);
 		ThemeManager& operator=(const ThemeManager&);
+		friend class ui::UiContext;
 		theme::DefaultTheme defaultTheme;
 		theme::BasicTheme basicTheme;
 	};
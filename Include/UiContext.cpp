@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./UiContext.h"
+#include "./SelectionManager.h"
+#include "./FocusManager.h"
+#include "./GlyphContext.h"
+#include "./ThemeManager.h"
+#include "./NotificationManager.h"
+#include "./theme/Default/Scheme.h"
+#include "./theme/TextLayoutCache.h"
+
+#ifdef _MSC_VER
+	#define UI_THREAD_LOCAL __declspec(thread)
+#else
+	#define UI_THREAD_LOCAL __thread
+#endif
+
+namespace ui
+{
+	// the context made current on this thread, 0 for the default.
+	static UI_THREAD_LOCAL UiContext *current = 0;
+
+	UiContext::Scope::Scope(UiContext &context)
+		:	previous(current)
+	{
+		current = &context;
+	}
+
+	UiContext::Scope::~Scope()
+	{
+		current = previous;
+	}
+
+// ---------------------------------------------------------------------------
+
+	UiContext::UiContext()
+		:	selectionManager(0),
+			focusManager(0),
+			glyphContext(0),
+			themeManager(0),
+			notificationManager(0),
+			schemeManager(0),
+			textLayoutCache(0)
+	{
+	}
+
+	UiContext::~UiContext()
+	{
+		// managers use each other, so the last one created,
+		// which may use all others, goes first.
+		while(!created.empty())
+		{
+			Destroy destroy = created.back();
+			created.pop_back();
+			destroy(*this);
+		}
+
+		if(current == this)
+		{
+			current = 0;
+		}
+	}
+
+	SelectionManager & UiContext::getSelectionManager()
+	{
+		return get<SelectionManager,&UiContext::selectionManager>();
+	}
+
+	FocusManager & UiContext::getFocusManager()
+	{
+		return get<FocusManager,&UiContext::focusManager>();
+	}
+
+	GlyphContext & UiContext::getGlyphContext()
+	{
+		return get<GlyphContext,&UiContext::glyphContext>();
+	}
+
+	ThemeManager & UiContext::getThemeManager()
+	{
+		return get<ThemeManager,&UiContext::themeManager>();
+	}
+
+	NotificationManager & UiContext::getNotificationManager()
+	{
+		return get<NotificationManager,&UiContext::notificationManager>();
+	}
+
+	theme::defaulttheme::SchemeManager & UiContext::getSchemeManager()
+	{
+		return get<theme::defaulttheme::SchemeManager,&UiContext::schemeManager>();
+	}
+
+	theme::TextLayoutCache & UiContext::getTextLayoutCache()
+	{
+		return get<theme::TextLayoutCache,&UiContext::textLayoutCache>();
+	}
+
+	NotificationManager * UiContext::findNotificationManager() const
+	{
+		return notificationManager;
+	}
+
+	FocusManager * UiContext::findFocusManager() const
+	{
+		return focusManager;
+	}
+
+	UiContext & UiContext::getCurrent()
+	{
+		if(current != 0)
+		{
+			return *current;
+		}
+		return getDefault();
+	}
+
+	UiContext & UiContext::getDefault()
+	{
+		static UiContext obj;
+		return obj;
+	}
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UICONTEXT_H
+#define UICONTEXT_H
+
+#include "./Pointers.h"
+
+namespace ui
+{
+	class SelectionManager;
+	class FocusManager;
+	class GlyphContext;
+	class ThemeManager;
+	class NotificationManager;
+
+	namespace theme
+	{
+		class TextLayoutCache;
+
+		namespace defaulttheme
+		{
+			class SchemeManager;
+		}
+	}
+
+	/**
+	 * A UiContext owns the managers a user interface works with:
+	 * the SelectionManager, FocusManager, GlyphContext, ThemeManager,
+	 * NotificationManager, SchemeManager and TextLayoutCache. Their
+	 * getInstance functions return the ones of the current context,
+	 * so two contexts share no hover state, focus, fonts or themes.
+	 * <p>
+	 * Every thread has its own current context, which is the default
+	 * context until another one is made current with a Scope. A
+	 * Component is bound to the context that is current when it is
+	 * constructed, may only be used while that context is current,
+	 * and has to be destroyed before it.
+	 * The Gui makes its context current in every call, so independent
+	 * Guis with their own contexts can be updated and laid out on
+	 * different threads at the same time. A context itself is not
+	 * safe to use from two threads at once, and painting still needs
+	 * the OpenGL context of the thread. Building Components and laying
+	 * them out makes no OpenGL calls; picking colors and textures are
+	 * created the first time they are painted.
+	 * </p>
+	 * The managers are created the first time they are used.
+	 */
+	class UiContext
+	{
+	public:
+		/**
+		 * Makes a context current for the lifetime of the Scope,
+		 * and the previous one current again when it ends.
+		 */
+		class Scope
+		{
+		public:
+			explicit Scope(UiContext &context);
+			~Scope();
+		private:
+			Scope(const Scope&);
+			Scope& operator=(const Scope&);
+
+			UiContext *previous;
+		};
+
+		UiContext();
+
+		/**
+		 * Destroys the managers, in the reverse order of their
+		 * creation.
+		 */
+		~UiContext();
+
+		SelectionManager & getSelectionManager();
+		FocusManager & getFocusManager();
+		GlyphContext & getGlyphContext();
+		ThemeManager & getThemeManager();
+		NotificationManager & getNotificationManager();
+		theme::defaulttheme::SchemeManager & getSchemeManager();
+		theme::TextLayoutCache & getTextLayoutCache();
+
+		/**
+		 * Returns the NotificationManager if it has been created,
+		 * without creating it.
+		 */
+		NotificationManager * findNotificationManager() const;
+
+		/**
+		 * Returns the FocusManager if it has been created,
+		 * without creating it.
+		 */
+		FocusManager * findFocusManager() const;
+
+		/**
+		 * Returns the context current on the calling thread.
+		 */
+		static UiContext & getCurrent();
+
+		/**
+		 * Returns the context used by threads which did not
+		 * make one current.
+		 */
+		static UiContext & getDefault();
+	private:
+		UiContext(const UiContext&);
+		UiContext& operator=(const UiContext&);
+
+		typedef void (*Destroy)(UiContext&);
+
+		template<typename T, T* UiContext::*slot>
+		T & get()
+		{
+			if(this->*slot == 0)
+			{
+				// managers which use others while they are created,
+				// such as the themes loading their fonts, get the
+				// ones of this context.
+				Scope scope(*this);
+				this->*slot = new T();
+				created.push_back(&UiContext::destroy<T,slot>);
+			}
+			return *(this->*slot);
+		}
+
+		template<typename T, T* UiContext::*slot>
+		static void destroy(UiContext &context)
+		{
+			// cleared first, so the others no longer find it
+			// while it is being destroyed.
+			T *obj = context.*slot;
+			context.*slot = 0;
+			delete obj;
+		}
+
+		SelectionManager *selectionManager;
+		FocusManager *focusManager;
+		GlyphContext *glyphContext;
+		ThemeManager *themeManager;
+		NotificationManager *notificationManager;
+		theme::defaulttheme::SchemeManager *schemeManager;
+		theme::TextLayoutCache *textLayoutCache;
+
+		std::vector<Destroy> created;
+	};
+}
+
+#endif
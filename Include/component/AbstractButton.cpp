@@ -38,7 +38,8 @@ namespace ui
 			selectedIcon(0),
 			disabledDefaultIcon(0),
 			disabledSelectedIcon(0),
-			selected(false)
+			selected(false),
+			textRevision(0)
 	{
 		setHorizontalAlignment(Component::CENTER);
 		setVerticalAlignment(Component::CENTER);
@@ -119,6 +120,7 @@ namespace ui
 	void AbstractButton::setText(const std::string &value)
 	{
 		str = value;
+		++textRevision;
 		event::PropertyEvent e(this,event::PropertyEvent::SPECIAL,AbstractButton::TEXTCHANGE);
 		processPropertyEvent(e);
 	//	invalidate();
@@ -129,6 +131,16 @@ namespace ui
 		return str;
 	}
 
+	std::size_t AbstractButton::getTextRevision() const
+	{
+		return textRevision;
+	}
+
+	theme::TextLayout & AbstractButton::getTextLayout() const
+	{
+		return textLayout;
+	}
+
 	void AbstractButton::setSelected(bool value)
 	{
 		selected = value;
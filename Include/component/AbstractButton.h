@@ -32,6 +32,7 @@
 #include "../CompoundComponent.h"
 #include "../event/KeyListener.h"
 #include "../event/KeyEvent.h"
+#include "../theme/TextLayout.h"
 
 namespace ui
 {
@@ -102,6 +103,18 @@ namespace ui
 		 */
 		const std::string & getText() const;
 
+		/**
+		 * Returns a number which changes whenever the
+		 * text changes.
+		 */
+		std::size_t getTextRevision() const;
+
+		/**
+		 * Returns the layout of the text, which is
+		 * maintained by the theme.
+		 */
+		theme::TextLayout & getTextLayout() const;
+
 
 		/**
 		 * Sets the horizontal alignment of the text.
@@ -199,6 +212,8 @@ namespace ui
 		bool selected;
 
 		std::string str;
+		std::size_t textRevision;
+		mutable theme::TextLayout textLayout;
 		mutable int horizontalAlignment;
 		mutable int verticalAlignment;
 
@@ -44,7 +44,7 @@ namespace ui
 	{
 		setThemeName("Button");
 		setDefaultIcon(icon);
-		addMouseListener(this);
+		addMouseListener(this,event::MouseEvent::MOUSE_PRESSED_MASK|event::MouseEvent::MOUSE_RELEASED_MASK);
 		addFocusListener(this);
 		setText(label);
 	}
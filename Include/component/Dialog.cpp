@@ -28,6 +28,7 @@
 #include "./Dialog.h"
 #include "../event/PropertyEvent.h"
 #include "../event/WindowEvent.h"
+#include "../SelectionManager.h"
 
 namespace ui
 {
@@ -113,7 +114,7 @@ namespace ui
 			parent->removeMouseListener(this);
 		}
 		parent = d;
-		d->addMouseListener(this);
+		d->addMouseListener(this,event::MouseEvent::MOUSE_PRESSED_MASK|event::MouseEvent::MOUSE_RELEASED_MASK|event::MouseEvent::MOUSE_DRAGGED_MASK);
 	}
 
 	Dialog * Dialog::DialogListener::getParent() const
@@ -147,6 +148,7 @@ namespace ui
 			if(!insets.contains(x,y))
 			{
 				resizing = true;
+				parent->getContext()->getSelectionManager().setCapture(e.getPointer(),parent);
 			}
 		}
 	}
@@ -26,6 +26,7 @@
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include "./Knob.h"
+#include "../SelectionManager.h"
 
 namespace ui
 {
@@ -35,7 +36,7 @@ namespace ui
 	{
 		setThemeName("Knob");
 		setSize(10,10);
-		addMouseListener(this);
+		addMouseListener(this,event::MouseEvent::MOUSE_PRESSED_MASK|event::MouseEvent::MOUSE_RELEASED_MASK);
 	}
 
 	void Knob::setKnobSize(int s)
@@ -63,6 +64,8 @@ namespace ui
 	void Knob::mousePressed(const event::MouseEvent &e)
 	{
 		dragging = true;
+		// the knob follows the mouse until it is released.
+		getContext()->getSelectionManager().setCapture(e.getPointer(),this);
 		setChanged();
 		notifyObserver();
 	}
@@ -30,11 +30,15 @@
 namespace ui
 {
 	Label::Label(Icon *icon, const std::string &label)
+		:	textRevision(0),
+			wordWrap(false)
 	{
 		init(icon,label);
 	}
 
 	Label::Label(const std::string &label)
+		:	textRevision(0),
+			wordWrap(false)
 	{
 		init(0,label);
 	}
@@ -58,9 +62,20 @@ namespace ui
 		return margin;
 	}
 
+	void Label::setWordWrap(bool wrap)
+	{
+		wordWrap = wrap;
+	}
+
+	bool Label::isWordWrap() const
+	{
+		return wordWrap;
+	}
+
 	void Label::setText(const std::string &label)
 	{
 		text = label;
+		++textRevision;
 	}
 
 	const std::string & Label::getText() const
@@ -68,6 +83,16 @@ namespace ui
 		return text;
 	}
 
+	std::size_t Label::getTextRevision() const
+	{
+		return textRevision;
+	}
+
+	theme::TextLayout & Label::getTextLayout() const
+	{
+		return textLayout;
+	}
+
 	void Label::setHorizontalAlignment(int alignment)
 	{
 		horizontalAlignment = alignment;
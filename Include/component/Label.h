@@ -29,6 +29,7 @@
 #define LABEL_H
 
 #include "../Component.h"
+#include "../theme/TextLayout.h"
 
 namespace ui
 {
@@ -41,6 +42,18 @@ namespace ui
 		void setText(const std::string &label);
 		const std::string & getText() const;
 
+		/**
+		 * Returns a number which changes whenever the
+		 * text changes.
+		 */
+		std::size_t getTextRevision() const;
+
+		/**
+		 * Returns the layout of the text, which is
+		 * maintained by the theme.
+		 */
+		theme::TextLayout & getTextLayout() const;
+
 		void setIcon(Icon *icon);
 		Icon * getIcon() const;
 
@@ -61,10 +74,24 @@ namespace ui
 		 */
 		const util::Insets & getMargin() const;
 
+		/**
+		 * Sets whether text which is too wide is wrapped
+		 * between words, or cut off.
+		 */
+		void setWordWrap(bool wrap);
+
+		/**
+		 * Returns true if text which is too wide is wrapped
+		 * between words.
+		 */
+		bool isWordWrap() const;
+
 	private:
 		void init(Icon *icon, const std::string &label);
 
 		std::string text;
+		std::size_t textRevision;
+		mutable theme::TextLayout textLayout;
 
 		Icon *icon;
 
@@ -72,6 +99,7 @@ namespace ui
 		mutable int horizontalAlignment;
 
 		util::Insets margin;
+		bool wordWrap;
 	};
 }
 
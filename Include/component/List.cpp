@@ -0,0 +1,527 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./List.h"
+#include "./ListModel.h"
+#include "../event/ListDataEvent.h"
+#include "../event/ChangeEvent.h"
+#include "../event/ChangeListener.h"
+#include "../event/MouseEvent.h"
+#include "../util/Insets.h"
+
+namespace ui
+{
+	List::List(ListModel *m)
+		:	model(0),
+			fixedCellHeight(-1),
+			estimatedCellHeight(0),
+			visibleRowCount(8),
+			selectedIndex(-1),
+			prototype(""),
+			prototypeSize(-1,-1),
+			prototypeFont(0),
+			hasViewport(false),
+			listLayout(this),
+			cellListener(this)
+	{
+		setThemeName("List");
+		setLayout(&listLayout);
+
+		// the pool always holds at least one cell, the Container
+		// is only laid out when it has children.
+		getCell(0);
+
+		setModel(m);
+	}
+
+	List::~List()
+	{
+		if(model != 0)
+		{
+			model->removeListDataListener(this);
+		}
+
+		removeAll();
+
+		std::vector<Cell>::iterator iter;
+		for(iter = cells.begin(); iter != cells.end(); ++iter)
+		{
+			delete iter->label;
+		}
+	}
+
+	void List::setModel(ListModel *m)
+	{
+		if(model != 0)
+		{
+			model->removeListDataListener(this);
+		}
+
+		model = m;
+		selectedIndex = -1;
+
+		if(model != 0)
+		{
+			model->addListDataListener(this);
+		}
+
+		resetRowHeights();
+		refreshCells();
+		invalidate();
+	}
+
+	ListModel * List::getModel() const
+	{
+		return model;
+	}
+
+	void List::setFixedCellHeight(int height)
+	{
+		fixedCellHeight = height;
+		resetRowHeights();
+		invalidate();
+	}
+
+	int List::getFixedCellHeight() const
+	{
+		return fixedCellHeight;
+	}
+
+	void List::setVisibleRowCount(int rows)
+	{
+		visibleRowCount = rows;
+		invalidate();
+	}
+
+	int List::getVisibleRowCount() const
+	{
+		return visibleRowCount;
+	}
+
+	void List::setSelectedIndex(int index)
+	{
+		if(index == selectedIndex)
+		{
+			return;
+		}
+
+		selectedIndex = index;
+
+		std::vector<Cell>::iterator iter;
+		for(iter = cells.begin(); iter != cells.end(); ++iter)
+		{
+			setCellSelected(*iter, iter->row != -1 && iter->row == selectedIndex);
+		}
+
+		fireSelectionChanged();
+	}
+
+	void List::fireSelectionChanged()
+	{
+		event::ChangeEvent e(this,event::ChangeEvent::SELECTION);
+
+		event::ChangeListenerList::const_iterator listener;
+		for(listener = changeListeners.begin(); listener != changeListeners.end(); ++listener)
+		{
+			(*listener)->stateChanged(e);
+		}
+	}
+
+	int List::getSelectedIndex() const
+	{
+		return selectedIndex;
+	}
+
+	void List::addChangeListener(event::ChangeListener *l)
+	{
+		changeListeners.push_back(l);
+	}
+
+	void List::removeChangeListener(event::ChangeListener *l)
+	{
+		changeListeners.erase(std::remove(changeListeners.begin(),changeListeners.end(),l),changeListeners.end());
+	}
+
+	int List::locationToIndex(int y) const
+	{
+		int rows = (model != 0) ? model->getSize() : 0;
+
+		if(y < 0 || rows == 0)
+		{
+			return -1;
+		}
+
+		int index;
+		if(fixedCellHeight > 0)
+		{
+			index = y / fixedCellHeight;
+		}
+		else
+		{
+			index = static_cast<int>(rowHeights.find(y));
+		}
+		return index < rows ? index : -1;
+	}
+
+	const util::Rectangle List::getCellBounds(int index) const
+	{
+		int height = (fixedCellHeight > 0) ? fixedCellHeight : rowHeights.get(index);
+		return util::Rectangle(0,getRowTop(index),getBounds().width,height);
+	}
+
+	int List::getRowTop(int index) const
+	{
+		if(fixedCellHeight > 0)
+		{
+			return index * fixedCellHeight;
+		}
+		return rowHeights.getPrefixSum(index);
+	}
+
+	int List::getRowHeight(int index)
+	{
+		if(fixedCellHeight > 0)
+		{
+			return fixedCellHeight;
+		}
+
+		if(!measured[index])
+		{
+			measured[index] = 1;
+			rowHeights.set(index,measureRow(index));
+		}
+		return rowHeights.get(index);
+	}
+
+	int List::measureRow(int index) const
+	{
+		prototype.setText(index >= 0 ? model->getElementAt(index) : std::string(" "));
+		prototype.invalidate();
+		return prototype.getPreferredSize().height;
+	}
+
+	const util::Dimension & List::getPrototypeSize() const
+	{
+		if(prototypeSize.height < 0 || prototypeFont != prototype.getFontHandle())
+		{
+			int rows = (model != 0) ? model->getSize() : 0;
+
+			measureRow(rows > 0 ? 0 : -1);
+			prototypeSize = prototype.getPreferredSize();
+			prototypeFont = prototype.getFontHandle();
+		}
+		return prototypeSize;
+	}
+
+	void List::resetRowHeights()
+	{
+		int rows = (model != 0) ? model->getSize() : 0;
+
+		// the first row serves as the estimate for all
+		// rows which have not been shown yet.
+		prototypeSize.height = -1;
+		estimatedCellHeight = getPrototypeSize().height;
+
+		if(fixedCellHeight > 0)
+		{
+			rowHeights.assign(0,0);
+			measured.clear();
+		}
+		else
+		{
+			rowHeights.assign(rows,estimatedCellHeight);
+			measured.assign(rows,0);
+		}
+	}
+
+	void List::refreshCells()
+	{
+		std::vector<Cell>::iterator iter;
+		for(iter = cells.begin(); iter != cells.end(); ++iter)
+		{
+			iter->row = -1;
+		}
+	}
+
+	List::Cell& List::getCell(std::size_t n)
+	{
+		while(cells.size() <= n)
+		{
+			Cell cell;
+			cell.label = new Label("");
+			cell.row = -1;
+			cell.selected = false;
+
+			cell.label->setVisible(false);
+			cell.label->addMouseListener(&cellListener,event::MouseEvent::MOUSE_PRESSED_MASK);
+
+			cells.push_back(cell);
+			addImpl(cell.label,-1);
+		}
+		return cells[n];
+	}
+
+	void List::setCellSelected(Cell &cell, bool selected)
+	{
+		if(cell.selected != selected)
+		{
+			util::Paint *background(cell.label->getBackground());
+			util::Paint *foreground(cell.label->getForeground());
+			cell.label->setBackground(foreground);
+			cell.label->setForeground(background);
+			cell.selected = selected;
+		}
+	}
+
+	void List::cellPressed(Component *comp)
+	{
+		std::vector<Cell>::const_iterator iter;
+		for(iter = cells.begin(); iter != cells.end(); ++iter)
+		{
+			if(iter->label == comp && iter->row != -1)
+			{
+				setSelectedIndex(iter->row);
+				return;
+			}
+		}
+	}
+
+	void List::layoutCells()
+	{
+		int rows = (model != 0) ? model->getSize() : 0;
+
+		if(fixedCellHeight <= 0 && rowHeights.size() != static_cast<std::size_t>(rows))
+		{
+			// the model changed without telling us.
+			resetRowHeights();
+			refreshCells();
+		}
+
+		util::Rectangle visible(hasViewport ? viewport : util::Rectangle(0,0,getBounds().width,getBounds().height));
+
+		int width = getBounds().width;
+		int bottom = visible.y + visible.height;
+		int total = getScrollableSize().height;
+		std::size_t used = 0;
+
+		int row = locationToIndex(std::max(visible.y,0));
+
+		if(row >= 0 && visible.height > 0)
+		{
+			for(int y = getRowTop(row); row < rows && y < bottom; ++row)
+			{
+				int height = getRowHeight(row);
+				Cell &cell = getCell(used++);
+
+				if(cell.row != row)
+				{
+					cell.label->setText(model->getElementAt(row));
+					cell.row = row;
+				}
+				setCellSelected(cell, row == selectedIndex);
+
+				// moving a cell does not invalidate it, resizing does.
+				const util::Rectangle &bounds = cell.label->getBounds();
+				if(bounds.width != width || bounds.height != height)
+				{
+					cell.label->setBounds(0,y,width,height);
+				}
+				else if(bounds.x != 0 || bounds.y != y)
+				{
+					cell.label->setLocation(0,y);
+				}
+
+				// cells have no FocusListeners, so showing and hiding
+				// them leaves the FocusRings alone.
+				if(!cell.label->isVisible())
+				{
+					cell.label->setVisible(true);
+				}
+				y += height;
+			}
+		}
+
+		for(std::size_t i = used; i < cells.size(); ++i)
+		{
+			if(cells[i].label->isVisible())
+			{
+				cells[i].label->setVisible(false);
+			}
+			setCellSelected(cells[i],false);
+			cells[i].row = -1;
+		}
+
+		// newly measured rows change the size of the content, which
+		// the ScrollPane needs to know about. While it validates us
+		// it checks the extent itself, otherwise the invalidation
+		// reaches it.
+		if(total != getScrollableSize().height)
+		{
+			invalidate();
+		}
+	}
+
+	const util::Dimension List::getScrollableSize() const
+	{
+		int rows = (model != 0) ? model->getSize() : 0;
+
+		if(fixedCellHeight > 0)
+		{
+			return util::Dimension(0,rows * fixedCellHeight);
+		}
+		return util::Dimension(0,rowHeights.getTotal());
+	}
+
+	const util::Dimension List::getPreferredViewportSize() const
+	{
+		const util::Dimension &size = getPrototypeSize();
+		int height = (fixedCellHeight > 0) ? fixedCellHeight : size.height;
+
+		return util::Dimension(size.width,visibleRowCount * height);
+	}
+
+	void List::setViewport(const util::Rectangle &v)
+	{
+		viewport = v;
+		hasViewport = true;
+		layoutCells();
+	}
+
+	void List::intervalAdded(const event::ListDataEvent &e)
+	{
+		int count = e.getIndex1() - e.getIndex0() + 1;
+
+		if(fixedCellHeight <= 0)
+		{
+			rowHeights.insert(e.getIndex0(),count,estimatedCellHeight);
+			measured.insert(measured.begin() + e.getIndex0(),count,0);
+		}
+
+		if(e.getIndex0() == 0)
+		{
+			prototypeSize.height = -1;
+		}
+
+		if(selectedIndex >= e.getIndex0())
+		{
+			selectedIndex += count;
+			fireSelectionChanged();
+		}
+
+		refreshCells();
+		invalidate();
+	}
+
+	void List::intervalRemoved(const event::ListDataEvent &e)
+	{
+		int count = e.getIndex1() - e.getIndex0() + 1;
+
+		if(fixedCellHeight <= 0)
+		{
+			rowHeights.erase(e.getIndex0(),count);
+			measured.erase(measured.begin() + e.getIndex0(),measured.begin() + e.getIndex0() + count);
+		}
+
+		if(e.getIndex0() == 0)
+		{
+			prototypeSize.height = -1;
+		}
+
+		if(selectedIndex > e.getIndex1())
+		{
+			selectedIndex -= count;
+			fireSelectionChanged();
+		}
+		else if(selectedIndex >= e.getIndex0())
+		{
+			setSelectedIndex(-1);
+		}
+
+		refreshCells();
+		invalidate();
+	}
+
+	void List::contentsChanged(const event::ListDataEvent &e)
+	{
+		if(e.getIndex0() == 0)
+		{
+			prototypeSize.height = -1;
+		}
+
+		if(fixedCellHeight <= 0)
+		{
+			int count = e.getIndex1() - e.getIndex0() + 1;
+
+			if(count > static_cast<int>(measured.size()) / 4)
+			{
+				resetRowHeights();
+			}
+			else
+			{
+				// measure the rows again once they are shown.
+				std::fill(measured.begin() + e.getIndex0(),measured.begin() + e.getIndex1() + 1,0);
+			}
+		}
+
+		refreshCells();
+		invalidate();
+	}
+
+// ---------------------------------------------------------------------------
+
+	List::ListLayout::ListLayout(List *l)
+		:	list(l)
+	{
+	}
+
+	void List::ListLayout::layoutContainer(const Container* parent)
+	{
+		list->layoutCells();
+	}
+
+	const util::Dimension List::ListLayout::preferredLayoutSize(const Container* parent) const
+	{
+		util::Dimension dim(list->getPreferredViewportSize());
+
+		dim.width += parent->getInsets().left + parent->getInsets().right;
+		dim.height += parent->getInsets().top + parent->getInsets().bottom;
+
+		return dim;
+	}
+
+// ---------------------------------------------------------------------------
+
+	List::CellListener::CellListener(List *l)
+		:	list(l)
+	{
+	}
+
+	void List::CellListener::mousePressed(const event::MouseEvent &e)
+	{
+		list->cellPressed(e.getSource());
+	}
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIST_H
+#define LIST_H
+
+#include "../Container.h"
+#include "../Scrollable.h"
+#include "../layout/LayoutManager.h"
+#include "../event/ListDataListener.h"
+#include "../event/MouseListener.h"
+#include "../util/PrefixSumTree.h"
+#include "./Label.h"
+
+namespace ui
+{
+	/**
+	 * Shows the rows of a ListModel and lets the user select one.
+	 * <p>
+	 * The List only creates cell Components for the rows that are
+	 * visible, and reuses them when other rows scroll into view. Rows
+	 * are fetched from the model when they become visible, so the cost
+	 * of a frame does not depend on the size of the model. A List is
+	 * meant to be placed in a ScrollPane, which it cooperates with
+	 * through the Scrollable interface.
+	 * </p>
+	 * Rows either have a fixed height, or are measured when they
+	 * are first shown. Rows that have not been measured yet are assumed
+	 * to be as high as the first row.
+	 */
+	class List : public Container, public Scrollable, public event::ListDataListener
+	{
+	public:
+		/**
+		 * Creates a new List showing the given model.
+		 * @param
+		 *	model the ListModel to show, can be 0.
+		 */
+		List(ListModel *model);
+
+		/**
+		 * Destructor.
+		 */
+		virtual ~List();
+
+		/**
+		 * Sets the model shown by this List.
+		 */
+		void setModel(ListModel *model);
+
+		/**
+		 * Returns the model shown by this List.
+		 */
+		ListModel * getModel() const;
+
+		/**
+		 * Sets the height of all rows. A height of -1
+		 * means rows are measured individually.
+		 */
+		void setFixedCellHeight(int height);
+
+		/**
+		 * Returns the fixed row height, or -1 if rows are
+		 * measured.
+		 */
+		int getFixedCellHeight() const;
+
+		/**
+		 * Sets the number of rows the List would like
+		 * to show.
+		 */
+		void setVisibleRowCount(int rows);
+
+		/**
+		 * Returns the number of rows the List would like
+		 * to show.
+		 */
+		int getVisibleRowCount() const;
+
+		/**
+		 * Selects the row at index, -1 clears the selection.
+		 * ChangeListeners are notified with a ChangeEvent::SELECTION.
+		 */
+		void setSelectedIndex(int index);
+
+		/**
+		 * Returns the selected row, or -1 if no row is
+		 * selected.
+		 */
+		int getSelectedIndex() const;
+
+		/**
+		 * Returns the row at the given vertical location,
+		 * or -1 if there is no row there.
+		 */
+		int locationToIndex(int y) const;
+
+		/**
+		 * Returns the bounds of the row at index, relative
+		 * to the List.
+		 */
+		const util::Rectangle getCellBounds(int index) const;
+
+		void addChangeListener(event::ChangeListener *l);
+		void removeChangeListener(event::ChangeListener *l);
+
+		const util::Dimension getScrollableSize() const;
+		const util::Dimension getPreferredViewportSize() const;
+		void setViewport(const util::Rectangle &viewport);
+
+		void intervalAdded(const event::ListDataEvent &e);
+		void intervalRemoved(const event::ListDataEvent &e);
+		void contentsChanged(const event::ListDataEvent &e);
+	private:
+		List(const List &rhs);
+		List& operator=(const List &rhs);
+
+		/**
+		 * A recycled cell and the row it currently shows.
+		 */
+		struct Cell
+		{
+			Label *label;
+			int row;
+			bool selected;
+		};
+
+		class ListLayout : public layout::LayoutManager
+		{
+		public:
+			ListLayout(List *list);
+			void layoutContainer(const Container* parent);
+			const util::Dimension preferredLayoutSize(const Container* parent) const;
+		private:
+			List *list;
+		};
+
+		class CellListener : public event::MouseAdapter
+		{
+		public:
+			CellListener(List *list);
+			void mousePressed(const event::MouseEvent &e);
+		private:
+			List *list;
+		};
+
+		friend class ListLayout;
+		friend class CellListener;
+
+		void layoutCells();
+		void resetRowHeights();
+		void refreshCells();
+		int getRowHeight(int index);
+		int getRowTop(int index) const;
+		int measureRow(int index) const;
+		const util::Dimension & getPrototypeSize() const;
+		void fireSelectionChanged();
+		Cell& getCell(std::size_t n);
+		void setCellSelected(Cell &cell, bool selected);
+		void cellPressed(Component *cell);
+
+		ListModel *model;
+		int fixedCellHeight;
+		int estimatedCellHeight;
+		int visibleRowCount;
+		int selectedIndex;
+
+		util::PrefixSumTree rowHeights;
+		std::vector<char> measured;
+
+		std::vector<Cell> cells;
+		mutable Label prototype;
+
+		/**
+		 * The size of the first row, measured once for the model
+		 * and the Font of the prototype it was measured with.
+		 */
+		mutable util::Dimension prototypeSize;
+		mutable FontHandle prototypeFont;
+
+		util::Rectangle viewport;
+		bool hasViewport;
+
+		ListLayout listLayout;
+		CellListener cellListener;
+		event::ChangeListenerList changeListeners;
+	};
+}
+
+#endif
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./ListModel.h"
+#include "../event/ListDataListener.h"
+#include "../event/ListDataEvent.h"
+
+namespace ui
+{
+	AbstractListModel::~AbstractListModel()
+	{
+	}
+
+	void AbstractListModel::addListDataListener(event::ListDataListener *l)
+	{
+		listDataListeners.push_back(l);
+	}
+
+	void AbstractListModel::removeListDataListener(event::ListDataListener *l)
+	{
+		listDataListeners.erase(std::remove(listDataListeners.begin(),listDataListeners.end(),l),listDataListeners.end());
+	}
+
+	void AbstractListModel::fireContentsChanged(int index0, int index1)
+	{
+		event::ListDataEvent e(this,event::ListDataEvent::CONTENTS_CHANGED,index0,index1);
+
+		event::ListDataListenerList::const_iterator iter;
+		for(iter = listDataListeners.begin(); iter != listDataListeners.end(); ++iter)
+		{
+			(*iter)->contentsChanged(e);
+		}
+	}
+
+	void AbstractListModel::fireIntervalAdded(int index0, int index1)
+	{
+		event::ListDataEvent e(this,event::ListDataEvent::INTERVAL_ADDED,index0,index1);
+
+		event::ListDataListenerList::const_iterator iter;
+		for(iter = listDataListeners.begin(); iter != listDataListeners.end(); ++iter)
+		{
+			(*iter)->intervalAdded(e);
+		}
+	}
+
+	void AbstractListModel::fireIntervalRemoved(int index0, int index1)
+	{
+		event::ListDataEvent e(this,event::ListDataEvent::INTERVAL_REMOVED,index0,index1);
+
+		event::ListDataListenerList::const_iterator iter;
+		for(iter = listDataListeners.begin(); iter != listDataListeners.end(); ++iter)
+		{
+			(*iter)->intervalRemoved(e);
+		}
+	}
+}
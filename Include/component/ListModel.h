@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LISTMODEL_H
+#define LISTMODEL_H
+
+#include <string>
+#include "../Pointers.h"
+
+namespace ui
+{
+	/**
+	 * ListModel interface.
+	 * Provides the rows shown in a List. Rows are fetched on
+	 * demand, only for the rows that are visible, so a model can
+	 * generate or look up its data lazily.
+	 */
+	class ListModel
+	{
+	public:
+		/**
+		 * Returns the number of rows in the model.
+		 */
+		virtual int getSize() const = 0;
+
+		/**
+		 * Returns the text of the row at index.
+		 */
+		virtual std::string getElementAt(int index) const = 0;
+
+		/**
+		 * Adds a listener which is notified of changes
+		 * in the model.
+		 */
+		virtual void addListDataListener(event::ListDataListener *l) = 0;
+
+		/**
+		 * Removes a listener from the model.
+		 */
+		virtual void removeListDataListener(event::ListDataListener *l) = 0;
+
+		virtual ~ListModel() {};
+	};
+
+	/**
+	 * Implements the listener management of a ListModel,
+	 * subclasses only need to provide the data and call the
+	 * fire methods when it changes.
+	 */
+	class AbstractListModel : public ListModel
+	{
+	public:
+		void addListDataListener(event::ListDataListener *l);
+		void removeListDataListener(event::ListDataListener *l);
+
+		virtual ~AbstractListModel();
+	protected:
+		/**
+		 * Notifies the listeners that rows index0 to index1
+		 * (inclusive) changed.
+		 */
+		void fireContentsChanged(int index0, int index1);
+
+		/**
+		 * Notifies the listeners that rows index0 to index1
+		 * (inclusive) were inserted.
+		 */
+		void fireIntervalAdded(int index0, int index1);
+
+		/**
+		 * Notifies the listeners that rows index0 to index1
+		 * (inclusive) were removed.
+		 */
+		void fireIntervalRemoved(int index0, int index1);
+	private:
+		event::ListDataListenerList listDataListeners;
+	};
+}
+
+#endif
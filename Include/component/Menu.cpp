@@ -63,7 +63,7 @@ namespace ui
 
 	void Menu::add(MenuItem* menuItem)
 	{
-		menuItem->addMouseListener(this);
+		menuItem->addMouseListener(this,event::MouseEvent::MOUSE_CLICKED_MASK|event::MouseEvent::MOUSE_ENTERED_MASK|event::MouseEvent::MOUSE_EXITED_MASK|event::MouseEvent::MOUSE_MOTION_MASK);
 		menuItem->addFocusListener(this);
 		popupMenu.add(menuItem);
 	}
@@ -99,19 +99,19 @@ namespace ui
 		setChanged();
 		notifyObserver();
 
-		FocusManager::getInstance().setPermanentFocusOwner(0);
+		getContext()->getFocusManager().setPermanentFocusOwner(0);
 	}
 
 	void Menu::mouseEntered(const event::MouseEvent &e)
 	{
-		FocusManager::getInstance().setFocusOwner(e.getSource());
+		getContext()->getFocusManager().setFocusOwner(e.getSource());
 	}
 
 	void Menu::mouseExited(const event::MouseEvent &e)
 	{
 		if(e.getSource()->hasFocus())
 		{
-			FocusManager::getInstance().setFocusOwner(0);
+			getContext()->getFocusManager().setFocusOwner(0);
 		}
 	}
 
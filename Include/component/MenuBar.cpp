@@ -43,7 +43,7 @@ namespace ui
 
 	void MenuBar::add(Menu* menu)
 	{
-		menu->addMouseListener(this);
+		menu->addMouseListener(this,event::MouseEvent::MOUSE_PRESSED_MASK|event::MouseEvent::MOUSE_ENTERED_MASK);
 		menu->addFocusListener(this);
 		menu->addObserver(this);
 		addImpl(menu,-1);
@@ -87,7 +87,7 @@ namespace ui
 			{
 				// find the new selectedMenu
 				ComponentList::const_iterator iter;
-				ComponentList list = getChildren();
+				const ComponentList &list = getChildren();
 				for(iter = list.begin(); iter != list.end(); ++iter)
 				{
 					Menu* menu = static_cast<Menu*>((*iter));
@@ -97,7 +97,7 @@ namespace ui
 						selectMenu(menu);
 						selectedMenu = menu;
 						selected = true;
-						FocusManager::getInstance().setPermanentFocusOwner(selectedMenu);
+						getContext()->getFocusManager().setPermanentFocusOwner(selectedMenu);
 					}
 					else
 					{
@@ -111,7 +111,7 @@ namespace ui
 	void MenuBar::mousePressed(const event::MouseEvent &e)
 	{
 		ComponentList::const_iterator iter;
-		ComponentList list = getChildren();
+		const ComponentList &list = getChildren();
 		for(iter = list.begin(); iter != list.end(); ++iter)
 		{
 			Menu* menu = static_cast<Menu*>((*iter));
@@ -158,8 +158,8 @@ namespace ui
 		selectedMenu = 0;
 		selected = false;
 
-		ComponentList::iterator iter;
-		ComponentList list = getChildren();
+		ComponentList::const_iterator iter;
+		const ComponentList &list = getChildren();
 		for(iter = list.begin(); iter != list.end(); ++iter)
 		{			
 			Menu* menu = static_cast<Menu*>((*iter));
@@ -172,8 +172,8 @@ namespace ui
 	{
 		bool found = false;
 
-		ComponentList::iterator iter;
-		ComponentList list = getChildren();
+		ComponentList::const_iterator iter;
+		const ComponentList &list = getChildren();
 		for(iter = list.begin(); iter != list.end(); ++iter)
 		{
 		
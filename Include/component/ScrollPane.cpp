@@ -27,19 +27,17 @@
  */
 #include "./ScrollPane.h"
 #include "../Graphics.h"
+#include "../Scrollable.h"
+#include "../util/Insets.h"
 
 namespace ui
 {
 	ScrollPane::ScrollPane(Component *comp)
-		:	horizontalScrollbar(Scrollbar::HORIZONTAL),
+		:	view(comp),
+			horizontalScrollbar(Scrollbar::HORIZONTAL),
 			verticalScrollbar(Scrollbar::VERTICAL),
-			layout(false),
-			view(comp),
-			x(0),
-			y(0)
-
+			layout(this)
 	{
-		view.setScrollPane(this);
 		setLayout(&layout);
 		setThemeName("ScrollPane");
 
@@ -49,9 +47,9 @@ namespace ui
 		horizontalScrollbar.setVisible(false);
 		verticalScrollbar.setVisible(false);
 
-		addImpl(&view,layout::BorderLayout::CENTER);
-		addImpl(&horizontalScrollbar,layout::BorderLayout::SOUTH);
-		addImpl(&verticalScrollbar,layout::BorderLayout::EAST);
+		addImpl(&view,-1);
+		addImpl(&horizontalScrollbar,-1);
+		addImpl(&verticalScrollbar,-1);
 	}
 
 	Scrollbar * ScrollPane::getHorizontalScrollbar()
@@ -66,97 +64,198 @@ namespace ui
 
 	void ScrollPane::stateChanged(const event::ChangeEvent &e)
 	{
-		if(e.getSource() == &horizontalScrollbar)
-		{
-			view.setHorizontalLocation(horizontalScrollbar.getValue());
-		}
-		else if(e.getSource() == &verticalScrollbar)
+		if(e.getSource() == &horizontalScrollbar || e.getSource() == &verticalScrollbar)
 		{
-			view.setVerticalLocation(verticalScrollbar.getValue());
+			updateViewLocation();
 		}
 	}
 
-// ---------------------------------------------------------------------------
-
-	ScrollPane::ViewContainer::ViewContainer(Component *child)
-		:	view(child)
+	float ScrollPane::getScrollFraction(const Scrollbar &scrollbar) const
 	{
-		// constructor parameters cannot be 0 (NULL).
-		assert(view);
-		add(view);
-	}
+		float range = scrollbar.getMaximum() - scrollbar.getMinimum();
 
-	void ScrollPane::ViewContainer::setScrollPane(ScrollPane *parent)
-	{
-		scrollPane = parent;
+		if(range <= 0.0f)
+		{
+			return 0.0f;
+		}
+		return (scrollbar.getValue() - scrollbar.getMinimum()) / range;
 	}
 
-	const util::Dimension & ScrollPane::ViewContainer::getPreferredSize() const
+	void ScrollPane::updateViewLocation()
 	{
-		return view->getPreferredSize();
-	}
+		// scrolling only translates the content, it is not laid out again.
+		Component *content = view.getView();
 
-	void ScrollPane::ViewContainer::setHorizontalLocation(float value)
-	{
-		float screen = static_cast<float>(view->getBounds().width);
-		float window = static_cast<float>(getBounds().width);
-	
-		float tmp = ((screen-window) / 100.0f) * value;
+		int maxX = std::max(content->getBounds().width - view.getBounds().width,0);
+		int maxY = std::max(content->getBounds().height - view.getBounds().height,0);
 
-		int y = view->getLocation().y;
+		int offsetX = static_cast<int>(static_cast<float>(maxX) * getScrollFraction(horizontalScrollbar));
+		int offsetY = static_cast<int>(static_cast<float>(maxY) * getScrollFraction(verticalScrollbar));
 
-		view->setLocation(static_cast<int>(-tmp),y);
+		content->setLocation(-offsetX,-offsetY);
+
+		if(view.getScrollable() != 0)
+		{
+			view.getScrollable()->setViewport(util::Rectangle(offsetX,offsetY,view.getBounds().width,view.getBounds().height));
+		}
 	}
 
-	void ScrollPane::ViewContainer::setVerticalLocation(float value)
+	void ScrollPane::layoutScrollPane()
 	{
-		float screen = static_cast<float>(view->getBounds().height);
-		float window = static_cast<float>(getBounds().height);
-	
-		float tmp = ((screen-window) / 100.0f) * value;
+		// the Scrollable measures the content it scrolls into view,
+		// which can change its extent while we are being validated.
+		// Invalidating us has no effect at that point, so lay out
+		// again until the extent settles.
+		for(int pass = 0; pass < 3; ++pass)
+		{
+			util::Dimension extent(view.getExtent());
 
-		int x = view->getLocation().x;
+			layoutScrollPane(extent);
 
-		view->setLocation(x,static_cast<int>(-tmp));
+			if(extent == view.getExtent())
+			{
+				break;
+			}
+		}
 	}
 
-	void ScrollPane::ViewContainer::paintChildren(Graphics &g) const
+	void ScrollPane::layoutScrollPane(const util::Dimension &extent)
 	{
-		assert(scrollPane);
+		const util::Insets &insets = getInsets();
+
+		int width = getBounds().width - insets.left - insets.right;
+		int height = getBounds().height - insets.top - insets.bottom;
+
+		int scrollbarWidth = verticalScrollbar.getPreferredSize().width;
+		int scrollbarHeight = horizontalScrollbar.getPreferredSize().height;
 
-		// the child always has its preferred size...
-		view->setSize(view->getPreferredSize());
+		// a scrollbar takes space away from the viewport, which can
+		// make the other scrollbar necessary as well.
+		bool vertical = extent.height > height;
+		bool horizontal = extent.width > (vertical ? width - scrollbarWidth : width);
 
-		if(view->getBounds().width > getBounds().width)
+		if(horizontal && !vertical)
 		{
-			scrollPane->getHorizontalScrollbar()->setVisible(true);
+			vertical = extent.height > height - scrollbarHeight;
 		}
-		else
+
+		int viewportWidth = std::max(vertical ? width - scrollbarWidth : width,0);
+		int viewportHeight = std::max(horizontal ? height - scrollbarHeight : height,0);
+
+		if(horizontalScrollbar.isVisible() != horizontal)
+		{
+			horizontalScrollbar.setVisible(horizontal);
+		}
+
+		if(verticalScrollbar.isVisible() != vertical)
+		{
+			verticalScrollbar.setVisible(vertical);
+		}
+
+		view.setBounds(insets.left,insets.top,viewportWidth,viewportHeight);
+
+		if(horizontal)
+		{
+			horizontalScrollbar.setBounds(insets.left,insets.top + viewportHeight,viewportWidth,scrollbarHeight);
+			horizontalScrollbar.setThumbSize(std::min(viewportWidth * 100 / std::max(extent.width,1),100));
+		}
+
+		if(vertical)
 		{
-			scrollPane->getHorizontalScrollbar()->setVisible(false);
+			verticalScrollbar.setBounds(insets.left + viewportWidth,insets.top,scrollbarWidth,viewportHeight);
+			verticalScrollbar.setThumbSize(std::min(viewportHeight * 100 / std::max(extent.height,1),100));
 		}
 
-		if(view->getBounds().height > getBounds().height)
+		if(view.getScrollable() != 0)
 		{
-			scrollPane->getVerticalScrollbar()->setVisible(true);
+			// Scrollable content covers at least the viewport.
+			view.getView()->setSize(std::max(extent.width,viewportWidth),std::max(extent.height,viewportHeight));
 		}
 		else
 		{
-			scrollPane->getVerticalScrollbar()->setVisible(false);
+			// the child always has its preferred size...
+			view.getView()->setSize(extent);
+		}
+		updateViewLocation();
+	}
+
+// ---------------------------------------------------------------------------
+
+	ScrollPane::ScrollPaneLayout::ScrollPaneLayout(ScrollPane *pane)
+		:	scrollPane(pane)
+	{
+	}
+
+	void ScrollPane::ScrollPaneLayout::layoutContainer(const Container* parent)
+	{
+		scrollPane->layoutScrollPane();
+	}
+
+	const util::Dimension ScrollPane::ScrollPaneLayout::preferredLayoutSize(const Container* parent) const
+	{
+		util::Dimension dim(scrollPane->view.getPreferredSize());
+
+		if(scrollPane->verticalScrollbar.isVisible())
+		{
+			dim.width += scrollPane->verticalScrollbar.getPreferredSize().width;
+		}
+
+		if(scrollPane->horizontalScrollbar.isVisible())
+		{
+			dim.height += scrollPane->horizontalScrollbar.getPreferredSize().height;
 		}
-	//	scrollPane->getParent()->invalidate();
-		int hpercentage = static_cast<int>((static_cast<float>(getBounds().width) / static_cast<float>(view->getBounds().width)) * 100.0f);
-		scrollPane->getHorizontalScrollbar()->setThumbSize(hpercentage);
 
-		int vpercentage = static_cast<int>((static_cast<float>(getBounds().height) / static_cast<float>(view->getBounds().height)) * 100.0f);
-		scrollPane->getVerticalScrollbar()->setThumbSize(vpercentage);
+		dim.width += parent->getInsets().left + parent->getInsets().right;
+		dim.height += parent->getInsets().top + parent->getInsets().bottom;
+
+		return dim;
+	}
+
+// ---------------------------------------------------------------------------
+
+	ScrollPane::ViewContainer::ViewContainer(Component *child)
+		:	view(child),
+			scrollable(dynamic_cast<Scrollable*>(child))
+	{
+		// constructor parameters cannot be 0 (NULL).
+		assert(view);
+		add(view);
+	}
+
+	Component * ScrollPane::ViewContainer::getView() const
+	{
+		return view;
+	}
+
+	Scrollable * ScrollPane::ViewContainer::getScrollable() const
+	{
+		return scrollable;
+	}
+
+	const util::Dimension ScrollPane::ViewContainer::getExtent() const
+	{
+		if(scrollable != 0)
+		{
+			return scrollable->getScrollableSize();
+		}
+		return view->getPreferredSize();
+	}
 
+	const util::Dimension & ScrollPane::ViewContainer::getPreferredSize() const
+	{
+		if(scrollable != 0)
+		{
+			viewportSize = scrollable->getPreferredViewportSize();
+			return viewportSize;
+		}
+		return view->getPreferredSize();
+	}
 
+	void ScrollPane::ViewContainer::paintChildren(Graphics &g) const
+	{
 		util::Point p(getLocationOnScreen());
 		g.enableScissor(p.x,p.y,getBounds().width,getBounds().height);
 		Container::paintChildren(g);
 		g.disableScissor();
 	}
-
-
-}
\ No newline at end of file
+}
@@ -30,7 +30,7 @@
 
 #include "../Container.h"
 #include "./Scrollbar.h"
-#include "../layout/BorderLayout.h"
+#include "../layout/LayoutManager.h"
 #include "../event/ChangeListener.h"
 #include "../event/ChangeEvent.h"
 
@@ -42,6 +42,13 @@ namespace ui
 	 * it offers Scrollbars to access them.
 	 * ScrollPane is an instance of the Adapter
 	 * design pattern, taking its child in the constructor.
+	 * <p>
+	 * If the child implements the Scrollable interface, the
+	 * ScrollPane uses its estimated size for the scrollbars and
+	 * tells it which part is visible, so the child only needs to
+	 * lay out and paint that part. Scrolling moves the child, it
+	 * does not cause a new layout.
+	 * </p>
 	 */
 	class ScrollPane : public Container, public ui::event::ChangeListener
 	{
@@ -55,22 +62,48 @@ namespace ui
 		{
 		public:
 			ViewContainer(Component *child);
-			void setScrollPane(ScrollPane *parent);
 			const util::Dimension & getPreferredSize() const;
-			void setHorizontalLocation(float value);
-			void setVerticalLocation(float value);
+			Component * getView() const;
+			Scrollable * getScrollable() const;
+
+			/**
+			 * Returns the size of the content, which is
+			 * estimated for Scrollable content.
+			 */
+			const util::Dimension getExtent() const;
 		private:
 			void paintChildren(Graphics &g) const;
 			Component *view;
+			Scrollable *scrollable;
+			mutable util::Dimension viewportSize;
+		};
+
+		/**
+		 * Lays out the viewport and scrollbars. Scrollbar visibility
+		 * and thumb sizes are updated here, not while painting.
+		 */
+		class ScrollPaneLayout : public layout::LayoutManager
+		{
+		public:
+			ScrollPaneLayout(ScrollPane *pane);
+			void layoutContainer(const Container* parent);
+			const util::Dimension preferredLayoutSize(const Container* parent) const;
+		private:
 			ScrollPane *scrollPane;
 		};
 
+		friend class ScrollPaneLayout;
+
 		void stateChanged(const event::ChangeEvent &e);
+		void layoutScrollPane();
+		void layoutScrollPane(const util::Dimension &extent);
+		void updateViewLocation();
+		float getScrollFraction(const Scrollbar &scrollbar) const;
+
 		ViewContainer view;
 		Scrollbar horizontalScrollbar;
 		Scrollbar verticalScrollbar;
-		layout::BorderLayout layout;
-		int x,y;
+		ScrollPaneLayout layout;
 	};
 }
 
@@ -85,8 +85,8 @@ namespace ui
 		addImpl(&scroller,layout::BorderLayout::CENTER);
 		
 
-		incrementButton.addMouseListener(this);
-		decrementButton.addMouseListener(this);
+		incrementButton.addMouseListener(this,event::MouseEvent::MOUSE_PRESSED_MASK|event::MouseEvent::MOUSE_RELEASED_MASK);
+		decrementButton.addMouseListener(this,event::MouseEvent::MOUSE_PRESSED_MASK|event::MouseEvent::MOUSE_RELEASED_MASK);
 
 		setThemeName("Scrollbar");
 	}
@@ -111,24 +111,20 @@ namespace ui
 					value = v;
 				}
 
-				if(getParent())
-				{
-					event::ChangeListenerList::iterator iter;
+				postNotification(event::ChangeEvent::RANGE);
+			}
+		}
 
-					for(iter = changeListenerList.begin(); iter != changeListenerList.end(); ++iter)
-					{
-						(*iter)->stateChanged(event::ChangeEvent(getParent(),event::ChangeEvent::RANGE));
-					}
-				}
-				else
-				{
-					event::ChangeListenerList::iterator iter;
+		void Scroller::deliverNotification(int id)
+		{
+			// the event comes from the Scrollbar we are part of, if any
+			Component *source = getParent() ? getParent() : this;
+			event::ChangeEvent e(source,id);
 
-					for(iter = changeListenerList.begin(); iter != changeListenerList.end(); ++iter)
-					{
-						(*iter)->stateChanged(event::ChangeEvent(this,event::ChangeEvent::RANGE));
-					}
-				}
+			event::ChangeListenerList::iterator iter;
+			for(iter = changeListenerList.begin(); iter != changeListenerList.end(); ++iter)
+			{
+				(*iter)->stateChanged(e);
 			}
 		}
 
@@ -133,6 +133,12 @@ namespace ui
 			void setThumbSize(int percentage);
 
 			int getThumbSize() const;
+
+			/**
+			 * Sends the ChangeEvent for a new value to the
+			 * ChangeListeners.
+			 */
+			void deliverNotification(int id);
 		private:
 			event::ChangeListenerList changeListenerList;
 			int orient, thumbSize;
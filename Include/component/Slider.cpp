@@ -108,11 +108,17 @@ namespace ui
 			value = v;
 		}
 
-		event::ChangeListenerList::iterator iter;
+		postNotification(event::ChangeEvent::RANGE);
+	}
 
+	void Slider::deliverNotification(int id)
+	{
+		event::ChangeEvent e(this,id);
+
+		event::ChangeListenerList::iterator iter;
 		for(iter = changeListenerList.begin(); iter != changeListenerList.end(); ++iter)
 		{
-			(*iter)->stateChanged(event::ChangeEvent(this,event::ChangeEvent::RANGE));
+			(*iter)->stateChanged(e);
 		}
 	}
 
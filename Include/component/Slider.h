@@ -117,6 +117,12 @@ namespace ui
 		void addChangeListener(event::ChangeListener *l);
 
 		void removeChangeListener(event::ChangeListener *l);
+
+		/**
+		 * Sends the ChangeEvent for a new value to the
+		 * ChangeListeners.
+		 */
+		void deliverNotification(int id);
 	private:
 		void update(util::Observable* subject);
 		int orient;
@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./Table.h"
+#include "./TableModel.h"
+#include "./TableSorter.h"
+#include "../Font.h"
+#include "../event/TableModelEvent.h"
+#include "../event/ChangeEvent.h"
+#include "../event/ChangeListener.h"
+#include "../event/MouseEvent.h"
+
+namespace ui
+{
+	Table::Table(TableModel *m)
+		:	model(0),
+			rowHeight(16),
+			headerHeight(20),
+			cellMargin(4),
+			visibleRowCount(8),
+			selectedRow(-1),
+			columnOffsets(1,0),
+			viewportSet(false)
+	{
+		setThemeName("Table");
+		addMouseListener(this,event::MouseEvent::MOUSE_PRESSED_MASK);
+		setModel(m);
+	}
+
+	Table::~Table()
+	{
+		if(model != 0)
+		{
+			model->removeTableModelListener(this);
+		}
+	}
+
+	void Table::setModel(TableModel *m)
+	{
+		if(model != 0)
+		{
+			model->removeTableModelListener(this);
+		}
+
+		model = m;
+		selectedRow = -1;
+
+		if(model != 0)
+		{
+			model->addTableModelListener(this);
+		}
+
+		sizeColumnsToFit();
+	}
+
+	TableModel * Table::getModel() const
+	{
+		return model;
+	}
+
+	void Table::setRowHeight(int height)
+	{
+		rowHeight = std::max(height,1);
+		invalidate();
+	}
+
+	int Table::getRowHeight() const
+	{
+		return rowHeight;
+	}
+
+	void Table::setHeaderHeight(int height)
+	{
+		headerHeight = std::max(height,0);
+		invalidate();
+	}
+
+	int Table::getHeaderHeight() const
+	{
+		return headerHeight;
+	}
+
+	void Table::setCellMargin(int margin)
+	{
+		cellMargin = margin;
+	}
+
+	int Table::getCellMargin() const
+	{
+		return cellMargin;
+	}
+
+	int Table::getColumnCount() const
+	{
+		return static_cast<int>(columnWidths.size());
+	}
+
+	void Table::setColumnWidth(int column, int width)
+	{
+		columnWidths[column] = std::max(width,0);
+		updateColumnOffsets();
+	}
+
+	int Table::getColumnWidth(int column) const
+	{
+		return columnWidths[column];
+	}
+
+	int Table::getColumnX(int column) const
+	{
+		return columnOffsets[column];
+	}
+
+	void Table::sizeColumnsToFit()
+	{
+		int columns = (model != 0) ? model->getColumnCount() : 0;
+
+		columnWidths.resize(columns);
+		for(int column = 0; column < columns; ++column)
+		{
+			columnWidths[column] = measureColumn(column);
+		}
+		updateColumnOffsets();
+	}
+
+	int Table::measureColumn(int column) const
+	{
+		const Font *font = getFont();
+
+		if(font == 0)
+		{
+			return defaultColumnWidth;
+		}
+
+		int width = font->getStringBoundingBox(model->getColumnName(column)).width;
+		int rows = model->getRowCount();
+		if(rows > measuredRows)
+		{
+			rows = measuredRows;
+		}
+
+		for(int row = 0; row < rows; ++row)
+		{
+			model->getValueAt(row,column,value);
+			width = std::max(width,font->getStringBoundingBox(value).width);
+		}
+		return width + 2 * cellMargin;
+	}
+
+	void Table::updateColumnOffsets()
+	{
+		// columnOffsets holds the left edge of every column, and
+		// the right edge of the last column at the end.
+		columnOffsets.resize(columnWidths.size() + 1);
+		columnOffsets[0] = 0;
+
+		for(std::size_t i = 0; i < columnWidths.size(); ++i)
+		{
+			columnOffsets[i + 1] = columnOffsets[i] + columnWidths[i];
+		}
+		invalidate();
+	}
+
+	int Table::columnAtPoint(int x) const
+	{
+		if(x < 0 || x >= columnOffsets.back())
+		{
+			return -1;
+		}
+		return static_cast<int>(std::upper_bound(columnOffsets.begin(),columnOffsets.end(),x) - columnOffsets.begin()) - 1;
+	}
+
+	int Table::rowAtPoint(int y) const
+	{
+		int rows = (model != 0) ? model->getRowCount() : 0;
+
+		if(y < headerHeight)
+		{
+			return -1;
+		}
+
+		int row = (y - headerHeight) / rowHeight;
+		return row < rows ? row : -1;
+	}
+
+	void Table::setVisibleRowCount(int rows)
+	{
+		visibleRowCount = rows;
+		invalidate();
+	}
+
+	int Table::getVisibleRowCount() const
+	{
+		return visibleRowCount;
+	}
+
+	void Table::setSelectedRow(int row)
+	{
+		if(row == selectedRow)
+		{
+			return;
+		}
+
+		selectedRow = row;
+
+		event::ChangeEvent e(this,event::ChangeEvent::SELECTION);
+
+		event::ChangeListenerList::const_iterator listener;
+		for(listener = changeListeners.begin(); listener != changeListeners.end(); ++listener)
+		{
+			(*listener)->stateChanged(e);
+		}
+	}
+
+	int Table::getSelectedRow() const
+	{
+		return selectedRow;
+	}
+
+	const util::Rectangle Table::getVisibleRect() const
+	{
+		if(viewportSet)
+		{
+			return viewport;
+		}
+		return util::Rectangle(0,0,getBounds().width,getBounds().height);
+	}
+
+	bool Table::isInViewport() const
+	{
+		return viewportSet;
+	}
+
+	void Table::addChangeListener(event::ChangeListener *l)
+	{
+		changeListeners.push_back(l);
+	}
+
+	void Table::removeChangeListener(event::ChangeListener *l)
+	{
+		changeListeners.erase(std::remove(changeListeners.begin(),changeListeners.end(),l),changeListeners.end());
+	}
+
+	const util::Dimension Table::getScrollableSize() const
+	{
+		int rows = (model != 0) ? model->getRowCount() : 0;
+		return util::Dimension(columnOffsets.back(),headerHeight + rows * rowHeight);
+	}
+
+	const util::Dimension Table::getPreferredViewportSize() const
+	{
+		return util::Dimension(columnOffsets.back(),headerHeight + visibleRowCount * rowHeight);
+	}
+
+	void Table::setViewport(const util::Rectangle &v)
+	{
+		// nothing to lay out, the theme paints whatever
+		// is inside the viewport.
+		viewport = v;
+		viewportSet = true;
+	}
+
+	void Table::tableChanged(const event::TableModelEvent &e)
+	{
+		TableSorter *sorter = dynamic_cast<TableSorter*>(model);
+
+		switch(e.getID())
+		{
+			case event::TableModelEvent::STRUCTURE_CHANGED:
+			{
+				setSelectedRow(-1);
+				sizeColumnsToFit();
+				break;
+			}
+			case event::TableModelEvent::DATA_CHANGED:
+			case event::TableModelEvent::ROWS_UPDATED:
+			{
+				// a TableSorter reorders its rows, the same row of
+				// the decorated model stays selected.
+				if(sorter != 0)
+				{
+					setSelectedRow(sorter->convertRowIndexToView(sorter->convertPreviousRowIndexToModel(selectedRow)));
+				}
+				else if(e.getID() == event::TableModelEvent::DATA_CHANGED)
+				{
+					setSelectedRow(-1);
+				}
+				break;
+			}
+			case event::TableModelEvent::ROWS_INSERTED:
+			{
+				if(selectedRow >= e.getFirstRow())
+				{
+					selectedRow += e.getLastRow() - e.getFirstRow() + 1;
+				}
+				break;
+			}
+			case event::TableModelEvent::ROWS_DELETED:
+			{
+				if(selectedRow > e.getLastRow())
+				{
+					selectedRow -= e.getLastRow() - e.getFirstRow() + 1;
+				}
+				else if(selectedRow >= e.getFirstRow())
+				{
+					setSelectedRow(-1);
+				}
+				break;
+			}
+		}
+
+		// the number of rows may have changed, which
+		// the ScrollPane needs to know about.
+		if(e.getID() != event::TableModelEvent::ROWS_UPDATED)
+		{
+			invalidate();
+		}
+	}
+
+	void Table::mousePressed(const event::MouseEvent &e)
+	{
+		util::Point location(getLocationOnScreen());
+		const util::Rectangle visible(getVisibleRect());
+
+		int x = e.getX() - location.x;
+		int y = e.getY() - location.y;
+
+		if(y < visible.y + headerHeight)
+		{
+			int column = columnAtPoint(x);
+			TableSorter *sorter = dynamic_cast<TableSorter*>(model);
+
+			if(sorter != 0 && column != -1)
+			{
+				sorter->setSortColumn(column,!(sorter->getSortColumn() == column && sorter->isAscending()));
+			}
+		}
+		else
+		{
+			setSelectedRow(rowAtPoint(y));
+		}
+	}
+}
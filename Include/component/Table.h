@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TABLE_H
+#define TABLE_H
+
+#include "../Component.h"
+#include "../Scrollable.h"
+#include "../event/TableModelListener.h"
+#include "../event/MouseListener.h"
+
+namespace ui
+{
+	/**
+	 * Shows the cells of a TableModel in rows and columns, with
+	 * a header showing the column names.
+	 * <p>
+	 * A Table does not create a Component per cell. Its theme
+	 * paints the cells directly, and only those which are inside
+	 * the viewport, so the cost of a frame does not depend on the
+	 * size of the model. A Table is meant to be placed in a
+	 * ScrollPane, which it cooperates with through the Scrollable
+	 * interface. The header stays at the top of the viewport while
+	 * the rows scroll underneath it.
+	 * </p>
+	 * <p>
+	 * All rows have the same height. Column widths are measured from
+	 * the header and the first rows when the model is set or its
+	 * structure changes, and are cached until then.
+	 * </p>
+	 * Clicking a column header sorts the Table on that column if its
+	 * model is a TableSorter, clicking it again reverses the order.
+	 */
+	class Table : public Component, public Scrollable, public event::TableModelListener, public event::MouseAdapter
+	{
+	public:
+		/**
+		 * Creates a new Table showing the given model.
+		 * @param
+		 *	model the TableModel to show, can be 0.
+		 */
+		Table(TableModel *model);
+
+		/**
+		 * Destructor.
+		 */
+		virtual ~Table();
+
+		/**
+		 * Sets the model shown by this Table.
+		 */
+		void setModel(TableModel *model);
+
+		/**
+		 * Returns the model shown by this Table.
+		 */
+		TableModel * getModel() const;
+
+		/**
+		 * Sets the height of all rows.
+		 */
+		void setRowHeight(int height);
+
+		/**
+		 * Returns the height of all rows.
+		 */
+		int getRowHeight() const;
+
+		/**
+		 * Sets the height of the header, 0 hides the header.
+		 */
+		void setHeaderHeight(int height);
+
+		/**
+		 * Returns the height of the header.
+		 */
+		int getHeaderHeight() const;
+
+		/**
+		 * Sets the space left and right of the text of
+		 * each cell.
+		 */
+		void setCellMargin(int margin);
+
+		/**
+		 * Returns the space left and right of the text of
+		 * each cell.
+		 */
+		int getCellMargin() const;
+
+		/**
+		 * Returns the number of columns.
+		 */
+		int getColumnCount() const;
+
+		/**
+		 * Sets the width of a column. The width is kept until
+		 * the structure of the model changes.
+		 */
+		void setColumnWidth(int column, int width);
+
+		/**
+		 * Returns the width of a column.
+		 */
+		int getColumnWidth(int column) const;
+
+		/**
+		 * Returns the left edge of a column, relative to
+		 * the Table.
+		 */
+		int getColumnX(int column) const;
+
+		/**
+		 * Measures all columns again from their header and
+		 * the first rows of the model.
+		 */
+		void sizeColumnsToFit();
+
+		/**
+		 * Returns the column at the given horizontal location,
+		 * or -1 if there is no column there.
+		 */
+		int columnAtPoint(int x) const;
+
+		/**
+		 * Returns the row at the given vertical location,
+		 * or -1 if there is no row there. The location
+		 * is relative to the Table, and ignores the header.
+		 */
+		int rowAtPoint(int y) const;
+
+		/**
+		 * Sets the number of rows the Table would like
+		 * to show.
+		 */
+		void setVisibleRowCount(int rows);
+
+		/**
+		 * Returns the number of rows the Table would like
+		 * to show.
+		 */
+		int getVisibleRowCount() const;
+
+		/**
+		 * Selects a row, -1 clears the selection.
+		 * ChangeListeners are notified with a ChangeEvent::SELECTION.
+		 * If the model is a TableSorter, the same row of the
+		 * decorated model stays selected when the rows are
+		 * sorted or filtered again.
+		 */
+		void setSelectedRow(int row);
+
+		/**
+		 * Returns the selected row, or -1 if no row is
+		 * selected.
+		 */
+		int getSelectedRow() const;
+
+		/**
+		 * Returns the part of the Table which is visible,
+		 * relative to the Table. This is the viewport of the
+		 * ScrollPane the Table is in, or its bounds otherwise.
+		 */
+		const util::Rectangle getVisibleRect() const;
+
+		/**
+		 * Returns true if the Table is shown in the viewport
+		 * of a ScrollPane.
+		 */
+		bool isInViewport() const;
+
+		void addChangeListener(event::ChangeListener *l);
+		void removeChangeListener(event::ChangeListener *l);
+
+		const util::Dimension getScrollableSize() const;
+		const util::Dimension getPreferredViewportSize() const;
+		void setViewport(const util::Rectangle &viewport);
+
+		void tableChanged(const event::TableModelEvent &e);
+	private:
+		Table(const Table &rhs);
+		Table& operator=(const Table &rhs);
+
+		void mousePressed(const event::MouseEvent &e);
+
+		int measureColumn(int column) const;
+		void updateColumnOffsets();
+
+		/**
+		 * The number of rows measured to find the width
+		 * of a column.
+		 */
+		static const int measuredRows = 64;
+
+		/**
+		 * The width of a column when there is no Font
+		 * to measure it with.
+		 */
+		static const int defaultColumnWidth = 80;
+
+		TableModel *model;
+		int rowHeight;
+		int headerHeight;
+		int cellMargin;
+		int visibleRowCount;
+		int selectedRow;
+
+		std::vector<int> columnWidths;
+		std::vector<int> columnOffsets;
+		mutable std::string value;
+
+		util::Rectangle viewport;
+		bool viewportSet;
+
+		event::ChangeListenerList changeListeners;
+	};
+}
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./TableModel.h"
+#include "../event/TableModelListener.h"
+#include "../event/TableModelEvent.h"
+
+namespace ui
+{
+	AbstractTableModel::AbstractTableModel()
+	{
+	}
+
+	AbstractTableModel::~AbstractTableModel()
+	{
+	}
+
+	const std::string & AbstractTableModel::getColumnName(int column) const
+	{
+		// spreadsheet style names: A, B, .., Z, AA, AB, ..
+		// made up once per column.
+		while(static_cast<int>(columnNames.size()) <= column)
+		{
+			std::string name;
+			for(int n = static_cast<int>(columnNames.size()) + 1; n > 0; n = (n - 1) / 26)
+			{
+				name.insert(name.begin(),static_cast<char>('A' + (n - 1) % 26));
+			}
+			columnNames.push_back(name);
+		}
+		return columnNames[column];
+	}
+
+	int AbstractTableModel::compare(int row0, int row1, int column) const
+	{
+		getValueAt(row0,column,value0);
+		getValueAt(row1,column,value1);
+		return value0.compare(value1);
+	}
+
+	void AbstractTableModel::addTableModelListener(event::TableModelListener *l)
+	{
+		tableModelListeners.push_back(l);
+	}
+
+	void AbstractTableModel::removeTableModelListener(event::TableModelListener *l)
+	{
+		tableModelListeners.erase(std::remove(tableModelListeners.begin(),tableModelListeners.end(),l),tableModelListeners.end());
+	}
+
+	void AbstractTableModel::fireTableDataChanged()
+	{
+		fireTableChanged(event::TableModelEvent(this,event::TableModelEvent::DATA_CHANGED));
+	}
+
+	void AbstractTableModel::fireTableStructureChanged()
+	{
+		fireTableChanged(event::TableModelEvent(this,event::TableModelEvent::STRUCTURE_CHANGED));
+	}
+
+	void AbstractTableModel::fireTableRowsUpdated(int firstRow, int lastRow)
+	{
+		fireTableChanged(event::TableModelEvent(this,event::TableModelEvent::ROWS_UPDATED,firstRow,lastRow));
+	}
+
+	void AbstractTableModel::fireTableRowsInserted(int firstRow, int lastRow)
+	{
+		fireTableChanged(event::TableModelEvent(this,event::TableModelEvent::ROWS_INSERTED,firstRow,lastRow));
+	}
+
+	void AbstractTableModel::fireTableRowsDeleted(int firstRow, int lastRow)
+	{
+		fireTableChanged(event::TableModelEvent(this,event::TableModelEvent::ROWS_DELETED,firstRow,lastRow));
+	}
+
+	void AbstractTableModel::fireTableChanged(const event::TableModelEvent &e)
+	{
+		event::TableModelListenerList::const_iterator iter;
+		for(iter = tableModelListeners.begin(); iter != tableModelListeners.end(); ++iter)
+		{
+			(*iter)->tableChanged(e);
+		}
+	}
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TABLEMODEL_H
+#define TABLEMODEL_H
+
+#include <string>
+#include <vector>
+#include "../Pointers.h"
+
+namespace ui
+{
+	/**
+	 * TableModel interface.
+	 * Provides the cells shown in a Table. Cells are fetched on
+	 * demand, only for the part of the Table that is visible, so a
+	 * model can generate or look up its data lazily.
+	 */
+	class TableModel
+	{
+	public:
+		/**
+		 * Returns the number of rows in the model.
+		 */
+		virtual int getRowCount() const = 0;
+
+		/**
+		 * Returns the number of columns in the model.
+		 */
+		virtual int getColumnCount() const = 0;
+
+		/**
+		 * Returns the name of a column, which is shown in the
+		 * header of the Table. The header is painted every
+		 * frame, so the name is returned by reference; it has
+		 * to stay valid until the columns of the model change.
+		 */
+		virtual const std::string & getColumnName(int column) const = 0;
+
+		/**
+		 * Stores the text of a cell in value. The string is
+		 * owned by the caller, which lets the Table reuse one
+		 * buffer for all the cells it paints.
+		 */
+		virtual void getValueAt(int row, int column, std::string &value) const = 0;
+
+		/**
+		 * Compares two rows on the given column.
+		 * @return
+		 *	a negative value if row0 comes before row1, zero
+		 *	if they are equal and a positive value otherwise.
+		 */
+		virtual int compare(int row0, int row1, int column) const = 0;
+
+		/**
+		 * Adds a listener which is notified of changes
+		 * in the model.
+		 */
+		virtual void addTableModelListener(event::TableModelListener *l) = 0;
+
+		/**
+		 * Removes a listener from the model.
+		 */
+		virtual void removeTableModelListener(event::TableModelListener *l) = 0;
+
+		virtual ~TableModel() {};
+	};
+
+	/**
+	 * Implements the listener management of a TableModel,
+	 * subclasses only need to provide the data and call the
+	 * fire methods when it changes. Rows are compared on the
+	 * text of their cells, models holding numbers should
+	 * override compare.
+	 */
+	class AbstractTableModel : public TableModel
+	{
+	public:
+		AbstractTableModel();
+
+		const std::string & getColumnName(int column) const;
+		int compare(int row0, int row1, int column) const;
+
+		void addTableModelListener(event::TableModelListener *l);
+		void removeTableModelListener(event::TableModelListener *l);
+
+		virtual ~AbstractTableModel();
+	protected:
+		/**
+		 * Notifies the listeners that any row may have changed.
+		 */
+		void fireTableDataChanged();
+
+		/**
+		 * Notifies the listeners that the columns changed.
+		 */
+		void fireTableStructureChanged();
+
+		/**
+		 * Notifies the listeners that rows firstRow to lastRow
+		 * (inclusive) changed.
+		 */
+		void fireTableRowsUpdated(int firstRow, int lastRow);
+
+		/**
+		 * Notifies the listeners that rows firstRow to lastRow
+		 * (inclusive) were inserted.
+		 */
+		void fireTableRowsInserted(int firstRow, int lastRow);
+
+		/**
+		 * Notifies the listeners that rows firstRow to lastRow
+		 * (inclusive) were removed.
+		 */
+		void fireTableRowsDeleted(int firstRow, int lastRow);
+
+		/**
+		 * Notifies the listeners of e.
+		 */
+		void fireTableChanged(const event::TableModelEvent &e);
+	private:
+		mutable std::string value0;
+		mutable std::string value1;
+
+		/**
+		 * The names made up so far, by column.
+		 */
+		mutable std::vector<std::string> columnNames;
+		event::TableModelListenerList tableModelListeners;
+	};
+}
+
+#endif
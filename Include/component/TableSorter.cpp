@@ -0,0 +1,413 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <functional>
+#include "./TableSorter.h"
+#include "../event/TableModelEvent.h"
+
+namespace ui
+{
+	TableSorter::RowComparator::RowComparator(const TableModel *m, int c, bool a)
+		:	model(m),
+			column(c),
+			ascending(a)
+	{
+	}
+
+	bool TableSorter::RowComparator::operator()(int row0, int row1) const
+	{
+		if(column != -1)
+		{
+			int result = model->compare(row0,row1,column);
+
+			if(result != 0)
+			{
+				return ascending ? result < 0 : result > 0;
+			}
+		}
+		return row0 < row1;
+	}
+
+	TableSorter::TableSorter(TableModel *m)
+		:	model(0),
+			filter(0),
+			sortColumn(-1),
+			ascending(true)
+	{
+		setModel(m);
+	}
+
+	TableSorter::~TableSorter()
+	{
+		if(model != 0)
+		{
+			model->removeTableModelListener(this);
+		}
+	}
+
+	void TableSorter::setModel(TableModel *m)
+	{
+		if(model != 0)
+		{
+			model->removeTableModelListener(this);
+		}
+
+		model = m;
+
+		if(model != 0)
+		{
+			model->addTableModelListener(this);
+		}
+
+		if(model == 0 || sortColumn >= model->getColumnCount())
+		{
+			sortColumn = -1;
+		}
+
+		reindex();
+		fireTableStructureChanged();
+	}
+
+	TableModel * TableSorter::getModel() const
+	{
+		return model;
+	}
+
+	void TableSorter::setFilter(TableFilter *f)
+	{
+		filter = f;
+		reindex();
+		fireTableDataChanged();
+	}
+
+	TableFilter * TableSorter::getFilter() const
+	{
+		return filter;
+	}
+
+	void TableSorter::setSortColumn(int column, bool a)
+	{
+		sortColumn = column;
+		ascending = a;
+		reindex();
+		fireTableDataChanged();
+	}
+
+	int TableSorter::getSortColumn() const
+	{
+		return sortColumn;
+	}
+
+	bool TableSorter::isAscending() const
+	{
+		return ascending;
+	}
+
+	void TableSorter::reindex()
+	{
+		previousIndices.swap(indices);
+		indices.clear();
+		viewIndices.clear();
+
+		if(model == 0)
+		{
+			return;
+		}
+
+		int rows = model->getRowCount();
+		indices.reserve(rows);
+		viewIndices.assign(rows,-1);
+
+		for(int row = 0; row < rows; ++row)
+		{
+			if(isIncluded(row))
+			{
+				indices.push_back(row);
+			}
+		}
+
+		if(sortColumn != -1)
+		{
+			std::stable_sort(indices.begin(),indices.end(),RowComparator(model,sortColumn,ascending));
+		}
+		updateViewIndices(0);
+	}
+
+	int TableSorter::convertRowIndexToModel(int row) const
+	{
+		return indices[row];
+	}
+
+	int TableSorter::convertRowIndexToView(int row) const
+	{
+		if(row < 0 || row >= static_cast<int>(viewIndices.size()))
+		{
+			return -1;
+		}
+		return viewIndices[row];
+	}
+
+	int TableSorter::convertPreviousRowIndexToModel(int row) const
+	{
+		if(row < 0 || row >= static_cast<int>(previousIndices.size()))
+		{
+			return -1;
+		}
+		return previousIndices[row];
+	}
+
+	int TableSorter::getRowCount() const
+	{
+		return static_cast<int>(indices.size());
+	}
+
+	int TableSorter::getColumnCount() const
+	{
+		return (model != 0) ? model->getColumnCount() : 0;
+	}
+
+	const std::string & TableSorter::getColumnName(int column) const
+	{
+		return model->getColumnName(column);
+	}
+
+	void TableSorter::getValueAt(int row, int column, std::string &value) const
+	{
+		model->getValueAt(indices[row],column,value);
+	}
+
+	int TableSorter::compare(int row0, int row1, int column) const
+	{
+		return model->compare(indices[row0],indices[row1],column);
+	}
+
+	void TableSorter::tableChanged(const event::TableModelEvent &e)
+	{
+		switch(e.getID())
+		{
+			case event::TableModelEvent::ROWS_INSERTED:
+			{
+				rowsInserted(e.getFirstRow(),e.getLastRow());
+				break;
+			}
+			case event::TableModelEvent::ROWS_DELETED:
+			{
+				rowsDeleted(e.getFirstRow(),e.getLastRow());
+				break;
+			}
+			case event::TableModelEvent::ROWS_UPDATED:
+			{
+				rowsUpdated(e.getFirstRow(),e.getLastRow());
+				break;
+			}
+			case event::TableModelEvent::STRUCTURE_CHANGED:
+			{
+				if(sortColumn >= getColumnCount())
+				{
+					sortColumn = -1;
+				}
+				reindex();
+				fireTableStructureChanged();
+				break;
+			}
+			default:
+			{
+				// all the data changed, so the permutation is rebuilt.
+				reindex();
+				fireTableDataChanged();
+				break;
+			}
+		}
+	}
+
+	bool TableSorter::isIncluded(int row) const
+	{
+		return filter == 0 || filter->include(model,row);
+	}
+
+	int TableSorter::findPosition(int row) const
+	{
+		return static_cast<int>(std::lower_bound(indices.begin(),indices.end(),row,RowComparator(model,sortColumn,ascending)) - indices.begin());
+	}
+
+	void TableSorter::updateViewIndices(std::size_t first)
+	{
+		for(std::size_t i = first; i < indices.size(); ++i)
+		{
+			viewIndices[indices[i]] = static_cast<int>(i);
+		}
+	}
+
+	void TableSorter::removeRows(std::vector<int> &rows)
+	{
+		// from the last row to the first, so the rows still to be
+		// removed keep their index, and every event describes the
+		// permutation as it is at that moment.
+		std::sort(rows.begin(),rows.end(),std::greater<int>());
+
+		for(std::vector<int>::const_iterator row = rows.begin(); row != rows.end(); ++row)
+		{
+			indices.erase(indices.begin() + *row);
+			updateViewIndices(*row);
+			fireTableRowsDeleted(*row,*row);
+		}
+	}
+
+	void TableSorter::insertRows(std::vector<int> &rows)
+	{
+		// in the order they are shown, so every row is inserted
+		// at the index it ends up at.
+		std::sort(rows.begin(),rows.end(),RowComparator(model,sortColumn,ascending));
+
+		for(std::vector<int>::const_iterator row = rows.begin(); row != rows.end(); ++row)
+		{
+			int position = findPosition(*row);
+			indices.insert(indices.begin() + position,*row);
+			updateViewIndices(position);
+			fireTableRowsInserted(position,position);
+		}
+	}
+
+	void TableSorter::rowsInserted(int firstRow, int lastRow)
+	{
+		int count = lastRow - firstRow + 1;
+
+		// the rows after the inserted ones move down, which does
+		// not change their order.
+		for(std::vector<int>::iterator i = indices.begin(); i != indices.end(); ++i)
+		{
+			if(*i >= firstRow)
+			{
+				*i += count;
+			}
+		}
+		viewIndices.insert(viewIndices.begin() + firstRow,count,-1);
+		updateViewIndices(0);
+
+		rows.clear();
+		for(int row = firstRow; row <= lastRow; ++row)
+		{
+			if(isIncluded(row))
+			{
+				rows.push_back(row);
+			}
+		}
+		insertRows(rows);
+	}
+
+	void TableSorter::rowsDeleted(int firstRow, int lastRow)
+	{
+		int count = lastRow - firstRow + 1;
+
+		positions.clear();
+		for(int row = firstRow; row <= lastRow; ++row)
+		{
+			if(viewIndices[row] != -1)
+			{
+				positions.push_back(viewIndices[row]);
+			}
+		}
+
+		// the rows after the deleted ones move up.
+		for(std::vector<int>::iterator i = indices.begin(); i != indices.end(); ++i)
+		{
+			if(*i > lastRow)
+			{
+				*i -= count;
+			}
+		}
+		viewIndices.erase(viewIndices.begin() + firstRow,viewIndices.begin() + lastRow + 1);
+		removeRows(positions);
+	}
+
+	void TableSorter::rowsUpdated(int firstRow, int lastRow)
+	{
+		positions.clear();
+		rows.clear();
+		for(int row = firstRow; row <= lastRow; ++row)
+		{
+			if(viewIndices[row] != -1)
+			{
+				positions.push_back(viewIndices[row]);
+				viewIndices[row] = -1;
+			}
+
+			if(isIncluded(row))
+			{
+				rows.push_back(row);
+			}
+		}
+
+		if(positions.empty())
+		{
+			insertRows(rows);
+		}
+		else if(rows.empty())
+		{
+			removeRows(positions);
+		}
+		else
+		{
+			// the updated rows are taken out first, the rest of the
+			// permutation is still in order then, and put back where
+			// they belong now.
+			previousIndices.assign(indices.begin(),indices.end());
+
+			std::vector<int>::iterator end = indices.begin();
+			for(std::vector<int>::iterator i = indices.begin(); i != indices.end(); ++i)
+			{
+				if(*i < firstRow || *i > lastRow)
+				{
+					*end++ = *i;
+				}
+			}
+			indices.erase(end,indices.end());
+
+			for(std::vector<int>::const_iterator row = rows.begin(); row != rows.end(); ++row)
+			{
+				indices.insert(indices.begin() + findPosition(*row),*row);
+			}
+			updateViewIndices(0);
+
+			if(rows.size() == positions.size())
+			{
+				// the rows between the old and new places move, but
+				// the rows outside of them keep their index.
+				for(std::vector<int>::const_iterator row = rows.begin(); row != rows.end(); ++row)
+				{
+					positions.push_back(viewIndices[*row]);
+				}
+				fireTableRowsUpdated(*std::min_element(positions.begin(),positions.end()),*std::max_element(positions.begin(),positions.end()));
+			}
+			else
+			{
+				fireTableDataChanged();
+			}
+		}
+	}
+}
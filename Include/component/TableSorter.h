@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TABLESORTER_H
+#define TABLESORTER_H
+
+#include <vector>
+#include "./TableModel.h"
+#include "../event/TableModelListener.h"
+
+namespace ui
+{
+	/**
+	 * Decides which rows of a TableModel a TableSorter shows.
+	 */
+	class TableFilter
+	{
+	public:
+		/**
+		 * Returns true if the row of model should be shown.
+		 */
+		virtual bool include(const TableModel *model, int row) const = 0;
+
+		virtual ~TableFilter() {};
+	};
+
+	/**
+	 * Sorts and filters the rows of another TableModel.
+	 * <p>
+	 * The TableSorter never copies or moves the data of the model
+	 * it decorates, it only keeps a permutation of row indices.
+	 * Cells are fetched from the decorated model through this
+	 * permutation, and rows are compared with TableModel::compare,
+	 * so a model can compare its own data without converting it
+	 * to text.
+	 * </p>
+	 * Sorting is stable, rows which compare equal keep the order
+	 * they have in the decorated model.
+	 * <p>
+	 * Rows which are inserted, deleted or updated in the decorated
+	 * model are moved in and out of the permutation one by one,
+	 * and the change is passed on as row events, so a Table keeps
+	 * its selection. Only a change of all the data sorts again.
+	 * </p>
+	 */
+	class TableSorter : public AbstractTableModel, public event::TableModelListener
+	{
+	public:
+		/**
+		 * Creates a new TableSorter decorating model.
+		 * @param
+		 *	model the TableModel to sort, can be 0.
+		 */
+		TableSorter(TableModel *model);
+
+		/**
+		 * Destructor.
+		 */
+		virtual ~TableSorter();
+
+		/**
+		 * Sets the model which is sorted.
+		 */
+		void setModel(TableModel *model);
+
+		/**
+		 * Returns the model which is sorted.
+		 */
+		TableModel * getModel() const;
+
+		/**
+		 * Sets the filter, 0 shows all rows.
+		 */
+		void setFilter(TableFilter *filter);
+
+		/**
+		 * Returns the filter, or 0 if all rows are shown.
+		 */
+		TableFilter * getFilter() const;
+
+		/**
+		 * Sorts the rows on column. A column of -1 shows
+		 * the rows in the order of the decorated model.
+		 */
+		void setSortColumn(int column, bool ascending = true);
+
+		/**
+		 * Returns the column the rows are sorted on, or -1.
+		 */
+		int getSortColumn() const;
+
+		/**
+		 * Returns true if the rows are sorted in ascending
+		 * order.
+		 */
+		bool isAscending() const;
+
+		/**
+		 * Applies the filter and sort order again. Call this
+		 * when the criteria of the filter changed.
+		 */
+		void reindex();
+
+		/**
+		 * Converts a row of this model to the corresponding
+		 * row of the decorated model.
+		 */
+		int convertRowIndexToModel(int row) const;
+
+		/**
+		 * Converts a row of the decorated model to the
+		 * corresponding row of this model.
+		 * @return
+		 *	the row of this model, or -1 if the row is
+		 *	filtered out or does not exist.
+		 */
+		int convertRowIndexToView(int row) const;
+
+		/**
+		 * Converts a row of this model, as it was before the rows
+		 * were sorted or filtered again, to the corresponding row
+		 * of the decorated model. This is valid while listeners
+		 * are notified of the DATA_CHANGED or ROWS_UPDATED event
+		 * which reordered the rows.
+		 * @return
+		 *	the row of the decorated model, or -1.
+		 */
+		int convertPreviousRowIndexToModel(int row) const;
+
+		int getRowCount() const;
+		int getColumnCount() const;
+		const std::string & getColumnName(int column) const;
+		void getValueAt(int row, int column, std::string &value) const;
+		int compare(int row0, int row1, int column) const;
+
+		void tableChanged(const event::TableModelEvent &e);
+	private:
+		TableSorter(const TableSorter &rhs);
+		TableSorter& operator=(const TableSorter &rhs);
+
+		/**
+		 * Orders rows of the decorated model on the sort column,
+		 * and rows which compare equal on their index, which is
+		 * the order a stable sort leaves them in.
+		 */
+		class RowComparator
+		{
+		public:
+			RowComparator(const TableModel *model, int column, bool ascending);
+			bool operator()(int row0, int row1) const;
+		private:
+			const TableModel *model;
+			int column;
+			bool ascending;
+		};
+
+		bool isIncluded(int row) const;
+		int findPosition(int row) const;
+		void updateViewIndices(std::size_t first);
+		void removeRows(std::vector<int> &rows);
+		void insertRows(std::vector<int> &rows);
+
+		void rowsInserted(int firstRow, int lastRow);
+		void rowsDeleted(int firstRow, int lastRow);
+		void rowsUpdated(int firstRow, int lastRow);
+
+		TableModel *model;
+		TableFilter *filter;
+		int sortColumn;
+		bool ascending;
+
+		/**
+		 * The row of the decorated model for every row
+		 * of this model.
+		 */
+		std::vector<int> indices;
+
+		/**
+		 * The row of this model for every row of the decorated
+		 * model, -1 for rows which are filtered out.
+		 */
+		std::vector<int> viewIndices;
+
+		/**
+		 * The permutation before the rows were last ordered
+		 * again.
+		 */
+		std::vector<int> previousIndices;
+
+		/**
+		 * The changed rows of this model and of the decorated
+		 * model, reused between events.
+		 */
+		std::vector<int> positions;
+		std::vector<int> rows;
+	};
+}
+
+#endif
@@ -0,0 +1,481 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./TextArea.h"
+#include "../GlyphContext.h"
+#include "../event/PropertyEvent.h"
+#include "../util/Insets.h"
+
+namespace ui
+{
+	TextArea::TextArea(const std::string &text)
+	{
+		init(text);
+	}
+
+	TextArea::TextArea()
+	{
+		init("");
+	}
+
+	TextArea::~TextArea()
+	{
+		std::vector<Paragraph*>::iterator iter;
+		for(iter = paragraphs.begin(); iter != paragraphs.end(); ++iter)
+		{
+			delete *iter;
+		}
+	}
+
+	void TextArea::init(const std::string &text)
+	{
+		textRevision = 0;
+		generation = 1;
+		wrapWidth = -1;
+		wrapFont = 0;
+		wrapAlgorithm = 0;
+		averageAdvance = defaultAdvance;
+		algorithm = &wordWrap;
+		lineHeight = 16;
+		preferredRows = 8;
+		preferredColumns = 40;
+		viewportSet = false;
+
+		setThemeName("TextArea");
+		setText(text);
+	}
+
+	void TextArea::setText(const std::string &text)
+	{
+		std::vector<Paragraph*>::iterator iter;
+		for(iter = paragraphs.begin(); iter != paragraphs.end(); ++iter)
+		{
+			delete *iter;
+		}
+		paragraphs.clear();
+		paragraphs.push_back(new Paragraph());
+		lineCounts.assign(1,1);
+
+		std::string::size_type lineBreak = text.find('\n');
+		paragraphs.front()->text.assign(text,0,lineBreak);
+
+		if(lineBreak != std::string::npos)
+		{
+			insertParagraphs(0,text,lineBreak + 1,std::string());
+		}
+
+		validateLayout();
+		lineCounts.set(0,estimateLineCount(paragraphs.front()));
+		fireTextChanged();
+	}
+
+	const std::string TextArea::getText() const
+	{
+		std::string text;
+		std::vector<Paragraph*>::const_iterator iter;
+		for(iter = paragraphs.begin(); iter != paragraphs.end(); ++iter)
+		{
+			if(iter != paragraphs.begin())
+			{
+				text += '\n';
+			}
+			text += (*iter)->text;
+		}
+		return text;
+	}
+
+	void TextArea::append(const std::string &text)
+	{
+		std::size_t last = paragraphs.size() - 1;
+		std::string::size_type lineBreak = text.find('\n');
+
+		paragraphs[last]->text.append(text,0,lineBreak);
+		paragraphChanged(last);
+
+		if(lineBreak != std::string::npos)
+		{
+			insertParagraphs(last,text,lineBreak + 1,std::string());
+		}
+		fireTextChanged();
+	}
+
+	void TextArea::insertText(std::size_t paragraph, std::size_t offset, const std::string &text)
+	{
+		assert(paragraph < paragraphs.size());
+
+		Paragraph *p = paragraphs[paragraph];
+		std::string::size_type lineBreak = text.find('\n');
+
+		offset = std::min(offset,p->text.length());
+
+		if(lineBreak == std::string::npos)
+		{
+			p->text.insert(offset,text);
+		}
+		else
+		{
+			// the text after the insertion point ends up in
+			// the last inserted paragraph.
+			std::string tail(p->text,offset,std::string::npos);
+			p->text.erase(offset);
+			p->text.append(text,0,lineBreak);
+			insertParagraphs(paragraph,text,lineBreak + 1,tail);
+		}
+		paragraphChanged(paragraph);
+		fireTextChanged();
+	}
+
+	void TextArea::removeText(std::size_t paragraph, std::size_t offset, std::size_t length)
+	{
+		assert(paragraph < paragraphs.size());
+
+		Paragraph *p = paragraphs[paragraph];
+
+		if(offset < p->text.length() && length > 0)
+		{
+			p->text.erase(offset,length);
+			paragraphChanged(paragraph);
+			fireTextChanged();
+		}
+	}
+
+	void TextArea::removeParagraphs(std::size_t first, std::size_t count)
+	{
+		if(first >= paragraphs.size())
+		{
+			return;
+		}
+		count = std::min(count,paragraphs.size() - first);
+
+		for(std::size_t i = first; i < first + count; ++i)
+		{
+			delete paragraphs[i];
+		}
+		paragraphs.erase(paragraphs.begin() + first,paragraphs.begin() + first + count);
+		lineCounts.erase(first,count);
+
+		if(paragraphs.empty())
+		{
+			paragraphs.push_back(new Paragraph());
+			lineCounts.append(1);
+		}
+		fireTextChanged();
+	}
+
+	std::size_t TextArea::getParagraphCount() const
+	{
+		return paragraphs.size();
+	}
+
+	const std::string & TextArea::getParagraph(std::size_t paragraph) const
+	{
+		assert(paragraph < paragraphs.size());
+		return paragraphs[paragraph]->text;
+	}
+
+	const theme::LineSpanBuffer & TextArea::getParagraphLines(std::size_t paragraph) const
+	{
+		assert(paragraph < paragraphs.size());
+
+		validateLayout();
+		wrapParagraph(paragraph);
+		return paragraphs[paragraph]->lines;
+	}
+
+	std::size_t TextArea::getParagraphLine(std::size_t paragraph) const
+	{
+		validateLayout();
+		return static_cast<std::size_t>(lineCounts.getPrefixSum(paragraph));
+	}
+
+	std::size_t TextArea::getParagraphAtLine(std::size_t line) const
+	{
+		validateLayout();
+		return std::min(lineCounts.find(static_cast<int>(line)),paragraphs.size() - 1);
+	}
+
+	std::size_t TextArea::getLineCount() const
+	{
+		validateLayout();
+		return static_cast<std::size_t>(lineCounts.getTotal());
+	}
+
+	void TextArea::setLineHeight(int height)
+	{
+		lineHeight = std::max(height,1);
+		invalidate();
+	}
+
+	int TextArea::getLineHeight() const
+	{
+		return lineHeight;
+	}
+
+	void TextArea::setPreferredLines(int rows, int columns)
+	{
+		preferredRows = rows;
+		preferredColumns = columns;
+		invalidate();
+	}
+
+	void TextArea::setTextWrappingAlgorithm(const theme::TextWrappingAlgorithm *a)
+	{
+		algorithm = (a != 0) ? a : &wordWrap;
+		invalidate();
+	}
+
+	const theme::TextWrappingAlgorithm * TextArea::getTextWrappingAlgorithm() const
+	{
+		return algorithm;
+	}
+
+	std::size_t TextArea::getTextRevision() const
+	{
+		return textRevision;
+	}
+
+	const util::Rectangle TextArea::getVisibleRect() const
+	{
+		if(viewportSet)
+		{
+			return viewport;
+		}
+		return util::Rectangle(0,0,getBounds().width,getBounds().height);
+	}
+
+	bool TextArea::isInViewport() const
+	{
+		return viewportSet;
+	}
+
+	const util::Dimension TextArea::getScrollableSize() const
+	{
+		// the width follows the viewport, lines are wrapped to it.
+		return util::Dimension(0,static_cast<int>(getLineCount()) * lineHeight + getInsets().top + getInsets().bottom);
+	}
+
+	const util::Dimension TextArea::getPreferredViewportSize() const
+	{
+		validateLayout();
+		return util::Dimension(preferredColumns * averageAdvance + getInsets().left + getInsets().right,preferredRows * lineHeight + getInsets().top + getInsets().bottom);
+	}
+
+	void TextArea::setViewport(const util::Rectangle &v)
+	{
+		viewport = v;
+		viewportSet = true;
+
+		std::size_t total = getLineCount();
+
+		// wrap the paragraphs in view, so the number of lines
+		// is exact where it matters.
+		int top = std::max(v.y - getInsets().top,0) / lineHeight;
+		int bottom = std::max(v.y + v.height - getInsets().top,0) / lineHeight;
+
+		for(std::size_t p = getParagraphAtLine(top); p < paragraphs.size() && getParagraphLine(p) <= static_cast<std::size_t>(bottom); ++p)
+		{
+			wrapParagraph(p);
+		}
+
+		// the ScrollPane needs to know the new size of the content,
+		// also when this happens while it is being validated.
+		if(total != getLineCount())
+		{
+			invalidate();
+		}
+	}
+
+	void TextArea::validateLayout() const
+	{
+		int width = std::max(getBounds().width - getInsets().left - getInsets().right,0);
+		Font *font = getFont();
+
+		if(width == wrapWidth && font == wrapFont && algorithm == wrapAlgorithm)
+		{
+			return;
+		}
+
+		if(font != wrapFont)
+		{
+			averageAdvance = defaultAdvance;
+			if(font != 0)
+			{
+				int sample = getContext()->getGlyphContext().getStringBoundingBox(font,"abcdefghijklmnopqrstuvwxyz").width;
+				averageAdvance = std::max(sample / 26,1);
+			}
+
+			std::vector<Paragraph*>::const_iterator iter;
+			for(iter = paragraphs.begin(); iter != paragraphs.end(); ++iter)
+			{
+				(*iter)->textWidth = -1;
+			}
+		}
+
+		wrapWidth = width;
+		wrapFont = font;
+		wrapAlgorithm = algorithm;
+
+		// a new generation discards all wrapped lines, without
+		// visiting every paragraph.
+		++generation;
+
+		lineCounts.assign(paragraphs.size(),1);
+		for(std::size_t i = 0; i < paragraphs.size(); ++i)
+		{
+			int lines = estimateLineCount(paragraphs[i]);
+			if(lines != 1)
+			{
+				lineCounts.set(i,lines);
+			}
+		}
+	}
+
+	int TextArea::estimateLineCount(const Paragraph *paragraph) const
+	{
+		if(wrapFont == 0 || wrapWidth <= 0)
+		{
+			return 1;
+		}
+
+		int width = paragraph->textWidth;
+		if(width < 0)
+		{
+			width = static_cast<int>(paragraph->text.length()) * averageAdvance;
+		}
+		return std::max((width + wrapWidth - 1) / wrapWidth,1);
+	}
+
+	void TextArea::wrapParagraph(std::size_t paragraph) const
+	{
+		Paragraph *p = paragraphs[paragraph];
+
+		if(p->generation == generation)
+		{
+			return;
+		}
+
+		std::size_t count = 0;
+
+		if(wrapFont == 0 || wrapWidth <= 0)
+		{
+			// nothing to measure with, or no room to wrap
+			// in. Keep the paragraph on a single line.
+			theme::LineSpan &span = theme::TextUtil::appendLineSpan(p->lines,count);
+			span.offset = 0;
+			span.length = p->text.length();
+			span.width = 0;
+		}
+		else
+		{
+			measured.measure(getContext()->getGlyphContext(),p->text,wrapFont);
+			p->textWidth = measured.getPrefixWidths().back();
+			count = wrapAlgorithm->wrapSpans(p->text,measured,wrapWidth,p->lines,0);
+		}
+
+		p->lines.resize(count);
+		p->generation = generation;
+
+		if(lineCounts.get(paragraph) != static_cast<int>(count))
+		{
+			lineCounts.set(paragraph,static_cast<int>(count));
+		}
+	}
+
+	void TextArea::insertParagraphs(std::size_t paragraph, const std::string &text, std::string::size_type index, const std::string &tail)
+	{
+		std::vector<Paragraph*> inserted;
+		std::string::size_type lineBreak;
+
+		do
+		{
+			lineBreak = text.find('\n',index);
+
+			Paragraph *p = new Paragraph();
+			p->text.assign(text,index,lineBreak == std::string::npos ? std::string::npos : lineBreak - index);
+			inserted.push_back(p);
+
+			index = lineBreak + 1;
+		}
+		while(lineBreak != std::string::npos);
+
+		inserted.back()->text.append(tail);
+
+		// new paragraphs are wrapped once they are shown.
+		std::size_t position = paragraph + 1;
+
+		if(position == paragraphs.size())
+		{
+			std::vector<Paragraph*>::const_iterator iter;
+			for(iter = inserted.begin(); iter != inserted.end(); ++iter)
+			{
+				paragraphs.push_back(*iter);
+				lineCounts.append(estimateLineCount(*iter));
+			}
+		}
+		else
+		{
+			paragraphs.insert(paragraphs.begin() + position,inserted.begin(),inserted.end());
+			lineCounts.insert(position,inserted.size(),1);
+
+			for(std::size_t i = position; i < position + inserted.size(); ++i)
+			{
+				int lines = estimateLineCount(paragraphs[i]);
+				if(lines != 1)
+				{
+					lineCounts.set(i,lines);
+				}
+			}
+		}
+	}
+
+	void TextArea::paragraphChanged(std::size_t paragraph)
+	{
+		Paragraph *p = paragraphs[paragraph];
+		p->textWidth = -1;
+		p->generation = 0;
+
+		validateLayout();
+		wrapParagraph(paragraph);
+	}
+
+	void TextArea::fireTextChanged()
+	{
+		++textRevision;
+		invalidate();
+
+		event::PropertyEvent e(this,event::PropertyEvent::SPECIAL,TextArea::TEXTCHANGE);
+		processPropertyEvent(e);
+	}
+
+// ---------------------------------------------------------------------------
+
+	TextArea::Paragraph::Paragraph()
+		:	textWidth(-1),
+			generation(0)
+	{
+	}
+}
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TEXTAREA_H
+#define TEXTAREA_H
+
+#include "../Component.h"
+#include "../Scrollable.h"
+#include "../theme/TextUtil.h"
+#include "../util/PrefixSumTree.h"
+
+namespace ui
+{
+	/**
+	 * Shows multiple lines of text, wrapped to its width.
+	 * <p>
+	 * The text is stored as a list of paragraphs, one for every line
+	 * break in the text. Each paragraph caches the lines it was wrapped
+	 * into, and the number of lines of all paragraphs is kept in a
+	 * PrefixSumTree, so the paragraph at a given line can be found in
+	 * logarithmic time. Editing a paragraph only wraps that paragraph
+	 * again, and appending text does not touch the existing paragraphs,
+	 * which makes a TextArea suitable for logs of many thousands of lines.
+	 * </p>
+	 * <p>
+	 * Paragraphs are wrapped when they are first shown. Until then, their
+	 * number of lines is estimated from their length. A TextArea is meant
+	 * to be placed in a ScrollPane, which it cooperates with through the
+	 * Scrollable interface, and its theme only paints the lines which are
+	 * inside the viewport.
+	 * </p>
+	 * Listeners are notified with a PropertyEvent::SPECIAL and TEXTCHANGE
+	 * whenever the text changes.
+	 */
+	class TextArea : public Component, public Scrollable
+	{
+	public:
+		/**
+		 * Creates a new TextArea showing the given text.
+		 */
+		TextArea(const std::string &text);
+
+		/**
+		 * Creates an empty TextArea.
+		 */
+		TextArea();
+
+		/**
+		 * Destructor.
+		 */
+		virtual ~TextArea();
+
+		/**
+		 * Replaces all text. This does not wrap the text,
+		 * paragraphs are wrapped when they are shown.
+		 */
+		void setText(const std::string &text);
+
+		/**
+		 * Returns all text, with the paragraphs separated by
+		 * line breaks. This copies the text of every paragraph.
+		 */
+		const std::string getText() const;
+
+		/**
+		 * Appends text to the end of the last paragraph. Every
+		 * line break in the text starts a new paragraph.
+		 */
+		void append(const std::string &text);
+
+		/**
+		 * Inserts text into a paragraph. Every line break in the
+		 * text splits the paragraph.
+		 * @param
+		 *	paragraph the index of the paragraph.
+		 * @param
+		 *	offset the byte offset in the paragraph to insert at.
+		 */
+		void insertText(std::size_t paragraph, std::size_t offset, const std::string &text);
+
+		/**
+		 * Removes text from a paragraph. The range is clipped
+		 * to the paragraph, paragraphs are never joined.
+		 * @param
+		 *	paragraph the index of the paragraph.
+		 * @param
+		 *	offset the byte offset of the first byte to remove.
+		 * @param
+		 *	length the number of bytes to remove.
+		 */
+		void removeText(std::size_t paragraph, std::size_t offset, std::size_t length);
+
+		/**
+		 * Removes whole paragraphs. This takes time linear in the
+		 * number of paragraphs, so logs should remove old paragraphs
+		 * in batches rather than one at a time. At least one, empty,
+		 * paragraph always remains.
+		 */
+		void removeParagraphs(std::size_t first, std::size_t count);
+
+		/**
+		 * Returns the number of paragraphs, which is always
+		 * at least one.
+		 */
+		std::size_t getParagraphCount() const;
+
+		/**
+		 * Returns the text of a paragraph, without its line break.
+		 */
+		const std::string & getParagraph(std::size_t paragraph) const;
+
+		/**
+		 * Returns the lines a paragraph is wrapped into, as ranges of
+		 * the text of the paragraph. The paragraph is wrapped if it
+		 * has not been wrapped for the current width and Font.
+		 */
+		const theme::LineSpanBuffer & getParagraphLines(std::size_t paragraph) const;
+
+		/**
+		 * Returns the index of the first line of a paragraph.
+		 * The index counts wrapped lines, not paragraphs.
+		 */
+		std::size_t getParagraphLine(std::size_t paragraph) const;
+
+		/**
+		 * Returns the paragraph containing a line. Lines past
+		 * the end belong to the last paragraph.
+		 */
+		std::size_t getParagraphAtLine(std::size_t line) const;
+
+		/**
+		 * Returns the number of lines, counting paragraphs which
+		 * have not been wrapped yet by their estimated number
+		 * of lines.
+		 */
+		std::size_t getLineCount() const;
+
+		/**
+		 * Sets the height of every line.
+		 */
+		void setLineHeight(int height);
+
+		/**
+		 * Returns the height of every line.
+		 */
+		int getLineHeight() const;
+
+		/**
+		 * Sets the number of lines and the number of average
+		 * characters per line the TextArea would like to show.
+		 */
+		void setPreferredLines(int rows, int columns);
+
+		/**
+		 * Sets the algorithm used to wrap paragraphs. The
+		 * algorithm is not owned by the TextArea.
+		 * @param
+		 *	algorithm the algorithm, 0 restores the default,
+		 *	which wraps words greedily.
+		 */
+		void setTextWrappingAlgorithm(const theme::TextWrappingAlgorithm *algorithm);
+
+		/**
+		 * Returns the algorithm used to wrap paragraphs.
+		 */
+		const theme::TextWrappingAlgorithm * getTextWrappingAlgorithm() const;
+
+		/**
+		 * Returns a number which changes whenever the text changes.
+		 */
+		std::size_t getTextRevision() const;
+
+		/**
+		 * Returns the part of the TextArea which is visible,
+		 * relative to the TextArea. This is the viewport of the
+		 * ScrollPane the TextArea is in, or its bounds otherwise.
+		 */
+		const util::Rectangle getVisibleRect() const;
+
+		/**
+		 * Returns true if the TextArea is shown in the viewport
+		 * of a ScrollPane.
+		 */
+		bool isInViewport() const;
+
+		const util::Dimension getScrollableSize() const;
+		const util::Dimension getPreferredViewportSize() const;
+		void setViewport(const util::Rectangle &viewport);
+
+		enum PROPERTYEVENTS
+		{
+			TEXTCHANGE = 1
+		};
+	private:
+		TextArea(const TextArea &rhs);
+		TextArea& operator=(const TextArea &rhs);
+
+		/**
+		 * A paragraph and the lines it was last wrapped into.
+		 */
+		struct Paragraph
+		{
+			Paragraph();
+
+			std::string text;
+
+			// the width of the text on a single line, or -1
+			// if the text has not been measured.
+			int textWidth;
+
+			// the layout generation the lines were wrapped in.
+			std::size_t generation;
+			theme::LineSpanBuffer lines;
+		};
+
+		void init(const std::string &text);
+
+		/**
+		 * Starts a new layout generation if the width, Font or
+		 * algorithm changed, and estimates the number of lines
+		 * of all paragraphs for it.
+		 */
+		void validateLayout() const;
+
+		/**
+		 * Wraps a paragraph if it was not wrapped in the
+		 * current layout generation.
+		 */
+		void wrapParagraph(std::size_t paragraph) const;
+
+		int estimateLineCount(const Paragraph *paragraph) const;
+
+		/**
+		 * Inserts a new paragraph after the given paragraph for
+		 * every line of text from index on. The tail is appended
+		 * to the last new paragraph.
+		 */
+		void insertParagraphs(std::size_t paragraph, const std::string &text, std::string::size_type index, const std::string &tail);
+
+		/**
+		 * Marks a paragraph as edited, and wraps it again.
+		 */
+		void paragraphChanged(std::size_t paragraph);
+
+		void fireTextChanged();
+
+		/**
+		 * The assumed width of a character when there is no
+		 * Font to measure it with.
+		 */
+		static const int defaultAdvance = 6;
+
+		std::vector<Paragraph*> paragraphs;
+		std::size_t textRevision;
+
+		mutable util::PrefixSumTree lineCounts;
+		mutable std::size_t generation;
+		mutable int wrapWidth;
+		mutable Font *wrapFont;
+		mutable const theme::TextWrappingAlgorithm *wrapAlgorithm;
+		mutable int averageAdvance;
+		mutable theme::MeasuredText measured;
+
+		theme::WordWrapAlgorithm wordWrap;
+		const theme::TextWrappingAlgorithm *algorithm;
+
+		int lineHeight;
+		int preferredRows;
+		int preferredColumns;
+
+		util::Rectangle viewport;
+		bool viewportSet;
+	};
+}
+
+#endif
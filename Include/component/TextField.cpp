@@ -26,7 +26,9 @@
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include "./TextField.h"
+#include "../GlyphContext.h"
 #include "../event/PropertyEvent.h"
+#include "../util/Utf8.h"
 
 namespace ui
 {
@@ -42,6 +44,17 @@ namespace ui
 
 	void TextField::init(const std::string &text)
 	{
+		textRevision = 0;
+		textCopyRevision = 0;
+		caret = 0;
+		anchor = 0;
+		widthsValid = false;
+		measuredFont = GlyphContext::noFont;
+		textWidth = 0;
+		caretX = 0;
+		anchorX = 0;
+		scrollOffset = 0;
+
 		setThemeName("TextField");
 		setText(text);
 		echoCharacter = 0;
@@ -50,16 +63,331 @@ namespace ui
 
 	void TextField::setText(const std::string &t)
 	{
-		text = t;
-		event::PropertyEvent e(this,event::PropertyEvent::SPECIAL,TextField::TEXTCHANGE);
-		processPropertyEvent(e);
+		buffer.assign(t);
+		caret = anchor = t.length();
+		widthsValid = false;
+		fireTextChanged();
 	}
 
 	const std::string & TextField::getText() const
 	{
+		if(textCopyRevision != textRevision)
+		{
+			buffer.getText(text);
+			textCopyRevision = textRevision;
+		}
 		return text;
 	}
 
+	std::size_t TextField::getTextRevision() const
+	{
+		return textRevision;
+	}
+
+	const util::DecodedText & TextField::getDecodedText() const
+	{
+		decodedText.update(getText(),textRevision);
+		return decodedText;
+	}
+
+	void TextField::insertText(const std::string &t)
+	{
+		removeSelection();
+		buffer.insert(caret,t);
+
+		if(widthsValid)
+		{
+			int width = measure(caret,caret + t.length());
+			textWidth += width;
+			caretX += width;
+		}
+		caret += t.length();
+		anchor = caret;
+		anchorX = caretX;
+		fireTextChanged();
+	}
+
+	void TextField::deleteBackward()
+	{
+		if(hasSelection())
+		{
+			removeSelection();
+		}
+		else if(caret > 0)
+		{
+			std::size_t start = previousCharacter(caret);
+			if(widthsValid)
+			{
+				int width = measure(start,caret);
+				textWidth -= width;
+				caretX -= width;
+			}
+			buffer.erase(start,caret - start);
+			caret = anchor = start;
+			anchorX = caretX;
+		}
+		else
+		{
+			return;
+		}
+		fireTextChanged();
+	}
+
+	void TextField::deleteForward()
+	{
+		if(hasSelection())
+		{
+			removeSelection();
+		}
+		else if(caret < buffer.length())
+		{
+			std::size_t end = nextCharacter(caret);
+			if(widthsValid)
+			{
+				textWidth -= measure(caret,end);
+			}
+			buffer.erase(caret,end - caret);
+		}
+		else
+		{
+			return;
+		}
+		fireTextChanged();
+	}
+
+	void TextField::removeSelection()
+	{
+		if(!hasSelection())
+		{
+			return;
+		}
+
+		std::size_t start = getSelectionStart();
+		std::size_t end = getSelectionEnd();
+
+		if(widthsValid)
+		{
+			textWidth -= measure(start,end);
+			caretX = anchorX = std::min(caretX,anchorX);
+		}
+		buffer.erase(start,end - start);
+		caret = anchor = start;
+	}
+
+	void TextField::moveCaretLeft(bool select)
+	{
+		validateWidths();
+
+		if(!select && hasSelection())
+		{
+			moveCaret(getSelectionStart(),std::min(caretX,anchorX),false);
+		}
+		else
+		{
+			std::size_t position = previousCharacter(caret);
+			moveCaret(position,caretX - measure(position,caret),select);
+		}
+	}
+
+	void TextField::moveCaretRight(bool select)
+	{
+		validateWidths();
+
+		if(!select && hasSelection())
+		{
+			moveCaret(getSelectionEnd(),std::max(caretX,anchorX),false);
+		}
+		else
+		{
+			std::size_t position = nextCharacter(caret);
+			moveCaret(position,caretX + measure(caret,position),select);
+		}
+	}
+
+	void TextField::moveCaretHome(bool select)
+	{
+		validateWidths();
+		moveCaret(0,0,select);
+	}
+
+	void TextField::moveCaretEnd(bool select)
+	{
+		validateWidths();
+		moveCaret(buffer.length(),textWidth,select);
+	}
+
+	void TextField::setCaretPosition(std::size_t position, bool select)
+	{
+		validateWidths();
+
+		position = std::min(position,buffer.length());
+		while(position > 0 && position < buffer.length() && util::Utf8::isContinuation(buffer.at(position)))
+		{
+			--position;
+		}
+		moveCaret(position,measure(0,position),select);
+	}
+
+	void TextField::moveCaret(std::size_t position, int x, bool select)
+	{
+		caret = position;
+		caretX = x;
+		if(!select)
+		{
+			anchor = caret;
+			anchorX = caretX;
+		}
+		fireCaretChanged();
+	}
+
+	std::size_t TextField::getCaretPosition() const
+	{
+		return caret;
+	}
+
+	void TextField::selectAll()
+	{
+		validateWidths();
+		anchor = 0;
+		anchorX = 0;
+		caret = buffer.length();
+		caretX = textWidth;
+		fireCaretChanged();
+	}
+
+	bool TextField::hasSelection() const
+	{
+		return caret != anchor;
+	}
+
+	std::size_t TextField::getSelectionStart() const
+	{
+		return std::min(caret,anchor);
+	}
+
+	std::size_t TextField::getSelectionEnd() const
+	{
+		return std::max(caret,anchor);
+	}
+
+	int TextField::getTextWidth() const
+	{
+		validateWidths();
+		return textWidth;
+	}
+
+	int TextField::getCaretX() const
+	{
+		validateWidths();
+		return caretX;
+	}
+
+	int TextField::getAnchorX() const
+	{
+		validateWidths();
+		return anchorX;
+	}
+
+	int TextField::getScrollOffset(int viewWidth) const
+	{
+		validateWidths();
+
+		if(caretX - scrollOffset > viewWidth)
+		{
+			scrollOffset = caretX - viewWidth;
+		}
+		if(caretX < scrollOffset)
+		{
+			scrollOffset = caretX;
+		}
+
+		// don't leave empty space at the end when text is removed.
+		if(textWidth - scrollOffset < viewWidth)
+		{
+			scrollOffset = std::max(0,textWidth - viewWidth);
+		}
+		return scrollOffset;
+	}
+
+	void TextField::validateWidths() const
+	{
+		if(!widthsValid || measuredFont != getFontHandle())
+		{
+			measuredFont = getFontHandle();
+			widthsValid = true;
+			textWidth = measure(0,buffer.length());
+			caretX = measure(0,caret);
+			anchorX = measure(0,anchor);
+		}
+	}
+
+	int TextField::measure(std::size_t begin, std::size_t end) const
+	{
+		if(end <= begin || getFontHandle() == GlyphContext::noFont)
+		{
+			return 0;
+		}
+		buffer.copy(begin,end - begin,piece);
+		return getContext()->getGlyphContext().getStringBoundingBox(getFontHandle(),piece).width;
+	}
+
+	unsigned int TextField::getCodepoint(std::size_t position, std::size_t &next) const
+	{
+		buffer.copy(position,4,piece);
+
+		std::size_t index = 0;
+		unsigned int codepoint = util::Utf8::decode(piece,index);
+		next = position + index;
+		return codepoint;
+	}
+
+	std::size_t TextField::previousCharacter(std::size_t position) const
+	{
+		std::size_t next;
+		while(position > 0)
+		{
+			do
+			{
+				--position;
+			}
+			while(position > 0 && util::Utf8::isContinuation(buffer.at(position)));
+
+			if(!util::DecodedText::isExtending(getCodepoint(position,next)))
+			{
+				break;
+			}
+		}
+		return position;
+	}
+
+	std::size_t TextField::nextCharacter(std::size_t position) const
+	{
+		std::size_t next;
+		if(position < buffer.length())
+		{
+			getCodepoint(position,next);
+			position = next;
+		}
+		while(position < buffer.length() && util::DecodedText::isExtending(getCodepoint(position,next)))
+		{
+			position = next;
+		}
+		return position;
+	}
+
+	void TextField::fireTextChanged()
+	{
+		++textRevision;
+		event::PropertyEvent e(this,event::PropertyEvent::SPECIAL,TextField::TEXTCHANGE);
+		processPropertyEvent(e);
+	}
+
+	void TextField::fireCaretChanged()
+	{
+		event::PropertyEvent e(this,event::PropertyEvent::SPECIAL,TextField::CARETCHANGE);
+		processPropertyEvent(e);
+	}
+
 	void TextField::setEchoCharacter(int c)
 	{
 		echoCharacter = c;
@@ -101,21 +429,38 @@ namespace ui
 	{
 		TextField *textField(static_cast<TextField*>(e.getSource()));
 
-		std::string str(textField->getText());
+		bool shift = (e.getModifier() & event::KeyEvent::MOD_LSHIFT) || (e.getModifier() & event::KeyEvent::MOD_RSHIFT);
 
 		if(e.getKeyCode() == event::KeyEvent::VKUI_BACKSPACE)
 		{
-					// backspace
-			str = str.substr(0,str.length()-1);
-		//	cursorPosition--;
-		//	cursorPosition = std::max(0,cursorPosition);
+			textField->deleteBackward();
+		}
+		else if(e.getKeyCode() == event::KeyEvent::VKUI_DELETE)
+		{
+			textField->deleteForward();
 		}
 		else if(e.getKeyCode() == event::KeyEvent::VKUI_LEFT)
 		{
-			// move the cursor left
+			textField->moveCaretLeft(shift);
 		}
 		else if(e.getKeyCode() == event::KeyEvent::VKUI_RIGHT)
 		{
+			textField->moveCaretRight(shift);
+		}
+		else if(e.getKeyCode() == event::KeyEvent::VKUI_HOME)
+		{
+			textField->moveCaretHome(shift);
+		}
+		else if(e.getKeyCode() == event::KeyEvent::VKUI_END)
+		{
+			textField->moveCaretEnd(shift);
+		}
+		else if(e.getCharacter() >= 0x20 && e.getCharacter() != 0x7f)
+		{
+			// the character typed, in any script.
+			std::string typed;
+			util::Utf8::encode(e.getCharacter(),typed);
+			textField->insertText(typed);
 		}
 		else if((e.getKeyCode() == event::KeyEvent::VKUI_UP) ||
 			(e.getKeyCode() == event::KeyEvent::VKUI_DOWN) ||
@@ -132,21 +477,18 @@ namespace ui
 		{
 			// keys we just ignore
 		}
-		else
+		else if(e.getCharacter() == 0)
 		{
-			// normal keys
+			// normal keys, without a character from the
+			// application the character is guessed.
 			std::string tmp(1,(char)e.getKeyCode());
 			// check for uppercase
-			if((e.getModifier() & event::KeyEvent::MOD_LSHIFT) ||
-			(e.getModifier() & event::KeyEvent::MOD_RSHIFT) ||
-			(e.getModifier() & event::KeyEvent::MOD_CAPS))
+			if(shift || (e.getModifier() & event::KeyEvent::MOD_CAPS))
 			{
 				std::transform(tmp.begin(),tmp.end(),tmp.begin(),toupper);
 			}
-			str.append(tmp);
-		//	cursorPosition++;
+			textField->insertText(tmp);
 		}
-		textField->setText(str);
 	}
 
 	void TextField::TextListener::keyReleased(const event::KeyEvent &e)
@@ -156,4 +498,4 @@ namespace ui
 	void TextField::TextListener::keyTyped(const event::KeyEvent &e)
 	{
 	}
-}
\ No newline at end of file
+}
@@ -31,18 +31,154 @@
 #include "../Component.h"
 #include "../event/KeyListener.h"
 #include "../event/KeyEvent.h"
+#include "../util/DecodedText.h"
+#include "../util/GapBuffer.h"
 
 namespace ui
 {
+	/**
+	 * A single line of editable text.
+	 * <p>
+	 * The text is stored in a GapBuffer, so an edit at the caret costs
+	 * time in the size of the edit. The width of the text and the
+	 * horizontal position of the caret are updated from the width of
+	 * the edited characters only; the theme never has to measure the
+	 * whole text again while the user types. Characters are measured
+	 * on their own, so kerning between an edit and its neighbours is
+	 * not taken into account until the text is measured again by
+	 * setText, setCaretPosition or a change of Font.
+	 * </p>
+	 * Positions are byte offsets in the UTF-8 text, and the caret
+	 * only stops between characters.
+	 */
 	class TextField : public Component
 	{
 	public:
 		TextField(const std::string &text);
 		TextField();
 
+		/**
+		 * Returns the text. The text is copied out of the
+		 * GapBuffer at most once per revision.
+		 */
 		const std::string & getText() const;
+
+		/**
+		 * Replaces the text and moves the caret to its end.
+		 */
 		void setText(const std::string &text);
 
+		/**
+		 * Replaces the selection with text, or inserts text
+		 * at the caret if nothing is selected.
+		 */
+		void insertText(const std::string &text);
+
+		/**
+		 * Removes the selection, or the character before the caret.
+		 */
+		void deleteBackward();
+
+		/**
+		 * Removes the selection, or the character after the caret.
+		 */
+		void deleteForward();
+
+		/**
+		 * Moves the caret one character to the left.
+		 * @param
+		 *	select true to extend the selection, false to
+		 *	collapse it.
+		 */
+		void moveCaretLeft(bool select);
+
+		/**
+		 * Moves the caret one character to the right.
+		 * @param
+		 *	select true to extend the selection, false to
+		 *	collapse it.
+		 */
+		void moveCaretRight(bool select);
+
+		/**
+		 * Moves the caret to the start of the text.
+		 */
+		void moveCaretHome(bool select);
+
+		/**
+		 * Moves the caret to the end of the text.
+		 */
+		void moveCaretEnd(bool select);
+
+		/**
+		 * Moves the caret to a position, which is moved to the
+		 * start of the character it is in. This measures the
+		 * text before the position.
+		 */
+		void setCaretPosition(std::size_t position, bool select);
+
+		/**
+		 * Returns the byte offset of the caret.
+		 */
+		std::size_t getCaretPosition() const;
+
+		/**
+		 * Selects the whole text.
+		 */
+		void selectAll();
+
+		/**
+		 * Returns true if some text is selected.
+		 */
+		bool hasSelection() const;
+
+		/**
+		 * Returns the offset of the first selected byte.
+		 */
+		std::size_t getSelectionStart() const;
+
+		/**
+		 * Returns the offset after the last selected byte.
+		 */
+		std::size_t getSelectionEnd() const;
+
+		/**
+		 * Returns the width of the text in the current Font.
+		 */
+		int getTextWidth() const;
+
+		/**
+		 * Returns the horizontal position of the caret,
+		 * relative to the start of the text.
+		 */
+		int getCaretX() const;
+
+		/**
+		 * Returns the horizontal position of the selection
+		 * anchor, the end of the selection which is not at
+		 * the caret.
+		 */
+		int getAnchorX() const;
+
+		/**
+		 * Returns how far the text must be scrolled to the
+		 * left to keep the caret inside a view of the given
+		 * width. The offset only changes when the caret would
+		 * leave the view.
+		 */
+		int getScrollOffset(int viewWidth) const;
+
+		/**
+		 * Returns a number which changes whenever the text changes.
+		 */
+		std::size_t getTextRevision() const;
+
+		/**
+		 * Returns the code points and character boundaries of
+		 * the text, decoded at most once per revision.
+		 */
+		const util::DecodedText & getDecodedText() const;
+
 		void setEchoCharacter(int c);
 
 		int getEchoCharacter() const;
@@ -51,7 +187,8 @@ namespace ui
 
 		enum PROPERTYEVENTS
 		{
-			TEXTCHANGE = 1
+			TEXTCHANGE = 1,
+			CARETCHANGE = 2
 		};
 	private:
 		class TextListener : public event::KeyListener
@@ -67,9 +204,50 @@ namespace ui
 			TextField *parent;
 		};
 		void init(const std::string &text);
-		std::string text;
+
+		/**
+		 * Returns the offset of the character before or after
+		 * position, stepping over combining marks.
+		 */
+		std::size_t previousCharacter(std::size_t position) const;
+		std::size_t nextCharacter(std::size_t position) const;
+
+		/**
+		 * Decodes the code point starting at position.
+		 */
+		unsigned int getCodepoint(std::size_t position, std::size_t &next) const;
+
+		/**
+		 * Returns the width of the text between two offsets.
+		 */
+		int measure(std::size_t begin, std::size_t end) const;
+
+		/**
+		 * Measures the text and the caret position if the text
+		 * was replaced or the Font changed since the last time.
+		 */
+		void validateWidths() const;
+
+		void removeSelection();
+		void moveCaret(std::size_t position, int x, bool select);
+		void fireTextChanged();
+		void fireCaretChanged();
+
+		util::GapBuffer buffer;
+		mutable std::string text;
+		mutable std::size_t textCopyRevision;
+		std::size_t textRevision;
+		mutable util::DecodedText decodedText;
 		int echoCharacter;
 		TextListener listener;
+
+		std::size_t caret, anchor;
+
+		mutable bool widthsValid;
+		mutable FontHandle measuredFont;
+		mutable int textWidth, caretX, anchorX;
+		mutable int scrollOffset;
+		mutable std::string piece;
 	};
 }
 
@@ -74,8 +74,8 @@ namespace ui
 		dragging = false;
 		nextX = 0;
 		nextY = 0;
-		addMouseListener(this);
-		closeButton.addMouseListener(this);
+		addMouseListener(this,event::MouseEvent::MOUSE_PRESSED_MASK|event::MouseEvent::MOUSE_RELEASED_MASK|event::MouseEvent::MOUSE_DRAGGED_MASK);
+		closeButton.addMouseListener(this,event::MouseEvent::MOUSE_PRESSED_MASK|event::MouseEvent::MOUSE_RELEASED_MASK|event::MouseEvent::MOUSE_DRAGGED_MASK);
 	}
 
 	Label * TitleBar::getTitleLabel()
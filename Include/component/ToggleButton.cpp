@@ -57,7 +57,7 @@ namespace ui
 		setSelected(selected);
 		setThemeName("ToggleButton");
 		addFocusListener(this);
-		addMouseListener(this);
+		addMouseListener(this,event::MouseEvent::MOUSE_PRESSED_MASK);
 	}
 
 	void ToggleButton::focusGained(const event::FocusEvent &e)
@@ -28,6 +28,7 @@
 #include "./Window.h"
 #include "../event/WindowEvent.h"
 #include "../Graphics.h"
+#include "../FocusManager.h"
 
 namespace ui
 {
@@ -51,6 +52,8 @@ namespace ui
 	{
 		window->setParent(this);
 		windowList.push_back(window);
+		getContext()->getFocusManager().removeFocusRing(window);
+		getContext()->getFocusManager().invalidateFocusRing(this);
 
 	}
 
@@ -67,12 +70,14 @@ namespace ui
 		{
 			(*pos)->setParent(0);
 			windowList.erase(pos);
+			getContext()->getFocusManager().invalidateFocusRing(this);
 		}
 	}
 
 	void Window::removeOwnedWindows()
 	{
 		windowList.clear();
+		getContext()->getFocusManager().invalidateFocusRing(this);
 	}
 
 	void Window::add(Component *comp, int constraints)
@@ -115,7 +120,7 @@ namespace ui
 		windowListenerList.clear();
 	}
 
-	const event::WindowListenerList Window::getWindowListeners() const
+	const event::WindowListenerList& Window::getWindowListeners() const
 	{
 		return windowListenerList;
 	}
@@ -234,6 +239,9 @@ namespace ui
 	{
 		Container::paintChildren(g);
 
+		// owned windows are painted over the text of this one.
+		g.flush();
+
 		WindowList::const_iterator iter;
 		for(iter = windowList.begin(); iter != windowList.end(); ++iter)
 		{
@@ -178,7 +178,7 @@ namespace ui
 		 * @return
 		 *	All registered Window Listeners.
 		 */
-		const event::WindowListenerList getWindowListeners() const;
+		const event::WindowListenerList& getWindowListeners() const;
 
 		/**
 		 * Forwards the event to the registered listeners and appropriate
@@ -41,7 +41,9 @@ namespace ui
 
 			enum STATECHANGES
 			{
-				RANGE = 1
+				RANGE = 1,
+
+				SELECTION = 2
 			};
 
 			/**
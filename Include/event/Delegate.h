@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DELEGATE_H
+#define DELEGATE_H
+
+#include "../Pointers.h"
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+namespace ui
+{
+	namespace event
+	{
+		/**
+		 * A callback for events of type EventType. A Delegate is two
+		 * pointers, an object and a function that calls the right
+		 * member on it, so it can be copied around and stored by value
+		 * without allocating anything.
+		 * <pre>
+		 * Delegate<MouseEvent>::fromMethod<Knob,&Knob::mousePressed>(this)
+		 * Delegate<MouseEvent>::fromFunction<&onClick>()
+		 * Delegate<MouseEvent>::fromFunctor(&functionObject)
+		 * </pre>
+		 * Delegates compare equal when they call the same function on
+		 * the same object, which is how they are removed again.
+		 */
+		template<class EventType>
+		class Delegate
+		{
+		public:
+			Delegate()
+				:	object(0),
+					stub(0)
+			{
+			}
+
+			/**
+			 * Returns a Delegate that calls a free function.
+			 */
+			template<void (*Function)(const EventType&)>
+			static Delegate fromFunction()
+			{
+				return Delegate(0,&functionStub<Function>);
+			}
+
+			/**
+			 * Returns a Delegate that calls a member function on
+			 * object. Virtual functions are called virtually.
+			 */
+			template<class T, void (T::*Method)(const EventType&)>
+			static Delegate fromMethod(T *object)
+			{
+				return Delegate(object,&methodStub<T,Method>);
+			}
+
+			/**
+			 * Returns a Delegate that calls operator() on functor.
+			 * The functor is not copied, so it has to outlive the
+			 * Delegate.
+			 */
+			template<class T>
+			static Delegate fromFunctor(T *functor)
+			{
+				return Delegate(functor,&functorStub<T>);
+			}
+
+			/**
+			 * Calls the function.
+			 */
+			void operator()(const EventType &e) const
+			{
+				stub(object,e);
+			}
+
+			/**
+			 * Returns true if the Delegate calls something.
+			 */
+			bool isBound() const
+			{
+				return stub != 0;
+			}
+
+			/**
+			 * Returns the object the Delegate calls a function on,
+			 * or 0 for free functions.
+			 */
+			void * getObject() const
+			{
+				return object;
+			}
+
+			bool operator==(const Delegate &rhs) const
+			{
+				return object == rhs.object && stub == rhs.stub;
+			}
+
+			bool operator!=(const Delegate &rhs) const
+			{
+				return !(*this == rhs);
+			}
+		private:
+			typedef void (*Stub)(void *object, const EventType &e);
+
+			Delegate(void *o, Stub s)
+				:	object(o),
+					stub(s)
+			{
+			}
+
+			template<void (*Function)(const EventType&)>
+			static void functionStub(void *, const EventType &e)
+			{
+				Function(e);
+			}
+
+			template<class T, void (T::*Method)(const EventType&)>
+			static void methodStub(void *object, const EventType &e)
+			{
+				(static_cast<T*>(object)->*Method)(e);
+			}
+
+			template<class T>
+			static void functorStub(void *object, const EventType &e)
+			{
+				(*static_cast<T*>(object))(e);
+			}
+
+			void *object;
+			Stub stub;
+		};
+
+		/**
+		 * Delegates for events of type EventType, kept in a separate
+		 * list per event identifier. Dispatching an event only calls
+		 * the Delegates registered for its identifier, and lists for
+		 * identifiers nobody registered for are never created.
+		 * <p>
+		 * Delegates removed while the table dispatches are only
+		 * unbound, and taken out of the lists when the outermost
+		 * dispatch returns, so the ones after them are still called.
+		 * </p>
+		 */
+		template<class EventType>
+		class DelegateTable
+		{
+		public:
+			typedef std::vector<Delegate<EventType> > DelegateList;
+
+			DelegateTable()
+				:	dispatching(0),
+					unbound(false)
+			{
+			}
+
+			/**
+			 * Adds delegate to the list for id.
+			 */
+			void add(int id, const Delegate<EventType> &delegate)
+			{
+				assert(id >= 0);
+				if(static_cast<int>(lists.size()) <= id)
+				{
+					lists.resize(id + 1);
+				}
+				lists[id].push_back(delegate);
+			}
+
+			/**
+			 * Removes delegate from the list for id.
+			 */
+			void remove(int id, const Delegate<EventType> &delegate)
+			{
+				if(id >= 0 && id < static_cast<int>(lists.size()))
+				{
+					DelegateList &list = lists[id];
+					if(dispatching > 0)
+					{
+						std::replace(list.begin(),list.end(),delegate,Delegate<EventType>());
+						unbound = true;
+					}
+					else
+					{
+						list.erase(std::remove(list.begin(),list.end(),delegate),list.end());
+					}
+				}
+			}
+
+			/**
+			 * Removes all Delegates.
+			 */
+			void clear()
+			{
+				if(dispatching > 0)
+				{
+					for(std::size_t i = 0; i < lists.size(); ++i)
+					{
+						std::fill(lists[i].begin(),lists[i].end(),Delegate<EventType>());
+					}
+					unbound = true;
+				}
+				else
+				{
+					lists.clear();
+				}
+			}
+
+			/**
+			 * Returns true if there is a Delegate for id.
+			 */
+			bool has(int id) const
+			{
+				return id >= 0 && id < static_cast<int>(lists.size()) && hasBound(lists[id]);
+			}
+
+			/**
+			 * Returns true if there are no Delegates at all.
+			 */
+			bool isEmpty() const
+			{
+				for(std::size_t i = 0; i < lists.size(); ++i)
+				{
+					if(hasBound(lists[i]))
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+
+			/**
+			 * Calls the Delegates for the identifier of e, in the
+			 * order they were added. Delegates may add or remove
+			 * Delegates while this runs.
+			 */
+			void dispatch(const EventType &e)
+			{
+				int id = e.getID();
+				if(id < 0 || id >= static_cast<int>(lists.size()))
+				{
+					return;
+				}
+
+				// by index, the lists may grow while we call.
+				++dispatching;
+				for(std::size_t i = 0; i < lists[id].size(); ++i)
+				{
+					Delegate<EventType> delegate = lists[id][i];
+					if(delegate.isBound())
+					{
+						delegate(e);
+					}
+				}
+				--dispatching;
+
+				if(dispatching == 0 && unbound)
+				{
+					compact();
+				}
+			}
+		private:
+			bool hasBound(const DelegateList &list) const
+			{
+				if(!unbound)
+				{
+					return !list.empty();
+				}
+				for(std::size_t i = 0; i < list.size(); ++i)
+				{
+					if(list[i].isBound())
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+
+			void compact()
+			{
+				for(std::size_t i = 0; i < lists.size(); ++i)
+				{
+					DelegateList &list = lists[i];
+					list.erase(std::remove(list.begin(),list.end(),Delegate<EventType>()),list.end());
+				}
+				unbound = false;
+			}
+
+			std::vector<DelegateList> lists;
+			int dispatching;
+			bool unbound;
+		};
+	}
+}
+
+#endif
@@ -31,10 +31,11 @@ namespace ui
 {
 	namespace event
 	{
-		KeyEvent::KeyEvent(Component* source, int id, int kCode, int mod)
+		KeyEvent::KeyEvent(Component* source, int id, int kCode, int mod, unsigned int c)
 			:	Event(source,id),
 				keyCode(kCode),
-				modifiers(mod)
+				modifiers(mod),
+				character(c)
 
 		{
 		}
@@ -48,5 +49,10 @@ namespace ui
 		{
 			return modifiers;
 		}
+
+		unsigned int KeyEvent::getCharacter() const
+		{
+			return character;
+		}
 	}
 }
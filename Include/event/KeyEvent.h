@@ -54,7 +54,7 @@ namespace ui
 			 *	modifiers the modifier used while generating this Event. Modifiers
 			 *	are keys like SHIFT, CTRL and ALT.
 			 */
-			KeyEvent(Component* source, int id, int keyCode, int modifiers);
+			KeyEvent(Component* source, int id, int keyCode, int modifiers, unsigned int character = 0);
 
 			enum
 			{
@@ -250,8 +250,15 @@ namespace ui
 			 */
 			int getModifier() const;
 
+			/**
+			 * Return the unicode code point typed, or 0 if the
+			 * key does not produce a character.
+			 */
+			unsigned int getCharacter() const;
+
 		private:
 			int keyCode, modifiers;
+			unsigned int character;
 		};
 	}
 }
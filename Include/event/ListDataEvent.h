@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LISTDATAEVENT_H
+#define LISTDATAEVENT_H
+
+#include "./Event.h"
+
+namespace ui
+{
+	namespace event
+	{
+		/**
+		 * Describes a change in a ListModel. The change
+		 * covers the closed interval [index0, index1].
+		 */
+		class ListDataEvent : public Event
+		{
+		public:
+			/**
+			 * Kinds of change.
+			 */
+			enum EventTypes
+			{
+				/**
+				 * The contents of the interval changed.
+				 */
+				CONTENTS_CHANGED,
+
+				/**
+				 * The interval was inserted into the model.
+				 */
+				INTERVAL_ADDED,
+
+				/**
+				 * The interval was removed from the model.
+				 */
+				INTERVAL_REMOVED
+			};
+
+			/**
+			 * Creates a new ListDataEvent.
+			 * @param
+			 *	model the ListModel that changed.
+			 * @param
+			 *	id the kind of change.
+			 * @param
+			 *	index0 first index of the interval.
+			 * @param
+			 *	index1 last index of the interval.
+			 */
+			ListDataEvent(ListModel *model, int id, int index0, int index1);
+
+			/**
+			 * Returns the ListModel that changed.
+			 */
+			ListModel * getModel() const;
+
+			/**
+			 * Returns the lower index of the interval.
+			 */
+			int getIndex0() const;
+
+			/**
+			 * Returns the upper index of the interval.
+			 */
+			int getIndex1() const;
+		private:
+			ListModel *model;
+			int index0, index1;
+		};
+	}
+}
+#endif
@@ -31,11 +31,12 @@ namespace ui
 {
 	namespace event
 	{
-		MouseEvent::MouseEvent(Component* sourceComponent, int id, int x, int y, int mouseButton)
+		MouseEvent::MouseEvent(Component* sourceComponent, int id, int x, int y, int mouseButton, int pointer)
 			:	Event(sourceComponent, id),
 				mouseX(x),
 				mouseY(y),
-				button(mouseButton)
+				button(mouseButton),
+				pointerId(pointer)
 		{
 		}
 
@@ -53,5 +54,10 @@ namespace ui
 		{
 			return mouseY;
 		}
+
+		int MouseEvent::getPointer() const
+		{
+			return pointerId;
+		}
 	}
 }
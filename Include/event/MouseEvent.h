@@ -30,6 +30,7 @@
 #define MOUSEEVENT_H
 
 #include "Event.h"
+#include "./Delegate.h"
 
 
 namespace ui
@@ -80,6 +81,22 @@ namespace ui
 				MOUSE_MOTION
 			};
 
+			/**
+			 * Masks for each event type, to be or-ed together
+			 * when adding a MouseListener to a Component.
+			 */
+			enum MouseEventMasks
+			{
+				MOUSE_PRESSED_MASK = 1 << MOUSE_PRESSED,
+				MOUSE_RELEASED_MASK = 1 << MOUSE_RELEASED,
+				MOUSE_CLICKED_MASK = 1 << MOUSE_CLICKED,
+				MOUSE_EXITED_MASK = 1 << MOUSE_EXITED,
+				MOUSE_DRAGGED_MASK = 1 << MOUSE_DRAGGED,
+				MOUSE_ENTERED_MASK = 1 << MOUSE_ENTERED,
+				MOUSE_MOTION_MASK = 1 << MOUSE_MOTION,
+				MOUSE_ALL_MASK = (1 << (MOUSE_MOTION + 1)) - 1
+			};
+
 			enum MouseButtons
 			{
 				MOUSE_BUTTON1, //left
@@ -92,8 +109,11 @@ namespace ui
 			/**
 			 * Creates a new MouseEvent with the specified
 			 * Component as source.
+			 * @param
+			 *	pointer Id of the pointer which caused the event,
+			 *	0 is the mouse.
 			 */
-			MouseEvent(Component* sourceComponent, int id, int x, int y, int mouseButton);
+			MouseEvent(Component* sourceComponent, int id, int x, int y, int mouseButton, int pointer = 0);
 
 			/**
 			 * Returns the button that generated this event.
@@ -109,9 +129,18 @@ namespace ui
 			 * Returns the y location of the MouseEvent.
 			 */
 			int getY() const;
+
+			/**
+			 * Returns the id of the pointer which caused this
+			 * event. The mouse is pointer 0, touches and other
+			 * mice have ids of their own.
+			 */
+			int getPointer() const;
 		private:
-			int mouseX, mouseY, button;
+			int mouseX, mouseY, button, pointerId;
 		};
+
+		typedef Delegate<MouseEvent> MouseDelegate;
 	}
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TABLEMODELEVENT_H
+#define TABLEMODELEVENT_H
+
+#include "./Event.h"
+
+namespace ui
+{
+	namespace event
+	{
+		/**
+		 * Describes a change in a TableModel. The change
+		 * covers the rows in the closed interval [firstRow, lastRow],
+		 * or all rows if the event is of type DATA_CHANGED or
+		 * STRUCTURE_CHANGED.
+		 */
+		class TableModelEvent : public Event
+		{
+		public:
+			/**
+			 * Kinds of change.
+			 */
+			enum EventTypes
+			{
+				/**
+				 * The values of any row may have changed, and
+				 * the number of rows may be different.
+				 */
+				DATA_CHANGED,
+
+				/**
+				 * The number or names of the columns changed.
+				 */
+				STRUCTURE_CHANGED,
+
+				/**
+				 * The values of the interval changed.
+				 */
+				ROWS_UPDATED,
+
+				/**
+				 * The interval was inserted into the model.
+				 */
+				ROWS_INSERTED,
+
+				/**
+				 * The interval was removed from the model.
+				 */
+				ROWS_DELETED
+			};
+
+			/**
+			 * Creates a new TableModelEvent.
+			 * @param
+			 *	model the TableModel that changed.
+			 * @param
+			 *	id the kind of change.
+			 * @param
+			 *	firstRow first row of the interval.
+			 * @param
+			 *	lastRow last row of the interval.
+			 */
+			TableModelEvent(TableModel *model, int id, int firstRow = 0, int lastRow = 0);
+
+			/**
+			 * Returns the TableModel that changed.
+			 */
+			TableModel * getModel() const;
+
+			/**
+			 * Returns the first row of the interval.
+			 */
+			int getFirstRow() const;
+
+			/**
+			 * Returns the last row of the interval.
+			 */
+			int getLastRow() const;
+		private:
+			TableModel *model;
+			int firstRow, lastRow;
+		};
+	}
+}
+#endif
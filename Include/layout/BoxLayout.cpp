@@ -0,0 +1,554 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./BoxLayout.h"
+#include "../Container.h"
+#include "../util/Dimension.h"
+#include "../util/Insets.h"
+#include "../util/Rectangle.h"
+
+namespace ui
+{
+	namespace layout
+	{
+		BoxLayout::Item::Item(Component *comp)
+			:	component(comp),
+				grow(0),
+				shrink(1),
+				basis(-1),
+				alignSelf(-1),
+				main(0),
+				cross(0)
+		{
+		}
+
+		BoxLayout::BoxLayout()
+			:	direction(Component::HORIZONTAL),
+				wrap(false),
+				justify(START),
+				alignItems(STRETCH)
+		{
+		}
+
+		BoxLayout::BoxLayout(int dir)
+			:	direction(dir),
+				wrap(false),
+				justify(START),
+				alignItems(STRETCH)
+		{
+		}
+
+		BoxLayout::BoxLayout(int dir, bool w, int hgap, int vgap)
+			:	direction(dir),
+				wrap(w),
+				justify(START),
+				alignItems(STRETCH)
+		{
+			setHgap(hgap);
+			setVgap(vgap);
+		}
+
+		BoxLayout::BoxLayout(const BoxLayout& rhs)
+			:	LayoutManager(rhs),
+				direction(rhs.direction),
+				wrap(rhs.wrap),
+				justify(rhs.justify),
+				alignItems(rhs.alignItems),
+				items(rhs.items),
+				index(rhs.index)
+		{
+		}
+
+		BoxLayout& BoxLayout::operator =(const BoxLayout& rhs)
+		{
+			BoxLayout temp(rhs);
+			swap(temp);
+			return *this;
+		}
+
+		void BoxLayout::swap(BoxLayout& rhs) throw()
+		{
+			LayoutManager::swap(rhs);
+			std::swap(direction,rhs.direction);
+			std::swap(wrap,rhs.wrap);
+			std::swap(justify,rhs.justify);
+			std::swap(alignItems,rhs.alignItems);
+			items.swap(rhs.items);
+			lines.swap(rhs.lines);
+			index.swap(rhs.index);
+		}
+
+		void BoxLayout::addLayoutComponent(Component* comp, int constraint)
+		{
+			Item &item = getItem(comp);
+
+			// -1 is the default of Container::add(), don't lose
+			// what setFlex() was told before the add.
+			if(constraint >= 0)
+			{
+				item.grow = constraint;
+			}
+		}
+
+		void BoxLayout::removeLayoutComponent(Component* comp)
+		{
+			ItemIndex::iterator pos = index.find(comp);
+			if(pos == index.end())
+			{
+				return;
+			}
+
+			// the last Item takes the place of the removed one, the
+			// order is restored by synchronize.
+			std::size_t i = pos->second;
+			index.erase(pos);
+			if(i != items.size() - 1)
+			{
+				items[i] = items.back();
+				index[items[i].component] = i;
+			}
+			items.pop_back();
+		}
+
+		void BoxLayout::setFlex(Component* comp, int grow, int shrink, int basis)
+		{
+			Item &item = getItem(comp);
+			item.grow = std::max(grow,0);
+			item.shrink = std::max(shrink,0);
+			item.basis = basis;
+			invalidateParent(comp);
+		}
+
+		void BoxLayout::setAlignSelf(Component* comp, int alignment)
+		{
+			getItem(comp).alignSelf = alignment;
+			invalidateParent(comp);
+		}
+
+		void BoxLayout::invalidateParent(Component* comp)
+		{
+			if(comp->getParent() != 0)
+			{
+				comp->getParent()->invalidate();
+			}
+		}
+
+		void BoxLayout::setDirection(int dir)
+		{
+			direction = dir;
+		}
+
+		int BoxLayout::getDirection() const
+		{
+			return direction;
+		}
+
+		void BoxLayout::setWrap(bool w)
+		{
+			wrap = w;
+		}
+
+		bool BoxLayout::isWrap() const
+		{
+			return wrap;
+		}
+
+		void BoxLayout::setJustifyContent(int j)
+		{
+			justify = j;
+		}
+
+		int BoxLayout::getJustifyContent() const
+		{
+			return justify;
+		}
+
+		void BoxLayout::setAlignItems(int alignment)
+		{
+			alignItems = alignment;
+		}
+
+		int BoxLayout::getAlignItems() const
+		{
+			return alignItems;
+		}
+
+		BoxLayout::Item& BoxLayout::getItem(Component *comp)
+		{
+			ItemIndex::iterator pos = index.find(comp);
+			if(pos != index.end())
+			{
+				return items[pos->second];
+			}
+			index.insert(std::make_pair(comp,items.size()));
+			items.push_back(Item(comp));
+			return items.back();
+		}
+
+		void BoxLayout::reindex()
+		{
+			index.clear();
+			for(std::size_t i = 0; i < items.size(); ++i)
+			{
+				index.insert(std::make_pair(items[i].component,i));
+			}
+		}
+
+		void BoxLayout::synchronize(const Container* parent)
+		{
+			// the items are kept in the same order as the children, so
+			// the common case (nothing was added, removed or reordered)
+			// is a single linear comparison.
+			const ComponentList &children = parent->getChildren();
+
+			bool inSync = (items.size() == children.size());
+
+			for(std::size_t i = 0; inSync && i < items.size(); ++i)
+			{
+				inSync = (items[i].component == children[i]);
+			}
+
+			if(!inSync)
+			{
+				// one pass over the children, each finds its Item
+				// through the index.
+				reordered.clear();
+				reordered.reserve(children.size());
+
+				ComponentList::const_iterator iter;
+				for(iter = children.begin(); iter != children.end(); ++iter)
+				{
+					ItemIndex::const_iterator pos = index.find(*iter);
+					reordered.push_back(pos != index.end() ? items[pos->second] : Item(*iter));
+				}
+				items.swap(reordered);
+				reindex();
+			}
+		}
+
+		int BoxLayout::getMain(const util::Dimension &dim) const
+		{
+			return direction == Component::VERTICAL ? dim.height : dim.width;
+		}
+
+		int BoxLayout::getCross(const util::Dimension &dim) const
+		{
+			return direction == Component::VERTICAL ? dim.width : dim.height;
+		}
+
+		int BoxLayout::getMainGap() const
+		{
+			return direction == Component::VERTICAL ? getVgap() : getHgap();
+		}
+
+		int BoxLayout::getCrossGap() const
+		{
+			return direction == Component::VERTICAL ? getHgap() : getVgap();
+		}
+
+		const util::Dimension BoxLayout::preferredLayoutSize(const Container* parent) const
+		{
+			const ComponentList &children = parent->getChildren();
+
+			int main = 0, cross = 0;
+			bool first = true;
+
+			for(std::size_t i = 0; i < children.size(); ++i)
+			{
+				const Component *comp = children[i];
+
+				if(comp->isVisible())
+				{
+					int basis = -1;
+
+					// items mirror the children once the Container has been laid out
+					if(i < items.size() && items[i].component == comp)
+					{
+						basis = items[i].basis;
+					}
+
+					if(first)
+					{
+						first = false;
+					}
+					else
+					{
+						main += getMainGap();
+					}
+
+					main += basis >= 0 ? basis : getMain(comp->getPreferredSize());
+					cross = std::max(cross,getCross(comp->getPreferredSize()));
+				}
+			}
+
+			const util::Insets &insets = parent->getInsets();
+
+			if(direction == Component::VERTICAL)
+			{
+				return util::Dimension(cross + insets.left + insets.right, main + insets.top + insets.bottom);
+			}
+			return util::Dimension(main + insets.left + insets.right, cross + insets.top + insets.bottom);
+		}
+
+		void BoxLayout::layoutContainer(const Container* parent)
+		{
+			synchronize(parent);
+
+			const util::Insets &insets = parent->getInsets();
+			util::Dimension available(parent->getBounds().width - insets.left - insets.right, parent->getBounds().height - insets.top - insets.bottom);
+
+			int mainSize = getMain(available);
+			int crossSize = getCross(available);
+
+			// first pass: measure the Components and break them into lines.
+			lines.clear();
+
+			Line line = {0, 0, 0, 0, 0, 0};
+			bool empty = true;
+
+			for(std::size_t i = 0; i < items.size(); ++i)
+			{
+				Item &item = items[i];
+
+				if(!item.component->isVisible())
+				{
+					continue;
+				}
+
+				const util::Dimension &preferred = item.component->getPreferredSize();
+				item.main = item.basis >= 0 ? item.basis : getMain(preferred);
+				item.cross = getCross(preferred);
+
+				if(!empty)
+				{
+					if(wrap && line.main + getMainGap() + item.main > mainSize)
+					{
+						line.end = i;
+						lines.push_back(line);
+
+						Line next = {i, i, 0, 0, 0, 0};
+						line = next;
+					}
+					else
+					{
+						line.main += getMainGap();
+					}
+				}
+
+				line.main += item.main;
+				line.cross = std::max(line.cross,item.cross);
+				line.grow += item.grow;
+				line.shrink += item.shrink * item.main;
+				empty = false;
+			}
+
+			if(empty)
+			{
+				return;
+			}
+
+			line.end = items.size();
+			lines.push_back(line);
+
+			// the lines share the freeSpace space on the cross axis.
+			int crossFree = crossSize - static_cast<int>(lines.size() - 1) * getCrossGap();
+			for(LineList::const_iterator iter = lines.begin(); iter != lines.end(); ++iter)
+			{
+				crossFree -= iter->cross;
+			}
+
+			// second pass: resolve the flexible lengths and position each line.
+			int x = insets.left;
+			int y = insets.top;
+			int linesLeft = static_cast<int>(lines.size());
+
+			for(LineList::iterator iter = lines.begin(); iter != lines.end(); ++iter)
+			{
+				int lineCross = iter->cross;
+
+				if(crossFree > 0)
+				{
+					int share = crossFree / linesLeft;
+					lineCross += share;
+					crossFree -= share;
+				}
+				--linesLeft;
+
+				arrangeLine(*iter, x, y, mainSize, lineCross);
+
+				if(direction == Component::VERTICAL)
+				{
+					x += lineCross + getCrossGap();
+				}
+				else
+				{
+					y += lineCross + getCrossGap();
+				}
+			}
+		}
+
+		void BoxLayout::arrangeLine(const Line &line, int x, int y, int mainSize, int crossSize)
+		{
+			int freeSpace = mainSize - line.main;
+			int count = 0;
+
+			if(freeSpace > 0 && line.grow > 0)
+			{
+				int growLeft = line.grow;
+
+				for(std::size_t i = line.begin; i < line.end; ++i)
+				{
+					Item &item = items[i];
+					if(item.component->isVisible() && item.grow > 0)
+					{
+						int share = freeSpace * item.grow / growLeft;
+						item.main += share;
+						freeSpace -= share;
+						growLeft -= item.grow;
+					}
+				}
+			}
+			else if(freeSpace < 0 && line.shrink > 0)
+			{
+				double shrinkLeft = line.shrink;
+
+				for(std::size_t i = line.begin; i < line.end; ++i)
+				{
+					Item &item = items[i];
+					if(item.component->isVisible() && item.shrink > 0 && item.main > 0)
+					{
+						double weight = static_cast<double>(item.shrink) * item.main;
+						int share = std::min(static_cast<int>(-freeSpace * weight / shrinkLeft), item.main);
+						item.main -= share;
+						freeSpace += share;
+						shrinkLeft -= weight;
+					}
+				}
+			}
+
+			for(std::size_t i = line.begin; i < line.end; ++i)
+			{
+				if(items[i].component->isVisible())
+				{
+					++count;
+				}
+			}
+
+			// distribute what is left of the freeSpace space on the main axis.
+			int position = 0;
+			int spacing = 0;
+			int spacingLeft = 0;
+			int gaps = 0;
+
+			if(freeSpace > 0)
+			{
+				switch(justify)
+				{
+					case END:
+					{
+						position = freeSpace;
+						break;
+					}
+					case CENTER:
+					{
+						position = freeSpace / 2;
+						break;
+					}
+					case SPACE_BETWEEN:
+					{
+						gaps = count - 1;
+						spacingLeft = freeSpace;
+						break;
+					}
+					case SPACE_AROUND:
+					{
+						position = freeSpace / (2 * count);
+						gaps = count - 1;
+						spacingLeft = freeSpace - 2 * position;
+						break;
+					}
+				}
+			}
+			else if(justify == CENTER || justify == SPACE_AROUND)
+			{
+				position = freeSpace / 2;
+			}
+
+			for(std::size_t i = line.begin; i < line.end; ++i)
+			{
+				Item &item = items[i];
+
+				if(!item.component->isVisible())
+				{
+					continue;
+				}
+
+				int alignment = item.alignSelf >= 0 ? item.alignSelf : alignItems;
+				int crossPosition = 0;
+				int cross = std::min(item.cross,crossSize);
+
+				switch(alignment)
+				{
+					case STRETCH:
+					{
+						cross = crossSize;
+						break;
+					}
+					case END:
+					{
+						crossPosition = crossSize - cross;
+						break;
+					}
+					case CENTER:
+					{
+						crossPosition = (crossSize - cross) / 2;
+						break;
+					}
+				}
+
+				if(direction == Component::VERTICAL)
+				{
+					item.component->setBounds(x + crossPosition, y + position, cross, item.main);
+				}
+				else
+				{
+					item.component->setBounds(x + position, y + crossPosition, item.main, cross);
+				}
+
+				position += item.main + getMainGap();
+
+				if(gaps > 0)
+				{
+					spacing = spacingLeft / gaps;
+					spacingLeft -= spacing;
+					--gaps;
+					position += spacing;
+				}
+			}
+		}
+	}
+}
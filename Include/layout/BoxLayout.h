@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BOXLAYOUT_H
+#define BOXLAYOUT_H
+
+#include <map>
+#include <vector>
+#include "../Pointers.h"
+#include "./LayoutManager.h"
+
+namespace ui
+{
+	namespace layout
+	{
+		/**
+		 * BoxLayout.
+		 * A LayoutManager modelled after a subset of the CSS flexible box
+		 * model. Components are placed in a row or a column (the main axis),
+		 * optionally wrapping onto multiple lines. Each Component can grow
+		 * into, or shrink out of, the free space on its line and can be aligned
+		 * on the cross axis.
+		 * <p>
+		 * The layout runs in two linear passes: the first pass measures the
+		 * Components and breaks them into lines, the second resolves the flexible
+		 * lengths and positions the Components. Scratch space is kept in the
+		 * LayoutManager and reused, so laying out an unchanged Container does not
+		 * allocate memory. Sizes are taken from Component::getPreferredSize(), so
+		 * the preferred size cache of the children is used.
+		 * </p>
+		 * The constraint passed to Container::add() is used as the grow factor
+		 * of the Component, use setFlex() to set all flex properties at once.
+		 */
+		class BoxLayout : public LayoutManager
+		{
+		public:
+			/**
+			 * Creates a horizontal BoxLayout which does not wrap.
+			 */
+			BoxLayout();
+
+			/**
+			 * Creates a BoxLayout with the given direction.
+			 * @param
+			 *	direction Component::HORIZONTAL or Component::VERTICAL.
+			 */
+			BoxLayout(int direction);
+
+			/**
+			 * Creates a BoxLayout with the given direction, wrapping
+			 * and spacing.
+			 * @param
+			 *	direction Component::HORIZONTAL or Component::VERTICAL.
+			 * @param
+			 *	wrap true if Components should wrap onto a new line when
+			 *	they do not fit.
+			 * @param
+			 *	hgap Horizontal spacing between Components.
+			 * @param
+			 *	vgap Vertical spacing between Components.
+			 */
+			BoxLayout(int direction, bool wrap, int hgap, int vgap);
+
+			/**
+			 * Copy constructor.
+			 */
+			BoxLayout(const BoxLayout& rhs);
+
+			/**
+			 * Assignment operator.
+			 */
+			BoxLayout& operator=(const BoxLayout& rhs);
+
+			/**
+			 * Swaps this LayoutManager with another.
+			 */
+			void swap(BoxLayout& rhs) throw();
+
+			/**
+			 * Lay out the given Container.
+			 * @param
+			 *	parent the Container to be laid out.
+			 */
+			void layoutContainer(const Container* parent);
+
+			/**
+			 * Adds a Component to the LayoutManager. The constraint
+			 * is used as the grow factor of the Component. A negative
+			 * constraint, which is what Container::add() passes by
+			 * default, keeps the grow factor set with setFlex().
+			 * @param
+			 *	comp Component to add to this LayoutManager.
+			 * @param
+			 *	constraint grow factor of the Component.
+			 */
+			void addLayoutComponent(Component* comp, int constraint);
+
+			/**
+			 * Remove the given Component from the LayoutManager.
+			 * @param
+			 *	comp the Component to remove from the LayoutManager.
+			 */
+			void removeLayoutComponent(Component* comp);
+
+			/**
+			 * Returns the preferred Dimension the Container likes to
+			 * have. This is the size of all Components on a single
+			 * line.
+			 * @param
+			 *	container Container to calculate and return the preferredSize from.
+			 * @return
+			 *	The preferred size for the given Container.
+			 */
+			const util::Dimension preferredLayoutSize(const Container* parent) const;
+
+			/**
+			 * Sets the flex properties of a Component.
+			 * @param
+			 *	comp the Component to set the properties for.
+			 * @param
+			 *	grow share of positive free space the Component receives.
+			 * @param
+			 *	shrink share of negative free space the Component gives up,
+			 *	weighted by its size on the main axis.
+			 * @param
+			 *	basis the initial size on the main axis, or -1 to use the
+			 *	preferred size of the Component.
+			 */
+			void setFlex(Component* comp, int grow, int shrink, int basis);
+
+			/**
+			 * Overrides the cross axis alignment for a single Component.
+			 * @param
+			 *	comp the Component to align.
+			 * @param
+			 *	alignment one of START, END, CENTER or STRETCH, or -1 to
+			 *	use the alignment set with setAlignItems().
+			 */
+			void setAlignSelf(Component* comp, int alignment);
+
+			/**
+			 * Sets the direction of the main axis.
+			 * @param
+			 *	direction Component::HORIZONTAL or Component::VERTICAL.
+			 */
+			void setDirection(int direction);
+
+			/**
+			 * Returns the direction of the main axis.
+			 */
+			int getDirection() const;
+
+			/**
+			 * Sets wether Components wrap onto a new line.
+			 */
+			void setWrap(bool wrap);
+
+			/**
+			 * Returns true if Components wrap onto a new line.
+			 */
+			bool isWrap() const;
+
+			/**
+			 * Sets how free space on the main axis is distributed.
+			 * @param
+			 *	justify one of START, END, CENTER, SPACE_BETWEEN or SPACE_AROUND.
+			 */
+			void setJustifyContent(int justify);
+
+			/**
+			 * Returns the main axis alignment.
+			 */
+			int getJustifyContent() const;
+
+			/**
+			 * Sets the default cross axis alignment.
+			 * @param
+			 *	alignment one of START, END, CENTER or STRETCH.
+			 */
+			void setAlignItems(int alignment);
+
+			/**
+			 * Returns the default cross axis alignment.
+			 */
+			int getAlignItems() const;
+
+			/**
+			 * Alignment constants.
+			 */
+			enum ALIGNMENT
+			{
+				/**
+				 * Align at the start of the axis.
+				 */
+				START,
+				/**
+				 * Align at the end of the axis.
+				 */
+				END,
+				/**
+				 * Align in the middle of the axis.
+				 */
+				CENTER,
+				/**
+				 * Stretch to fill the line (cross axis only).
+				 */
+				STRETCH,
+				/**
+				 * Distribute free space between Components (main axis only).
+				 */
+				SPACE_BETWEEN,
+				/**
+				 * Distribute free space around Components (main axis only).
+				 */
+				SPACE_AROUND
+			};
+		private:
+			/**
+			 * Flex properties and scratch sizes of a single Component.
+			 */
+			struct Item
+			{
+				Item(Component *comp);
+
+				Component *component;
+				int grow, shrink, basis, alignSelf;
+				int main, cross;
+			};
+
+			/**
+			 * A line of Items, indices into the items list.
+			 */
+			struct Line
+			{
+				std::size_t begin, end;
+				int main, cross;
+				int grow, shrink;
+			};
+
+			typedef std::vector<Item> ItemList;
+			typedef std::vector<Line> LineList;
+			typedef std::map<Component*,std::size_t> ItemIndex;
+
+			Item& getItem(Component *comp);
+			static void invalidateParent(Component *comp);
+			void synchronize(const Container* parent);
+			void reindex();
+			void arrangeLine(const Line &line, int x, int y, int mainSize, int crossSize);
+
+			int getMain(const util::Dimension &dim) const;
+			int getCross(const util::Dimension &dim) const;
+			int getMainGap() const;
+			int getCrossGap() const;
+
+			int direction;
+			bool wrap;
+			int justify;
+			int alignItems;
+
+			ItemList items, reordered;
+			LineList lines;
+
+			/**
+			 * The position of the Item of each Component in items.
+			 */
+			ItemIndex index;
+		};
+	}
+}
+#endif
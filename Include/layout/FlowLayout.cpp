@@ -79,7 +79,7 @@ namespace ui
 			util::Dimension preferredSize;
 
 			ComponentList::const_iterator iter;
-			ComponentList list = parent->getChildren();
+			const ComponentList &list = parent->getChildren();
 
 			bool firstComponent = false;
 
@@ -115,7 +115,7 @@ namespace ui
 			bool first = true;
 
 			ComponentList::iterator iter;
-			ComponentList childList = parent->getChildren();
+			const ComponentList &childList = parent->getChildren();
 			for(iter = childList.begin(); iter != childList.end(); ++iter)
 			{
 				if((*iter)->isVisible())
@@ -150,7 +150,7 @@ namespace ui
 			int rowHeight = 0, start = 0;
 
 			ComponentList::iterator iter;
-			ComponentList list = parent->getChildren();
+			const ComponentList &list = parent->getChildren();
 			int i = 0;
 			for(iter = list.begin(); iter != list.end(); ++iter)
 			{
@@ -191,9 +191,9 @@ namespace ui
 			int y = parentInsets.top;
 
 			ComponentList::const_iterator iter;
-			ComponentList list = parent->getChildren();
+			const ComponentList &list = parent->getChildren();
 
-			ComponentList row;
+			row.clear();
 
 			for(iter = list.begin(); iter != list.end(); ++iter)
 			{
@@ -106,6 +106,7 @@ namespace ui
 			void align(ComponentList &row, int rowHeight, util::Insets &parentInsets, util::Dimension &rowDimension, util::Dimension &parentDimension);
 			void moveComponents(Container* parent, int x, int y, int width, int height, int rowStart, int rowEnd);
 			int alignment;
+			ComponentList row;
 		};
 	}
 }
@@ -58,7 +58,7 @@ namespace ui
 			{
 				numRows = (numComponents + numCols - 1) / numCols;
 			}
-			ComponentList childList = parent->getChildren();
+			const ComponentList &childList = parent->getChildren();
 
 			int width = 0;
 			int height = 0;
@@ -95,7 +95,7 @@ namespace ui
 			width = (width - (numCols - 1) * getHgap()) / numCols;
 			height = (height - (numRows - 1) * getVgap()) / numRows;
 
-			ComponentList childList = parent->getChildren();
+			const ComponentList &childList = parent->getChildren();
 			ComponentList::const_iterator iter;
 
 			int x = insets.left;
@@ -51,8 +51,8 @@ namespace ui
 
 		void PopupLayout::layoutContainer(const Container* parent)
 		{
-			ComponentList children = parent->getChildren();
-			ComponentList::iterator iter;
+			const ComponentList &children = parent->getChildren();
+			ComponentList::const_iterator iter;
 			for(iter = children.begin(); iter != children.end(); ++iter)
 			{
 				(*iter)->setSize((*iter)->getPreferredSize());
@@ -21,6 +21,8 @@ namespace ui
 			textFieldTheme = new basic::TextFieldTheme();
 			sliderTheme = new basic::SliderTheme();
 			knobTheme = new basic::KnobTheme();
+			tableTheme = new basic::TableTheme();
+			textAreaTheme = new basic::TextAreaTheme();
 		}
 
 		BasicTheme::~BasicTheme()
@@ -40,6 +42,8 @@ namespace ui
 			delete textFieldTheme;
 			delete sliderTheme;
 			delete knobTheme;
+			delete tableTheme;
+			delete textAreaTheme;
 		}
 
 		ThemeComponent * BasicTheme::getThemeComponent(const std::string &componentName) const
@@ -100,6 +104,14 @@ namespace ui
 			{
 				return knobTheme;
 			}
+			else if(componentName == "Table")
+			{
+				return tableTheme;
+			}
+			else if(componentName == "TextArea")
+			{
+				return textAreaTheme;
+			}
 
 			return componentTheme;
 		}
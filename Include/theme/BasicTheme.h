@@ -44,6 +44,8 @@
 #include "./basic/TextFieldTheme.h"
 #include "./basic/SliderTheme.h"
 #include "./basic/KnobTheme.h"
+#include "./basic/TableTheme.h"
+#include "./basic/TextAreaTheme.h"
 
 namespace ui
 {
@@ -71,6 +73,8 @@ namespace ui
 			basic::TextFieldTheme *textFieldTheme;
 			basic::SliderTheme *sliderTheme;
 			basic::KnobTheme *knobTheme;
+			basic::TableTheme *tableTheme;
+			basic::TextAreaTheme *textAreaTheme;
 		};
 	}
 }
@@ -59,13 +59,13 @@ namespace ui
 
 				button->addPropertyListener(this);
 				button->setBorder(&borderRaised);
-				button->setBackground(SchemeManager::getInstance().getScheme()->getPushableRaisedBackground());
-				button->setForeground(SchemeManager::getInstance().getScheme()->getTextColor());
+				button->setBackground(button->getContext()->getSchemeManager().getScheme()->getPushableRaisedBackground());
+				button->setForeground(button->getContext()->getSchemeManager().getScheme()->getTextColor());
 				button->setBorderPainted(true);
 				button->setFocusPainted(true);
 				button->setMargin(util::Insets(7,7,7,7));
 				button->addKeyListener(this);
-				button->setFont(SchemeManager::getInstance().getScheme()->getDefaultFont()); // default font
+				button->setFont(button->getContext()->getSchemeManager().getScheme()->getDefaultFont()); // default font
 			}
 
 			void ButtonTheme::deinstallTheme(Component *comp)
@@ -82,7 +82,7 @@ namespace ui
 
 				const AbstractButton *button = static_cast<const AbstractButton*>(comp);
 
-				Util::paintButton(button,g);
+				Util::paintButton(button,g,text);
 
 			}
 
@@ -103,7 +103,7 @@ namespace ui
 					case AbstractButton::SELECTED:
 						{
 				
-								comp->setBackground(SchemeManager::getInstance().getScheme()->getPushableLoweredBackground());
+								comp->setBackground(comp->getContext()->getSchemeManager().getScheme()->getPushableLoweredBackground());
 								comp->setBorder(&borderLowered);
 							
 							break;
@@ -111,7 +111,7 @@ namespace ui
 					case AbstractButton::DESELECTED:
 						{
 						
-								comp->setBackground(SchemeManager::getInstance().getScheme()->getPushableRaisedBackground());
+								comp->setBackground(comp->getContext()->getSchemeManager().getScheme()->getPushableRaisedBackground());
 								comp->setBorder(&borderRaised);
 				
 							break;
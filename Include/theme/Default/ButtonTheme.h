@@ -30,6 +30,7 @@
 #define BUTTONTHEME_H
 
 #include "./ComponentTheme.h"
+#include "./Util.h"
 #include "../../util/GradientColor.h"
 #include "../../border/BevelBorder.h"
 #include "../../event/PropertyListener.h"
@@ -62,6 +63,9 @@ namespace ui
 				util::Color focus;
 				border::BevelBorder borderRaised;
 				border::BevelBorder borderLowered;
+
+				// the text painted, reused from frame to frame.
+				mutable Util::StringBuffer text;
 			};
 		}
 	}
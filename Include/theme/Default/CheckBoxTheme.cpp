@@ -61,11 +61,11 @@ namespace ui
 				button->setDefaultIcon(&defaultIcon);
 				button->setSelectedIcon(&selectedIcon);
 				button->setMargin(util::Insets(7,7,7,7));
-				button->setForeground(SchemeManager::getInstance().getScheme()->getTextColor());
+				button->setForeground(button->getContext()->getSchemeManager().getScheme()->getTextColor());
 				button->setHorizontalAlignment(Component::LEFT);
 				button->setBorder(NULL);
 				button->addKeyListener(this);
-				button->setFont(SchemeManager::getInstance().getScheme()->getDefaultFont()); // default font
+				button->setFont(button->getContext()->getSchemeManager().getScheme()->getDefaultFont()); // default font
 			}
 
 			void CheckBoxTheme::paint(Graphics &g, const Component *comp) const
@@ -76,7 +76,7 @@ namespace ui
 				{
 					ComponentTheme::paint(g,button);
 				}
-				Util::paintButton(button,g);
+				Util::paintButton(button,g,text);
 			}
 
 			const util::Dimension CheckBoxTheme::getPreferredSize(const Component *comp) const
@@ -30,6 +30,7 @@
 #define CHECKBOXTHEME_H
 
 #include "./ComponentTheme.h"
+#include "./Util.h"
 #include "../../event/PropertyListener.h"
 #include "../../border/BevelBorder.h"
 #include "../../Icon.h"
@@ -85,6 +86,9 @@ namespace ui
 
 				DefaultIcon defaultIcon;
 				SelectedIcon selectedIcon;
+
+				// the text painted, reused from frame to frame.
+				mutable Util::StringBuffer text;
 			};
 		}
 	}
@@ -61,7 +61,7 @@ namespace ui
 
 			void ComponentTheme::paintSelection(Graphics &g, const Component *comp) const
 			{
-				int index = SelectionManager::getInstance().getComponentId(comp);
+				int index = comp->getContext()->getSelectionManager().getComponentId(comp);
 
 				int width = comp->getBounds().width;
 				int height = comp->getBounds().height;
@@ -71,8 +71,8 @@ namespace ui
 
 			void ComponentTheme::installTheme(Component *comp)
 			{
-				comp->setBackground(SchemeManager::getInstance().getScheme()->getDefaultBackground());
-				comp->setForeground(SchemeManager::getInstance().getScheme()->getTextColor());
+				comp->setBackground(comp->getContext()->getSchemeManager().getScheme()->getDefaultBackground());
+				comp->setForeground(comp->getContext()->getSchemeManager().getScheme()->getTextColor());
 				comp->setBorderPainted(true);
 			}
 
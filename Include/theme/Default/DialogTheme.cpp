@@ -73,7 +73,7 @@ namespace ui
 			{
 				Dialog *dialog = static_cast<Dialog*>(e.getSource());
 				// this is a bit of a hack..
-				dialog->getTitleBar()->getTitleLabel()->setBackground(SchemeManager::getInstance().getScheme()->getTitleBarSelected());
+				dialog->getTitleBar()->getTitleLabel()->setBackground(dialog->getContext()->getSchemeManager().getScheme()->getTitleBarSelected());
 			}
 
 			void DialogTheme::paint(Graphics &g, const Component *comp) const
@@ -114,7 +114,7 @@ namespace ui
 			void DialogTheme::windowDeactivated(const event::WindowEvent &e)
 			{
 				Dialog *dialog = static_cast<Dialog*>(e.getSource());
-				dialog->getTitleBar()->getTitleLabel()->setBackground(SchemeManager::getInstance().getScheme()->getTitleBarDeselected());
+				dialog->getTitleBar()->getTitleLabel()->setBackground(dialog->getContext()->getSchemeManager().getScheme()->getTitleBarDeselected());
 			}
 
 			void DialogTheme::windowClosed(const event::WindowEvent &e)
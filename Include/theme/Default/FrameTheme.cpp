@@ -47,7 +47,7 @@ namespace ui
 			void FrameTheme::installTheme(Component *comp)
 			{
 				comp->setBorder(&border);
-				comp->setBackground(SchemeManager::getInstance().getScheme()->getHighlight());
+				comp->setBackground(comp->getContext()->getSchemeManager().getScheme()->getHighlight());
 				comp->setBorderPainted(true);
 			}
 
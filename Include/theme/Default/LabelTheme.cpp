@@ -50,7 +50,7 @@ namespace ui
 				//label->setForeground(&foreground);
 				label->setBorderPainted(true);
 				label->setMargin(util::Insets(7,7,7,7));
-				label->setFont(SchemeManager::getInstance().getScheme()->getDefaultFont()); // default font
+				label->setFont(label->getContext()->getSchemeManager().getScheme()->getDefaultFont()); // default font
 			}
 
 			void LabelTheme::deinstallTheme(Component *comp)
@@ -74,13 +74,13 @@ namespace ui
 				return getLabelSize(label);
 			}
 
-			std::string LabelTheme::getLabelString(const Label *label) const
+			const std::string & LabelTheme::getLabelString(const Label *label) const
 			{
 				// this function might appear quite slow, and in fact, it is.
 				// the speed depends on the font engine implementation, having
 				// a fast font engine, with for example cached glyph dimensions speeds
 				// up the whole font rendering.
-				util::Dimension bbox(label->getFont()->getStringBoundingBox(label->getText()));
+				util::Dimension bbox(label->getContext()->getGlyphContext().getStringBoundingBox(label->getFontHandle(),label->getText()));
 			//	int width = bbox.width;
 			//	int height = bbox.height;
 
@@ -95,39 +95,19 @@ namespace ui
 					{
 						// by now, the text does not fit in our Component,
 						// let's see if chopping off some characters helps.
-						std::string text = label->getText();
-						std::string final;
-						for(std::size_t i = 0; i < text.length(); ++i)
-						{
-							std::string tmp(final);
-							util::Dimension strbbox(label->getFont()->getStringBoundingBox(tmp.append(".......")));
-							if(strbbox.width < (label->getBounds().width - label->getMargin().left - label->getMargin().right) && strbbox.height < label->getBounds().height)
-							{
-								// so far we fit, append one char and try again
-								//std::string(text[i]);
-								final += text[i];
-							}
-							else
-							{
-								if(final != "")
-								{
-									final.append("...");
-								}
-								break;
-							}
-						}
-						return final;
+						return Util::truncateString(label->getContext()->getGlyphContext(),label->getFont(),label->getText(),label->getBounds().width - label->getMargin().left - label->getMargin().right,text);
 					}
 				}
-				return "";
+				text.text.clear();
+				return text.text;
 			}
 
 			const util::Dimension LabelTheme::getLabelSize(const Label *label) const
 			{
-				std::string text = label->getText();
+				const std::string &text = label->getText();
 				Font *f = label->getFont();
 
-				util::Dimension bbox(f->getStringBoundingBox(text));
+				util::Dimension bbox(label->getContext()->getGlyphContext().getStringBoundingBox(f,text));
 				int width = bbox.width + label->getMargin().left + label->getMargin().right + label->getInsets().left + label->getInsets().right;
 				int height= bbox.height + label->getMargin().top + label->getMargin().bottom + label->getInsets().top + label->getInsets().bottom; 	
 
@@ -153,10 +133,10 @@ namespace ui
 				// but instead calculating them on the fly. Performance could
 				// be improved by writing a better font engine.
 				// HACK HACK: edited the font engine to cache values :|
-				std::string str = getLabelString(label);
+				const std::string &str = getLabelString(label);
 				util::Point alignment(getLabelAlignment(label,str));
 
-				util::Dimension rec(label->getFont()->getStringBoundingBox(str));
+				util::Dimension rec(label->getContext()->getGlyphContext().getStringBoundingBox(label->getFontHandle(),str));
 			
 				g.setPaint(label->getForeground());
 				g.setFont(label->getFont());
@@ -184,7 +164,7 @@ namespace ui
 					{
 					case AbstractButton::CENTER:
 						{
-							util::Dimension bbox(label->getFont()->getStringBoundingBox(text));
+							util::Dimension bbox(label->getContext()->getGlyphContext().getStringBoundingBox(label->getFontHandle(),text));
 							x = (comp.width / 2) - (bbox.width / 2) - (getActiveIcon(label)->getIconWidth() /2);/*/2 - getActiveIcon(button)->getIconWidth()/2;*/
 							break;
 						}
@@ -230,7 +210,7 @@ namespace ui
 			util::Point LabelTheme::getLabelAlignment(const Label *label, const std::string &text) const
 			{
 				util::Point ret;
-				util::Dimension bbox(label->getFont()->getStringBoundingBox(text));
+				util::Dimension bbox(label->getContext()->getGlyphContext().getStringBoundingBox(label->getFontHandle(),text));
 				util::Dimension comp(label->getBounds().width,label->getBounds().height);
 
 				int horizontalAlignment = label->getHorizontalAlignment();
@@ -29,6 +29,7 @@
 #define LABELTHEME_H
 
 #include "./ComponentTheme.h"
+#include "./Util.h"
 #include "../../component/Label.h"
 #include "../../Icon.h"
 
@@ -49,13 +50,15 @@ namespace ui
 			private:
 
 				util::Point getLabelAlignment(const Label *label, const std::string &text) const;
-				std::string getLabelString(const Label *label) const;
+				const std::string & getLabelString(const Label *label) const;
 				Icon * getActiveIcon(const Label *label) const;
 				util::Color foreground;
 				const util::Dimension getLabelSize(const Label * label) const;
 				void paintLabel(const Label *button, Graphics &g) const;
 				void paintIcon(const Label *button, Graphics &g, const std::string &text) const;
 
+				// the text painted, reused from frame to frame.
+				mutable Util::StringBuffer text;
 			};
 		}
 	}
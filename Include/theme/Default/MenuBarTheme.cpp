@@ -41,7 +41,7 @@ namespace ui
 
 			void MenuBarTheme::installTheme(Component *comp)
 			{
-				comp->setBackground(SchemeManager::getInstance().getScheme()->getMenuBarBackground());
+				comp->setBackground(comp->getContext()->getSchemeManager().getScheme()->getMenuBarBackground());
 			}
 
 			void MenuBarTheme::deinstallTheme(Component *comp)
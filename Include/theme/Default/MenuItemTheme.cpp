@@ -60,7 +60,7 @@ namespace ui
 			//	menuItem->addFocusListener(this);
 				menuItem->addPropertyListener(this);
 				menuItem->addKeyListener(this);
-				menuItem->setFont(SchemeManager::getInstance().getScheme()->getDefaultFont()); // default font
+				menuItem->setFont(menuItem->getContext()->getSchemeManager().getScheme()->getDefaultFont()); // default font
 			}
 
 			void MenuItemTheme::deinstallTheme(Component *comp)
@@ -54,10 +54,10 @@ namespace ui
 
 				button->setFocusPainted(false);
 				button->setBorder(&border);
-				button->setBackground(SchemeManager::getInstance().getScheme()->getMenuDeselectedBackground());
+				button->setBackground(button->getContext()->getSchemeManager().getScheme()->getMenuDeselectedBackground());
 				button->setBorderPainted(false);
 				button->setForeground(&foreground);
-				button->setFont(SchemeManager::getInstance().getScheme()->getDefaultFont()); // default font
+				button->setFont(button->getContext()->getSchemeManager().getScheme()->getDefaultFont()); // default font
 				button->addPropertyListener(this);
 				button->addKeyListener(this);
 
@@ -76,12 +76,12 @@ namespace ui
 					if(e.getID() == Menu::SELECTED)
 					{
 						e.getSource()->setBorderPainted(true);
-						e.getSource()->setBackground(SchemeManager::getInstance().getScheme()->getMenuSelectedBackground());
+						e.getSource()->setBackground(e.getSource()->getContext()->getSchemeManager().getScheme()->getMenuSelectedBackground());
 					}
 					else if(e.getID() == Menu::DESELECTED)
 					{
 						e.getSource()->setBorderPainted(false);
-						e.getSource()->setBackground(SchemeManager::getInstance().getScheme()->getMenuDeselectedBackground());
+						e.getSource()->setBackground(e.getSource()->getContext()->getSchemeManager().getScheme()->getMenuDeselectedBackground());
 					}
 				}
 			}
@@ -92,7 +92,7 @@ namespace ui
 
 				const AbstractButton *button = static_cast<const AbstractButton*>(comp);
 
-				Util::paintButton(button,g);
+				Util::paintButton(button,g,text);
 			}
 
 			const util::Dimension MenuTheme::getPreferredSize(const Component *comp) const
@@ -30,6 +30,7 @@
 #define MENUTHEME_H
 
 #include "./ComponentTheme.h"
+#include "./Util.h"
 #include "../../util/GradientColor.h"
 #include "../../event/PropertyListener.h"
 #include "../../border/LineBorder.h"
@@ -58,6 +59,9 @@ namespace ui
 				util::Color foreground;
 				border::LineBorder border;
 				util::Color transparant;
+
+				// the text painted, reused from frame to frame.
+				mutable Util::StringBuffer text;
 			};
 		}
 	}
@@ -52,7 +52,7 @@ namespace ui
 				ProgressBar *progressBar = static_cast<ProgressBar*>(comp);
 			//	progressBar->setBackground(&background);
 			//	progressBar->setForeground(&foreground);
-				progressBar->setFont(SchemeManager::getInstance().getScheme()->getDefaultFont()); // default font
+				progressBar->setFont(progressBar->getContext()->getSchemeManager().getScheme()->getDefaultFont()); // default font
 				progressBar->setBorder(&border);
 			}
 			
@@ -65,7 +65,7 @@ namespace ui
 				const ProgressBar *progressBar = static_cast<const ProgressBar*>(comp);
 
 				util::Dimension ret;
-				util::Dimension bbox(progressBar->getFont()->getStringBoundingBox("00%"));
+				util::Dimension bbox(progressBar->getContext()->getGlyphContext().getStringBoundingBox(progressBar->getFontHandle(),"00%"));
 
 				if(progressBar->getOrientation() == ProgressBar::HORIZONTAL)
 				{
@@ -89,7 +89,7 @@ namespace ui
 				// calculate the percentage
 				float tmp = ((float)(progressBar->getValue()-progressBar->getMinimum()) / (float)(progressBar->getMaximum()-progressBar->getMinimum()));
 				
-				g.setPaint(SchemeManager::getInstance().getScheme()->getHighlight());
+				g.setPaint(progressBar->getContext()->getSchemeManager().getScheme()->getHighlight());
 				if(progressBar->getOrientation() == ProgressBar::VERTICAL)
 				{
 					int percentage = (int) (tmp * progressBar->getBounds().height);
@@ -111,7 +111,7 @@ namespace ui
 
 					std::string p = s.str();
 
-					util::Dimension bbox(progressBar->getFont()->getStringBoundingBox(p));
+					util::Dimension bbox(progressBar->getContext()->getGlyphContext().getStringBoundingBox(progressBar->getFontHandle(),p));
 
 					int x = progressBar->getBounds().width /2 - bbox.width/2;
 					int y = progressBar->getBounds().height/2 - bbox.height/2;
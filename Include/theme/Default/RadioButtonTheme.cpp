@@ -65,7 +65,7 @@ namespace ui
 				button->setHorizontalAlignment(Component::LEFT);
 				button->setBorder(NULL);
 				button->addKeyListener(this);
-				button->setFont(SchemeManager::getInstance().getScheme()->getDefaultFont()); // default font
+				button->setFont(button->getContext()->getSchemeManager().getScheme()->getDefaultFont()); // default font
 			}
 
 			void RadioButtonTheme::paint(Graphics &g, const Component *comp) const
@@ -76,7 +76,7 @@ namespace ui
 				{
 					ComponentTheme::paint(g,button);
 				}
-				Util::paintButton(button,g);
+				Util::paintButton(button,g,text);
 			}
 
 			const util::Dimension RadioButtonTheme::getPreferredSize(const Component *comp) const
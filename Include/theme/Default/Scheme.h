@@ -30,6 +30,7 @@
 
 #include "../../util/Paint.h"
 #include "../../Font.h"
+#include "../../UiContext.h"
 
 namespace ui
 {
@@ -65,8 +66,7 @@ namespace ui
 
 				static SchemeManager &getInstance()
 				{
-					static SchemeManager obj;
-					return obj;
+					return UiContext::getCurrent().getSchemeManager();
 				}
 				Scheme * getScheme() const;
 				void setScheme(Scheme *s);
@@ -75,6 +75,7 @@ namespace ui
 				~SchemeManager();
 				SchemeManager(const SchemeManager&);
 				SchemeManager& operator=(const SchemeManager&);
+				friend class ui::UiContext;
 				Scheme *scheme;
 			};
 		}
@@ -109,6 +109,11 @@ namespace ui
 
 			void ScrollbarTheme::IncrementIcon::paint(const Component *comp, Graphics &g, int x, int y) const
 			{
+				if(textureId == 0)
+				{
+					upload();
+				}
+
 				g.setPaint(&foreground);
 				if(orientation == Scroller::VERTICAL)
 				{
@@ -132,7 +137,8 @@ namespace ui
 
 			ScrollbarTheme::IncrementIcon::IncrementIcon()
 				:	foreground(0,0,0),
-				orientation(Scroller::HORIZONTAL)
+				orientation(Scroller::HORIZONTAL),
+				textureId(0)
 			{
 				GLubyte texture[textureWidth][textureHeight] = 
 				{
@@ -154,8 +160,6 @@ namespace ui
 					{ 0  , 0  , 0  , 0  , 0  , 0  , 0  , 0  , 0  , 0  , 0  , 0  , 0  , 0  , 0  , 0  }
 				};
 
-				GLubyte uploadTexture[textureWidth][textureHeight][4];
-
 				for(int width = 0; width < textureWidth; ++width)
 				{
 					for(int height = 0; height < textureHeight; ++height)
@@ -166,7 +170,12 @@ namespace ui
 						uploadTexture[width][height][3] = texture[width][height];
 					}
 				}
+			}
 
+			void ScrollbarTheme::IncrementIcon::upload() const
+			{
+				// in paint, not the constructor, which may run on a
+				// thread without an OpenGL context.
 				glGenTextures(1,&textureId);
 				glBindTexture(GL_TEXTURE_2D,textureId);
 			
@@ -197,6 +206,11 @@ namespace ui
 			
 			void ScrollbarTheme::DecrementIcon::paint(const Component *comp, Graphics &g, int x, int y) const
 			{
+				if(textureId == 0)
+				{
+					upload();
+				}
+
 				g.setPaint(&foreground);
 				if(orientation == Scroller::VERTICAL)
 				{
@@ -215,7 +229,8 @@ namespace ui
 
 			ScrollbarTheme::DecrementIcon::DecrementIcon()
 				:	foreground(0,0,0),
-					orientation(Scroller::HORIZONTAL)
+					orientation(Scroller::HORIZONTAL),
+					textureId(0)
 			{
 				GLubyte texture[textureWidth][textureHeight] = 
 				{
@@ -237,8 +252,6 @@ namespace ui
 					{ 0  , 0  , 0  , 0  , 0  , 0  , 0  , 0  , 0  , 0  , 0  , 0  , 0  , 0  , 0  , 0  }
 				};
 
-				GLubyte uploadTexture[textureWidth][textureHeight][4];
-
 				for(int width = 0; width < textureWidth; ++width)
 				{
 					for(int height = 0; height < textureHeight; ++height)
@@ -249,7 +262,11 @@ namespace ui
 						uploadTexture[width][height][3] = texture[width][height];
 					}
 				}
+			}
 
+			void ScrollbarTheme::DecrementIcon::upload() const
+			{
+				// see IncrementIcon::upload
 				glGenTextures(1,&textureId);
 				glBindTexture(GL_TEXTURE_2D,textureId);
 			
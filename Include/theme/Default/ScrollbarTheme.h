@@ -66,11 +66,12 @@ namespace ui
 				private:
 					util::Color foreground;
 					int orientation;
+					void upload() const;
 					static const int textureWidth = 16;
 					static const int textureHeight = 16;
 					//GLubyte texture[textureWidth][textureHeight];
-					//GLubyte texture[textureWidth][textureHeight][4];
-					GLuint textureId;
+					GLubyte uploadTexture[textureWidth][textureHeight][4];
+					mutable GLuint textureId;
 				};
 
 				class DecrementIcon : public Icon
@@ -84,9 +85,11 @@ namespace ui
 				private:
 					util::Color foreground;
 					int orientation;
+					void upload() const;
 					static const int textureWidth = 16;
 					static const int textureHeight = 16;
-					GLuint textureId;
+					GLubyte uploadTexture[textureWidth][textureHeight][4];
+					mutable GLuint textureId;
 				};
 
 				mutable IncrementIcon incrementIcon;
@@ -56,7 +56,7 @@ namespace ui
 
 			void ScrollerTheme::installTheme(Component *comp)
 			{
-				comp->addMouseListener(this);
+				comp->addMouseListener(this,event::MouseEvent::MOUSE_PRESSED_MASK|event::MouseEvent::MOUSE_RELEASED_MASK|event::MouseEvent::MOUSE_MOTION_MASK);
 				comp->setBackground(&background);
 			}
 
@@ -29,6 +29,7 @@
 #include "../../Component.h"
 #include "../../component/Slider.h"
 #include "../../Graphics.h"
+#include "../../SelectionManager.h"
 #include "../../event/MouseEvent.h"
 #include <cmath>
 
@@ -54,7 +55,7 @@ namespace ui
 
 			void SliderTheme::installTheme(Component *comp)
 			{
-				comp->addMouseListener(this);
+				comp->addMouseListener(this,event::MouseEvent::MOUSE_PRESSED_MASK|event::MouseEvent::MOUSE_RELEASED_MASK|event::MouseEvent::MOUSE_MOTION_MASK);
 			}
 
 			void SliderTheme::deinstallTheme(Component *comp)
@@ -199,6 +200,7 @@ namespace ui
 					if(selectionKnob.contains(e.getX(),e.getY()))
 					{
 						slider->setAdjusting(true);
+						slider->getContext()->getSelectionManager().setCapture(e.getPointer(),slider);
 					}
 					else
 					{
@@ -220,6 +222,7 @@ namespace ui
 					if(selectionKnob.contains(e.getX(),e.getY()))
 					{
 						slider->setAdjusting(true);
+						slider->getContext()->getSelectionManager().setCapture(e.getPointer(),slider);
 					}
 					else
 					{
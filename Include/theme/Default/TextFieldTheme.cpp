@@ -31,8 +31,9 @@
 #include "../../Font.h"
 #include "../../GlyphContext.h"
 #include "../../Graphics.h"
-#include "../../event/KeyEvent.h"
 #include "../../event/FocusEvent.h"
+#include "../../event/PropertyEvent.h"
+#include "../../util/Utf8.h"
 
 namespace ui
 {
@@ -43,20 +44,20 @@ namespace ui
 			void TextFieldTheme::installTheme(Component *comp)
 			{
 				comp->setBorder(&border);
-				comp->setBackground(SchemeManager::getInstance().getScheme()->getTextBackground());
+				comp->setBackground(comp->getContext()->getSchemeManager().getScheme()->getTextBackground());
 				//comp->setForeground(&foreground);
-				comp->addKeyListener(this);
 				comp->addFocusListener(this);
 				comp->addMouseListener(this);
+				comp->addPropertyListener(this);
 				comp->addInterpolator(&interpolator);
-				comp->setFont(SchemeManager::getInstance().getScheme()->getDefaultFont()); // default font
+				comp->setFont(comp->getContext()->getSchemeManager().getScheme()->getDefaultFont()); // default font
 			}
 
 			void TextFieldTheme::deinstallTheme(Component *comp)
 			{
-				comp->removeKeyListener(this);
 				comp->removeFocusListener(this);
 				comp->removeMouseListener(this);
+				comp->removePropertyListener(this);
 				comp->removeInterpolator(&interpolator);
 			}
 
@@ -68,23 +69,51 @@ namespace ui
 
 				g.enableScissor(textField->getLocationOnScreen().x,textField->getLocationOnScreen().y,textField->getBounds().width,textField->getBounds().height);
 
-				g.setPaint(&foreground);
-				std::string text = textField->getText();
 				Font *f = textField->getFont();
 				g.setFont(f);
 
+				// the TextField keeps the caret and scroll positions up
+				// to date while it is edited, and it does the editing
+				// itself. Only echoed text is measured here.
+				const std::string *text = &textField->getText();
+				int viewWidth = textField->getBounds().width - textField->getInsets().left - textField->getInsets().right - 2;
+				int caretX, anchorX, scrollOffset;
+
 				if(textField->hasEchoCharacter())
 				{
-					//std::size_t length = text.length();
-					text = std::string(text.length(),static_cast<char>(textField->getEchoCharacter()));
+					char echo = static_cast<char>(textField->getEchoCharacter());
+					int echoWidth = textField->getContext()->getGlyphContext().getStringBoundingBox(f,std::string(1,echo)).width;
+
+					caretX = echoWidth * countCharacters(*text,textField->getCaretPosition());
+					anchorX = echoWidth * countCharacters(*text,(textField->getCaretPosition() == textField->getSelectionStart()) ? textField->getSelectionEnd() : textField->getSelectionStart());
+					scrollOffset = std::max(0,caretX - viewWidth);
+
+					echoText.assign(util::Utf8::length(*text),echo);
+					text = &echoText;
+				}
+				else
+				{
+					caretX = textField->getCaretX();
+					anchorX = textField->getAnchorX();
+					scrollOffset = textField->getScrollOffset(viewWidth);
+				}
+
+				int x = textField->getInsets().left - scrollOffset;
+				int height = textField->getContext()->getGlyphContext().getStringBoundingBox(f,"Xg").height;
+				int y = textField->getBounds().height / 2 - height/2;
+				int border = 4;
+
+				if(textField->hasSelection())
+				{
+					g.setPaint(textField->getContext()->getSchemeManager().getScheme()->getHighlight());
+					g.fillRect(x + std::min(caretX,anchorX),border,std::abs(caretX - anchorX),textField->getBounds().height - border - border);
 				}
-				util::Dimension bbox(f->getStringBoundingBox(text));
-				int y = textField->getBounds().height / 2 - bbox.height/2;
-				g.drawString(textField->getInsets().left,y,text);
+
+				g.setPaint(&foreground);
+				g.drawString(x,y,*text);
 				if(displayCursor && textField->hasFocus())
 				{
-					int border = 4;
-					g.fillRect(2 + bbox.width,border,2,textField->getBounds().height - border - border);
+					g.fillRect(x + caretX,border,2,textField->getBounds().height - border - border);
 				}
 				g.disableScissor();
 			}
@@ -93,18 +122,32 @@ namespace ui
 			{
 				const TextField *textField = static_cast<const TextField*>(comp);
 
-				std::string text = textField->getText();
-				Font *f = textField->getFont();
+				// the width of the text is kept by the TextField, it is
+				// not measured again for every layout.
+				int width = textField->getTextWidth() + textField->getInsets().left + textField->getInsets().right + 2;
+				int height = textField->getContext()->getGlyphContext().getStringBoundingBox(textField->getFontHandle(),"Xg").height + textField->getInsets().top + textField->getInsets().bottom;
 
-				util::Dimension bbox(f->getStringBoundingBox(text));
-				//int width = bbox.width + textField->getMargin().left + textField->getMargin().right + textField->getInsets().left + textField->getInsets().right;
-				int height= bbox.height + textField->getInsets().top + textField->getInsets().bottom; 	
+				return util::Dimension(std::max(140,width),height);
+			}
 
-				return util::Dimension(140,height);
+			int TextFieldTheme::countCharacters(const std::string &text, std::size_t end)
+			{
+				int count = 0;
+				for(std::size_t index = 0; index < end; index = util::Utf8::next(text,index))
+				{
+					++count;
+				}
+				return count;
 			}
 
 			void TextFieldTheme::propertyChanged(const event::PropertyEvent &e)
 			{
+				if(e.getClassID() == event::PropertyEvent::SPECIAL && (e.getID() == TextField::TEXTCHANGE || e.getID() == TextField::CARETCHANGE))
+				{
+					// keep the caret visible while the user types.
+					displayCursor = true;
+					interpolator.reset();
+				}
 			}
 
 			TextFieldTheme::TextFieldTheme()
@@ -122,59 +165,6 @@ namespace ui
 				interpolator.removeInterpolatee(this);
 			}
 
-			void TextFieldTheme::keyPressed(const event::KeyEvent &e)
-			{
-				TextField *textField(static_cast<TextField*>(e.getSource()));
-
-				std::string str(textField->getText());
-
-				if(e.getKeyCode() == event::KeyEvent::VKUI_BACKSPACE)
-				{
-					// backspace
-					str = str.substr(0,str.length()-1);
-					cursorPosition--;
-					cursorPosition = std::max(0,cursorPosition);
-				}
-				else if(e.getKeyCode() == event::KeyEvent::VKUI_LEFT)
-				{
-					// move the cursor left
-				}
-				else if(e.getKeyCode() == event::KeyEvent::VKUI_RIGHT)
-				{
-				}
-				else if((e.getKeyCode() == event::KeyEvent::VKUI_UP) ||
-					(e.getKeyCode() == event::KeyEvent::VKUI_DOWN) ||
-					(e.getKeyCode() == 0) ||
-					(e.getKeyCode() == event::KeyEvent::VKUI_BREAK) ||
-					(e.getKeyCode() == event::KeyEvent::VKUI_RSHIFT) || 
-					(e.getKeyCode() == event::KeyEvent::VKUI_LSHIFT) ||
-					(e.getKeyCode() == event::KeyEvent::VKUI_CAPSLOCK) ||
-					(e.getKeyCode() == event::KeyEvent::VKUI_ESCAPE) ||
-					(e.getKeyCode() == event::KeyEvent::VKUI_UNKNOWN) ||
-					(e.getKeyCode() == event::KeyEvent::VKUI_RETURN) ||
-					(e.getKeyCode() == event::KeyEvent::VKUI_TAB))
-
-				{
-					// keys we just ignore
-				//	int x = 0;
-				}
-				else
-				{
-					// normal keys
-					std::string tmp(1,(char)e.getKeyCode());
-					// check for uppercase
-					if((e.getModifier() & event::KeyEvent::MOD_LSHIFT) ||
-					(e.getModifier() & event::KeyEvent::MOD_RSHIFT) ||
-					(e.getModifier() & event::KeyEvent::MOD_CAPS))
-					{
-						std::transform(tmp.begin(),tmp.end(),tmp.begin(),toupper);
-					}
-					str.append(tmp);
-					cursorPosition++;
-				}
-				textField->setText(str);
-			}
-
 			void TextFieldTheme::update(float value)
 			{
 				if(value == 100.0f)
@@ -184,18 +174,8 @@ namespace ui
 				}
 			}
 
-			void TextFieldTheme::keyReleased(const event::KeyEvent &e)
-			{
-			}
-
-			void TextFieldTheme::keyTyped(const event::KeyEvent &e)
-			{
-			}
-
 			void TextFieldTheme::focusGained(const event::FocusEvent &e)
 			{
-				TextField *textField(static_cast<TextField*>(e.getSource()));
-				cursorPosition = static_cast<int>(textField->getText().length());
 			}
 
 			void TextFieldTheme::focusLost(const event::FocusEvent &e)
@@ -31,7 +31,6 @@
 
 #include "./ComponentTheme.h"
 #include "../../event/PropertyListener.h"
-#include "../../event/KeyListener.h"
 #include "../../event/MouseListener.h"
 #include "../../event/FocusListener.h"
 #include "../../border/BevelBorder.h"
@@ -44,7 +43,7 @@ namespace ui
 	{
 		namespace defaulttheme
 		{
-			class TextFieldTheme : public ComponentTheme, public event::PropertyListener, public event::KeyListener, public event::FocusListener, public event::MouseAdapter, public util::Interpolatee
+			class TextFieldTheme : public ComponentTheme, public event::PropertyListener, public event::FocusListener, public event::MouseAdapter, public util::Interpolatee
 			{
 			public:
 				TextFieldTheme();
@@ -55,21 +54,23 @@ namespace ui
 				const util::Dimension getPreferredSize(const Component *comp) const;
 			private:
 				void propertyChanged(const event::PropertyEvent &e);
-				void keyPressed(const event::KeyEvent &e);
-				void keyReleased(const event::KeyEvent &e);
-				void keyTyped(const event::KeyEvent &e);
 
 				void focusLost(const event::FocusEvent &e);
 				void focusGained(const event::FocusEvent &e);
 
 				void update(float value);
 
+				/**
+				 * Returns the number of characters before end.
+				 */
+				static int countCharacters(const std::string &text, std::size_t end);
+
 				util::Color foreground;
 				util::GradientColor background;
 				border::BevelBorder border;
 				util::LinearTimeInterpolator interpolator;
 				bool displayCursor;
-				int cursorPosition;
+				mutable std::string echoText;
 			};
 		}
 	}
@@ -52,7 +52,7 @@ namespace ui
 				titleBar->getCloseButton()->setFocusPainted(false);
 				titleBar->getTitleLabel()->setMargin(util::Insets(0,5,0,0));
 				//titleBar->getTitleLabel()->setForeground(&foreground);
-				titleBar->setBackground(SchemeManager::getInstance().getScheme()->getTitleBarDeselected());
+				titleBar->setBackground(titleBar->getContext()->getSchemeManager().getScheme()->getTitleBarDeselected());
 				titleBar->setBorder(&border);
 				titleBar->setInsets(util::Insets(0,0,1,0)); // draw only the bottom border (looks better)
 				titleBar->getTitleLabel()->setBackground(&background);
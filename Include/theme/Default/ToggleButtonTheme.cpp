@@ -58,18 +58,18 @@ namespace ui
 				if(button->isSelected())
 				{
 					button->setBorder(&borderLowered);
-					button->setBackground(SchemeManager::getInstance().getScheme()->getPushableLoweredBackground());
+					button->setBackground(button->getContext()->getSchemeManager().getScheme()->getPushableLoweredBackground());
 				}
 				else
 				{
 					button->setBorder(&borderRaised);
-					button->setBackground(SchemeManager::getInstance().getScheme()->getPushableRaisedBackground());
+					button->setBackground(button->getContext()->getSchemeManager().getScheme()->getPushableRaisedBackground());
 				}
 				button->setBorderPainted(true);
 				button->setForeground(&foreground);
 				button->setMargin(util::Insets(7,7,7,7));
 				button->addKeyListener(this);
-				button->setFont(SchemeManager::getInstance().getScheme()->getDefaultFont()); // default font
+				button->setFont(button->getContext()->getSchemeManager().getScheme()->getDefaultFont()); // default font
 			}
 
 			void ToggleButtonTheme::deinstallTheme(Component *comp)
@@ -88,7 +88,7 @@ namespace ui
 				{
 					ComponentTheme::paint(g,button);
 				}
-				Util::paintButton(button,g);
+				Util::paintButton(button,g,text);
 			}
 
 			void ToggleButtonTheme::propertyChanged(const event::PropertyEvent &e)
@@ -107,13 +107,13 @@ namespace ui
 						}
 					case AbstractButton::SELECTED:
 						{
-							comp->setBackground(SchemeManager::getInstance().getScheme()->getPushableLoweredBackground());
+							comp->setBackground(comp->getContext()->getSchemeManager().getScheme()->getPushableLoweredBackground());
 							comp->setBorder(&borderLowered);
 							break;
 						}
 					case AbstractButton::DESELECTED:
 						{
-							comp->setBackground(SchemeManager::getInstance().getScheme()->getPushableRaisedBackground());
+							comp->setBackground(comp->getContext()->getSchemeManager().getScheme()->getPushableRaisedBackground());
 							comp->setBorder(&borderRaised);
 							break;
 						}
@@ -28,9 +28,11 @@
 #include "./Util.h"
 #include "../../util/Dimension.h"
 #include "../../Font.h"
+#include "../../GlyphContext.h"
 #include "../../Graphics.h"
 #include "../../Icon.h"
 #include "./Scheme.h"
+#include "../TextUtil.h"
 
 namespace ui
 {
@@ -38,13 +40,13 @@ namespace ui
 	{
 		namespace defaulttheme
 		{
-			std::string Util::getButtonString(const AbstractButton *button)
+			const std::string & Util::getButtonString(const AbstractButton *button, StringBuffer &buffer)
 			{
 				// this function might appear quite slow, and in fact, it is.
 				// the speed depends on the font engine implementation, having
 				// a fast font engine, with for example cached glyph dimensions speeds
 				// up the whole font rendering.
-				util::Dimension bbox(button->getFont()->getStringBoundingBox(button->getText()));
+				util::Dimension bbox(button->getContext()->getGlyphContext().getStringBoundingBox(button->getFontHandle(),button->getText()));
 			//	int width = bbox.width;
 			//	int height = bbox.height;
 
@@ -59,39 +61,43 @@ namespace ui
 					{
 						// by now, the text does not fit in our Component,
 						// let's see if chopping off some characters helps.
-						std::string text = button->getText();
-						std::string final;
-						for(std::size_t i = 0; i < text.length(); ++i)
-						{
-							std::string tmp(final);
-							util::Dimension strbbox(button->getFont()->getStringBoundingBox(tmp.append(".......")));
-							if(strbbox.width < (button->getBounds().width - button->getMargin().left - button->getMargin().right) && strbbox.height < button->getBounds().height)
-							{
-								// so far we fit, append one char and try again
-								//std::string(text[i]);
-								final += text[i];
-							}
-							else
-							{
-								if(final != "")
-								{
-									final.append("...");
-								}
-								break;
-							}
-						}
-						return final;
+						return Util::truncateString(button->getContext()->getGlyphContext(),button->getFont(),button->getText(),button->getBounds().width - button->getMargin().left - button->getMargin().right,buffer);
 					}
 				}
-				return "";
+				buffer.text.clear();
+				return buffer.text;
+			}
+
+			const std::string & Util::truncateString(GlyphContext &glyphs, Font *font, const std::string &text, int width, StringBuffer &buffer)
+			{
+				// the text is measured once, its prefix widths tell how many
+				// characters fit in front of the ellipsis.
+				std::vector<int> &widths = buffer.widths;
+				TextUtil::getPrefixWidths(glyphs,font,text,widths);
+
+				int limit = width - glyphs.getStringBoundingBox(font,".......").width;
+				std::size_t length = std::lower_bound(widths.begin(),widths.end() - 1,limit) - widths.begin();
+
+				if(length == text.length())
+				{
+					return text;
+				}
+
+				// assign keeps the capacity of the buffer.
+				buffer.text.assign(text,0,length);
+				if(length > 0)
+				{
+					buffer.text.append("...");
+				}
+				return buffer.text;
 			}
 
 			const util::Dimension Util::getButtonSize(const AbstractButton *button)
 			{
-				std::string text = button->getText();
+				const std::string &text = button->getText();
 				Font *f = button->getFont();
 
-				util::Dimension bbox(f->getStringBoundingBox(text));
+				util::Dimension bbox(button->getContext()->getGlyphContext().getStringBoundingBox(f,text));
 				int width = bbox.width + button->getMargin().left + button->getMargin().right + button->getInsets().left + button->getInsets().right;
 				int height= bbox.height + button->getMargin().top + button->getMargin().bottom + button->getInsets().top + button->getInsets().bottom; 	
 
@@ -127,8 +133,8 @@ namespace ui
 				// be improved by writing a better font engine.
 				// HACK HACK: edited the font engine to cache values :|
 				//std::string str = Util::getButtonString(button);
-				std::string str = button->getText();
-				util::Dimension rec(button->getFont()->getStringBoundingBox(str));
+				const std::string &str = button->getText();
+				util::Dimension rec(button->getContext()->getGlyphContext().getStringBoundingBox(button->getFontHandle(),str));
 				util::Point alignment(Util::getButtonAlignment(button,str,rec));
 
 				
@@ -139,7 +145,7 @@ namespace ui
 					// Sigh.
 					//int offset = 3;
 					//util::Color focus(139,178,206);
-					g.setPaint(SchemeManager::getInstance().getScheme()->getHighlight());
+					g.setPaint(button->getContext()->getSchemeManager().getScheme()->getHighlight());
 					g.fillRect(0,0,button->getBounds().width,button->getBounds().height);
 					//g.drawRect(alignment.x - offset,alignment.y - offset,rec.width + offset + offset,rec.height + offset + offset);
 				}
@@ -155,14 +161,14 @@ namespace ui
 
 			}
 
-			void Util::paintButton(const AbstractButton *button, Graphics &g)
+			void Util::paintButton(const AbstractButton *button, Graphics &g, StringBuffer &buffer)
 			{			
 				// this is slow due to the Font engine not caching these values,
 				// but instead calculating them on the fly. Performance could
 				// be improved by writing a better font engine.
 				// HACK HACK: edited the font engine to cache values :|
-				std::string str = Util::getButtonString(button);
-				util::Dimension rec(button->getFont()->getStringBoundingBox(str));
+				const std::string &str = Util::getButtonString(button,buffer);
+				util::Dimension rec(button->getContext()->getGlyphContext().getStringBoundingBox(button->getFontHandle(),str));
 				util::Point alignment(Util::getButtonAlignment(button,str,rec));
 
 				
@@ -173,7 +179,7 @@ namespace ui
 					// Sigh.
 					int offset = 3;
 					//util::Color focus(139,178,206);
-					g.setPaint(SchemeManager::getInstance().getScheme()->getHighlight());
+					g.setPaint(button->getContext()->getSchemeManager().getScheme()->getHighlight());
 					g.drawRect(alignment.x - offset,alignment.y - offset,rec.width + offset + offset,rec.height + offset + offset);
 				}
 
@@ -218,7 +224,7 @@ namespace ui
 					{
 					case AbstractButton::CENTER:
 						{
-							util::Dimension bbox(button->getFont()->getStringBoundingBox(text));
+							util::Dimension bbox(button->getContext()->getGlyphContext().getStringBoundingBox(button->getFontHandle(),text));
 							x = (comp.width / 2) - (bbox.width / 2) - (getActiveIcon(button)->getIconWidth() /2);/*/2 - getActiveIcon(button)->getIconWidth()/2;*/
 							break;
 						}
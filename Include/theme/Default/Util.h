@@ -48,12 +48,37 @@ namespace ui
 			class Util
 			{
 			public:
+				/**
+				 * Scratch space for the strings painted by a theme. It
+				 * is owned by the caller and reused, so painting does
+				 * not allocate once it has grown to the longest text.
+				 */
+				class StringBuffer
+				{
+				public:
+					std::string text;
+					std::vector<int> widths;
+				};
+
 				static util::Point getButtonAlignment(const AbstractButton *button, const std::string &text, const util::Dimension &strbbox);
-				// this will create a string that fits in the button
-				static std::string getButtonString(const AbstractButton *button);
-				static void paintButton(const AbstractButton *button, Graphics &g);
+
+				/**
+				 * Returns the text of the button, truncated to fit in it,
+				 * or an empty string if it does not fit at all. The result
+				 * is either the text of the button or stored in buffer.
+				 */
+				static const std::string & getButtonString(const AbstractButton *button, StringBuffer &buffer);
+				static void paintButton(const AbstractButton *button, Graphics &g, StringBuffer &buffer);
 				static void paintMenuItem(const MenuItem *menuItem, Graphics &g);
 				static const util::Dimension getButtonSize(const AbstractButton * button);
+
+				/**
+				 * Returns the longest prefix of text which fits in width
+				 * together with an ellipsis, or text itself if it fits.
+				 * A truncated string is stored in buffer.
+				 * The text is measured with glyphs.
+				 */
+				static const std::string & truncateString(GlyphContext &glyphs, Font *font, const std::string &text, int width, StringBuffer &buffer);
 				
 				
 				
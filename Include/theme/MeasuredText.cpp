@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./MeasuredText.h"
+#include "./TextUtil.h"
+#include "../GlyphContext.h"
+#include "../util/DecodedText.h"
+
+namespace ui
+{
+	namespace theme
+	{
+		MeasuredText::MeasuredText()
+			:	widths(1,0),
+				font(0),
+				glyphContext(0)
+		{
+		}
+
+		void MeasuredText::measure(GlyphContext &glyphs, const std::string &text, Font *f)
+		{
+			font = f;
+			glyphContext = &glyphs;
+			TextUtil::getPrefixWidths(glyphs,font,text,widths);
+			size = glyphs.getStringBoundingBox(font,text);
+
+			util::DecodedText decoded;
+			decoded.decode(text);
+
+			breaks.clear();
+			for(std::size_t i = 1; i < text.length(); ++i)
+			{
+				if(decoded.isLineBreak(i))
+				{
+					breaks.push_back(i);
+				}
+			}
+			breaks.push_back(text.length());
+		}
+
+		const std::vector<int> & MeasuredText::getPrefixWidths() const
+		{
+			return widths;
+		}
+
+		const std::vector<std::size_t> & MeasuredText::getBreakOpportunities() const
+		{
+			return breaks;
+		}
+
+		const util::Dimension & MeasuredText::getSize() const
+		{
+			return size;
+		}
+
+		Font * MeasuredText::getFont() const
+		{
+			return font;
+		}
+
+		GlyphContext * MeasuredText::getGlyphContext() const
+		{
+			return glyphContext;
+		}
+
+		std::size_t MeasuredText::getMemoryUsage() const
+		{
+			return sizeof(MeasuredText) + widths.capacity() * sizeof(int) + breaks.capacity() * sizeof(std::size_t);
+		}
+
+		void MeasuredText::release()
+		{
+			std::vector<int>(1,0).swap(widths);
+			std::vector<std::size_t>().swap(breaks);
+			size = util::Dimension();
+			font = 0;
+			glyphContext = 0;
+		}
+	}
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MEASUREDTEXT_H
+#define MEASUREDTEXT_H
+
+#include "../Pointers.h"
+#include "../util/Dimension.h"
+
+namespace ui
+{
+	namespace theme
+	{
+		/**
+		 * The part of wrapping a line of text which does not depend
+		 * on the width it is wrapped to: the width of every prefix of
+		 * the text, and the offsets at which the line may be broken.
+		 * <p>
+		 * A line is measured once per text and Font. Wrapping it to
+		 * another width, when a Component is resized, then only has to
+		 * fit the measured words into lines, which does not call the
+		 * Font at all.
+		 * </p>
+		 * Break opportunities follow util::DecodedText: after spaces and
+		 * hyphens, and around ideographs, kana and hangul.
+		 */
+		class MeasuredText
+		{
+		public:
+			/**
+			 * Creates an empty MeasuredText.
+			 */
+			MeasuredText();
+
+			/**
+			 * Measures a line of text.
+			 * @param
+			 *	glyphs the GlyphContext to measure with.
+			 * @param
+			 *	text the text, without line breaks.
+			 * @param
+			 *	font the Font to measure with.
+			 */
+			void measure(GlyphContext &glyphs, const std::string &text, Font *font);
+
+			/**
+			 * Returns the width of every prefix of the text, so the
+			 * width of the first n bytes is at index n. The bytes
+			 * of a code point after the first add no width.
+			 */
+			const std::vector<int> & getPrefixWidths() const;
+
+			/**
+			 * Returns the offsets at which the line may be broken,
+			 * in increasing order. The last offset is always the
+			 * length of the text.
+			 */
+			const std::vector<std::size_t> & getBreakOpportunities() const;
+
+			/**
+			 * Returns the bounding box of the whole line.
+			 */
+			const util::Dimension & getSize() const;
+
+			/**
+			 * Returns the Font the text was measured with.
+			 */
+			Font * getFont() const;
+
+			/**
+			 * Returns the GlyphContext the text was measured with.
+			 */
+			GlyphContext * getGlyphContext() const;
+
+			/**
+			 * Returns the number of bytes used.
+			 */
+			std::size_t getMemoryUsage() const;
+
+			/**
+			 * Frees all memory.
+			 */
+			void release();
+		private:
+			std::vector<int> widths;
+			std::vector<std::size_t> breaks;
+			util::Dimension size;
+			Font *font;
+			GlyphContext *glyphContext;
+		};
+
+		typedef std::vector<MeasuredText> MeasuredTextBuffer;
+	}
+}
+
+#endif
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./TextLayout.h"
+#include "./TextLayoutCache.h"
+
+namespace ui
+{
+	namespace theme
+	{
+		TextLayout::TextLayout()
+			:	valid(false),
+				revision(0),
+				font(0),
+				algorithm(0),
+				horizontal(0),
+				vertical(0),
+				measured(false),
+				measuredRevision(0),
+				measuredFont(0),
+				lineCount(0),
+				verticalIconAlignment(0),
+				verticalTextAlignment(0),
+				horizontalAlignment(0),
+				cache(0),
+				previous(0),
+				next(0),
+				memoryUsage(0)
+		{
+		}
+
+		TextLayout::TextLayout(const TextLayout &rhs)
+			:	valid(false),
+				revision(0),
+				font(0),
+				algorithm(0),
+				horizontal(0),
+				vertical(0),
+				measured(false),
+				measuredRevision(0),
+				measuredFont(0),
+				lineCount(0),
+				verticalIconAlignment(0),
+				verticalTextAlignment(0),
+				horizontalAlignment(0),
+				cache(0),
+				previous(0),
+				next(0),
+				memoryUsage(0)
+		{
+		}
+
+		TextLayout& TextLayout::operator=(const TextLayout &rhs)
+		{
+			invalidate();
+			return *this;
+		}
+
+		TextLayout::~TextLayout()
+		{
+			// not getInstance, the layout may be destroyed in
+			// another context, or after its cache.
+			if(cache != 0)
+			{
+				cache->remove(this);
+			}
+		}
+
+		void TextLayout::invalidate()
+		{
+			valid = false;
+		}
+
+		bool TextLayout::isValid() const
+		{
+			return valid;
+		}
+
+		const StringInfoBuffer & TextLayout::getLines() const
+		{
+			return lines;
+		}
+
+		std::size_t TextLayout::getLineCount() const
+		{
+			return lineCount;
+		}
+
+		const util::Dimension & TextLayout::getStringBoundingBox() const
+		{
+			return stringBoundingBox;
+		}
+
+		int TextLayout::getVerticalIconAlignment() const
+		{
+			return verticalIconAlignment;
+		}
+
+		int TextLayout::getVerticalTextAlignment() const
+		{
+			return verticalTextAlignment;
+		}
+
+		int TextLayout::getHorizontalAlignment() const
+		{
+			return horizontalAlignment;
+		}
+
+		std::size_t TextLayout::getMemoryUsage() const
+		{
+			std::size_t bytes = sizeof(TextLayout) + lines.capacity() * sizeof(StringInfo);
+
+			StringInfoBuffer::const_iterator iter;
+			for(iter = lines.begin(); iter != lines.end(); ++iter)
+			{
+				bytes += iter->first.capacity();
+			}
+
+			bytes += measuredLines.capacity() * sizeof(MeasuredText);
+
+			MeasuredTextBuffer::const_iterator line;
+			for(line = measuredLines.begin(); line != measuredLines.end(); ++line)
+			{
+				bytes += line->getMemoryUsage() - sizeof(MeasuredText);
+			}
+			return bytes;
+		}
+
+		void TextLayout::release()
+		{
+			valid = false;
+			measured = false;
+			lineCount = 0;
+			StringInfoBuffer().swap(lines);
+			MeasuredTextBuffer().swap(measuredLines);
+		}
+	}
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TEXTLAYOUT_H
+#define TEXTLAYOUT_H
+
+#include "../Pointers.h"
+#include "../util/Dimension.h"
+#include "../util/Insets.h"
+#include "./MeasuredText.h"
+
+namespace ui
+{
+	namespace theme
+	{
+		class TextWrappingAlgorithm;
+		class TextLayoutCache;
+
+		typedef std::vector<std::string> StringBuffer;
+		typedef std::pair<std::string,util::Dimension> StringInfo;
+		typedef std::vector<StringInfo> StringInfoBuffer;
+
+		/**
+		 * A line of wrapped text, given as a range of bytes in
+		 * the text which was wrapped and the width of that range.
+		 */
+		struct LineSpan
+		{
+			std::size_t offset;
+			std::size_t length;
+			int width;
+		};
+
+		typedef std::vector<LineSpan> LineSpanBuffer;
+
+		/**
+		 * The lines of a text fitted in the bounds of a Component, and
+		 * where they are painted.
+		 * <p>
+		 * Each Component which shows text owns a TextLayout. Its theme
+		 * lets TextUtil::layoutText fill it in, and reuses the result
+		 * for as long as the text, font, bounds, insets, margins, icon,
+		 * alignment and wrapping algorithm stay the same, which is
+		 * nearly always the case from one frame to the next. The
+		 * measurements of the lines are kept for as long as the text
+		 * and font stay the same, so resizing the Component only fits
+		 * the measured words into lines again.
+		 * </p>
+		 * The memory used by all TextLayouts is bounded by the
+		 * TextLayoutCache, which discards the least recently painted
+		 * layouts when it runs out of budget.
+		 */
+		class TextLayout
+		{
+		public:
+			TextLayout();
+
+			/**
+			 * Copies nothing, a copy is laid out again
+			 * when it is first painted.
+			 */
+			TextLayout(const TextLayout &rhs);
+			TextLayout& operator=(const TextLayout &rhs);
+
+			~TextLayout();
+
+			/**
+			 * Forces the text to be laid out again the next
+			 * time it is painted.
+			 */
+			void invalidate();
+
+			/**
+			 * Returns true if the layout is up to date.
+			 */
+			bool isValid() const;
+
+			/**
+			 * Returns the fitted lines. Only the first getLineCount()
+			 * are part of the layout, the rest are kept so their
+			 * strings can be reused.
+			 */
+			const StringInfoBuffer & getLines() const;
+
+			/**
+			 * Returns the number of fitted lines.
+			 */
+			std::size_t getLineCount() const;
+
+			/**
+			 * Returns the bounding box of the fitted lines.
+			 */
+			const util::Dimension & getStringBoundingBox() const;
+
+			/**
+			 * Returns the vertical location of the icon.
+			 */
+			int getVerticalIconAlignment() const;
+
+			/**
+			 * Returns the vertical location of the text.
+			 */
+			int getVerticalTextAlignment() const;
+
+			/**
+			 * Returns the horizontal location of the content.
+			 */
+			int getHorizontalAlignment() const;
+		private:
+			friend class TextUtil;
+			friend class TextLayoutCache;
+
+			/**
+			 * Returns the number of bytes used by the layout.
+			 */
+			std::size_t getMemoryUsage() const;
+
+			/**
+			 * Frees the memory of the lines.
+			 */
+			void release();
+
+			bool valid;
+
+			// the inputs the layout was computed for.
+			std::size_t revision;
+			Font *font;
+			const TextWrappingAlgorithm *algorithm;
+			util::Dimension componentBoundingBox;
+			util::Dimension iconBoundingBox;
+			util::Insets insets;
+			util::Insets margins;
+			int horizontal;
+			int vertical;
+
+			// the measured lines, which only depend on
+			// the text and font.
+			bool measured;
+			std::size_t measuredRevision;
+			Font *measuredFont;
+			MeasuredTextBuffer measuredLines;
+
+			// the results.
+			StringInfoBuffer lines;
+			std::size_t lineCount;
+			util::Dimension stringBoundingBox;
+			int verticalIconAlignment;
+			int verticalTextAlignment;
+			int horizontalAlignment;
+
+			// the TextLayoutCache keeps its layouts in a list,
+			// the most recently used first. cache is the one the
+			// layout is in, 0 if it holds no lines.
+			TextLayoutCache *cache;
+			TextLayout *previous;
+			TextLayout *next;
+			std::size_t memoryUsage;
+		};
+	}
+}
+
+#endif
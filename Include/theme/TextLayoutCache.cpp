@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./TextLayoutCache.h"
+#include "./TextLayout.h"
+
+namespace ui
+{
+	namespace theme
+	{
+		TextLayoutCache::TextLayoutCache()
+			:	first(0),
+				last(0),
+				size(0),
+				budget(1024 * 1024),
+				memoryUsage(0),
+				hits(0),
+				misses(0),
+				evictions(0)
+		{
+		}
+
+		TextLayoutCache::~TextLayoutCache()
+		{
+			// layouts which outlive the cache no longer remove
+			// themselves from it.
+			while(first != 0)
+			{
+				TextLayout *layout = first;
+				first = layout->next;
+				layout->cache = 0;
+				layout->previous = 0;
+				layout->next = 0;
+			}
+		}
+
+		void TextLayoutCache::setBudget(std::size_t bytes)
+		{
+			budget = bytes;
+			evict(0);
+		}
+
+		std::size_t TextLayoutCache::getBudget() const
+		{
+			return budget;
+		}
+
+		std::size_t TextLayoutCache::getMemoryUsage() const
+		{
+			return memoryUsage;
+		}
+
+		std::size_t TextLayoutCache::getSize() const
+		{
+			return size;
+		}
+
+		std::size_t TextLayoutCache::getHits() const
+		{
+			return hits;
+		}
+
+		std::size_t TextLayoutCache::getMisses() const
+		{
+			return misses;
+		}
+
+		std::size_t TextLayoutCache::getEvictions() const
+		{
+			return evictions;
+		}
+
+		float TextLayoutCache::getHitRate() const
+		{
+			if(hits + misses == 0)
+			{
+				return 0.0f;
+			}
+			return static_cast<float>(hits) / static_cast<float>(hits + misses);
+		}
+
+		void TextLayoutCache::resetStatistics()
+		{
+			hits = 0;
+			misses = 0;
+			evictions = 0;
+		}
+
+		void TextLayoutCache::hit(TextLayout *layout)
+		{
+			++hits;
+
+			// the lines are still there when the cache which
+			// held them was destroyed, this one takes them over.
+			if(layout->cache != this)
+			{
+				link(layout);
+				evict(layout);
+			}
+			else if(layout != first)
+			{
+				unlink(layout);
+
+				layout->next = first;
+				first->previous = layout;
+				first = layout;
+			}
+		}
+
+		void TextLayoutCache::store(TextLayout *layout)
+		{
+			++misses;
+			link(layout);
+			evict(layout);
+		}
+
+		void TextLayoutCache::link(TextLayout *layout)
+		{
+			// the layout may already be in a list with
+			// lines from an earlier layout.
+			if(layout->cache != 0)
+			{
+				layout->cache->remove(layout);
+			}
+			layout->cache = this;
+
+			layout->memoryUsage = layout->getMemoryUsage();
+			memoryUsage += layout->memoryUsage;
+			++size;
+
+			layout->next = first;
+			if(first != 0)
+			{
+				first->previous = layout;
+			}
+			else
+			{
+				last = layout;
+			}
+			first = layout;
+		}
+
+		void TextLayoutCache::remove(TextLayout *layout)
+		{
+			if(layout->cache == this)
+			{
+				unlink(layout);
+				memoryUsage -= layout->memoryUsage;
+				layout->memoryUsage = 0;
+				layout->cache = 0;
+				--size;
+			}
+		}
+
+		void TextLayoutCache::unlink(TextLayout *layout)
+		{
+			if(layout->previous != 0)
+			{
+				layout->previous->next = layout->next;
+			}
+			else
+			{
+				first = layout->next;
+			}
+
+			if(layout->next != 0)
+			{
+				layout->next->previous = layout->previous;
+			}
+			else
+			{
+				last = layout->previous;
+			}
+			layout->previous = 0;
+			layout->next = 0;
+		}
+
+		void TextLayoutCache::evict(const TextLayout *keep)
+		{
+			// the layout which is being painted is never discarded,
+			// even if it alone is larger than the budget.
+			while(memoryUsage > budget && last != 0 && last != keep)
+			{
+				TextLayout *layout = last;
+				remove(layout);
+				layout->release();
+				++evictions;
+			}
+		}
+	}
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TEXTLAYOUTCACHE_H
+#define TEXTLAYOUTCACHE_H
+
+#include "../Pointers.h"
+#include "../UiContext.h"
+
+namespace ui
+{
+	namespace theme
+	{
+		/**
+		 * A singleton which bounds the memory used by all
+		 * TextLayouts and keeps statistics on how often
+		 * a layout could be reused.
+		 * <p>
+		 * Layouts are kept in least recently used order. When the
+		 * memory used by all layouts exceeds the budget, the lines of
+		 * the least recently painted layouts are freed, and those
+		 * layouts are computed again the next time they are painted.
+		 * </p>
+		 */
+		class TextLayoutCache
+		{
+		public:
+			/**
+			 * Sets the number of bytes all TextLayouts may use
+			 * together. Layouts are discarded immediately if they
+			 * use more than the new budget.
+			 */
+			void setBudget(std::size_t bytes);
+
+			/**
+			 * Returns the number of bytes all TextLayouts may
+			 * use together.
+			 */
+			std::size_t getBudget() const;
+
+			/**
+			 * Returns the number of bytes used by all
+			 * TextLayouts.
+			 */
+			std::size_t getMemoryUsage() const;
+
+			/**
+			 * Returns the number of TextLayouts which hold lines.
+			 */
+			std::size_t getSize() const;
+
+			/**
+			 * Returns the number of times a layout was reused.
+			 */
+			std::size_t getHits() const;
+
+			/**
+			 * Returns the number of times a text had to be
+			 * laid out.
+			 */
+			std::size_t getMisses() const;
+
+			/**
+			 * Returns the number of layouts discarded to stay
+			 * within the budget.
+			 */
+			std::size_t getEvictions() const;
+
+			/**
+			 * Returns the fraction of lookups that reused a
+			 * layout, between 0 and 1.
+			 */
+			float getHitRate() const;
+
+			/**
+			 * Sets the hit, miss and eviction counters to zero.
+			 */
+			void resetStatistics();
+
+			/**
+			 * Returns the instance of the current UiContext.
+			 * @note this is part of the Singleton.
+			 */
+			static TextLayoutCache &getInstance()
+			{
+				return UiContext::getCurrent().getTextLayoutCache();
+			}
+		private:
+			TextLayoutCache();
+			~TextLayoutCache();
+			TextLayoutCache(const TextLayoutCache&);
+			TextLayoutCache& operator=(const TextLayoutCache&);
+			friend class ui::UiContext;
+
+			friend class TextUtil;
+			friend class TextLayout;
+
+			/**
+			 * Marks a layout as used, called when it is reused.
+			 */
+			void hit(TextLayout *layout);
+
+			/**
+			 * Accounts for a layout which was just computed.
+			 */
+			void store(TextLayout *layout);
+
+			/**
+			 * Forgets a layout, called when it is destroyed.
+			 */
+			void remove(TextLayout *layout);
+
+			/**
+			 * Takes layout out of the cache it is in, and puts it
+			 * at the front of this one.
+			 */
+			void link(TextLayout *layout);
+
+			void unlink(TextLayout *layout);
+			void evict(const TextLayout *keep);
+
+			TextLayout *first;
+			TextLayout *last;
+			std::size_t size;
+			std::size_t budget;
+			std::size_t memoryUsage;
+			std::size_t hits;
+			std::size_t misses;
+			std::size_t evictions;
+		};
+	}
+}
+
+#endif
@@ -29,7 +29,10 @@
 #include "../Component.h"
 #include "../Graphics.h"
 #include "../Font.h"
+#include "../GlyphContext.h"
 #include "../Icon.h"
+#include "./TextLayoutCache.h"
+#include "../util/Utf8.h"
 
 namespace ui
 {
@@ -252,74 +255,42 @@ namespace ui
 			return std::string("");
 		}
 
-		StringInfoBuffer TextUtil::getButtonString(Font *font, const std::string &text) const
+		StringInfoBuffer TextUtil::getButtonString(GlyphContext &glyphs, Font *font, const std::string &text) const
 		{
 			StringInfoBuffer result;
-			std::vector<std::string> tempString(splitText(text));
-			std::vector<std::string>::const_iterator iter;
+			std::string::size_type index = 0;
 
-			for(iter = tempString.begin(); iter != tempString.end(); ++iter)
+			while(getLine(text,index,line))
 			{
-				result.push_back(StringInfo((*iter),font->getStringBoundingBox((*iter))));
+				result.push_back(StringInfo(line,glyphs.getStringBoundingBox(font,line)));
 			}
 			return result;
 		}
 
-		StringInfoBuffer TextUtil::getButtonString(const util::Dimension &boundingBox, const util::Insets &margin, Font *font, const std::string &text, bool wordWrap) const
+		StringInfoBuffer TextUtil::getButtonString(GlyphContext &glyphs, const util::Dimension &boundingBox, const util::Insets &margin, Font *font, const std::string &text, bool wordWrap) const
 		{
 			StringInfoBuffer result;
-			std::vector<std::string> tempString(splitText(text));
-			std::vector<std::string>::const_iterator iter;
+			std::string::size_type index = 0;
 
 			int height = 0;
-			for(iter = tempString.begin(); iter != tempString.end(); ++iter)
+			while(getLine(text,index,line))
 			{
-				util::Dimension stringBoundingBox = font->getStringBoundingBox((*iter));
+				util::Dimension stringBoundingBox = glyphs.getStringBoundingBox(font,line);
 				if((height + stringBoundingBox.height) <= (boundingBox.height - margin.bottom - margin.top))
 				{
 					if(stringBoundingBox.width <= (boundingBox.width - margin.left - margin.right))
 					{
-						result.push_back(StringInfo((*iter),util::Dimension(stringBoundingBox.width,stringBoundingBox.height)));
+						result.push_back(StringInfo(line,util::Dimension(stringBoundingBox.width,stringBoundingBox.height)));
 					}
 					else
 					{
 						if(wordWrap)
 						{
-							/*
-							//std::vector<std::string> result;
-							std::string::size_type index = 0;
-			
-							while(index != std::string::npos)
-							{
-								int width = 0;
-								std::string::size_type lineBreak = 0;
-								while(width <= boundingBox.width)
-								{
-									lineBreak = (*iter).find(' ');
-									width = font->getStringBoundingBox((*iter).substr(index,lineBreak));
-
-									if(lineBreak == std::string::npos)
-									{
-										break;
-									}
-								}
-
-								result.push_back(text.substr(index,lineBreak));
-
-								if(lineBreak != std::string::npos)
-								{
-									index = lineBreak + 1;
-								}
-								else
-								{
-									break;
-								}
-							}
-							*/
+							result.resize(wordWrapAlgorithm.wrapText(glyphs,line,font,boundingBox.width - margin.left - margin.right,result,result.size()));
 						}
 						else
 						{
-							result.push_back(StringInfo(getMaxString((*iter),font,boundingBox.width),util::Dimension(boundingBox.width,stringBoundingBox.height)));
+							result.push_back(StringInfo(getMaxString(line,font,boundingBox.width),util::Dimension(boundingBox.width,stringBoundingBox.height)));
 						}
 					}	
 				}
@@ -328,97 +299,463 @@ namespace ui
 			return result;
 		}
 
-		StringBuffer TextUtil::splitText(const std::string &text) const
+		bool TextUtil::getLine(const std::string &text, std::string::size_type &index, std::string &line) const
 		{
-			StringBuffer result;
-			std::string::size_type index = 0;
-			
-			while(index != std::string::npos)
+			if(index == std::string::npos)
 			{
-				std::string::size_type lineBreak = text.find('\n',index);
+				return false;
+			}
 
-				if(lineBreak == index)
-				{
-					result.push_back(std::string(""));
-				}
-				else
+			std::string::size_type lineBreak = text.find('\n',index);
+
+			if(lineBreak != std::string::npos)
+			{
+				line.assign(text,index,lineBreak - index);
+				index = lineBreak + 1;
+			}
+			else
+			{
+				line.assign(text,index,std::string::npos);
+				index = std::string::npos;
+			}
+			return true;
+		}
+
+		StringInfo& TextUtil::appendStringInfo(StringInfoBuffer &buffer, std::size_t &count)
+		{
+			if(count == buffer.size())
+			{
+				buffer.push_back(StringInfo());
+			}
+			return buffer[count++];
+		}
+
+		LineSpan& TextUtil::appendLineSpan(LineSpanBuffer &buffer, std::size_t &count)
+		{
+			if(count == buffer.size())
+			{
+				buffer.push_back(LineSpan());
+			}
+			return buffer[count++];
+		}
+
+		void TextUtil::getPrefixWidths(GlyphContext &glyphs, Font *font, const std::string &text, std::vector<int> &widths)
+		{
+			glyphs.getGlyphAdvances(font,text,widths);
+			widths.resize(text.length() + 1);
+
+			// turn the advances into a running sum, in place.
+			int width = 0;
+			for(std::size_t i = 0; i < text.length(); ++i)
+			{
+				int advance = widths[i];
+				widths[i] = width;
+				width += advance;
+			}
+			widths[text.length()] = width;
+		}
+
+		std::size_t TextUtil::getFittingLength(const std::vector<int> &widths, int width)
+		{
+			if(widths.empty() || width < widths.front())
+			{
+				return 0;
+			}
+			return (std::upper_bound(widths.begin(),widths.end(),width) - widths.begin()) - 1;
+		}
+
+		std::size_t TextUtil::getCaretIndex(const std::vector<int> &widths, int x)
+		{
+			std::size_t index = getFittingLength(widths,x);
+
+			// pick the closest edge of the character under x.
+			if(index + 1 < widths.size() && (x - widths[index]) * 2 > (widths[index + 1] - widths[index]))
+			{
+				// move past the rest of the code point, whose
+				// other bytes have no width.
+				index = getFittingLength(widths,widths[index + 1]);
+			}
+			return index;
+		}
+		// -------------------------------------------------------------------
+		std::size_t TextWrappingAlgorithm::wrapText(GlyphContext &glyphs, const std::string &text, Font *font, int width, StringInfoBuffer &buffer, std::size_t count) const
+		{
+			measuredText.measure(glyphs,text,font);
+			return wrapMeasuredText(text,measuredText,width,buffer,count);
+		}
+
+		std::size_t TextWrappingAlgorithm::wrapMeasuredText(const std::string &text, const MeasuredText &measured, int width, StringInfoBuffer &buffer, std::size_t count) const
+		{
+			std::size_t lines = wrapSpans(text,measured,width,spans,0);
+
+			for(std::size_t i = 0; i < lines; ++i)
+			{
+				StringInfo &info = TextUtil::appendStringInfo(buffer,count);
+				info.first.assign(text,spans[i].offset,spans[i].length);
+				info.second = util::Dimension(spans[i].width,measured.getSize().height);
+			}
+			return count;
+		}
+		// -------------------------------------------------------------------
+		std::size_t CuttoffAlgorithm::wrapMeasuredText(const std::string &text, const MeasuredText &measured, int width, StringInfoBuffer &buffer, std::size_t count) const
+		{
+			const std::vector<int> &widths = measured.getPrefixWidths();
+
+			// the longest prefix which still leaves room for the ellipsis.
+			int ellipsisWidth = measured.getGlyphContext()->getStringBoundingBox(measured.getFont(),"...").width;
+			std::size_t index = TextUtil::getFittingLength(widths,width - ellipsisWidth);
+
+			StringInfo &info = TextUtil::appendStringInfo(buffer,count);
+
+			if(index > 0)
+			{
+				info.first.assign(text,0,index);
+				info.first.append("...");
+				info.second = util::Dimension(widths[index] + ellipsisWidth,measured.getSize().height);
+			}
+			else
+			{
+				info.first.erase();
+				info.second = util::Dimension(0,0);
+			}
+			return count;
+		}
+
+		std::size_t CuttoffAlgorithm::wrapSpans(const std::string &text, const MeasuredText &measured, int width, LineSpanBuffer &buffer, std::size_t count) const
+		{
+			const std::vector<int> &widths = measured.getPrefixWidths();
+
+			LineSpan &span = TextUtil::appendLineSpan(buffer,count);
+			span.offset = 0;
+			span.length = TextUtil::getFittingLength(widths,width);
+			span.width = widths[span.length];
+			return count;
+		}
+		// -------------------------------------------------------------------
+		std::size_t CharacterWrapAlgorithm::wrapSpans(const std::string &text, const MeasuredText &measured, int width, LineSpanBuffer &buffer, std::size_t count) const
+		{
+			const std::vector<int> &widths = measured.getPrefixWidths();
+			std::size_t offset = 0;
+
+			do
+			{
+				std::size_t length = TextUtil::getFittingLength(widths,widths[offset] + width) - offset;
+
+				// a line holds at least one code point, even
+				// if it does not fit.
+				if(length == 0 && offset < text.length())
 				{
-					result.push_back(text.substr(index,lineBreak-index));
+					length = util::Utf8::next(text,offset) - offset;
 				}
 
-				if(lineBreak != std::string::npos)
+				LineSpan &span = TextUtil::appendLineSpan(buffer,count);
+				span.offset = offset;
+				span.length = length;
+				span.width = widths[offset + length] - widths[offset];
+
+				offset += length;
+			}
+			while(offset < text.length());
+
+			return count;
+		}
+		// -------------------------------------------------------------------
+		WordWrapAlgorithm::WordWrapAlgorithm(int m)
+			:	mode(m)
+		{
+		}
+
+		int WordWrapAlgorithm::getMode() const
+		{
+			return mode;
+		}
+
+		std::size_t WordWrapAlgorithm::wrapSpans(const std::string &text, const MeasuredText &measured, int width, LineSpanBuffer &buffer, std::size_t count) const
+		{
+			if(text.empty())
+			{
+				LineSpan &span = TextUtil::appendLineSpan(buffer,count);
+				span.offset = 0;
+				span.length = 0;
+				span.width = 0;
+				return count;
+			}
+
+			if(mode == MINIMUM_RAGGEDNESS)
+			{
+				return wrapMinimumRaggedness(text,measured,width,buffer,count);
+			}
+			return wrapGreedy(text,measured,width,buffer,count);
+		}
+
+		std::size_t WordWrapAlgorithm::wrapGreedy(const std::string &text, const MeasuredText &measured, int width, LineSpanBuffer &buffer, std::size_t count) const
+		{
+			const std::vector<int> &widths = measured.getPrefixWidths();
+			const std::vector<std::size_t> &breaks = measured.getBreakOpportunities();
+
+			std::size_t begin = 0;
+			std::size_t next = 0;
+
+			do
+			{
+				// take words for as long as they fit.
+				std::size_t end = begin;
+				while(next < breaks.size() && getLineWidth(text,widths,begin,breaks[next]) <= width)
 				{
-					index = lineBreak + 1;
+					end = breaks[next++];
 				}
-				else
+
+				if(end == begin)
 				{
-					break;
+					// the next word is wider than a line on its own,
+					// break it at the last code point which fits.
+					end = TextUtil::getFittingLength(widths,widths[begin] + width);
+					if(end <= begin)
+					{
+						end = util::Utf8::next(text,begin);
+					}
 				}
+
+				appendLine(text,widths,begin,end,buffer,count);
+				begin = end;
 			}
-			return result;
+			while(begin < text.length());
+
+			return count;
 		}
-		// -------------------------------------------------------------------
-		StringInfoBuffer CuttoffAlgorithm::wrapText(const std::string &text, Font *font, int width) const
+
+		std::size_t WordWrapAlgorithm::wrapMinimumRaggedness(const std::string &text, const MeasuredText &measured, int width, LineSpanBuffer &buffer, std::size_t count) const
 		{
-			StringInfoBuffer result;
-			util::Dimension bbox;
-			std::string::size_type index = 0;
-			while(index <= text.length())
+			const std::vector<int> &widths = measured.getPrefixWidths();
+			const std::vector<std::size_t> &breaks = measured.getBreakOpportunities();
+
+			// node 0 is the start of the text, node j the break
+			// opportunity j - 1. costs[j] is the lowest cost of the
+			// lines up to node j, and previous[j] the node the last
+			// of those lines starts at.
+			std::size_t nodes = breaks.size() + 1;
+			costs.assign(nodes,0.0);
+			previous.assign(nodes,0);
+
+			for(std::size_t j = 1; j < nodes; ++j)
 			{
-				bbox = font->getStringBoundingBox(text.substr(0,index));
-				if(bbox.width >= width)
+				std::size_t end = breaks[j - 1];
+				bool found = false;
+
+				// lines only get wider when they start earlier.
+				for(std::size_t i = j; i-- > 0;)
 				{
-					break;
+					int lineWidth = getLineWidth(text,widths,(i == 0) ? 0 : breaks[i - 1],end);
+					if(lineWidth > width)
+					{
+						break;
+					}
+
+					// the last line may be as short as it likes.
+					double slack = (j == nodes - 1) ? 0.0 : static_cast<double>(width - lineWidth);
+					double cost = costs[i] + slack * slack;
+
+					if(!found || cost < costs[j])
+					{
+						costs[j] = cost;
+						previous[j] = i;
+						found = true;
+					}
+				}
+
+				if(!found)
+				{
+					return wrapGreedy(text,measured,width,buffer,count);
 				}
-				index++;
 			}
-			if(index > 3)
+
+			lines.clear();
+			for(std::size_t j = nodes - 1; j > 0; j = previous[j])
 			{
-				result.push_back(StringInfo(text.substr(0,index-3).append("..."),bbox));
+				lines.push_back(j);
 			}
-			else
+
+			for(std::size_t k = lines.size(); k > 0; --k)
 			{
-				result.push_back(StringInfo(std::string(""),util::Dimension(0,0)));
+				std::size_t j = lines[k - 1];
+				std::size_t i = previous[j];
+				appendLine(text,widths,(i == 0) ? 0 : breaks[i - 1],breaks[j - 1],buffer,count);
 			}
-			return result;
+			return count;
+		}
+
+		int WordWrapAlgorithm::getLineWidth(const std::string &text, const std::vector<int> &widths, std::size_t begin, std::size_t end)
+		{
+			while(end > begin && (text[end - 1] == ' ' || text[end - 1] == '\t'))
+			{
+				--end;
+			}
+			return widths[end] - widths[begin];
+		}
+
+		LineSpan& WordWrapAlgorithm::appendLine(const std::string &text, const std::vector<int> &widths, std::size_t begin, std::size_t end, LineSpanBuffer &buffer, std::size_t &count)
+		{
+			while(end > begin && (text[end - 1] == ' ' || text[end - 1] == '\t'))
+			{
+				--end;
+			}
+
+			LineSpan &span = TextUtil::appendLineSpan(buffer,count);
+			span.offset = begin;
+			span.length = end - begin;
+			span.width = widths[end] - widths[begin];
+			return span;
 		}
 		// -------------------------------------------------------------------
 		TextUtil::TextUtil(TextWrappingAlgorithm *algorithm)
-			:	textWrappingAlgorithm(algorithm)
+			:	textWrappingAlgorithm(algorithm),
+				wordWrapAlgorithm(WordWrapAlgorithm::GREEDY)
 		{
 		}
 
-		StringInfoBuffer TextUtil::fitStringInBoundingBox(const std::string &text, const util::Dimension &componentBoundingBox, const util::Dimension &iconBoundingBox, Font *font, const util::Insets &componentInsets, const util::Insets &componentMargins) const
+		std::size_t TextUtil::fitStringInBoundingBox(GlyphContext &glyphs, const std::string &text, const util::Dimension &componentBoundingBox, const util::Dimension &iconBoundingBox, Font *font, const util::Insets &componentInsets, const util::Insets &componentMargins, StringInfoBuffer &result) const
 		{
-			StringInfoBuffer result;
-			StringBuffer tempString(splitText(text));
-			StringBuffer::const_iterator end(tempString.end());
+			std::size_t count = 0;
+			std::string::size_type index = 0;
+			int maxWidth = componentBoundingBox.width - componentMargins.left - componentMargins.right - componentInsets.left - componentInsets.right - iconBoundingBox.width;
 
 			int height = 0;
-			for(StringBuffer::const_iterator iter = tempString.begin(); iter != end; ++iter)
+			while(getLine(text,index,line))
 			{
-				util::Dimension stringBoundingBox(font->getStringBoundingBox((*iter)));
+				util::Dimension stringBoundingBox(glyphs.getStringBoundingBox(font,line));
 			
 				if((height + stringBoundingBox.height) <= (componentBoundingBox.height - componentMargins.bottom - componentMargins.top))
 				{
-					if(stringBoundingBox.width <= (componentBoundingBox.width - componentMargins.left - componentMargins.right - componentInsets.left - componentInsets.right - iconBoundingBox.width))
+					if(stringBoundingBox.width <= maxWidth)
 					{
-						result.push_back(StringInfo((*iter),util::Dimension(stringBoundingBox.width,stringBoundingBox.height)));
+						StringInfo &info = appendStringInfo(result,count);
+						info.first = line;
+						info.second = stringBoundingBox;
 					}
 					else
 					{
-						StringInfoBuffer data(textWrappingAlgorithm->wrapText((*iter),font,componentBoundingBox.width - componentMargins.left - componentMargins.right - componentInsets.left - componentInsets.right - iconBoundingBox.width));
-						std::copy(data.begin(),data.end(), std::back_inserter(result));
+						count = textWrappingAlgorithm->wrapText(glyphs,line,font,maxWidth,result,count);
 					}	
 				}
 				height += stringBoundingBox.height;
 			}
-			return result;
+			return count;
+		}
+
+		std::size_t TextUtil::measureLines(GlyphContext &glyphs, const std::string &text, Font *font, MeasuredTextBuffer &result) const
+		{
+			std::size_t count = 0;
+			std::string::size_type index = 0;
+
+			while(getLine(text,index,line))
+			{
+				if(count == result.size())
+				{
+					result.push_back(MeasuredText());
+				}
+				result[count++].measure(glyphs,line,font);
+			}
+			return count;
+		}
+
+		std::size_t TextUtil::fitMeasuredLines(const std::string &text, const MeasuredTextBuffer &measured, const util::Dimension &componentBoundingBox, const util::Dimension &iconBoundingBox, const util::Insets &componentInsets, const util::Insets &componentMargins, StringInfoBuffer &result) const
+		{
+			std::size_t count = 0;
+			std::size_t n = 0;
+			std::string::size_type index = 0;
+			int maxWidth = componentBoundingBox.width - componentMargins.left - componentMargins.right - componentInsets.left - componentInsets.right - iconBoundingBox.width;
+			int maxHeight = componentBoundingBox.height - componentMargins.bottom - componentMargins.top;
+
+			int height = 0;
+			while(getLine(text,index,line))
+			{
+				const util::Dimension &stringBoundingBox = measured[n++].getSize();
+
+				if((height + stringBoundingBox.height) <= maxHeight)
+				{
+					if(stringBoundingBox.width <= maxWidth)
+					{
+						StringInfo &info = appendStringInfo(result,count);
+						info.first = line;
+						info.second = stringBoundingBox;
+					}
+					else
+					{
+						std::size_t first = count;
+						count = textWrappingAlgorithm->wrapMeasuredText(line,measured[n - 1],maxWidth,result,count);
+
+						// wrapped lines take up height as well, drop
+						// those which do not fit.
+						std::size_t fitting = std::max((maxHeight - height) / std::max(stringBoundingBox.height,1),1);
+						count = std::min(count,first + fitting);
+						height += static_cast<int>(count - first - 1) * stringBoundingBox.height;
+					}
+				}
+				height += stringBoundingBox.height;
+			}
+			return count;
 		}
 		
+		const TextLayout & TextUtil::layoutText(UiContext &context, TextLayout &layout, std::size_t revision, const std::string &text, const util::Dimension &componentBoundingBox, Icon *icon, Font *font, const util::Insets &componentInsets, const util::Insets &componentMargins, int horizontalAlignment, int verticalAlignment) const
+		{
+			util::Dimension iconBoundingBox(getIconBoundingBox(icon));
+
+			if(layout.valid &&
+				layout.revision == revision &&
+				layout.font == font &&
+				layout.algorithm == textWrappingAlgorithm &&
+				layout.componentBoundingBox == componentBoundingBox &&
+				layout.iconBoundingBox == iconBoundingBox &&
+				layout.insets == componentInsets &&
+				layout.margins == componentMargins &&
+				layout.horizontal == horizontalAlignment &&
+				layout.vertical == verticalAlignment)
+			{
+				context.getTextLayoutCache().hit(&layout);
+				return layout;
+			}
+
+			// measuring is the expensive part, and only needs to be done
+			// again when the text or font changed. A resize only fits
+			// the measured lines into the new bounds.
+			if(!layout.measured || layout.measuredRevision != revision || layout.measuredFont != font)
+			{
+				measureLines(context.getGlyphContext(),text,font,layout.measuredLines);
+				layout.measured = true;
+				layout.measuredRevision = revision;
+				layout.measuredFont = font;
+			}
+
+			layout.lineCount = fitMeasuredLines(text,layout.measuredLines,componentBoundingBox,iconBoundingBox,componentInsets,componentMargins,layout.lines);
+
+			layout.stringBoundingBox = getStringBoundingBox(layout.lines,layout.lineCount);
+			layout.verticalIconAlignment = getVerticalAlignment(iconBoundingBox,componentBoundingBox,verticalAlignment,componentInsets,componentMargins);
+			layout.verticalTextAlignment = getVerticalAlignment(layout.stringBoundingBox,componentBoundingBox,verticalAlignment,componentInsets,componentMargins);
+			layout.horizontalAlignment = getHorizontalAlignment(layout.stringBoundingBox,iconBoundingBox,componentBoundingBox,horizontalAlignment,componentInsets,componentMargins);
+
+			layout.valid = true;
+			layout.revision = revision;
+			layout.font = font;
+			layout.algorithm = textWrappingAlgorithm;
+			layout.componentBoundingBox = componentBoundingBox;
+			layout.iconBoundingBox = iconBoundingBox;
+			layout.insets = componentInsets;
+			layout.margins = componentMargins;
+			layout.horizontal = horizontalAlignment;
+			layout.vertical = verticalAlignment;
+
+			context.getTextLayoutCache().store(&layout);
+			return layout;
+		}
+
 		util::Dimension TextUtil::getStringBoundingBox(const StringInfoBuffer &str) const
 		{
-			StringInfoBuffer::const_iterator end(str.end());
+			return getStringBoundingBox(str,str.size());
+		}
+
+		util::Dimension TextUtil::getStringBoundingBox(const StringInfoBuffer &str, std::size_t count) const
+		{
+			StringInfoBuffer::const_iterator end(str.begin() + count);
 			int width(0);
 			int height(0);
 
@@ -493,17 +830,16 @@ namespace ui
 			return x;
 		}
 
-		util::Dimension TextUtil::getPreferredBoundingBox(const std::string &text, Icon *icon, Font *font) const
+		util::Dimension TextUtil::getPreferredBoundingBox(GlyphContext &glyphs, const std::string &text, Icon *icon, Font *font) const
 		{
-			StringBuffer tempString(splitText(text));
-			StringBuffer::const_iterator end(tempString.end());
+			std::string::size_type index = 0;
 
 			int width(0);
 			int height(0);
 
-			for(StringBuffer::const_iterator iter = tempString.begin(); iter != end; ++iter)
+			while(getLine(text,index,line))
 			{
-				util::Dimension bbox(font->getStringBoundingBox(*iter));
+				util::Dimension bbox(glyphs.getStringBoundingBox(font,line));
 				width = std::max(width,bbox.width);
 				height += bbox.height;
 			}
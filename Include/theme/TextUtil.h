@@ -30,35 +30,130 @@
 
 #include "../Pointers.h"
 #include "../component/AbstractButton.h"
+#include "./TextLayout.h"
+#include "./MeasuredText.h"
 
 namespace ui
 {
 	namespace theme
 	{
-		typedef std::vector<std::string> StringBuffer;
-		typedef std::pair<std::string,util::Dimension> StringInfo;
-		typedef std::vector<StringInfo> StringInfoBuffer;
-
 		class TextWrappingAlgorithm
 		{
 		public:
-			virtual StringInfoBuffer wrapText(const std::string &text, Font *font, int width) const = 0;
+			/**
+			 * Fits a single line of text into the given width. The resulting
+			 * lines are stored in the buffer starting at index <code>count</code>,
+			 * reusing the StringInfo objects already present in the buffer.
+			 * @param
+			 *	glyphs the GlyphContext the text is measured with.
+			 * @return
+			 *	the number of lines in the buffer after wrapping.
+			 */
+			virtual std::size_t wrapText(GlyphContext &glyphs, const std::string &text, Font *font, int width, StringInfoBuffer &buffer, std::size_t count) const;
+
+			/**
+			 * Fits a single line of text which has been measured
+			 * already into the given width. By default, the lines are
+			 * copied out of the spans returned by wrapSpans.
+			 * @return
+			 *	the number of lines in the buffer after wrapping.
+			 */
+			virtual std::size_t wrapMeasuredText(const std::string &text, const MeasuredText &measured, int width, StringInfoBuffer &buffer, std::size_t count) const;
+
+			/**
+			 * Fits a single line of text into the given width without
+			 * copying it. The resulting lines are stored in the buffer
+			 * as ranges of the text, starting at index <code>count</code>.
+			 * There is always at least one line, even if the text is empty.
+			 * @param
+			 *	measured the prefix widths and break opportunities
+			 *	of the text.
+			 * @return
+			 *	the number of lines in the buffer after wrapping.
+			 */
+			virtual std::size_t wrapSpans(const std::string &text, const MeasuredText &measured, int width, LineSpanBuffer &buffer, std::size_t count) const = 0;
 			virtual ~TextWrappingAlgorithm() {};
+		private:
+			mutable MeasuredText measuredText;
+			mutable LineSpanBuffer spans;
 		};
 
+		/**
+		 * Cuts off the text which does not fit, and ends it with
+		 * an ellipsis. Text is never wrapped onto a second line.
+		 */
 		class CuttoffAlgorithm : public TextWrappingAlgorithm
 		{
 		public:
-			StringInfoBuffer wrapText(const std::string &text, Font *font, int width) const;
+			std::size_t wrapMeasuredText(const std::string &text, const MeasuredText &measured, int width, StringInfoBuffer &buffer, std::size_t count) const;
+			std::size_t wrapSpans(const std::string &text, const MeasuredText &measured, int width, LineSpanBuffer &buffer, std::size_t count) const;
 			virtual ~CuttoffAlgorithm() {};
 		};
 
+		/**
+		 * Wraps text at the last code point which fits on
+		 * a line, regardless of words.
+		 */
+		class CharacterWrapAlgorithm : public TextWrappingAlgorithm
+		{
+		public:
+			std::size_t wrapSpans(const std::string &text, const MeasuredText &measured, int width, LineSpanBuffer &buffer, std::size_t count) const;
+			virtual ~CharacterWrapAlgorithm() {};
+		};
+
+		/**
+		 * Wraps text between words. Words which are wider than a
+		 * line are broken at the last code point which fits.
+		 * Spaces at the end of a line are not part of it.
+		 */
+		class WordWrapAlgorithm : public TextWrappingAlgorithm
+		{
+		public:
+			enum MODES
+			{
+				/**
+				 * Puts as many words on each line as fit, in
+				 * linear time.
+				 */
+				GREEDY = 0,
+				/**
+				 * Minimizes the sum of the squared space left at the end
+				 * of every line but the last, which gives an even right
+				 * edge. This takes time proportional to the number of
+				 * words times the number of words on a line. Text with a
+				 * word which is wider than a line is wrapped greedily.
+				 */
+				MINIMUM_RAGGEDNESS = 1
+			};
+
+			WordWrapAlgorithm(int mode = GREEDY);
+			std::size_t wrapSpans(const std::string &text, const MeasuredText &measured, int width, LineSpanBuffer &buffer, std::size_t count) const;
+			int getMode() const;
+			virtual ~WordWrapAlgorithm() {};
+		private:
+			std::size_t wrapGreedy(const std::string &text, const MeasuredText &measured, int width, LineSpanBuffer &buffer, std::size_t count) const;
+			std::size_t wrapMinimumRaggedness(const std::string &text, const MeasuredText &measured, int width, LineSpanBuffer &buffer, std::size_t count) const;
+
+			/**
+			 * Returns the width of the text between begin and end,
+			 * ignoring spaces at the end.
+			 */
+			static int getLineWidth(const std::string &text, const std::vector<int> &widths, std::size_t begin, std::size_t end);
+
+			static LineSpan& appendLine(const std::string &text, const std::vector<int> &widths, std::size_t begin, std::size_t end, LineSpanBuffer &buffer, std::size_t &count);
+
+			int mode;
+			mutable std::vector<double> costs;
+			mutable std::vector<std::size_t> previous;
+			mutable std::vector<std::size_t> lines;
+		};
+
 		class TextUtil
 		{
 		public:
 				
-				StringInfoBuffer getButtonString(const util::Dimension &boundingBox, const util::Insets &margin, Font *font, const std::string &text, bool wordWrap) const;
-				StringInfoBuffer getButtonString(Font *font, const std::string &text) const;
+				StringInfoBuffer getButtonString(GlyphContext &glyphs, const util::Dimension &boundingBox, const util::Insets &margin, Font *font, const std::string &text, bool wordWrap) const;
+				StringInfoBuffer getButtonString(GlyphContext &glyphs, Font *font, const std::string &text) const;
 				std::string getMaxString(const std::string &str, Font *font, int maxWidth) const;
 				util::Point getTextAlignment(const util::Dimension &boundingBox, const util::Insets &margin, const util::Insets &insets, int horizontalAlignment, int verticalAlignment, const StringInfoBuffer &buffer) const;
 				util::Point getIconAlignment(const util::Dimension &boundingBox, const util::Insets &margin, const util::Insets &insets, int horizontalAlignment, int verticalAlignment, Icon *icon) const;
@@ -70,15 +165,94 @@ namespace ui
 				util::Dimension getContentBoundingBox(const util::Dimension &bufferBoundingBox, Icon *icon) const;
 		public:
 			TextUtil(TextWrappingAlgorithm *algorithm);
-			StringInfoBuffer fitStringInBoundingBox(const std::string &text, const util::Dimension &componentBoundingBox, const util::Dimension &iconBoundingBox, Font *font, const util::Insets &componentInsets, const util::Insets &componentMargins) const;
+
+			/**
+			 * Fits the text in the bounding box of a Component. The result
+			 * buffer is reused, so passing the same buffer every frame does not
+			 * allocate memory once it has grown large enough. It is never
+			 * shrunk, which would free the strings of the lines past the end.
+			 * @return
+			 *	the number of lines at the start of result that were fitted.
+			 */
+			std::size_t fitStringInBoundingBox(GlyphContext &glyphs, const std::string &text, const util::Dimension &componentBoundingBox, const util::Dimension &iconBoundingBox, Font *font, const util::Insets &componentInsets, const util::Insets &componentMargins, StringInfoBuffer &result) const;
+
+			/**
+			 * Same as fitStringInBoundingBox, for text which has been
+			 * measured by measureLines already.
+			 */
+			std::size_t fitMeasuredLines(const std::string &text, const MeasuredTextBuffer &measured, const util::Dimension &componentBoundingBox, const util::Dimension &iconBoundingBox, const util::Insets &componentInsets, const util::Insets &componentMargins, StringInfoBuffer &result) const;
+
+			/**
+			 * Measures every line of text, reusing the MeasuredText
+			 * objects already present in the buffer.
+			 * @return
+			 *	the number of lines measured.
+			 */
+			std::size_t measureLines(GlyphContext &glyphs, const std::string &text, Font *font, MeasuredTextBuffer &result) const;
+
+			/**
+			 * Fits the text in the bounding box of a Component and aligns it,
+			 * storing the result in layout. The text is only laid out again if
+			 * any of the arguments differ from the last call with this layout.
+			 * @param
+			 *	context the UiContext of the Component, whose GlyphContext
+			 *	measures the text and whose TextLayoutCache keeps the layout.
+			 * @param
+			 *	layout the TextLayout of the Component.
+			 * @param
+			 *	revision the revision of the text, which the Component
+			 *	increments whenever its text changes.
+			 */
+			const TextLayout & layoutText(UiContext &context, TextLayout &layout, std::size_t revision, const std::string &text, const util::Dimension &componentBoundingBox, Icon *icon, Font *font, const util::Insets &componentInsets, const util::Insets &componentMargins, int horizontalAlignment, int verticalAlignment) const;
 			util::Dimension getStringBoundingBox(const StringInfoBuffer &str) const;
+			util::Dimension getStringBoundingBox(const StringInfoBuffer &str, std::size_t count) const;
 			util::Dimension getIconBoundingBox(Icon *icon) const;
-			util::Dimension getPreferredBoundingBox(const std::string &text, Icon *icon, Font *font) const;
+			util::Dimension getPreferredBoundingBox(GlyphContext &glyphs, const std::string &text, Icon *icon, Font *font) const;
 			int getVerticalAlignment(const util::Dimension &contentBoundingBox, const util::Dimension &componentBoundingBox, int alignment, const util::Insets &componentInsets, const util::Insets &componentMargins) const;
 			int getHorizontalAlignment(const util::Dimension &textBoundingBox, const util::Dimension &iconBoundingBox, const util::Dimension &componentBoundingBox, int alignment, const util::Insets &componentInsets, const util::Insets &componentMargins) const;
+
+			/**
+			 * Returns the StringInfo at <code>count</code> in the buffer and
+			 * increments count. The buffer only grows when it is too small.
+			 */
+			static StringInfo& appendStringInfo(StringInfoBuffer &buffer, std::size_t &count);
+
+			/**
+			 * Returns the LineSpan at <code>count</code> in the buffer and
+			 * increments count. The buffer only grows when it is too small.
+			 */
+			static LineSpan& appendLineSpan(LineSpanBuffer &buffer, std::size_t &count);
+
+			/**
+			 * Stores the width of every prefix of text in widths, so
+			 * widths[n] is the width of the first n characters. The
+			 * text is measured with a single call to Font::getGlyphAdvances.
+			 */
+			static void getPrefixWidths(GlyphContext &glyphs, Font *font, const std::string &text, std::vector<int> &widths);
+
+			/**
+			 * Returns the number of leading characters which fit in
+			 * width, using a binary search on the prefix widths.
+			 */
+			static std::size_t getFittingLength(const std::vector<int> &widths, int width);
+
+			/**
+			 * Returns the caret position closest to x, using a binary
+			 * search on the prefix widths.
+			 */
+			static std::size_t getCaretIndex(const std::vector<int> &widths, int x);
 		private:
 			TextWrappingAlgorithm *textWrappingAlgorithm;
-			StringBuffer splitText(const std::string &text) const;
+			WordWrapAlgorithm wordWrapAlgorithm;
+			mutable std::string line;
+
+			/**
+			 * Copies the line starting at index into line, and moves index
+			 * to the start of the next line.
+			 * @return
+			 *	false if there are no more lines.
+			 */
+			bool getLine(const std::string &text, std::string::size_type &index, std::string &line) const;
 		};
 
 		class TextPainter
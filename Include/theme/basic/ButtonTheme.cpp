@@ -46,7 +46,8 @@ namespace ui
 					black(0,0,0),
 					white(255,255,255),
 					border(white,util::Insets(1,1,1,1)),
-					textUtil(&algorithm)
+					textUtil(&algorithm),
+					font(GlyphContext::noFont)
 			{
 			}
 
@@ -59,7 +60,11 @@ namespace ui
 				button->setBorder(&border);
 				button->setMargin(util::Insets(10,10,10,10));
 				button->setFocusPainted(true);
-				button->setFont(GlyphContext::getInstance().createFont("Vera.ttf",10)); // default font
+				if(font == GlyphContext::noFont)
+				{
+					font = comp->getContext()->getGlyphContext().getFontHandle("Vera.ttf",10);
+				}
+				button->setFont(font); // default font
 
 				if(button->isSelected() && button->isContentAreaFilled())
 				{
@@ -86,15 +91,16 @@ namespace ui
 					BasicComponent::paint(g,button);
 				}
 				util::Dimension componentBoundingBox(button->getBounds().width,button->getBounds().height);
-				util::Dimension iconBoundingBox(textUtil.getIconBoundingBox(getActiveIcon(button)));
 
-				StringInfoBuffer stringInfo(textUtil.fitStringInBoundingBox(button->getText(),componentBoundingBox,iconBoundingBox,button->getFont(),button->getInsets(),button->getMargin()));
+				// the layout is only computed again when the text or
+				// the bounds of the button changed since the last frame.
+				const TextLayout &layout = textUtil.layoutText(*button->getContext(),button->getTextLayout(),button->getTextRevision(),button->getText(),componentBoundingBox,getActiveIcon(button),button->getFont(),button->getInsets(),button->getMargin(),button->getHorizontalAlignment(),button->getVerticalAlignment());
 
-				util::Dimension stringBoundingBox(textUtil.getStringBoundingBox(stringInfo));
+				const util::Dimension &stringBoundingBox = layout.getStringBoundingBox();
 
-				int verticalIconAlignment = textUtil.getVerticalAlignment(iconBoundingBox,componentBoundingBox,button->getVerticalAlignment(),button->getInsets(),button->getMargin());
-				int verticalTextAlignment = textUtil.getVerticalAlignment(stringBoundingBox,componentBoundingBox,button->getVerticalAlignment(),button->getInsets(),button->getMargin());
-				int horizontalAlignment = textUtil.getHorizontalAlignment(stringBoundingBox,iconBoundingBox,componentBoundingBox,button->getHorizontalAlignment(),button->getInsets(),button->getMargin());
+				int verticalIconAlignment = layout.getVerticalIconAlignment();
+				int verticalTextAlignment = layout.getVerticalTextAlignment();
+				int horizontalAlignment = layout.getHorizontalAlignment();
 
 				if(getActiveIcon(button) != 0)
 				{
@@ -103,7 +109,7 @@ namespace ui
 				}
 
 				g.setPaint(button->getForeground());
-				g.setFont(button->getFont());
+				g.setFont(button->getFontHandle());
 
 				if(button->hasFocus() && button->isFocusPainted())
 				{
@@ -112,17 +118,17 @@ namespace ui
 
 				if(getActiveIcon(button) != 0)
 				{
-					paintButton(horizontalAlignment,verticalTextAlignment,g,stringInfo,stringBoundingBox,Component::LEFT,getActiveIcon(button));
+					paintButton(horizontalAlignment,verticalTextAlignment,g,layout.getLines(),layout.getLineCount(),stringBoundingBox,Component::LEFT,getActiveIcon(button));
 				}
 				else
 				{
-					paintButton(horizontalAlignment,verticalTextAlignment,g,stringInfo,stringBoundingBox,Component::CENTER,getActiveIcon(button));
+					paintButton(horizontalAlignment,verticalTextAlignment,g,layout.getLines(),layout.getLineCount(),stringBoundingBox,Component::CENTER,getActiveIcon(button));
 				}
 			}
 
-			void ButtonTheme::paintButton(int x, int y, Graphics &g, const StringInfoBuffer &buffer, const util::Dimension &stringBoundingBox ,int alignment, Icon *icon) const
+			void ButtonTheme::paintButton(int x, int y, Graphics &g, const StringInfoBuffer &buffer, std::size_t count, const util::Dimension &stringBoundingBox ,int alignment, Icon *icon) const
 			{
-				StringInfoBuffer::const_iterator end(buffer.end());
+				StringInfoBuffer::const_iterator end(buffer.begin() + count);
 				int height = 0;
 
 				for(StringInfoBuffer::const_iterator iter = buffer.begin(); iter != end; ++iter)
@@ -197,7 +203,7 @@ namespace ui
 			{
 				const AbstractButton *button = static_cast<const AbstractButton*>(comp);
 
-				util::Dimension ret(textUtil.getPreferredBoundingBox(button->getText(),getActiveIcon(button),button->getFont()));
+				util::Dimension ret(textUtil.getPreferredBoundingBox(button->getContext()->getGlyphContext(),button->getText(),getActiveIcon(button),button->getFont()));
 
 				ret.width += button->getMargin().left + button->getMargin().right + button->getInsets().left + button->getInsets().right;
 				ret.height+= button->getMargin().top + button->getMargin().bottom + button->getInsets().top + button->getInsets().bottom; 
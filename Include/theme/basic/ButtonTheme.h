@@ -50,7 +50,7 @@ namespace ui
 				virtual const util::Dimension getPreferredSize(const Component *comp) const;
 				virtual void propertyChanged(const event::PropertyEvent &e);
 				virtual void paintFocus(int x, int y, Graphics &g, const util::Dimension &componentBoundingBox, const util::Dimension &boundingBox, int spacing) const;
-				virtual void paintButton(int x, int y, Graphics &g, const StringInfoBuffer &buffer, const util::Dimension &stringBoundingBox ,int alignment, Icon *icon) const;
+				virtual void paintButton(int x, int y, Graphics &g, const StringInfoBuffer &buffer, std::size_t count, const util::Dimension &stringBoundingBox ,int alignment, Icon *icon) const;
 
 			protected:
 				Icon * getActiveIcon(const AbstractButton *button) const;
@@ -59,7 +59,7 @@ namespace ui
 				border::LineBorder border;
 				CuttoffAlgorithm algorithm;
 				TextUtil textUtil;
-				
+				FontHandle font;
 			};
 		}
 	}
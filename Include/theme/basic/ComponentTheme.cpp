@@ -61,7 +61,7 @@ namespace ui
 
 			void BasicComponent::paintSelection(Graphics &g, const Component *comp) const
 			{
-				int index = SelectionManager::getInstance().getComponentId(comp);
+				int index = comp->getContext()->getSelectionManager().getComponentId(comp);
 
 				int width = comp->getBounds().width;
 				int height = comp->getBounds().height;
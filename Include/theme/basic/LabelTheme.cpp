@@ -39,7 +39,10 @@ namespace ui
 		{
 			LabelTheme::LabelTheme()
 				:
-					textUtil(&algorithm)
+					wordWrapAlgorithm(WordWrapAlgorithm::GREEDY),
+					textUtil(&algorithm),
+					wordWrapTextUtil(&wordWrapAlgorithm),
+					font(GlyphContext::noFont)
 			{
 			}
 
@@ -48,7 +51,11 @@ namespace ui
 				Label *label = static_cast<Label*>(comp);
 				
 				label->setMargin(util::Insets(10,10,10,10));
-				label->setFont(GlyphContext::getInstance().createFont("Vera.ttf",10));
+				if(font == GlyphContext::noFont)
+				{
+					font = comp->getContext()->getGlyphContext().getFontHandle("Vera.ttf",10);
+				}
+				label->setFont(font);
 			}
 
 			void LabelTheme::deinstallTheme(Component *comp)
@@ -62,15 +69,17 @@ namespace ui
 				const Label *label = static_cast<const Label*>(comp);
 
 				util::Dimension componentBoundingBox(label->getBounds().width,label->getBounds().height);
-				util::Dimension iconBoundingBox(textUtil.getIconBoundingBox(getActiveIcon(label)));
 
-				StringInfoBuffer stringInfo(textUtil.fitStringInBoundingBox(label->getText(),componentBoundingBox,iconBoundingBox,label->getFont(),label->getInsets(),label->getMargin()));
+				// the layout is only computed again when the text or
+				// the bounds of the label changed since the last frame.
+				const TextUtil &layoutUtil = label->isWordWrap() ? wordWrapTextUtil : textUtil;
+				const TextLayout &layout = layoutUtil.layoutText(*label->getContext(),label->getTextLayout(),label->getTextRevision(),label->getText(),componentBoundingBox,getActiveIcon(label),label->getFont(),label->getInsets(),label->getMargin(),label->getHorizontalAlignment(),label->getVerticalAlignment());
 
-				util::Dimension stringBoundingBox(textUtil.getStringBoundingBox(stringInfo));
+				const util::Dimension &stringBoundingBox = layout.getStringBoundingBox();
 
-				int verticalIconAlignment = textUtil.getVerticalAlignment(iconBoundingBox,componentBoundingBox,label->getVerticalAlignment(),label->getInsets(),label->getMargin());
-				int verticalTextAlignment = textUtil.getVerticalAlignment(stringBoundingBox,componentBoundingBox,label->getVerticalAlignment(),label->getInsets(),label->getMargin());
-				int horizontalAlignment = textUtil.getHorizontalAlignment(stringBoundingBox,iconBoundingBox,componentBoundingBox,label->getHorizontalAlignment(),label->getInsets(),label->getMargin());
+				int verticalIconAlignment = layout.getVerticalIconAlignment();
+				int verticalTextAlignment = layout.getVerticalTextAlignment();
+				int horizontalAlignment = layout.getHorizontalAlignment();
 
 				if(getActiveIcon(label) != 0)
 				{
@@ -79,21 +88,21 @@ namespace ui
 				}
 
 				g.setPaint(label->getForeground());
-				g.setFont(label->getFont());
+				g.setFont(label->getFontHandle());
 
 				if(getActiveIcon(label) != 0)
 				{
-					paintLabel(horizontalAlignment,verticalTextAlignment,g,stringInfo,stringBoundingBox,Component::LEFT,getActiveIcon(label));
+					paintLabel(horizontalAlignment,verticalTextAlignment,g,layout.getLines(),layout.getLineCount(),stringBoundingBox,Component::LEFT,getActiveIcon(label));
 				}
 				else
 				{
-					paintLabel(horizontalAlignment,verticalTextAlignment,g,stringInfo,stringBoundingBox,Component::CENTER,getActiveIcon(label));
+					paintLabel(horizontalAlignment,verticalTextAlignment,g,layout.getLines(),layout.getLineCount(),stringBoundingBox,Component::CENTER,getActiveIcon(label));
 				}
 			}
 
-			void LabelTheme::paintLabel(int x, int y, Graphics &g, const StringInfoBuffer &buffer, const util::Dimension &stringBoundingBox ,int alignment, Icon *icon) const
+			void LabelTheme::paintLabel(int x, int y, Graphics &g, const StringInfoBuffer &buffer, std::size_t count, const util::Dimension &stringBoundingBox ,int alignment, Icon *icon) const
 			{
-				StringInfoBuffer::const_iterator end(buffer.end());
+				StringInfoBuffer::const_iterator end(buffer.begin() + count);
 				int height = 0;
 
 				for(StringInfoBuffer::const_iterator iter = buffer.begin(); iter != end; ++iter)
@@ -116,7 +125,7 @@ namespace ui
 			{
 				const Label *label = static_cast<const Label*>(comp);
 
-				util::Dimension ret(textUtil.getPreferredBoundingBox(label->getText(),getActiveIcon(label),label->getFont()));
+				util::Dimension ret(textUtil.getPreferredBoundingBox(label->getContext()->getGlyphContext(),label->getText(),getActiveIcon(label),label->getFont()));
 
 				ret.width += label->getMargin().left + label->getMargin().right + label->getInsets().left + label->getInsets().right;
 				ret.height+= label->getMargin().top + label->getMargin().bottom + label->getInsets().top + label->getInsets().bottom; 
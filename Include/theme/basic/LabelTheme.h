@@ -48,10 +48,13 @@ namespace ui
 				void paint(Graphics& g,const Component *comp) const;
 				const util::Dimension getPreferredSize(const Component *comp) const;
 			private:
-				void paintLabel(int x, int y, Graphics &g, const StringInfoBuffer &buffer, const util::Dimension &stringBoundingBox ,int alignment, Icon *icon) const;
+				void paintLabel(int x, int y, Graphics &g, const StringInfoBuffer &buffer, std::size_t count, const util::Dimension &stringBoundingBox ,int alignment, Icon *icon) const;
 				Icon * getActiveIcon(const Label *label) const;
 				CuttoffAlgorithm algorithm;
+				WordWrapAlgorithm wordWrapAlgorithm;
 				TextUtil textUtil;
+				TextUtil wordWrapTextUtil;
+				FontHandle font;
 			};
 		}
 	}
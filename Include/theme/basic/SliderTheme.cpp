@@ -54,7 +54,7 @@ namespace ui
 			void SliderTheme::installTheme(Component *comp)
 			{
 				comp->setBackground(&black);
-				comp->addMouseListener(this);
+				comp->addMouseListener(this,event::MouseEvent::MOUSE_PRESSED_MASK|event::MouseEvent::MOUSE_RELEASED_MASK|event::MouseEvent::MOUSE_MOTION_MASK);
 			}
 
 			void SliderTheme::deinstallTheme(Component *comp)
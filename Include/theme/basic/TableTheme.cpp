@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./TableTheme.h"
+#include "../../component/TableModel.h"
+#include "../../Graphics.h"
+#include "../../Font.h"
+#include "../../GlyphContext.h"
+
+namespace ui
+{
+	namespace theme
+	{
+		namespace basic
+		{
+			TableTheme::TableTheme()
+				:	headerBackground(64,64,64),
+					gridColor(96,96,96),
+					font(GlyphContext::noFont)
+			{
+			}
+
+			void TableTheme::installTheme(Component *comp)
+			{
+				BasicComponent::installTheme(comp);
+
+				Table *table = static_cast<Table*>(comp);
+
+				if(font == GlyphContext::noFont)
+				{
+					font = comp->getContext()->getGlyphContext().getFontHandle("Vera.ttf",10);
+				}
+				table->setFont(font);
+
+				int height = table->getContext()->getGlyphContext().getStringBoundingBox(table->getFontHandle(),"Xg").height;
+				table->setRowHeight(height + 4);
+				table->setHeaderHeight(height + 8);
+			}
+
+			void TableTheme::paint(Graphics &g, const Component *comp) const
+			{
+				const Table *table = static_cast<const Table*>(comp);
+				const util::Rectangle visible(table->getVisibleRect());
+
+				// only the visible part is painted, the Table itself
+				// can be far larger than the screen.
+				g.setPaint(table->getBackground());
+				g.fillRect(visible.x,visible.y,visible.width,visible.height);
+
+				const TableModel *model = table->getModel();
+
+				if(model == 0 || table->getFont() == 0 || visible.width <= 0 || visible.height <= 0)
+				{
+					return;
+				}
+
+				int firstColumn = table->columnAtPoint(visible.x);
+				int lastColumn = table->columnAtPoint(visible.x + visible.width - 1);
+
+				if(firstColumn == -1)
+				{
+					return;
+				}
+				else if(lastColumn == -1)
+				{
+					lastColumn = table->getColumnCount() - 1;
+				}
+
+				int rowHeight = table->getRowHeight();
+				int headerHeight = table->getHeaderHeight();
+				int firstRow = visible.y / rowHeight;
+				int lastRow = std::min(model->getRowCount() - 1,(visible.y + visible.height - headerHeight - 1) / rowHeight);
+				int selectedRow = table->getSelectedRow();
+				int textOffset = (rowHeight - table->getContext()->getGlyphContext().getStringBoundingBox(table->getFontHandle(),"Xg").height) / 2;
+
+				util::Point screen(table->getLocationOnScreen());
+
+				g.setFont(table->getFontHandle());
+
+				if(selectedRow >= firstRow && selectedRow <= lastRow)
+				{
+					g.setPaint(table->getForeground());
+					g.fillRect(visible.x,headerHeight + selectedRow * rowHeight,visible.width,rowHeight);
+				}
+
+				// cells are painted a column at a time, so text which
+				// is wider than its column can be cut off with a single
+				// scissor per column.
+				for(int column = firstColumn; column <= lastColumn; ++column)
+				{
+					int x = table->getColumnX(column);
+					int width = table->getColumnWidth(column);
+
+					clip(g,screen,visible,x,visible.y + headerHeight,width - table->getCellMargin(),visible.height - headerHeight);
+
+					for(int row = firstRow; row <= lastRow; ++row)
+					{
+						model->getValueAt(row,column,value);
+
+						g.setPaint(row == selectedRow ? table->getBackground() : table->getForeground());
+						g.drawString(x + table->getCellMargin(),headerHeight + row * rowHeight + textOffset,value);
+					}
+				}
+
+				if(headerHeight > 0)
+				{
+					paintHeader(g,table,visible,firstColumn,lastColumn);
+				}
+
+				// scissors do not nest, restore the one of the viewport.
+				if(table->isInViewport())
+				{
+					g.enableScissor(screen.x + visible.x,screen.y + visible.y,visible.width,visible.height);
+				}
+				else
+				{
+					g.disableScissor();
+				}
+			}
+
+			void TableTheme::paintHeader(Graphics &g, const Table *table, const util::Rectangle &visible, int firstColumn, int lastColumn) const
+			{
+				const TableModel *model = table->getModel();
+				util::Point screen(table->getLocationOnScreen());
+
+				int headerHeight = table->getHeaderHeight();
+				int textOffset = (headerHeight - table->getContext()->getGlyphContext().getStringBoundingBox(table->getFontHandle(),"Xg").height) / 2;
+
+				// the header is painted over the rows at the top of the
+				// viewport, so it stays in place when the rows scroll.
+				clip(g,screen,visible,visible.x,visible.y,visible.width,headerHeight);
+
+				g.setPaint(&headerBackground);
+				g.fillRect(visible.x,visible.y,visible.width,headerHeight);
+
+				g.setPaint(&gridColor);
+				for(int column = firstColumn; column <= lastColumn; ++column)
+				{
+					int x = table->getColumnX(column) + table->getColumnWidth(column) - 1;
+					g.drawLine(x,visible.y,x,visible.y + headerHeight);
+				}
+
+				g.setPaint(table->getForeground());
+				for(int column = firstColumn; column <= lastColumn; ++column)
+				{
+					int x = table->getColumnX(column);
+
+					clip(g,screen,visible,x,visible.y,table->getColumnWidth(column) - table->getCellMargin(),headerHeight);
+					g.drawString(x + table->getCellMargin(),visible.y + textOffset,model->getColumnName(column));
+				}
+			}
+
+			void TableTheme::clip(Graphics &g, const util::Point &screen, const util::Rectangle &visible, int x, int y, int width, int height) const
+			{
+				// intersect with the visible rectangle, as the scissor
+				// replaces the one set by the ScrollPane.
+				int left = std::max(x,visible.x);
+				int top = std::max(y,visible.y);
+				int right = std::min(x + width,visible.x + visible.width);
+				int bottom = std::min(y + height,visible.y + visible.height);
+
+				g.enableScissor(screen.x + left,screen.y + top,std::max(right - left,0),std::max(bottom - top,0));
+			}
+
+			const util::Dimension TableTheme::getPreferredSize(const Component *comp) const
+			{
+				return static_cast<const Table*>(comp)->getPreferredViewportSize();
+			}
+		}
+	}
+}
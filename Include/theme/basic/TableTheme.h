@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BASICTABLETHEME_H
+#define BASICTABLETHEME_H
+
+#include "./ComponentTheme.h"
+#include "../../component/Table.h"
+
+namespace ui
+{
+	namespace theme
+	{
+		namespace basic
+		{
+			/**
+			 * Paints the visible cells of a Table. The theme keeps
+			 * no state per Table or per cell, all Tables share it.
+			 */
+			class TableTheme : public BasicComponent
+			{
+			public:
+				TableTheme();
+				void installTheme(Component *comp);
+				void paint(Graphics &g, const Component *comp) const;
+				const util::Dimension getPreferredSize(const Component *comp) const;
+			private:
+				void paintHeader(Graphics &g, const Table *table, const util::Rectangle &visible, int firstColumn, int lastColumn) const;
+				void clip(Graphics &g, const util::Point &screen, const util::Rectangle &visible, int x, int y, int width, int height) const;
+
+				util::Color headerBackground;
+				util::Color gridColor;
+				mutable std::string value;
+				FontHandle font;
+			};
+		}
+	}
+}
+#endif
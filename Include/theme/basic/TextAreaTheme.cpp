@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./TextAreaTheme.h"
+#include "../../Graphics.h"
+#include "../../Font.h"
+#include "../../GlyphContext.h"
+
+namespace ui
+{
+	namespace theme
+	{
+		namespace basic
+		{
+			TextAreaTheme::TextAreaTheme()
+				:	font(GlyphContext::noFont)
+			{
+			}
+
+			void TextAreaTheme::installTheme(Component *comp)
+			{
+				BasicComponent::installTheme(comp);
+
+				TextArea *textArea = static_cast<TextArea*>(comp);
+
+				if(font == GlyphContext::noFont)
+				{
+					font = comp->getContext()->getGlyphContext().getFontHandle("Vera.ttf",10);
+				}
+				textArea->setFont(font);
+
+				int height = textArea->getContext()->getGlyphContext().getStringBoundingBox(textArea->getFontHandle(),"Xg").height;
+				textArea->setLineHeight(height + 2);
+			}
+
+			void TextAreaTheme::paint(Graphics &g, const Component *comp) const
+			{
+				const TextArea *textArea = static_cast<const TextArea*>(comp);
+				const util::Rectangle visible(textArea->getVisibleRect());
+
+				// only the visible part is painted, the TextArea
+				// itself can be far larger than the screen.
+				g.setPaint(textArea->getBackground());
+				g.fillRect(visible.x,visible.y,visible.width,visible.height);
+
+				if(textArea->getFont() == 0 || visible.width <= 0 || visible.height <= 0)
+				{
+					return;
+				}
+
+				const util::Insets &insets = textArea->getInsets();
+				int lineHeight = textArea->getLineHeight();
+				int bottom = visible.y + visible.height;
+
+				std::size_t paragraph = textArea->getParagraphAtLine(std::max(visible.y - insets.top,0) / lineHeight);
+				int y = insets.top + static_cast<int>(textArea->getParagraphLine(paragraph)) * lineHeight;
+
+				g.setFont(textArea->getFontHandle());
+				g.setPaint(textArea->getForeground());
+
+				// walk the lines of the paragraphs from the first visible
+				// one, wrapping paragraphs which have not been shown yet.
+				for(; paragraph < textArea->getParagraphCount() && y < bottom; ++paragraph)
+				{
+					const std::string &text = textArea->getParagraph(paragraph);
+					const LineSpanBuffer &lines = textArea->getParagraphLines(paragraph);
+
+					LineSpanBuffer::const_iterator iter;
+					for(iter = lines.begin(); iter != lines.end() && y < bottom; ++iter)
+					{
+						if(y + lineHeight > visible.y && iter->length > 0)
+						{
+							line.assign(text,iter->offset,iter->length);
+							g.drawString(insets.left,y + 1,line);
+						}
+						y += lineHeight;
+					}
+				}
+			}
+
+			const util::Dimension TextAreaTheme::getPreferredSize(const Component *comp) const
+			{
+				return static_cast<const TextArea*>(comp)->getPreferredViewportSize();
+			}
+		}
+	}
+}
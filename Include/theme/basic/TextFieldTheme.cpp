@@ -33,6 +33,10 @@
 #include "../../Graphics.h"
 #include "../../event/KeyEvent.h"
 #include "../../event/FocusEvent.h"
+#include "../../event/MouseEvent.h"
+#include "../../event/PropertyEvent.h"
+#include "../../util/Utf8.h"
+#include "../TextUtil.h"
 
 namespace ui
 {
@@ -44,15 +48,21 @@ namespace ui
 			{
 				comp->setBorder(&border);
 				comp->addFocusListener(this);
-				comp->addMouseListener(this);
+				comp->addMouseListener(this,event::MouseEvent::MOUSE_PRESSED_MASK);
+				comp->addPropertyListener(this);
 				comp->addInterpolator(&interpolator);
-				comp->setFont(GlyphContext::getInstance().createFont("Vera.ttf",10)); // default font
+				if(font == GlyphContext::noFont)
+				{
+					font = comp->getContext()->getGlyphContext().getFontHandle("Vera.ttf",10);
+				}
+				comp->setFont(font); // default font
 			}
 
 			void TextFieldTheme::deinstallTheme(Component *comp)
 			{
 				comp->removeFocusListener(this);
 				comp->removeMouseListener(this);
+				comp->removePropertyListener(this);
 				comp->removeInterpolator(&interpolator);
 			}
 
@@ -64,23 +74,50 @@ namespace ui
 
 				g.enableScissor(textField->getLocationOnScreen().x,textField->getLocationOnScreen().y,textField->getBounds().width,textField->getBounds().height);
 
-				g.setPaint(textField->getForeground());
-				std::string text = textField->getText();
 				Font *f = textField->getFont();
-				g.setFont(f);
+				g.setFont(textField->getFontHandle());
+
+				// the caret and scroll positions are kept up to date by
+				// the TextField while it is edited, nothing is measured
+				// here except for echoed text.
+				const std::string *text = &textField->getText();
+				int viewWidth = getViewWidth(textField);
+				int caretX, anchorX, scrollOffset;
 
 				if(textField->hasEchoCharacter())
 				{
-					//std::size_t length = text.length();
-					text = std::string(text.length(),static_cast<char>(textField->getEchoCharacter()));
+					int echoWidth = textField->getContext()->getGlyphContext().getStringBoundingBox(f,std::string(1,static_cast<char>(textField->getEchoCharacter()))).width;
+
+					caretX = echoWidth * static_cast<int>(util::Utf8::length(text->substr(0,textField->getCaretPosition())));
+					anchorX = caretX + echoWidth * static_cast<int>(util::Utf8::length(text->substr(textField->getSelectionStart(),textField->getSelectionEnd() - textField->getSelectionStart()))) * (textField->getCaretPosition() == textField->getSelectionStart() ? 1 : -1);
+					scrollOffset = std::max(0,caretX - viewWidth);
+
+					echoText.assign(util::Utf8::length(*text),static_cast<char>(textField->getEchoCharacter()));
+					text = &echoText;
+				}
+				else
+				{
+					caretX = textField->getCaretX();
+					anchorX = textField->getAnchorX();
+					scrollOffset = textField->getScrollOffset(viewWidth);
 				}
-				util::Dimension bbox(f->getStringBoundingBox(text));
-				int y = textField->getBounds().height / 2 - bbox.height/2;
-				g.drawString(textField->getInsets().left,y,text);
+
+				int x = textField->getInsets().left - scrollOffset;
+				int height = textField->getContext()->getGlyphContext().getStringBoundingBox(f,"Xg").height;
+				int y = textField->getBounds().height / 2 - height/2;
+				int border = 4;
+
+				if(textField->hasSelection())
+				{
+					g.setPaint(&selectionColor);
+					g.fillRect(x + std::min(caretX,anchorX),border,std::abs(caretX - anchorX),textField->getBounds().height - border - border);
+				}
+
+				g.setPaint(textField->getForeground());
+				g.drawString(x,y,*text);
 				if(displayCursor && textField->hasFocus())
 				{
-					int border = 4;
-					g.fillRect(2 + bbox.width,border,2,textField->getBounds().height - border - border);
+					g.fillRect(x + caretX,border,2,textField->getBounds().height - border - border);
 				}
 				g.disableScissor();
 			}
@@ -89,23 +126,52 @@ namespace ui
 			{
 				const TextField *textField = static_cast<const TextField*>(comp);
 
-				std::string text = textField->getText();
-				Font *f = textField->getFont();
+				// the width of the text is kept by the TextField, it is
+				// not measured again for every layout.
+				int width = textField->getTextWidth() + textField->getInsets().left + textField->getInsets().right + 2;
+				int height = textField->getContext()->getGlyphContext().getStringBoundingBox(textField->getFontHandle(),"Xg").height + textField->getInsets().top + textField->getInsets().bottom;
 
-				util::Dimension bbox(f->getStringBoundingBox(text));
-				int height= bbox.height + textField->getInsets().top + textField->getInsets().bottom; 	
+				return util::Dimension(std::max(140,width),height);
+			}
 
-				return util::Dimension(140,height);
+			int TextFieldTheme::getViewWidth(const TextField *textField) const
+			{
+				// leave room for the caret at the end of the text.
+				return textField->getBounds().width - textField->getInsets().left - textField->getInsets().right - 2;
 			}
 
 			void TextFieldTheme::propertyChanged(const event::PropertyEvent &e)
 			{
+				if(e.getClassID() == event::PropertyEvent::SPECIAL && (e.getID() == TextField::TEXTCHANGE || e.getID() == TextField::CARETCHANGE))
+				{
+					// keep the caret visible while the user types.
+					displayCursor = true;
+					interpolator.reset();
+				}
+			}
+
+			void TextFieldTheme::mousePressed(const event::MouseEvent &e)
+			{
+				TextField *textField(static_cast<TextField*>(e.getSource()));
+
+				if(textField->hasEchoCharacter() || textField->getFont() == 0)
+				{
+					textField->moveCaretEnd(false);
+					return;
+				}
+
+				int x = e.getX() - textField->getLocationOnScreen().x - textField->getInsets().left + textField->getScrollOffset(getViewWidth(textField));
+
+				TextUtil::getPrefixWidths(textField->getContext()->getGlyphContext(),textField->getFont(),textField->getText(),widths);
+				textField->setCaretPosition(TextUtil::getCaretIndex(widths,x),false);
 			}
 
 			TextFieldTheme::TextFieldTheme()
 				:	border(util::Color(255,255,255),1),
 					interpolator(1.0f,0,100.0f),
-					displayCursor(false)
+					selectionColor(96,96,160),
+					displayCursor(false),
+					font(GlyphContext::noFont)
 			{
 				interpolator.addInterpolatee(this);
 				interpolator.start();
@@ -127,8 +193,6 @@ namespace ui
 
 			void TextFieldTheme::focusGained(const event::FocusEvent &e)
 			{
-				TextField *textField(static_cast<TextField*>(e.getSource()));
-				cursorPosition = static_cast<int>(textField->getText().length());
 			}
 
 			void TextFieldTheme::focusLost(const event::FocusEvent &e)
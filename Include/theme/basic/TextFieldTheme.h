@@ -37,9 +37,13 @@
 #include "../../border/LineBorder.h"
 #include "../../util/GradientColor.h"
 #include "../../util/LinearTimeInterpolator.h"
+#include <string>
+#include <vector>
 
 namespace ui
 {
+	class TextField;
+
 	namespace theme
 	{
 		namespace basic
@@ -57,12 +61,21 @@ namespace ui
 				void propertyChanged(const event::PropertyEvent &e);
 				void focusLost(const event::FocusEvent &e);
 				void focusGained(const event::FocusEvent &e);
+				void mousePressed(const event::MouseEvent &e);
+
+				/**
+				 * Returns the width available for text.
+				 */
+				int getViewWidth(const TextField *textField) const;
 
 				void update(float value);
 				border::LineBorder border;
 				util::LinearTimeInterpolator interpolator;
+				util::Color selectionColor;
 				bool displayCursor;
-				int cursorPosition;
+				FontHandle font;
+				mutable std::string echoText;
+				mutable std::vector<int> widths;
 			};
 		}
 	}
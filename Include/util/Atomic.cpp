@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./Atomic.h"
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+namespace ui
+{
+	namespace util
+	{
+#ifdef WIN32
+		void * Atomic::exchange(void * volatile *target, void *value)
+		{
+			return InterlockedExchangePointer(target,value);
+		}
+
+		void * Atomic::compareExchange(void * volatile *target, void *value, void *comparand)
+		{
+			return InterlockedCompareExchangePointer(target,value,comparand);
+		}
+#else
+		void * Atomic::exchange(void * volatile *target, void *value)
+		{
+			// the gcc exchange builtin is only an acquire barrier,
+			// a compare and swap is a full barrier, which also reads
+			// the current value when expected is wrong
+			void *expected = 0;
+			for(;;)
+			{
+				void *found = __sync_val_compare_and_swap(target,expected,value);
+				if(found == expected)
+				{
+					return found;
+				}
+				expected = found;
+			}
+		}
+
+		void * Atomic::compareExchange(void * volatile *target, void *value, void *comparand)
+		{
+			return __sync_val_compare_and_swap(target,comparand,value);
+		}
+#endif
+	}
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ATOMIC_H
+#define ATOMIC_H
+
+#include "../Pointers.h"
+
+namespace ui
+{
+	namespace util
+	{
+		/**
+		 * Atomic operations on pointers, for the few places
+		 * where more than one thread touches the same data.
+		 * Both are full memory barriers, so everything a thread
+		 * wrote before it published a pointer is visible to the
+		 * thread that takes it.
+		 */
+		class Atomic
+		{
+		public:
+			/**
+			 * Stores value in target and returns what was
+			 * stored before, as one atomic operation.
+			 */
+			static void * exchange(void * volatile *target, void *value);
+
+			/**
+			 * Stores value in target only if target still
+			 * holds comparand. Returns what target held
+			 * before, so the store happened if the result
+			 * equals comparand.
+			 */
+			static void * compareExchange(void * volatile *target, void *value, void *comparand);
+		private:
+			Atomic();
+		};
+	}
+}
+
+#endif
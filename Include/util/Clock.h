@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include "../Pointers.h"
+
+namespace ui
+{
+	namespace util
+	{
+		/**
+		 * A monotonic clock with sub-millisecond resolution,
+		 * for measuring how long parts of a frame take.
+		 */
+		class Clock
+		{
+		public:
+			/**
+			 * Returns the time in seconds since some fixed
+			 * point. Only differences are meaningful.
+			 */
+			static double getSeconds();
+		private:
+			Clock();
+		};
+
+		/**
+		 * Adds the time between its construction and destruction
+		 * to a total. Constructed with a null total it does nothing,
+		 * so timing can stay in place when it is turned off.
+		 */
+		class ScopedTimer
+		{
+		public:
+			ScopedTimer(double *total);
+			~ScopedTimer();
+		private:
+			ScopedTimer(const ScopedTimer &rhs);
+			ScopedTimer& operator=(const ScopedTimer &rhs);
+
+			double *total;
+			double start;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./DecodedText.h"
+#include "./Utf8.h"
+
+namespace ui
+{
+	namespace util
+	{
+		DecodedText::DecodedText()
+			:	revision(0),
+				decoded(false),
+				offsets(1,0),
+				boundaries(1,CODEPOINT | CHARACTER)
+		{
+		}
+
+		bool DecodedText::update(const std::string &text, std::size_t newRevision)
+		{
+			if(decoded && revision == newRevision)
+			{
+				return false;
+			}
+			decode(text);
+			revision = newRevision;
+			return true;
+		}
+
+		void DecodedText::decode(const std::string &text)
+		{
+			codepoints.clear();
+			offsets.clear();
+			boundaries.assign(text.length() + 1,0);
+			decoded = true;
+
+			std::size_t index = 0;
+			while(index < text.length())
+			{
+				offsets.push_back(index);
+				codepoints.push_back(Utf8::decode(text,index));
+			}
+			offsets.push_back(text.length());
+
+			unsigned int previous = 0;
+			std::size_t regionalIndicators = 0;
+
+			for(std::size_t i = 0; i < codepoints.size(); ++i)
+			{
+				unsigned int codepoint = codepoints[i];
+				unsigned char &boundary = boundaries[offsets[i]];
+
+				boundary |= CODEPOINT;
+
+				bool character = true;
+				if(i > 0)
+				{
+					if(isExtending(codepoint) || previous == 0x200d)
+					{
+						// marks, joiners and what a joiner joins.
+						character = false;
+					}
+					else if(previous == '\r' && codepoint == '\n')
+					{
+						character = false;
+					}
+					else if(isRegionalIndicator(codepoint) && regionalIndicators % 2 == 1)
+					{
+						// flags are pairs of regional indicators.
+						character = false;
+					}
+					else if(previous >= 0x1100 && previous < 0x11a8 && codepoint >= 0x1160 && codepoint < 0x1200)
+					{
+						// conjoining hangul jamo.
+						character = false;
+					}
+				}
+				regionalIndicators = isRegionalIndicator(codepoint) ? regionalIndicators + 1 : 0;
+
+				if(character)
+				{
+					boundary |= CHARACTER;
+
+					if(i > 0)
+					{
+						if(previous == '\n' || (previous == '\r' && codepoint != '\n'))
+						{
+							boundary |= LINEBREAK | MANDATORY;
+						}
+						else if(codepoint == ' ' || isClosingPunctuation(codepoint))
+						{
+							// spaces and closing punctuation stay on the line.
+						}
+						else if(previous == ' ' || previous == '-' || previous == '\t' || previous == 0x200b)
+						{
+							boundary |= LINEBREAK;
+						}
+						else if((isIdeographic(previous) || isIdeographic(codepoint)) && !isOpeningPunctuation(previous))
+						{
+							boundary |= LINEBREAK;
+						}
+					}
+				}
+				// combining marks break like their base, everything
+				// else is what the next code point is compared with.
+				if(character || !isExtending(codepoint) || codepoint == 0x200d)
+				{
+					previous = codepoint;
+				}
+			}
+
+			boundaries[text.length()] |= CODEPOINT | CHARACTER;
+		}
+
+		std::size_t DecodedText::getLength() const
+		{
+			return codepoints.size();
+		}
+
+		unsigned int DecodedText::getCodepoint(std::size_t index) const
+		{
+			return codepoints[index];
+		}
+
+		std::size_t DecodedText::getOffset(std::size_t index) const
+		{
+			return offsets[index];
+		}
+
+		const std::vector<unsigned int> & DecodedText::getCodepoints() const
+		{
+			return codepoints;
+		}
+
+		bool DecodedText::isCharacterBoundary(std::size_t offset) const
+		{
+			return offset < boundaries.size() && (boundaries[offset] & CHARACTER) != 0;
+		}
+
+		bool DecodedText::isLineBreak(std::size_t offset) const
+		{
+			return offset < boundaries.size() && (boundaries[offset] & LINEBREAK) != 0;
+		}
+
+		bool DecodedText::isMandatoryLineBreak(std::size_t offset) const
+		{
+			return offset < boundaries.size() && (boundaries[offset] & MANDATORY) != 0;
+		}
+
+		std::size_t DecodedText::nextCharacter(std::size_t offset) const
+		{
+			std::size_t end = boundaries.size() - 1;
+			if(offset >= end)
+			{
+				return end;
+			}
+			do
+			{
+				++offset;
+			}
+			while(offset < end && (boundaries[offset] & CHARACTER) == 0);
+			return offset;
+		}
+
+		std::size_t DecodedText::previousCharacter(std::size_t offset) const
+		{
+			if(offset == 0)
+			{
+				return 0;
+			}
+			if(offset >= boundaries.size())
+			{
+				offset = boundaries.size() - 1;
+			}
+			do
+			{
+				--offset;
+			}
+			while(offset > 0 && (boundaries[offset] & CHARACTER) == 0);
+			return offset;
+		}
+
+		bool DecodedText::isExtending(unsigned int c)
+		{
+			return (c >= 0x0300 && c < 0x0370)		// combining diacritical marks
+				|| (c >= 0x0483 && c < 0x048a)
+				|| (c >= 0x0591 && c < 0x05be)		// hebrew points
+				|| (c >= 0x0610 && c < 0x061b)
+				|| (c >= 0x064b && c < 0x0660)		// arabic marks
+				|| c == 0x0670
+				|| (c >= 0x06d6 && c < 0x06dd)
+				|| (c >= 0x0900 && c < 0x0904)		// devanagari signs
+				|| (c >= 0x093a && c < 0x0950)
+				|| (c >= 0x0951 && c < 0x0958)
+				|| (c >= 0x0962 && c < 0x0964)
+				|| c == 0x0e31
+				|| (c >= 0x0e34 && c < 0x0e3b)		// thai vowels and tones
+				|| (c >= 0x0e47 && c < 0x0e4f)
+				|| (c >= 0x1ab0 && c < 0x1b00)
+				|| (c >= 0x1dc0 && c < 0x1e00)
+				|| c == 0x200c || c == 0x200d		// joiners
+				|| (c >= 0x20d0 && c < 0x2100)
+				|| (c >= 0x3099 && c < 0x309b)		// kana voicing marks
+				|| (c >= 0xfe00 && c < 0xfe10)		// variation selectors
+				|| (c >= 0xfe20 && c < 0xfe30)
+				|| (c >= 0x1f3fb && c < 0x1f400)	// emoji modifiers
+				|| (c >= 0xe0100 && c < 0xe01f0);
+		}
+
+		bool DecodedText::isRegionalIndicator(unsigned int c)
+		{
+			return c >= 0x1f1e6 && c < 0x1f200;
+		}
+
+		bool DecodedText::isIdeographic(unsigned int c)
+		{
+			return (c >= 0x1100 && c < 0x1200)		// hangul jamo
+				|| (c >= 0x2e80 && c < 0xa4d0)		// cjk, kana, bopomofo, yi
+				|| (c >= 0xac00 && c < 0xd7a4)		// hangul syllables
+				|| (c >= 0xf900 && c < 0xfb00)
+				|| (c >= 0xff00 && c < 0xff61)		// fullwidth forms
+				|| (c >= 0x20000 && c < 0x30000);
+		}
+
+		bool DecodedText::isClosingPunctuation(unsigned int c)
+		{
+			switch(c)
+			{
+			case ')': case ']': case '}': case '.': case ',': case '!': case '?': case ':': case ';':
+			case 0x3001: case 0x3002: case 0x3009: case 0x300b: case 0x300d: case 0x300f: case 0x3011:
+			case 0x30fc: case 0xff01: case 0xff09: case 0xff0c: case 0xff0e: case 0xff1a: case 0xff1b: case 0xff1f:
+				return true;
+			default:
+				// small kana do not start a line either.
+				return c == 0x3041 || c == 0x3043 || c == 0x3045 || c == 0x3047 || c == 0x3049 || c == 0x3063 || c == 0x30c3
+					|| c == 0x30a1 || c == 0x30a3 || c == 0x30a5 || c == 0x30a7 || c == 0x30a9 || c == 0x3083 || c == 0x3085 || c == 0x3087
+					|| c == 0x30e3 || c == 0x30e5 || c == 0x30e7;
+			}
+		}
+
+		bool DecodedText::isOpeningPunctuation(unsigned int c)
+		{
+			switch(c)
+			{
+			case '(': case '[': case '{':
+			case 0x3008: case 0x300a: case 0x300c: case 0x300e: case 0x3010: case 0xff08:
+				return true;
+			default:
+				return false;
+			}
+		}
+	}
+}
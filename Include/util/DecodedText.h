@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DECODEDTEXT_H
+#define DECODEDTEXT_H
+
+#include <vector>
+#include <string>
+
+namespace ui
+{
+	namespace util
+	{
+		/**
+		 * The code points of a UTF-8 string and the boundaries
+		 * between its characters, decoded once per revision.
+		 * <p>
+		 * Components which own text keep a DecodedText next to it
+		 * and pass the revision of their text to update, which
+		 * decodes only when the revision changed. Editing, measuring
+		 * and wrapping code can then ask where characters start
+		 * without decoding the text again every frame.
+		 * </p>
+		 * Boundaries are byte offsets in the text. Characters are
+		 * grapheme clusters: a code point together with the combining
+		 * marks, joiners, variation selectors and emoji modifiers that
+		 * follow it. Line breaks are allowed after spaces and hyphens,
+		 * around ideographs, kana and hangul, and required after a
+		 * newline. This is a simplified version of the unicode rules
+		 * which covers the scripts the Gui is used with.
+		 */
+		class DecodedText
+		{
+		public:
+			/**
+			 * Creates an empty DecodedText.
+			 */
+			DecodedText();
+
+			/**
+			 * Decodes text if revision differs from the revision
+			 * decoded last.
+			 * @return
+			 *	true if the text was decoded.
+			 */
+			bool update(const std::string &text, std::size_t revision);
+
+			/**
+			 * Decodes text, regardless of revision.
+			 */
+			void decode(const std::string &text);
+
+			/**
+			 * Returns the number of code points.
+			 */
+			std::size_t getLength() const;
+
+			/**
+			 * Returns the code point at index.
+			 */
+			unsigned int getCodepoint(std::size_t index) const;
+
+			/**
+			 * Returns the byte offset of the code point at index,
+			 * index may be getLength() for the end of the text.
+			 */
+			std::size_t getOffset(std::size_t index) const;
+
+			/**
+			 * Returns the code points.
+			 */
+			const std::vector<unsigned int> & getCodepoints() const;
+
+			/**
+			 * Returns true if a character starts at offset,
+			 * the end of the text is a boundary as well.
+			 */
+			bool isCharacterBoundary(std::size_t offset) const;
+
+			/**
+			 * Returns true if a line may be broken at offset.
+			 */
+			bool isLineBreak(std::size_t offset) const;
+
+			/**
+			 * Returns true if a line must be broken at offset.
+			 */
+			bool isMandatoryLineBreak(std::size_t offset) const;
+
+			/**
+			 * Returns the offset of the character after offset,
+			 * or the length of the text.
+			 */
+			std::size_t nextCharacter(std::size_t offset) const;
+
+			/**
+			 * Returns the offset of the character before offset,
+			 * or 0.
+			 */
+			std::size_t previousCharacter(std::size_t offset) const;
+
+			/**
+			 * Returns true if a code point extends the character
+			 * before it, like a combining mark or a joiner.
+			 */
+			static bool isExtending(unsigned int codepoint);
+		private:
+			enum
+			{
+				CODEPOINT = 0x1,
+				CHARACTER = 0x2,
+				LINEBREAK = 0x4,
+				MANDATORY = 0x8
+			};
+
+			static bool isRegionalIndicator(unsigned int codepoint);
+			static bool isIdeographic(unsigned int codepoint);
+			static bool isClosingPunctuation(unsigned int codepoint);
+			static bool isOpeningPunctuation(unsigned int codepoint);
+
+			std::size_t revision;
+			bool decoded;
+			std::vector<unsigned int> codepoints;
+			std::vector<std::size_t> offsets;
+
+			/**
+			 * The boundary flags of every byte offset,
+			 * including the end of the text.
+			 */
+			std::vector<unsigned char> boundaries;
+		};
+	}
+}
+
+#endif
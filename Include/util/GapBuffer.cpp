@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./GapBuffer.h"
+#include <algorithm>
+
+namespace ui
+{
+	namespace util
+	{
+		const std::size_t GapBuffer::minimumGap;
+
+		GapBuffer::GapBuffer()
+			:	gapStart(0),
+				gapEnd(0)
+		{
+		}
+
+		std::size_t GapBuffer::length() const
+		{
+			return buffer.size() - (gapEnd - gapStart);
+		}
+
+		char GapBuffer::at(std::size_t index) const
+		{
+			return index < gapStart ? buffer[index] : buffer[index + gapEnd - gapStart];
+		}
+
+		void GapBuffer::assign(const std::string &text)
+		{
+			buffer.assign(text.begin(),text.end());
+			buffer.resize(text.length() + minimumGap);
+			gapStart = text.length();
+			gapEnd = buffer.size();
+		}
+
+		void GapBuffer::insert(std::size_t position, const std::string &text)
+		{
+			if(text.empty())
+			{
+				return;
+			}
+			moveGap(position);
+			reserve(text.length());
+			std::copy(text.begin(),text.end(),buffer.begin() + gapStart);
+			gapStart += text.length();
+		}
+
+		void GapBuffer::erase(std::size_t position, std::size_t count)
+		{
+			moveGap(position);
+			gapEnd += std::min(count,buffer.size() - gapEnd);
+		}
+
+		void GapBuffer::copy(std::size_t position, std::size_t count, std::string &result) const
+		{
+			result.erase();
+
+			std::size_t end = std::min(position + count,length());
+			if(position < gapStart)
+			{
+				result.append(buffer.begin() + position,buffer.begin() + std::min(end,gapStart));
+			}
+			if(end > gapStart)
+			{
+				std::size_t begin = std::max(position,gapStart);
+				result.append(buffer.begin() + begin + gapEnd - gapStart,buffer.begin() + end + gapEnd - gapStart);
+			}
+		}
+
+		void GapBuffer::getText(std::string &result) const
+		{
+			copy(0,length(),result);
+		}
+
+		void GapBuffer::moveGap(std::size_t position)
+		{
+			if(position < gapStart)
+			{
+				std::size_t count = gapStart - position;
+				std::copy_backward(buffer.begin() + position,buffer.begin() + gapStart,buffer.begin() + gapEnd);
+				gapStart -= count;
+				gapEnd -= count;
+			}
+			else if(position > gapStart)
+			{
+				std::size_t count = position - gapStart;
+				std::copy(buffer.begin() + gapEnd,buffer.begin() + gapEnd + count,buffer.begin() + gapStart);
+				gapStart += count;
+				gapEnd += count;
+			}
+		}
+
+		void GapBuffer::reserve(std::size_t size)
+		{
+			if(gapEnd - gapStart >= size)
+			{
+				return;
+			}
+
+			// grow by at least half the text, so a series of
+			// inserts takes amortized constant time per byte.
+			std::size_t gap = std::max(size,std::max(length() / 2,minimumGap));
+			std::vector<char> grown(length() + gap);
+
+			std::copy(buffer.begin(),buffer.begin() + gapStart,grown.begin());
+			std::copy(buffer.begin() + gapEnd,buffer.end(),grown.begin() + gapStart + gap);
+
+			gapEnd = gapStart + gap;
+			buffer.swap(grown);
+		}
+	}
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GAPBUFFER_H
+#define GAPBUFFER_H
+
+#include <vector>
+#include <string>
+
+namespace ui
+{
+	namespace util
+	{
+		/**
+		 * Text storage for editing.
+		 * <p>
+		 * The text is kept in one array with a gap at the position
+		 * that was edited last. Inserting or erasing at the gap only
+		 * moves the edges of the gap, so typing costs time in the
+		 * size of the edit, not in the length of the text. Editing
+		 * elsewhere first moves the gap there, which costs time in
+		 * the distance moved.
+		 * </p>
+		 */
+		class GapBuffer
+		{
+		public:
+			/**
+			 * Creates an empty GapBuffer.
+			 */
+			GapBuffer();
+
+			/**
+			 * Returns the length of the text.
+			 */
+			std::size_t length() const;
+
+			/**
+			 * Returns the byte at index.
+			 */
+			char at(std::size_t index) const;
+
+			/**
+			 * Replaces the text.
+			 */
+			void assign(const std::string &text);
+
+			/**
+			 * Inserts text before position.
+			 */
+			void insert(std::size_t position, const std::string &text);
+
+			/**
+			 * Erases count bytes starting at position.
+			 */
+			void erase(std::size_t position, std::size_t count);
+
+			/**
+			 * Copies count bytes starting at position to result.
+			 */
+			void copy(std::size_t position, std::size_t count, std::string &result) const;
+
+			/**
+			 * Copies the whole text to result.
+			 */
+			void getText(std::string &result) const;
+		private:
+			/**
+			 * Moves the gap so it starts at position.
+			 */
+			void moveGap(std::size_t position);
+
+			/**
+			 * Makes sure the gap can hold size bytes.
+			 */
+			void reserve(std::size_t size);
+
+			static const std::size_t minimumGap = 32;
+
+			std::vector<char> buffer;
+			std::size_t gapStart, gapEnd;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./MappedFile.h"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace ui
+{
+	namespace util
+	{
+		MappedFile::MappedFile()
+			:	data(0),
+				size(0)
+#ifdef WIN32
+				,file(INVALID_HANDLE_VALUE),
+				mapping(0)
+#endif
+		{
+		}
+
+		MappedFile::~MappedFile()
+		{
+			close();
+		}
+
+#ifdef WIN32
+		bool MappedFile::open(const std::string &fileName)
+		{
+			close();
+
+			file = CreateFileA(fileName.c_str(),GENERIC_READ,FILE_SHARE_READ,0,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,0);
+			if(file == INVALID_HANDLE_VALUE)
+			{
+				return false;
+			}
+
+			DWORD fileSize = GetFileSize(file,0);
+			if(fileSize == INVALID_FILE_SIZE || fileSize == 0)
+			{
+				close();
+				return false;
+			}
+
+			mapping = CreateFileMappingA(file,0,PAGE_READONLY,0,0,0);
+			if(mapping == 0)
+			{
+				close();
+				return false;
+			}
+
+			data = static_cast<const unsigned char*>(MapViewOfFile(mapping,FILE_MAP_READ,0,0,0));
+			if(data == 0)
+			{
+				close();
+				return false;
+			}
+			size = fileSize;
+			return true;
+		}
+
+		void MappedFile::close()
+		{
+			if(data != 0)
+			{
+				UnmapViewOfFile(data);
+			}
+			if(mapping != 0)
+			{
+				CloseHandle(mapping);
+			}
+			if(file != INVALID_HANDLE_VALUE)
+			{
+				CloseHandle(file);
+			}
+			data = 0;
+			size = 0;
+			mapping = 0;
+			file = INVALID_HANDLE_VALUE;
+		}
+#else
+		bool MappedFile::open(const std::string &fileName)
+		{
+			close();
+
+			int file = ::open(fileName.c_str(),O_RDONLY);
+			if(file == -1)
+			{
+				return false;
+			}
+
+			struct stat info;
+			if(fstat(file,&info) != 0 || info.st_size == 0)
+			{
+				::close(file);
+				return false;
+			}
+
+			// the mapping stays valid after the descriptor is closed.
+			void *view = mmap(0,info.st_size,PROT_READ,MAP_PRIVATE,file,0);
+			::close(file);
+
+			if(view == MAP_FAILED)
+			{
+				return false;
+			}
+			data = static_cast<const unsigned char*>(view);
+			size = static_cast<std::size_t>(info.st_size);
+			return true;
+		}
+
+		void MappedFile::close()
+		{
+			if(data != 0)
+			{
+				munmap(const_cast<unsigned char*>(data),size);
+			}
+			data = 0;
+			size = 0;
+		}
+#endif
+
+		bool MappedFile::isOpen() const
+		{
+			return data != 0;
+		}
+
+		const unsigned char * MappedFile::getData() const
+		{
+			return data;
+		}
+
+		std::size_t MappedFile::getSize() const
+		{
+			return size;
+		}
+	}
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+
+namespace ui
+{
+	namespace util
+	{
+		/**
+		 * Maps a file into memory for reading.
+		 * The operating system pages the file in when it is
+		 * accessed, so large read-only data such as precomputed
+		 * font atlases can be used without copying it first.
+		 */
+		class MappedFile
+		{
+		public:
+			/**
+			 * Creates a MappedFile which is not open.
+			 */
+			MappedFile();
+
+			/**
+			 * Unmaps the file if it is open.
+			 */
+			~MappedFile();
+
+			/**
+			 * Maps a file. A file which was open before is
+			 * closed first.
+			 * @param
+			 *	fileName the path of the file.
+			 * @return
+			 *	false if the file could not be mapped.
+			 */
+			bool open(const std::string &fileName);
+
+			/**
+			 * Unmaps the file.
+			 */
+			void close();
+
+			/**
+			 * Returns true if a file is mapped.
+			 */
+			bool isOpen() const;
+
+			/**
+			 * Returns the contents of the file, or
+			 * NULL if no file is mapped.
+			 */
+			const unsigned char * getData() const;
+
+			/**
+			 * Returns the size of the file in bytes.
+			 */
+			std::size_t getSize() const;
+		private:
+			MappedFile(const MappedFile &rhs);
+			MappedFile& operator=(const MappedFile &rhs);
+
+			const unsigned char *data;
+			std::size_t size;
+#ifdef WIN32
+			void *file;
+			void *mapping;
+#endif
+		};
+	}
+}
+
+#endif
@@ -27,6 +27,7 @@
  */
 #include "./Observable.h"
 #include "./Observer.h"
+#include "../NotificationManager.h"
 
 namespace ui
 {
@@ -39,6 +40,10 @@ namespace ui
 
 		Observable::~Observable()
 		{
+			if(NotificationManager::hasPendingNotifications())
+			{
+				NotificationManager::getInstance().cancel(this);
+			}
 			removeObservers();
 		}
 
@@ -58,6 +63,22 @@ namespace ui
 		}
 
 		void Observable::notifyObserver()
+		{
+			NotificationManager &notifications = NotificationManager::getInstance();
+			if(notifications.isDeferred())
+			{
+				if(hasChanged())
+				{
+					notifications.postObservable(this);
+				}
+			}
+			else
+			{
+				deliverNotification();
+			}
+		}
+
+		void Observable::deliverNotification()
 		{
 			if(hasChanged())
 			{
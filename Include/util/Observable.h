@@ -69,11 +69,19 @@ namespace ui
 			 * Notify the Observers of a change.
 			 * The Observers are only called when
 			 * the isChanged flag is set to true.
+			 * When the NotificationManager defers notifications,
+			 * they are called once at the end of input processing.
 			 * @see
 			 *	setChanged, hasChanged, clearChanged
 			 */
 			void notifyObserver();
 
+			/**
+			 * Notify the Observers right away, if the
+			 * isChanged flag is set.
+			 */
+			void deliverNotification();
+
 			/**
 			 * Destructor.
 			 */
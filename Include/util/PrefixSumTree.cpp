@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./PrefixSumTree.h"
+
+namespace ui
+{
+	namespace util
+	{
+		PrefixSumTree::PrefixSumTree()
+			:	tree(1,0),
+				mask(0)
+		{
+		}
+
+		void PrefixSumTree::assign(std::size_t count, int value)
+		{
+			values.assign(count,value);
+			build();
+		}
+
+		void PrefixSumTree::insert(std::size_t index, std::size_t count, int value)
+		{
+			assert(index <= values.size());
+			values.insert(values.begin() + index,count,value);
+			build();
+		}
+
+		void PrefixSumTree::append(int value)
+		{
+			values.push_back(value);
+
+			// the new node covers the values from just after its
+			// lowest bit up to and including itself.
+			std::size_t n = values.size();
+			std::size_t low = n - (n & (~n + 1));
+			tree.push_back(getPrefixSum(n - 1) - getPrefixSum(low) + value);
+
+			mask = std::max<std::size_t>(mask,1);
+			while(mask <= n / 2)
+			{
+				mask <<= 1;
+			}
+		}
+
+		void PrefixSumTree::erase(std::size_t index, std::size_t count)
+		{
+			assert(index + count <= values.size());
+			values.erase(values.begin() + index,values.begin() + index + count);
+			build();
+		}
+
+		void PrefixSumTree::build()
+		{
+			std::size_t n = values.size();
+
+			tree.assign(n + 1,0);
+
+			// linear time construction, every node pushes its
+			// sum to its parent.
+			for(std::size_t i = 1; i <= n; ++i)
+			{
+				tree[i] += values[i - 1];
+
+				std::size_t parent = i + (i & (~i + 1));
+				if(parent <= n)
+				{
+					tree[parent] += tree[i];
+				}
+			}
+
+			mask = 1;
+			while(mask <= n / 2)
+			{
+				mask <<= 1;
+			}
+		}
+
+		void PrefixSumTree::set(std::size_t index, int value)
+		{
+			assert(index < values.size());
+
+			int delta = value - values[index];
+			values[index] = value;
+
+			for(std::size_t i = index + 1; i < tree.size(); i += (i & (~i + 1)))
+			{
+				tree[i] += delta;
+			}
+		}
+
+		int PrefixSumTree::get(std::size_t index) const
+		{
+			assert(index < values.size());
+			return values[index];
+		}
+
+		std::size_t PrefixSumTree::size() const
+		{
+			return values.size();
+		}
+
+		int PrefixSumTree::getPrefixSum(std::size_t count) const
+		{
+			assert(count <= values.size());
+
+			int sum = 0;
+			for(std::size_t i = count; i > 0; i -= (i & (~i + 1)))
+			{
+				sum += tree[i];
+			}
+			return sum;
+		}
+
+		int PrefixSumTree::getTotal() const
+		{
+			return getPrefixSum(values.size());
+		}
+
+		std::size_t PrefixSumTree::find(int sum) const
+		{
+			if(sum < 0)
+			{
+				return 0;
+			}
+
+			std::size_t index = 0;
+			int remaining = sum;
+
+			for(std::size_t step = mask; step != 0; step >>= 1)
+			{
+				std::size_t next = index + step;
+				if(next < tree.size() && tree[next] <= remaining)
+				{
+					index = next;
+					remaining -= tree[next];
+				}
+			}
+			return index;
+		}
+	}
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PREFIXSUMTREE_H
+#define PREFIXSUMTREE_H
+
+#include "../Pointers.h"
+
+namespace ui
+{
+	namespace util
+	{
+		/**
+		 * A list of integer values which keeps its prefix sums
+		 * cached in a binary indexed (Fenwick) tree. Changing a value,
+		 * computing a prefix sum and finding the value containing a given
+		 * sum all take logarithmic time. This is used to store row and line
+		 * heights, so the row at a pixel offset can be found quickly.
+		 * Values are expected to be non-negative.
+		 */
+		class PrefixSumTree
+		{
+		public:
+			/**
+			 * Creates an empty PrefixSumTree.
+			 */
+			PrefixSumTree();
+
+			/**
+			 * Replaces the contents with count copies of value.
+			 */
+			void assign(std::size_t count, int value);
+
+			/**
+			 * Inserts count copies of value before index.
+			 * This rebuilds the tree and takes linear time.
+			 */
+			void insert(std::size_t index, std::size_t count, int value);
+
+			/**
+			 * Appends a value. Unlike insert, this takes
+			 * logarithmic time.
+			 */
+			void append(int value);
+
+			/**
+			 * Removes count values starting at index.
+			 * This rebuilds the tree and takes linear time.
+			 */
+			void erase(std::size_t index, std::size_t count);
+
+			/**
+			 * Sets the value at index.
+			 */
+			void set(std::size_t index, int value);
+
+			/**
+			 * Returns the value at index.
+			 */
+			int get(std::size_t index) const;
+
+			/**
+			 * Returns the number of values.
+			 */
+			std::size_t size() const;
+
+			/**
+			 * Returns the sum of the first count values.
+			 */
+			int getPrefixSum(std::size_t count) const;
+
+			/**
+			 * Returns the sum of all values.
+			 */
+			int getTotal() const;
+
+			/**
+			 * Returns the index of the value which contains the
+			 * given sum, ie. the largest index for which
+			 * getPrefixSum(index) <= sum. Returns size() if the
+			 * sum lies beyond the total.
+			 */
+			std::size_t find(int sum) const;
+		private:
+			void build();
+
+			std::vector<int> values;
+			std::vector<int> tree;
+			std::size_t mask;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./Utf8.h"
+
+namespace ui
+{
+	namespace util
+	{
+		const unsigned int Utf8::replacementCharacter = 0xfffd;
+
+		unsigned int Utf8::decode(const std::string &text, std::size_t &index)
+		{
+			unsigned char lead = static_cast<unsigned char>(text[index++]);
+
+			if(lead < 0x80)
+			{
+				return lead;
+			}
+
+			std::size_t count;
+			unsigned int codepoint;
+			unsigned int minimum;
+
+			if(lead >= 0xc2 && lead < 0xe0)
+			{
+				count = 1;
+				codepoint = lead & 0x1f;
+				minimum = 0x80;
+			}
+			else if(lead >= 0xe0 && lead < 0xf0)
+			{
+				count = 2;
+				codepoint = lead & 0x0f;
+				minimum = 0x800;
+			}
+			else if(lead >= 0xf0 && lead < 0xf5)
+			{
+				count = 3;
+				codepoint = lead & 0x07;
+				minimum = 0x10000;
+			}
+			else
+			{
+				return replacementCharacter;
+			}
+
+			if(index + count > text.length())
+			{
+				return replacementCharacter;
+			}
+
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				unsigned char byte = static_cast<unsigned char>(text[index + i]);
+				if(!isContinuation(byte))
+				{
+					return replacementCharacter;
+				}
+				codepoint = (codepoint << 6) | (byte & 0x3f);
+			}
+
+			// reject overlong forms, surrogates and values
+			// outside the unicode range.
+			if(codepoint < minimum || (codepoint >= 0xd800 && codepoint < 0xe000) || codepoint > 0x10ffff)
+			{
+				return replacementCharacter;
+			}
+
+			index += count;
+			return codepoint;
+		}
+
+		void Utf8::encode(unsigned int codepoint, std::string &text)
+		{
+			if(codepoint > 0x10ffff || (codepoint >= 0xd800 && codepoint < 0xe000))
+			{
+				codepoint = replacementCharacter;
+			}
+
+			if(codepoint < 0x80)
+			{
+				text += static_cast<char>(codepoint);
+			}
+			else if(codepoint < 0x800)
+			{
+				text += static_cast<char>(0xc0 | (codepoint >> 6));
+				text += static_cast<char>(0x80 | (codepoint & 0x3f));
+			}
+			else if(codepoint < 0x10000)
+			{
+				text += static_cast<char>(0xe0 | (codepoint >> 12));
+				text += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f));
+				text += static_cast<char>(0x80 | (codepoint & 0x3f));
+			}
+			else
+			{
+				text += static_cast<char>(0xf0 | (codepoint >> 18));
+				text += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3f));
+				text += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f));
+				text += static_cast<char>(0x80 | (codepoint & 0x3f));
+			}
+		}
+
+		std::size_t Utf8::next(const std::string &text, std::size_t index)
+		{
+			if(index >= text.length())
+			{
+				return text.length();
+			}
+			decode(text,index);
+			return index;
+		}
+
+		std::size_t Utf8::previous(const std::string &text, std::size_t index)
+		{
+			if(index == 0)
+			{
+				return 0;
+			}
+
+			// step back over at most three continuation bytes, and
+			// make sure the sequence found really ends at index.
+			std::size_t start = index - 1;
+			while(start > 0 && index - start < 4 && isContinuation(static_cast<unsigned char>(text[start])))
+			{
+				--start;
+			}
+			if(next(text,start) == index)
+			{
+				return start;
+			}
+			return index - 1;
+		}
+
+		bool Utf8::isContinuation(unsigned char byte)
+		{
+			return (byte & 0xc0) == 0x80;
+		}
+
+		std::size_t Utf8::length(const std::string &text)
+		{
+			std::size_t count = 0;
+			for(std::size_t index = 0; index < text.length(); ++count)
+			{
+				decode(text,index);
+			}
+			return count;
+		}
+	}
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UTF8_H
+#define UTF8_H
+
+#include <string>
+
+namespace ui
+{
+	namespace util
+	{
+		/**
+		 * Functions for text encoded in UTF-8, which is how
+		 * all text in the Gui is stored.
+		 * <p>
+		 * Positions in text are byte offsets, so a std::string
+		 * can be used as before, but only offsets on a code point
+		 * boundary should be used to split text. Malformed bytes
+		 * decode to the replacement character, one byte at a time.
+		 * </p>
+		 */
+		class Utf8
+		{
+		public:
+			/**
+			 * The code point malformed bytes decode to.
+			 */
+			static const unsigned int replacementCharacter;
+
+			/**
+			 * Decodes the code point starting at index and moves
+			 * index past it.
+			 */
+			static unsigned int decode(const std::string &text, std::size_t &index);
+
+			/**
+			 * Appends a code point to text.
+			 */
+			static void encode(unsigned int codepoint, std::string &text);
+
+			/**
+			 * Returns the offset of the code point after the one
+			 * at index, or the length of text.
+			 */
+			static std::size_t next(const std::string &text, std::size_t index);
+
+			/**
+			 * Returns the offset of the code point before index,
+			 * or 0.
+			 */
+			static std::size_t previous(const std::string &text, std::size_t index);
+
+			/**
+			 * Returns true if byte continues a code point,
+			 * that is, it is never the first byte of one.
+			 */
+			static bool isContinuation(unsigned char byte);
+
+			/**
+			 * Returns the number of code points in text.
+			 */
+			static std::size_t length(const std::string &text);
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./TestFont.h"
+#include "../Include/Gui.h"
+#include "../Include/component/Frame.h"
+#include "../Include/component/Panel.h"
+#include "../Include/component/Button.h"
+#include "../Include/component/Label.h"
+#include "../Include/component/CheckBox.h"
+#include "../Include/component/Slider.h"
+#include "../Include/component/TextField.h"
+#include "../Include/layout/FlowLayout.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+/**
+ * Checks that painting a Gui which does not change does not
+ * allocate. Every global operator new is counted; after a few
+ * frames to let the caches and buffers grow, the count has to
+ * stay the same.
+ */
+
+static std::size_t allocations = 0;
+
+void * operator new(std::size_t size) throw(std::bad_alloc)
+{
+	++allocations;
+	void *p = std::malloc(size == 0 ? 1 : size);
+	if(p == 0)
+	{
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void * operator new[](std::size_t size) throw(std::bad_alloc)
+{
+	return operator new(size);
+}
+
+void operator delete(void *p) throw()
+{
+	std::free(p);
+}
+
+void operator delete[](void *p) throw()
+{
+	std::free(p);
+}
+
+int main()
+{
+	test::TestFontFactory factory;
+
+	ui::Gui gui;
+	gui.setFontFactory(&factory);
+
+	ui::Frame frame(0,0,640,480);
+	ui::Panel content;
+	content.setLayout(new ui::layout::FlowLayout());
+	frame.setContentPane(&content);
+
+	ui::Button button("A button with a long label");
+	ui::Label label("A label");
+	ui::CheckBox check("Check");
+	ui::Slider slider(0.0f,100.0f);
+	ui::TextField field;
+	field.setText("Some text");
+
+	frame.add(&button);
+	frame.add(&label);
+	frame.add(&check);
+	frame.add(&slider);
+	frame.add(&field);
+	gui.addFrame(&frame);
+
+	const int warmup = 10;
+	const int frames = 100;
+
+	std::size_t before = 0;
+	for(int i = 0; i < warmup + frames; ++i)
+	{
+		if(i == warmup)
+		{
+			before = allocations;
+		}
+
+		// the mouse moves back and forth over the Components.
+		gui.importMouseMotion(10 + (i % 2) * 300,20);
+		gui.importUpdate(0.016f);
+		gui.paint();
+	}
+
+	std::size_t count = allocations - before;
+	std::printf("%lu allocations in %d steady state frames\n",static_cast<unsigned long>(count),frames);
+	return count == 0 ? 0 : 1;
+}
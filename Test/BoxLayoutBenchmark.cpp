@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "./TestFont.h"
+#include "../Include/Gui.h"
+#include "../Include/component/Frame.h"
+#include "../Include/component/Panel.h"
+#include "../Include/component/Label.h"
+#include "../Include/component/Button.h"
+#include "../Include/component/TextField.h"
+#include "../Include/layout/BoxLayout.h"
+#include "../Include/layout/BorderLayout.h"
+#include "../Include/layout/FlowLayout.h"
+#include "../Include/util/Clock.h"
+#include <cstdio>
+#include <vector>
+
+/**
+ * Lays out the same form, a toolbar above rows of a Label, a
+ * TextField and a Button, once with BoxLayouts and once with the
+ * nested BorderLayouts and FlowLayouts it takes without them. The
+ * width of the form changes every time, so every row is laid out
+ * again. A flat wrapping BoxLayout and FlowLayout with thousands
+ * of Buttons show that adding Components and laying them out the
+ * first time grows linearly with their number.
+ */
+
+/**
+ * Owns the Components and LayoutManagers of a form.
+ */
+class Form
+{
+public:
+	~Form()
+	{
+		for(std::size_t i = panels.size(); i-- > 0;)
+		{
+			panels[i]->removeAll();
+			delete panels[i];
+		}
+		for(std::size_t i = 0; i < components.size(); ++i)
+		{
+			delete components[i];
+		}
+		for(std::size_t i = 0; i < layouts.size(); ++i)
+		{
+			delete layouts[i];
+		}
+	}
+
+	ui::Panel * createPanel(ui::layout::LayoutManager *layout)
+	{
+		layouts.push_back(layout);
+		panels.push_back(new ui::Panel(layout));
+		return panels.back();
+	}
+
+	template<class T> T * create(T *component)
+	{
+		components.push_back(component);
+		return component;
+	}
+
+	std::vector<ui::Panel*> panels;
+	std::vector<ui::Component*> components;
+	std::vector<ui::layout::LayoutManager*> layouts;
+};
+
+static ui::Panel * createBoxForm(Form &form, int rows)
+{
+	ui::Panel *root = form.createPanel(new ui::layout::BoxLayout(ui::Component::VERTICAL,false,4,4));
+
+	ui::Panel *toolbar = form.createPanel(new ui::layout::BoxLayout(ui::Component::HORIZONTAL,true,4,4));
+	for(int i = 0; i < 10; ++i)
+	{
+		toolbar->add(form.create(new ui::Button("Tool")));
+	}
+	root->add(toolbar);
+
+	for(int i = 0; i < rows; ++i)
+	{
+		ui::Panel *row = form.createPanel(new ui::layout::BoxLayout(ui::Component::HORIZONTAL,false,4,4));
+		row->add(form.create(new ui::Label("Name")));
+		row->add(form.create(new ui::TextField()),1);
+		row->add(form.create(new ui::Button("Edit")));
+		root->add(row);
+	}
+	return root;
+}
+
+static ui::Panel * createNestedForm(Form &form, int rows)
+{
+	ui::Panel *root = form.createPanel(new ui::layout::BorderLayout(4,4));
+
+	ui::Panel *toolbar = form.createPanel(new ui::layout::FlowLayout(ui::Component::LEFT,4,4));
+	for(int i = 0; i < 10; ++i)
+	{
+		toolbar->add(form.create(new ui::Button("Tool")));
+	}
+	root->add(toolbar,ui::layout::BorderLayout::NORTH);
+
+	// every row sits at the top of the rest of the form.
+	ui::Panel *rest = root;
+	for(int i = 0; i < rows; ++i)
+	{
+		ui::Panel *holder = form.createPanel(new ui::layout::BorderLayout(4,4));
+		ui::Panel *row = form.createPanel(new ui::layout::BorderLayout(4,4));
+		row->add(form.create(new ui::Label("Name")),ui::layout::BorderLayout::WEST);
+		row->add(form.create(new ui::TextField()),ui::layout::BorderLayout::CENTER);
+		row->add(form.create(new ui::Button("Edit")),ui::layout::BorderLayout::EAST);
+		holder->add(row,ui::layout::BorderLayout::NORTH);
+		rest->add(holder,ui::layout::BorderLayout::CENTER);
+		rest = holder;
+	}
+	return root;
+}
+
+static double layout(ui::Gui &gui, ui::Panel *content, int frames)
+{
+	ui::Frame frame(0,0,640,480);
+	frame.setContentPane(content);
+	frame.setVisible(true);
+	gui.addFrame(&frame);
+	frame.validate();
+
+	const double start = ui::util::Clock::getSeconds();
+	for(int i = 0; i < frames; ++i)
+	{
+		frame.setSize(640 + (i % 2),480);
+		frame.validate();
+	}
+	const double elapsed = ui::util::Clock::getSeconds() - start;
+
+	gui.removeFrame(&frame);
+	return elapsed * 1e6 / frames;
+}
+
+static double fill(ui::Gui &gui, ui::layout::LayoutManager *layout, int buttons)
+{
+	Form form;
+	form.layouts.push_back(layout);
+	ui::Panel panel(layout);
+	ui::Frame frame(0,0,640,480);
+	frame.setContentPane(&panel);
+	frame.setVisible(true);
+	gui.addFrame(&frame);
+
+	for(int i = 0; i < buttons; ++i)
+	{
+		form.create(new ui::Button("Button"));
+	}
+
+	const double start = ui::util::Clock::getSeconds();
+	for(int i = 0; i < buttons; ++i)
+	{
+		panel.add(form.components[i]);
+	}
+	frame.validate();
+	const double elapsed = ui::util::Clock::getSeconds() - start;
+
+	gui.removeFrame(&frame);
+	panel.removeAll();
+	return elapsed * 1e6;
+}
+
+int main()
+{
+	test::TestFontFactory factory;
+	ui::Gui gui;
+	gui.setFontFactory(&factory);
+
+	const int frames = 200;
+	for(int rows = 10; rows <= 160; rows *= 4)
+	{
+		Form box, nested;
+		const double boxTime = layout(gui,createBoxForm(box,rows),frames);
+		const double nestedTime = layout(gui,createNestedForm(nested,rows),frames);
+		std::printf("%4d rows: BoxLayout %9.2f us, nested Border/FlowLayout %9.2f us per layout\n",rows,boxTime,nestedTime);
+	}
+
+	for(int buttons = 1000; buttons <= 8000; buttons *= 2)
+	{
+		const double boxTime = fill(gui,new ui::layout::BoxLayout(ui::Component::HORIZONTAL,true,2,2),buttons);
+		const double flowTime = fill(gui,new ui::layout::FlowLayout(),buttons);
+		std::printf("%5d buttons: BoxLayout %10.2f us, FlowLayout %10.2f us to add and lay out\n",buttons,boxTime,flowTime);
+	}
+	return 0;
+}
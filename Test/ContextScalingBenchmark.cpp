@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "./TestFont.h"
+#include "../Include/Gui.h"
+#include "../Include/UiContext.h"
+#include "../Include/component/Frame.h"
+#include "../Include/component/Panel.h"
+#include "../Include/component/Label.h"
+#include "../Include/component/ProgressBar.h"
+#include "../Include/layout/FlowLayout.h"
+#include "../Include/util/Clock.h"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Updates and lays out independent panels, each with a Gui and a
+ * UiContext of its own, on 1 to N threads, where N is the number
+ * of processors or the first argument. The panels share nothing,
+ * so the time per panel should drop with every thread added, up to
+ * the number of processors. Nothing is painted, which is the part
+ * that still needs the OpenGL context of one thread.
+ */
+
+static const int panels = 32;
+static const int steps = 200;
+
+/**
+ * A Frame of Labels and ProgressBars whose text and values change
+ * every step. They flow by their preferred sizes, so every step
+ * measures the text and lays the Frame out again.
+ */
+class ScalingPanel
+{
+public:
+	explicit ScalingPanel(test::TestFontFactory &factory)
+		:	gui(context)
+	{
+		ui::UiContext::Scope scope(context);
+		gui.setFontFactory(&factory);
+
+		frame = new ui::Frame(0,0,320,240);
+		content = new ui::Panel();
+		content->setLayout(new ui::layout::FlowLayout());
+		for(int i = 0; i < 12; ++i)
+		{
+			ui::Label *label = new ui::Label("Label");
+			labels.push_back(label);
+			content->add(label);
+		}
+		for(int i = 0; i < 4; ++i)
+		{
+			ui::ProgressBar *bar = new ui::ProgressBar(0,100);
+			bars.push_back(bar);
+			content->add(bar);
+		}
+		frame->setContentPane(content);
+		frame->setVisible(true);
+		gui.addFrame(frame);
+	}
+
+	~ScalingPanel()
+	{
+		ui::UiContext::Scope scope(context);
+		gui.removeFrame(frame);
+		content->removeAll();
+		for(std::size_t i = 0; i < labels.size(); ++i)
+		{
+			delete labels[i];
+		}
+		for(std::size_t i = 0; i < bars.size(); ++i)
+		{
+			delete bars[i];
+		}
+		delete content;
+		delete frame;
+	}
+
+	void step(int step)
+	{
+		gui.importUpdate(1.0f / 60.0f);
+
+		ui::UiContext::Scope scope(context);
+		char text[32];
+		for(std::size_t i = 0; i < labels.size(); ++i)
+		{
+			std::sprintf(text,"Value %d",step * 7 + static_cast<int>(i) * 1000);
+			labels[i]->setText(text);
+		}
+		for(std::size_t i = 0; i < bars.size(); ++i)
+		{
+			bars[i]->setValue((step + static_cast<int>(i) * 25) % 100);
+		}
+
+		// setText leaves the layout alone, the new sizes are
+		// taken into account by laying out again.
+		content->invalidate();
+		frame->validate();
+	}
+private:
+	ScalingPanel(const ScalingPanel&);
+	ScalingPanel& operator=(const ScalingPanel&);
+
+	ui::UiContext context;
+	ui::Gui gui;
+	ui::Frame *frame;
+	ui::Panel *content;
+	std::vector<ui::Label*> labels;
+	std::vector<ui::ProgressBar*> bars;
+};
+
+/**
+ * Steps a range of the panels, on a thread of its own.
+ */
+class Worker
+{
+public:
+	std::vector<ScalingPanel*> *panels;
+	std::size_t begin, end;
+
+	void run()
+	{
+		for(int s = 0; s < steps; ++s)
+		{
+			for(std::size_t i = begin; i < end; ++i)
+			{
+				(*panels)[i]->step(s);
+			}
+		}
+	}
+};
+
+#ifdef _MSC_VER
+static DWORD WINAPI work(LPVOID worker)
+{
+	static_cast<Worker*>(worker)->run();
+	return 0;
+}
+#else
+static void * work(void *worker)
+{
+	static_cast<Worker*>(worker)->run();
+	return 0;
+}
+#endif
+
+static int getProcessorCount()
+{
+#ifdef _MSC_VER
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return static_cast<int>(info.dwNumberOfProcessors);
+#else
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? static_cast<int>(count) : 1;
+#endif
+}
+
+int main(int argc, char **argv)
+{
+	test::TestFontFactory factory;
+
+	const int maximum = argc > 1 ? std::atoi(argv[1]) : getProcessorCount();
+
+	std::vector<ScalingPanel*> list;
+	for(int i = 0; i < panels; ++i)
+	{
+		list.push_back(new ScalingPanel(factory));
+	}
+
+	double single = 0.0;
+	for(int threads = 1; threads <= maximum; ++threads)
+	{
+		std::vector<Worker> workers(threads);
+#ifdef _MSC_VER
+		std::vector<HANDLE> handles(threads);
+#else
+		std::vector<pthread_t> handles(threads);
+#endif
+
+		const double start = ui::util::Clock::getSeconds();
+		for(int t = 0; t < threads; ++t)
+		{
+			workers[t].panels = &list;
+			workers[t].begin = list.size() * t / threads;
+			workers[t].end = list.size() * (t + 1) / threads;
+#ifdef _MSC_VER
+			handles[t] = CreateThread(0,0,work,&workers[t],0,0);
+#else
+			pthread_create(&handles[t],0,work,&workers[t]);
+#endif
+		}
+		for(int t = 0; t < threads; ++t)
+		{
+#ifdef _MSC_VER
+			WaitForSingleObject(handles[t],INFINITE);
+			CloseHandle(handles[t]);
+#else
+			pthread_join(handles[t],0);
+#endif
+		}
+		const double elapsed = ui::util::Clock::getSeconds() - start;
+
+		if(threads == 1)
+		{
+			single = elapsed;
+		}
+		std::printf("%2d threads: %8.2f us per panel step, %5.2f times one thread\n",threads,elapsed * 1e6 / (panels * steps),single / elapsed);
+	}
+
+	for(std::size_t i = 0; i < list.size(); ++i)
+	{
+		delete list[i];
+	}
+	return 0;
+}
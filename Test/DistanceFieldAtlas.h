@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DISTANCEFIELDATLAS_H
+#define DISTANCEFIELDATLAS_H
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace test
+{
+	/**
+	 * Writes atlas files in the format DistanceFieldFace loads, so
+	 * tests have one without a font engine. The glyphs are shapes
+	 * whose distances can be computed exactly: ISO 8859-1 letters
+	 * are boxes of a few widths, and a block of CJK ideographs from
+	 * U+4E00 are square rings, which need a version 2 file.
+	 */
+	class DistanceFieldAtlas
+	{
+	public:
+		/**
+		 * The first code point of the square rings.
+		 */
+		static const unsigned int ideographs = 0x4E00;
+
+		/**
+		 * The number of square rings.
+		 */
+		static const unsigned int ideographCount = 64;
+
+		/**
+		 * Creates an atlas for the given field size, in which a
+		 * distance of spread pixels maps to 0 and 255.
+		 */
+		DistanceFieldAtlas(int size, int distance)
+			:	fieldSize(size),
+				spread(distance),
+				width(512),
+				height(0)
+		{
+			int x = 0, y = 0, row = 0;
+
+			for(unsigned int c = ' '; c <= '~'; ++c)
+			{
+				addGlyph(c,x,y,row);
+			}
+			for(unsigned int c = ideographs; c < ideographs + ideographCount; ++c)
+			{
+				addGlyph(c,x,y,row);
+			}
+			height = y + row;
+
+			pixels.assign(static_cast<std::size_t>(width) * height,0);
+			for(std::size_t i = 0; i < glyphs.size(); ++i)
+			{
+				drawGlyph(glyphs[i]);
+			}
+		}
+
+		/**
+		 * Returns the advance of a code point in 1/64 pixels
+		 * at the field size, as it is written to the file.
+		 */
+		int getAdvance(unsigned int codepoint) const
+		{
+			for(std::size_t i = 0; i < glyphs.size(); ++i)
+			{
+				if(glyphs[i].codepoint == codepoint)
+				{
+					return glyphs[i].advance;
+				}
+			}
+			return 0;
+		}
+
+		/**
+		 * Writes a version 2 atlas file.
+		 * @return
+		 *	false if the file could not be written.
+		 */
+		bool write(const std::string &fileName) const
+		{
+			std::ofstream out(fileName.c_str(),std::ios::binary);
+
+			out.write("UIDF",4);
+			write16(out,2);
+			write16(out,width);
+			write16(out,height);
+			write16(out,fieldSize);
+			write16(out,spread);
+			write32(out,fieldSize * 80);
+			write16(out,static_cast<int>(glyphs.size()));
+
+			for(std::size_t i = 0; i < glyphs.size(); ++i)
+			{
+				const Glyph &glyph = glyphs[i];
+				write32(out,static_cast<int>(glyph.codepoint));
+				write16(out,glyph.x);
+				write16(out,glyph.y);
+				write16(out,glyph.width);
+				write16(out,glyph.height);
+				write16(out,glyph.left);
+				write16(out,glyph.top);
+				write32(out,glyph.advance);
+			}
+
+			out.write(reinterpret_cast<const char*>(&pixels[0]),static_cast<std::streamsize>(pixels.size()));
+			return out.good();
+		}
+	private:
+		struct Glyph
+		{
+			unsigned int codepoint;
+			int x, y;
+			int width, height;
+			int left, top;
+			int advance;
+
+			// the shape, in the pixels of the glyph.
+			float x0, y0, x1, y1;
+			bool ring;
+		};
+
+		void addGlyph(unsigned int codepoint, int &x, int &y, int &row)
+		{
+			Glyph glyph;
+			glyph.codepoint = codepoint;
+			glyph.ring = codepoint >= ideographs;
+
+			// the space has no shape, only an advance.
+			int shapeWidth = 0, shapeHeight = 0;
+			if(glyph.ring)
+			{
+				shapeWidth = shapeHeight = fieldSize * 9 / 10;
+			}
+			else if(codepoint != ' ')
+			{
+				shapeWidth = fieldSize * (3 + static_cast<int>(codepoint % 4)) / 10;
+				shapeHeight = fieldSize * 7 / 10;
+			}
+
+			glyph.advance = (shapeWidth + fieldSize / 10) * 64;
+			if(codepoint == ' ')
+			{
+				glyph.advance = fieldSize * 64 / 3;
+			}
+
+			if(shapeWidth == 0)
+			{
+				glyph.x = glyph.y = glyph.width = glyph.height = 0;
+				glyph.left = glyph.top = 0;
+				glyphs.push_back(glyph);
+				return;
+			}
+
+			// the field reaches spread pixels beyond the shape.
+			glyph.width = shapeWidth + 2 * spread;
+			glyph.height = shapeHeight + 2 * spread;
+			glyph.left = -spread;
+			glyph.top = fieldSize - shapeHeight - spread;
+			glyph.x0 = static_cast<float>(spread);
+			glyph.y0 = static_cast<float>(spread);
+			glyph.x1 = static_cast<float>(spread + shapeWidth);
+			glyph.y1 = static_cast<float>(spread + shapeHeight);
+
+			if(x + glyph.width > width)
+			{
+				x = 0;
+				y += row;
+				row = 0;
+			}
+			glyph.x = x;
+			glyph.y = y;
+			x += glyph.width;
+			row = std::max(row,glyph.height);
+
+			glyphs.push_back(glyph);
+		}
+
+		/**
+		 * Returns the distance of x,y to the edge of a box,
+		 * positive inside.
+		 */
+		static float getBoxDistance(float x, float y, float x0, float y0, float x1, float y1)
+		{
+			if(x >= x0 && x <= x1 && y >= y0 && y <= y1)
+			{
+				return std::min(std::min(x - x0,x1 - x),std::min(y - y0,y1 - y));
+			}
+			float dx = std::max(std::max(x0 - x,x - x1),0.0f);
+			float dy = std::max(std::max(y0 - y,y - y1),0.0f);
+			return -std::sqrt(dx * dx + dy * dy);
+		}
+
+		void drawGlyph(const Glyph &glyph)
+		{
+			const float border = (glyph.x1 - glyph.x0) / 4.0f;
+
+			for(int y = 0; y < glyph.height; ++y)
+			{
+				for(int x = 0; x < glyph.width; ++x)
+				{
+					float px = x + 0.5f, py = y + 0.5f;
+					float distance = getBoxDistance(px,py,glyph.x0,glyph.y0,glyph.x1,glyph.y1);
+					if(glyph.ring)
+					{
+						distance = std::min(distance,-getBoxDistance(px,py,glyph.x0 + border,glyph.y0 + border,glyph.x1 - border,glyph.y1 - border));
+					}
+
+					float value = 128.0f + distance * 127.0f / spread;
+					pixels[(glyph.y + y) * width + glyph.x + x] = static_cast<unsigned char>(std::max(0.0f,std::min(255.0f,value)));
+				}
+			}
+		}
+
+		static void write16(std::ofstream &out, int value)
+		{
+			char bytes[2] = { static_cast<char>(value & 0xff), static_cast<char>((value >> 8) & 0xff) };
+			out.write(bytes,2);
+		}
+
+		static void write32(std::ofstream &out, int value)
+		{
+			write16(out,value & 0xffff);
+			write16(out,(value >> 16) & 0xffff);
+		}
+
+		int fieldSize, spread;
+		int width, height;
+		std::vector<Glyph> glyphs;
+		std::vector<unsigned char> pixels;
+	};
+}
+
+#endif
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "./DistanceFieldAtlas.h"
+#include "./OffscreenContext.h"
+#include "../Include/DistanceFieldFont.h"
+#include "../Include/util/Clock.h"
+#include "../Include/util/Utf8.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/**
+ * Writes a distance field atlas with DistanceFieldAtlas, loads it
+ * through DistanceFieldFontFactory and checks what was loaded, and
+ * that damaged files are refused. Then measures and draws Latin and
+ * CJK text at sizes from 8 to 128 pixels. All sizes share one atlas,
+ * which is uploaded before the first size, so the first string of a
+ * new size rasterizes nothing and the cost does not grow with the
+ * size. Drawing needs an OffscreenContext; without one only
+ * measuring is timed.
+ */
+
+static const char *atlasName = "DistanceFieldBenchmark.udf";
+static const char *damagedName = "DistanceFieldBenchmarkDamaged.udf";
+
+/**
+ * Writes the first size bytes of the atlas, with the first
+ * byte replaced if magic is false.
+ */
+static void writeDamaged(std::size_t size, bool magic)
+{
+	std::ifstream in(atlasName,std::ios::binary);
+	std::vector<char> data((std::istreambuf_iterator<char>(in)),std::istreambuf_iterator<char>());
+	data.resize(std::min(size,data.size()));
+	if(!magic && !data.empty())
+	{
+		data[0] = 'X';
+	}
+
+	std::ofstream out(damagedName,std::ios::binary);
+	out.write(&data[0],static_cast<std::streamsize>(data.size()));
+}
+
+static int check(const test::DistanceFieldAtlas &atlas)
+{
+	int errors = 0;
+
+	ui::DistanceFieldFontFactory factory;
+	if(!factory.addFace("Test",atlasName))
+	{
+		std::printf("the atlas does not load\n");
+		return 1;
+	}
+
+	const ui::DistanceFieldFace *face = factory.getFace("Test");
+	const unsigned int codepoints[] = { 'A', 'g', ' ', test::DistanceFieldAtlas::ideographs + 5 };
+	for(std::size_t i = 0; i < sizeof(codepoints) / sizeof(codepoints[0]); ++i)
+	{
+		if(face->getGlyph(codepoints[i]).advance != atlas.getAdvance(codepoints[i]))
+		{
+			std::printf("U+%04X advances %d, expected %d\n",codepoints[i],face->getGlyph(codepoints[i]).advance,atlas.getAdvance(codepoints[i]));
+			++errors;
+		}
+	}
+
+	// not in the atlas, drawn as a question mark.
+	if(face->getGlyph(0x5000).advance != atlas.getAdvance('?'))
+	{
+		std::printf("a missing glyph is not a question mark\n");
+		++errors;
+	}
+
+	ui::DistanceFieldFace damaged;
+	writeDamaged(1000,true);
+	if(damaged.load(damagedName))
+	{
+		std::printf("a truncated atlas loads\n");
+		++errors;
+	}
+	writeDamaged(static_cast<std::size_t>(-1),false);
+	if(damaged.load(damagedName))
+	{
+		std::printf("an atlas without magic loads\n");
+		++errors;
+	}
+	return errors;
+}
+
+int main()
+{
+	test::DistanceFieldAtlas atlas(32,4);
+	if(!atlas.write(atlasName))
+	{
+		std::printf("could not write %s\n",atlasName);
+		return 1;
+	}
+
+	int errors = check(atlas);
+
+	test::OffscreenContext offscreen(640,480);
+	const bool draw = offscreen.isValid();
+	if(draw)
+	{
+		offscreen.beginFrame();
+	}
+	else
+	{
+		std::printf("no OpenGL context, only measuring\n");
+	}
+
+	std::string latin("The quick brown fox jumps over the lazy dog");
+	std::string cjk;
+	for(unsigned int i = 0; i < 20; ++i)
+	{
+		ui::util::Utf8::encode(test::DistanceFieldAtlas::ideographs + i * 3,cjk);
+	}
+	const std::string mixed = latin + " " + cjk;
+
+	ui::DistanceFieldFontFactory factory;
+	factory.addFace("Test",atlasName);
+	if(draw)
+	{
+		factory.getFace("Test")->bind();
+	}
+
+	const int strings = 2000;
+	std::vector<int> advances;
+	for(std::size_t size = 8; size <= 128; size *= 2)
+	{
+		const double start = ui::util::Clock::getSeconds();
+		ui::Font *font = factory.createFont("Test",size);
+		int width = font->getStringBoundingBox(mixed).width;
+		if(draw)
+		{
+			font->drawString(0,0,mixed);
+		}
+		const double first = ui::util::Clock::getSeconds() - start;
+
+		const double measureStart = ui::util::Clock::getSeconds();
+		for(int i = 0; i < strings; ++i)
+		{
+			width += font->getStringBoundingBox(i % 2 == 0 ? latin : cjk).width;
+			font->getGlyphAdvances(mixed,advances);
+		}
+		const double measure = ui::util::Clock::getSeconds() - measureStart;
+
+		double paint = 0.0;
+		if(draw)
+		{
+			const double drawStart = ui::util::Clock::getSeconds();
+			for(int i = 0; i < strings; ++i)
+			{
+				font->drawString(0,(i % 20) * static_cast<int>(size),mixed);
+			}
+			glFinish();
+			paint = ui::util::Clock::getSeconds() - drawStart;
+		}
+
+		std::printf("%3lu px: first string %7.2f us, measure %6.2f us, draw %6.2f us per string (%d)\n",
+			static_cast<unsigned long>(size),first * 1e6,measure * 1e6 / strings,paint * 1e6 / strings,width);
+	}
+
+	std::remove(atlasName);
+	std::remove(damagedName);
+
+	std::printf("%d errors\n",errors);
+	return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./TestFont.h"
+#include "../Include/util/Clock.h"
+#include <cstdio>
+#include <vector>
+
+/**
+ * Measures the default Font::getGlyphAdvances on text of growing
+ * length. The Font counts the characters it is asked to measure,
+ * which should grow linearly with the length of the text.
+ */
+
+class CountingFont : public test::TestFont
+{
+public:
+	CountingFont()
+		:	test::TestFont("Counting",12),
+			measured(0)
+	{
+	}
+
+	ui::util::Dimension getStringBoundingBox(const std::string &text) const
+	{
+		measured += text.length();
+		return test::TestFont::getStringBoundingBox(text);
+	}
+
+	mutable std::size_t measured;
+};
+
+int main()
+{
+	CountingFont font;
+	std::vector<int> advances;
+
+	for(std::size_t length = 16; length <= 4096; length *= 4)
+	{
+		std::string text;
+		for(std::size_t i = 0; i < length; ++i)
+		{
+			text += static_cast<char>('a' + i % 26);
+		}
+
+		const int calls = static_cast<int>(65536 / length);
+
+		font.measured = 0;
+		const double start = ui::util::Clock::getSeconds();
+
+		for(int i = 0; i < calls; ++i)
+		{
+			font.getGlyphAdvances(text,advances);
+		}
+
+		const double elapsed = ui::util::Clock::getSeconds() - start;
+		std::printf("%5lu characters: %10.2f us per call, %6.2f characters measured per character\n",static_cast<unsigned long>(length),elapsed * 1e6 / calls,static_cast<double>(font.measured) / (static_cast<double>(length) * calls));
+	}
+	return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "./TestFont.h"
+#include "../Include/Gui.h"
+#include "../Include/component/Frame.h"
+#include "../Include/component/List.h"
+#include "../Include/component/ListModel.h"
+#include "../Include/component/ScrollPane.h"
+#include "../Include/component/Scrollbar.h"
+#include "../Include/util/Clock.h"
+#include <cstdio>
+
+/**
+ * Scrolls a List in a ScrollPane through models of a thousand to a
+ * million rows. Only the visible rows are laid out and painted, so
+ * the time per frame should stay the same however many rows there
+ * are; only setting the model up grows with them. Every frame jumps
+ * to another part of the List, so every frame shows rows which have
+ * not been measured before.
+ */
+
+class RowModel : public ui::AbstractListModel
+{
+public:
+	explicit RowModel(int r)
+		:	rows(r)
+	{
+	}
+
+	int getSize() const
+	{
+		return rows;
+	}
+
+	std::string getElementAt(int index) const
+	{
+		char text[32];
+		std::sprintf(text,"Row %d",index);
+		return text;
+	}
+private:
+	int rows;
+};
+
+static void run(int rows)
+{
+	test::TestFontFactory factory;
+	ui::Gui gui;
+	gui.setFontFactory(&factory);
+
+	RowModel model(rows);
+
+	const double setup = ui::util::Clock::getSeconds();
+	ui::List list(&model);
+	ui::ScrollPane scrollPane(&list);
+	ui::Frame frame(0,0,320,480);
+	frame.setContentPane(&scrollPane);
+	frame.setVisible(true);
+	gui.addFrame(&frame);
+	gui.paint();
+	const double ready = ui::util::Clock::getSeconds();
+
+	ui::Scrollbar *scrollbar = scrollPane.getVerticalScrollbar();
+	const int frames = 500;
+	for(int i = 0; i < frames; ++i)
+	{
+		// steps through the List out of order, by a prime.
+		scrollbar->setValue(static_cast<float>((i * 37) % 101));
+		gui.importUpdate(1.0f / 60.0f);
+		gui.paint();
+	}
+	const double elapsed = ui::util::Clock::getSeconds() - ready;
+
+	std::printf("%8d rows: setup %9.2f us, %8.2f us per frame\n",rows,(ready - setup) * 1e6,elapsed * 1e6 / frames);
+
+	gui.removeFrame(&frame);
+}
+
+int main()
+{
+	for(int rows = 1000; rows <= 1000000; rows *= 10)
+	{
+		run(rows);
+	}
+	return 0;
+}
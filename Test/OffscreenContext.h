@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OFFSCREENCONTEXT_H
+#define OFFSCREENCONTEXT_H
+
+#ifdef _MSC_VER
+#include <windows.h>
+#include <gl/gl.h>
+#include <gl/glu.h>
+#else
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GL/gl.h>
+#include <GL/glu.h>
+#endif
+
+namespace test
+{
+	/**
+	 * An OpenGL context which draws into a buffer nobody sees, so
+	 * tests can pick, which reads the picking image back, without a
+	 * window on screen. On Windows it belongs to a hidden window,
+	 * elsewhere it is an EGL pbuffer, on the surfaceless platform
+	 * of Mesa if there is no display. Where neither can be made
+	 * isValid returns false, and tests which need picking say so
+	 * and pass.
+	 * <p>
+	 * Link with opengl32 and glu32 on Windows, and with EGL, GL
+	 * and GLU elsewhere.
+	 * </p>
+	 */
+	class OffscreenContext
+	{
+	public:
+		OffscreenContext(int w, int h)
+			:	width(w),
+				height(h),
+				valid(false)
+		{
+#ifdef _MSC_VER
+			window = 0;
+			dc = 0;
+			context = 0;
+
+			WNDCLASSA windowClass;
+			ZeroMemory(&windowClass,sizeof(windowClass));
+			windowClass.style = CS_OWNDC;
+			windowClass.lpfnWndProc = DefWindowProcA;
+			windowClass.hInstance = GetModuleHandleA(0);
+			windowClass.lpszClassName = "OffscreenContext";
+			RegisterClassA(&windowClass);
+
+			// never shown, only the back buffer is drawn to.
+			window = CreateWindowA("OffscreenContext","",WS_POPUP,0,0,width,height,0,0,windowClass.hInstance,0);
+			if(window == 0)
+			{
+				return;
+			}
+			dc = GetDC(window);
+
+			PIXELFORMATDESCRIPTOR format;
+			ZeroMemory(&format,sizeof(format));
+			format.nSize = sizeof(format);
+			format.nVersion = 1;
+			format.dwFlags = PFD_DRAW_TO_WINDOW | PFD_SUPPORT_OPENGL | PFD_DOUBLEBUFFER;
+			format.iPixelType = PFD_TYPE_RGBA;
+			format.cColorBits = 24;
+			format.cDepthBits = 16;
+			int index = ChoosePixelFormat(dc,&format);
+			if(index == 0 || !SetPixelFormat(dc,index,&format))
+			{
+				return;
+			}
+
+			context = wglCreateContext(dc);
+			valid = context != 0 && wglMakeCurrent(dc,context) != FALSE;
+#else
+			surface = EGL_NO_SURFACE;
+			context = EGL_NO_CONTEXT;
+			display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+			if(display == EGL_NO_DISPLAY || !eglInitialize(display,0,0))
+			{
+				// without a display server, Mesa still renders.
+				PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+				display = (getPlatformDisplay != 0) ? getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA,EGL_DEFAULT_DISPLAY,0) : EGL_NO_DISPLAY;
+				if(display == EGL_NO_DISPLAY || !eglInitialize(display,0,0))
+				{
+					display = EGL_NO_DISPLAY;
+					return;
+				}
+			}
+
+			const EGLint attributes[] =
+			{
+				EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+				EGL_RED_SIZE, 8,
+				EGL_GREEN_SIZE, 8,
+				EGL_BLUE_SIZE, 8,
+				EGL_DEPTH_SIZE, 16,
+				EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+				EGL_NONE
+			};
+			EGLConfig config;
+			EGLint configs = 0;
+			if(!eglChooseConfig(display,attributes,&config,1,&configs) || configs == 0 || !eglBindAPI(EGL_OPENGL_API))
+			{
+				return;
+			}
+
+			const EGLint size[] = { EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE };
+			surface = eglCreatePbufferSurface(display,config,size);
+			context = eglCreateContext(display,config,EGL_NO_CONTEXT,0);
+			valid = surface != EGL_NO_SURFACE && context != EGL_NO_CONTEXT && eglMakeCurrent(display,surface,surface,context);
+#endif
+		}
+
+		~OffscreenContext()
+		{
+#ifdef _MSC_VER
+			if(context != 0)
+			{
+				wglMakeCurrent(0,0);
+				wglDeleteContext(context);
+			}
+			if(window != 0)
+			{
+				ReleaseDC(window,dc);
+				DestroyWindow(window);
+			}
+#else
+			if(display != EGL_NO_DISPLAY)
+			{
+				eglMakeCurrent(display,EGL_NO_SURFACE,EGL_NO_SURFACE,EGL_NO_CONTEXT);
+				if(context != EGL_NO_CONTEXT)
+				{
+					eglDestroyContext(display,context);
+				}
+				if(surface != EGL_NO_SURFACE)
+				{
+					eglDestroySurface(display,surface);
+				}
+				eglTerminate(display);
+			}
+#endif
+		}
+
+		/**
+		 * Returns true if the context was made and is current.
+		 */
+		bool isValid() const
+		{
+			return valid;
+		}
+
+		/**
+		 * Clears the buffer and sets up the projection the toolkit
+		 * draws in, 0,0 at the top left corner and one unit per
+		 * pixel. Call it before every Gui::paint, as an application
+		 * would before drawing its user interface.
+		 */
+		void beginFrame()
+		{
+			glViewport(0,0,width,height);
+			glMatrixMode(GL_PROJECTION);
+			glLoadIdentity();
+			gluOrtho2D(0,width,height,0);
+			glMatrixMode(GL_MODELVIEW);
+			glLoadIdentity();
+			glClearColor(0.0f,0.0f,0.0f,1.0f);
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		}
+	private:
+		OffscreenContext(const OffscreenContext &rhs);
+		OffscreenContext& operator=(const OffscreenContext &rhs);
+
+		int width, height;
+		bool valid;
+#ifdef _MSC_VER
+		HWND window;
+		HDC dc;
+		HGLRC context;
+#else
+		EGLDisplay display;
+		EGLSurface surface;
+		EGLContext context;
+#endif
+	};
+}
+
+#endif
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./TestFont.h"
+#include "./OffscreenContext.h"
+#include "../Include/Gui.h"
+#include "../Include/component/Frame.h"
+#include "../Include/component/Panel.h"
+#include "../Include/component/Button.h"
+#include "../Include/event/MouseListener.h"
+#include "../Include/util/Point.h"
+#include "../Include/util/Rectangle.h"
+#include <cstdio>
+#include <string>
+
+/**
+ * Checks that input is picked when it is dispatched, not before:
+ * an event which changes the Components has to be seen by the
+ * events after it in the same frame. One Button covers another,
+ * and moves away when the mouse enters it. A second pointer which
+ * arrives in the same frame has to enter the Button that was below.
+ * Also checks that a pointer other than the mouse can be at 0,0.
+ * Picking reads the picking image back, so this needs an
+ * OffscreenContext; without one the test says so and passes.
+ */
+
+class EnterLog : public ui::event::MouseAdapter
+{
+public:
+	EnterLog(std::string &entered, char name, ui::Component *moved)
+		:	log(entered),
+			id(name),
+			away(moved)
+	{
+	}
+
+	void mouseEntered(const ui::event::MouseEvent &e)
+	{
+		log += id;
+		if(away != 0)
+		{
+			away->setLocation(400,300);
+		}
+	}
+private:
+	std::string &log;
+	char id;
+	ui::Component *away;
+};
+
+int main()
+{
+	test::OffscreenContext offscreen(640,480);
+	if(!offscreen.isValid())
+	{
+		std::printf("no OpenGL context, nothing picked\n");
+		return 0;
+	}
+
+	test::TestFontFactory factory;
+	ui::Gui gui;
+	gui.setFontFactory(&factory);
+
+	ui::Frame frame(0,0,640,480);
+	ui::Panel content(0);
+	frame.setContentPane(&content);
+
+	// top is added last, so it is painted over bottom.
+	ui::Button bottom("Bottom");
+	ui::Button top("Top");
+	content.add(&bottom);
+	content.add(&top);
+	bottom.setBounds(100,100,120,60);
+	top.setBounds(100,100,120,60);
+
+	std::string entered;
+	EnterLog bottomLog(entered,'b',0);
+	EnterLog topLog(entered,'t',&top);
+	bottom.addMouseListener(&bottomLog);
+	top.addMouseListener(&topLog);
+
+	frame.setVisible(true);
+	gui.addFrame(&frame);
+
+	offscreen.beginFrame();
+	gui.paint();
+
+	const ui::util::Point location = top.getLocationOnScreen();
+	const int x = location.x + 60;
+	const int y = location.y + 30;
+
+	// both motions are dispatched in the same frame.
+	gui.importPointerMotion(0,x,y);
+	gui.importPointerMotion(1,x,y);
+	offscreen.beginFrame();
+	gui.paint();
+
+	int errors = 0;
+	if(entered != "tb")
+	{
+		std::printf("entered \"%s\", expected \"tb\"\n",entered.c_str());
+		++errors;
+	}
+
+	// a pointer other than the mouse may be at 0,0. The top
+	// Button is moved there, in the coordinates of its parent.
+	gui.importPointerRemoved(1);
+	offscreen.beginFrame();
+	gui.paint();
+	entered.clear();
+	top.setLocation(100 - location.x,100 - location.y);
+	gui.importPointerMotion(1,0,0);
+	offscreen.beginFrame();
+	gui.paint();
+	if(entered != "t")
+	{
+		std::printf("entered \"%s\" near 0,0, expected \"t\"\n",entered.c_str());
+		++errors;
+	}
+
+	gui.removeFrame(&frame);
+	content.removeAll();
+
+	std::printf("%d errors\n",errors);
+	return errors == 0 ? 0 : 1;
+}
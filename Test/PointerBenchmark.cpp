@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./TestFont.h"
+#include "../Include/Gui.h"
+#include "../Include/component/Frame.h"
+#include "../Include/component/Panel.h"
+#include "../Include/component/Button.h"
+#include "../Include/layout/GridLayout.h"
+#include "../Include/util/Clock.h"
+#include <cstdio>
+#include <vector>
+
+/**
+ * Measures the cost of input dispatch with 1 to 10 pointers
+ * moving every frame over a grid of Buttons, as on a touch
+ * screen. All pointers of a frame are picked in one pass, so the
+ * time should grow much slower than the number of pointers.
+ */
+
+int main()
+{
+	test::TestFontFactory factory;
+
+	ui::Gui gui;
+	gui.setFontFactory(&factory);
+
+	ui::Frame frame(0,0,800,600);
+	ui::Panel content;
+	content.setLayout(new ui::layout::GridLayout(10,10));
+	frame.setContentPane(&content);
+
+	std::vector<ui::Button*> buttons;
+	for(int i = 0; i < 100; ++i)
+	{
+		ui::Button *button = new ui::Button("Button");
+		buttons.push_back(button);
+		content.add(button);
+	}
+	gui.addFrame(&frame);
+
+	const int frames = 2000;
+
+	for(int pointers = 1; pointers <= 10; ++pointers)
+	{
+		const double start = ui::util::Clock::getSeconds();
+		std::size_t picks = 0;
+
+		for(int i = 0; i < frames; ++i)
+		{
+			for(int p = 0; p < pointers; ++p)
+			{
+				// every pointer moves on a line of its own.
+				gui.importPointerMotion(p,1 + (i * 7 + p * 79) % 799,1 + p * 60);
+			}
+			gui.paint();
+			picks += gui.getInputStatistics().picks;
+		}
+
+		const double elapsed = ui::util::Clock::getSeconds() - start;
+		std::printf("%2d pointers: %8.2f us per frame, %lu picks\n",pointers,elapsed * 1e6 / frames,static_cast<unsigned long>(picks));
+	}
+
+	content.removeAll();
+	for(std::size_t i = 0; i < buttons.size(); ++i)
+	{
+		delete buttons[i];
+	}
+	return 0;
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "../Include/PostQueue.h"
+#include "../Include/InputQueue.h"
+#include "../Include/util/Command.h"
+#include <cstdio>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * Posts from several threads at once while the main thread takes,
+ * and checks that every post arrives exactly once and that the
+ * posts of each thread arrive in the order they were made. Input
+ * events and commands are mixed; a command pushes a marker into
+ * the InputQueue, so both end up in one stream.
+ */
+
+static const int producers = 4;
+static const int posts = 200000;
+
+class Marker : public ui::util::Command
+{
+public:
+	Marker(ui::InputQueue &queue, int producer, int sequence)
+		:	input(queue)
+	{
+		marker.type = ui::InputEvent::KEY_RELEASED;
+		marker.pointer = producer;
+		marker.keyCode = sequence;
+	}
+
+	void execute()
+	{
+		input.push(marker);
+	}
+private:
+	ui::InputQueue &input;
+	ui::InputEvent marker;
+};
+
+class Producer
+{
+public:
+	ui::PostQueue *queue;
+	ui::InputQueue *input;
+	int id;
+
+	void run()
+	{
+		for(int i = 0; i < posts; ++i)
+		{
+			if(i % 3 == 0)
+			{
+				queue->post(new Marker(*input,id,i));
+			}
+			else
+			{
+				ui::InputEvent e;
+				e.type = ui::InputEvent::KEY_PRESSED;
+				e.pointer = id;
+				e.keyCode = i;
+				queue->post(e);
+			}
+
+			// give the consumer a chance now and then, so it takes
+			// while the others are posting.
+			if(i % 256 == 0)
+			{
+#ifdef _MSC_VER
+				Sleep(0);
+#else
+				sched_yield();
+#endif
+			}
+		}
+	}
+};
+
+#ifdef _MSC_VER
+static DWORD WINAPI produce(LPVOID producer)
+{
+	static_cast<Producer*>(producer)->run();
+	return 0;
+}
+#else
+static void * produce(void *producer)
+{
+	static_cast<Producer*>(producer)->run();
+	return 0;
+}
+#endif
+
+int main()
+{
+	ui::PostQueue queue;
+	ui::InputQueue input;
+
+	Producer producer[producers];
+#ifdef _MSC_VER
+	HANDLE threads[producers];
+#else
+	pthread_t threads[producers];
+#endif
+
+	for(int i = 0; i < producers; ++i)
+	{
+		producer[i].queue = &queue;
+		producer[i].input = &input;
+		producer[i].id = i;
+#ifdef _MSC_VER
+		threads[i] = CreateThread(0,0,produce,&producer[i],0,0);
+#else
+		pthread_create(&threads[i],0,produce,&producer[i]);
+#endif
+	}
+
+	std::vector<int> expected(producers,0);
+	ui::InputEventList events;
+	int received = 0;
+	int errors = 0;
+	int takes = 0;
+
+	while(received < producers * posts && errors == 0)
+	{
+		if(queue.take(input,0.0f) != 0)
+		{
+			++takes;
+		}
+
+		input.drain(events);
+		for(std::size_t i = 0; i < events.size(); ++i)
+		{
+			const ui::InputEvent &e = events[i];
+
+			if(e.pointer < 0 || e.pointer >= producers || e.keyCode != expected[e.pointer])
+			{
+				std::printf("producer %d: post %d arrived, expected %d\n",e.pointer,e.keyCode,(e.pointer >= 0 && e.pointer < producers) ? expected[e.pointer] : -1);
+				++errors;
+				break;
+			}
+
+			// commands and events alternate in a fixed pattern.
+			bool command = (e.keyCode % 3 == 0);
+			if(command != (e.type == ui::InputEvent::KEY_RELEASED))
+			{
+				std::printf("producer %d: post %d arrived as the wrong kind\n",e.pointer,e.keyCode);
+				++errors;
+				break;
+			}
+			++expected[e.pointer];
+			++received;
+		}
+		events.clear();
+	}
+
+	for(int i = 0; i < producers; ++i)
+	{
+#ifdef _MSC_VER
+		WaitForSingleObject(threads[i],INFINITE);
+		CloseHandle(threads[i]);
+#else
+		pthread_join(threads[i],0);
+#endif
+	}
+
+	// nothing may arrive after the last post.
+	if(errors == 0 && queue.take(input,0.0f) != 0)
+	{
+		std::printf("posts arrived twice\n");
+		++errors;
+	}
+
+	std::printf("%d posts from %d threads in %d takes, %d errors\n",received,producers,takes,errors);
+	return errors == 0 ? 0 : 1;
+}
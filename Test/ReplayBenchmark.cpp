@@ -0,0 +1,588 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "./TestFont.h"
+#include "./OffscreenContext.h"
+#include "../Include/Gui.h"
+#include "../Include/InputLog.h"
+#include "../Include/UiContext.h"
+#include "../Include/component/Frame.h"
+#include "../Include/component/Dialog.h"
+#include "../Include/component/Panel.h"
+#include "../Include/component/TextField.h"
+#include "../Include/component/ToggleButton.h"
+#include "../Include/component/Menu.h"
+#include "../Include/component/MenuBar.h"
+#include "../Include/component/MenuItem.h"
+#include "../Include/component/List.h"
+#include "../Include/component/ListModel.h"
+#include "../Include/component/ScrollPane.h"
+#include "../Include/component/Scrollbar.h"
+#include "../Include/component/TitleBar.h"
+#include "../Include/layout/BorderLayout.h"
+#include "../Include/layout/GridLayout.h"
+#include "../Include/event/KeyEvent.h"
+#include "../Include/event/MouseEvent.h"
+#include "../Include/event/MouseListener.h"
+#include "../Include/util/Point.h"
+#include "../Include/util/Rectangle.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Replays canned InputLogs against a fixed user interface and
+ * prints the mean time of the parts of a frame for each of them.
+ * Every scenario is recorded through Gui::setInputLog, saved and
+ * loaded again, and replayed on a new copy of the interface, which
+ * has to end up in the same state as the one it was recorded on.
+ * The frames are painted into an OffscreenContext, so input is
+ * picked and dispatched as it would be on screen; without one the
+ * benchmark says so and passes.
+ * <p>
+ * With -save the canned logs are also written to the current
+ * directory, and logs passed by file name are replayed instead of
+ * the canned ones, so two builds can be compared on the same input.
+ * </p>
+ */
+
+namespace
+{
+	const float delta = 1.0f / 60.0f;
+	const int screenWidth = 1024;
+	const int screenHeight = 600;
+
+	/**
+	 * Ten thousand numbered rows.
+	 */
+	class RowModel : public ui::AbstractListModel
+	{
+	public:
+		int getSize() const
+		{
+			return 10000;
+		}
+
+		std::string getElementAt(int index) const
+		{
+			char text[32];
+			std::sprintf(text,"Row %d",index);
+			return text;
+		}
+	};
+
+	/**
+	 * Writes the label of every MenuItem clicked to a string.
+	 */
+	class MenuLog : public ui::event::MouseAdapter
+	{
+	public:
+		void mouseClicked(const ui::event::MouseEvent &e)
+		{
+			chosen += static_cast<const ui::MenuItem*>(e.getSource())->getText();
+			chosen += ',';
+		}
+
+		std::string chosen;
+	};
+
+	/**
+	 * A Frame with a MenuBar, a TextField above a grid of
+	 * ToggleButtons and a List of many rows in a ScrollPane, and a
+	 * Dialog beside it. Every Workbench has its own UiContext, so
+	 * focus and hover state do not carry over from one run to the
+	 * next.
+	 */
+	class Workbench
+	{
+	public:
+		Workbench(test::OffscreenContext &offscreen, test::TestFontFactory &factory)
+			:	screen(offscreen),
+				gui(context)
+		{
+			ui::UiContext::Scope scope(context);
+			gui.setFontFactory(&factory);
+
+			frame = new ui::Frame(0,0,640,480);
+			content = new ui::Panel();
+			content->setLayout(new ui::layout::BorderLayout());
+			grid = new ui::Panel();
+			grid->setLayout(new ui::layout::GridLayout(8,8));
+			field = new ui::TextField();
+			list = new ui::List(&rows);
+			scrollPane = new ui::ScrollPane(list);
+
+			for(int i = 0; i < 64; ++i)
+			{
+				ui::ToggleButton *button = new ui::ToggleButton("Toggle");
+				buttons.push_back(button);
+				grid->add(button);
+			}
+			content->add(field,ui::layout::BorderLayout::NORTH);
+			content->add(grid,ui::layout::BorderLayout::CENTER);
+			content->add(scrollPane,ui::layout::BorderLayout::EAST);
+			frame->setContentPane(content);
+
+			menuBar = new ui::MenuBar();
+			const char *names[] = { "File", "Edit", "View" };
+			for(int i = 0; i < 3; ++i)
+			{
+				ui::Menu *menu = new ui::Menu(names[i]);
+				menus.push_back(menu);
+				menuBar->add(menu);
+				for(int j = 0; j < 6; ++j)
+				{
+					char text[16];
+					std::sprintf(text,"%s %d",names[i],j);
+					ui::MenuItem *item = new ui::MenuItem(text);
+					item->addMouseListener(&menuLog,ui::event::MouseEvent::MOUSE_CLICKED_MASK);
+					items.push_back(item);
+					menu->add(item);
+				}
+			}
+			frame->setMenuBar(menuBar);
+			frame->setVisible(true);
+			gui.addFrame(frame);
+
+			dialog = new ui::Dialog(frame,"Dialog");
+			dialog->setBounds(700,40,240,160);
+			dialog->show();
+
+			// lays the interface out, so the scenarios can aim.
+			paint();
+		}
+
+		~Workbench()
+		{
+			ui::UiContext::Scope scope(context);
+			gui.removeFrame(frame);
+			frame->removeOwnedWindows();
+			grid->removeAll();
+			content->removeAll();
+			for(std::size_t i = 0; i < menus.size(); ++i)
+			{
+				menuBar->remove(menus[i]);
+			}
+			for(std::size_t i = 0; i < items.size(); ++i)
+			{
+				delete items[i];
+			}
+			for(std::size_t i = 0; i < menus.size(); ++i)
+			{
+				delete menus[i];
+			}
+			for(std::size_t i = 0; i < buttons.size(); ++i)
+			{
+				delete buttons[i];
+			}
+			delete dialog;
+			delete menuBar;
+			delete scrollPane;
+			delete list;
+			delete field;
+			delete grid;
+			delete content;
+			delete frame;
+		}
+
+		/**
+		 * Returns the text of the field, which buttons are
+		 * selected, the MenuItems chosen, where the Dialog is and
+		 * how far the List is scrolled, the same for the same input.
+		 */
+		std::string getState() const
+		{
+			std::string state = field->getText() + ":";
+			for(std::size_t i = 0; i < buttons.size(); ++i)
+			{
+				state += buttons[i]->isSelected() ? '1' : '0';
+			}
+
+			char text[64];
+			const ui::util::Point location = dialog->getLocationOnScreen();
+			std::sprintf(text,":%d,%d:%.1f",location.x,location.y,scrollPane->getVerticalScrollbar()->getValue());
+			return state + ":" + menuLog.chosen + text;
+		}
+
+		/**
+		 * Moves the mouse to x,y in c.
+		 */
+		void moveTo(const ui::Component *c, int x, int y)
+		{
+			ui::UiContext::Scope scope(context);
+			const ui::util::Point location = c->getLocationOnScreen();
+			gui.importMouseMotion(location.x + x,location.y + y);
+		}
+
+		/**
+		 * Moves the mouse to the center of c.
+		 */
+		void moveTo(const ui::Component *c)
+		{
+			moveTo(c,c->getBounds().width / 2,c->getBounds().height / 2);
+		}
+
+		/**
+		 * Presses and releases button, a frame each.
+		 */
+		void click(int button = ui::event::MouseEvent::MOUSE_BUTTON1)
+		{
+			gui.importMousePressed(button);
+			step();
+			gui.importMouseReleased(button);
+			step();
+		}
+
+		/**
+		 * Ends a frame of the scenario.
+		 */
+		void step()
+		{
+			gui.importUpdate(delta);
+			paint();
+		}
+
+		/**
+		 * Paints into the OffscreenContext.
+		 */
+		void paint()
+		{
+			screen.beginFrame();
+			gui.paint();
+		}
+
+		test::OffscreenContext &screen;
+		ui::UiContext context;
+		ui::Gui gui;
+		ui::Frame *frame;
+		ui::Dialog *dialog;
+		ui::Panel *content, *grid;
+		ui::TextField *field;
+		ui::List *list;
+		ui::ScrollPane *scrollPane;
+		ui::MenuBar *menuBar;
+		std::vector<ui::Menu*> menus;
+		std::vector<ui::MenuItem*> items;
+		std::vector<ui::ToggleButton*> buttons;
+		RowModel rows;
+		MenuLog menuLog;
+	private:
+		Workbench(const Workbench&);
+		Workbench& operator=(const Workbench&);
+	};
+
+	/**
+	 * The mouse sweeps over the grid without pressing.
+	 */
+	void hover(Workbench &bench)
+	{
+		for(int i = 0; i < 600; ++i)
+		{
+			int x = (i * 7) % 640;
+			int y = 40 + (i * 3) % 440;
+			bench.gui.importMouseMotion(x,y);
+			bench.step();
+		}
+	}
+
+	/**
+	 * Every button is clicked once, with the second mouse button,
+	 * which is the one a ToggleButton toggles on.
+	 */
+	void click(Workbench &bench)
+	{
+		for(std::size_t i = 0; i < bench.buttons.size(); ++i)
+		{
+			bench.moveTo(bench.buttons[i]);
+			bench.step();
+			bench.click(ui::event::MouseEvent::MOUSE_BUTTON2);
+		}
+	}
+
+	/**
+	 * A sentence is typed into the field, with a few mistakes
+	 * taken back.
+	 */
+	void typing(Workbench &bench)
+	{
+		bench.moveTo(bench.field);
+		bench.step();
+		bench.click();
+
+		const char *text = "the quick brown fxo\b\box jumps over the lazy dog";
+		for(const char *c = text; *c != 0; ++c)
+		{
+			if(*c == '\b')
+			{
+				bench.gui.importKeyPressed(ui::event::KeyEvent::VKUI_BACKSPACE,0);
+				bench.step();
+				bench.gui.importKeyReleased(ui::event::KeyEvent::VKUI_BACKSPACE,0);
+			}
+			else
+			{
+				bench.gui.importKeyPressed(*c,0,static_cast<unsigned char>(*c));
+				bench.step();
+				bench.gui.importKeyReleased(*c,0);
+			}
+			bench.step();
+		}
+	}
+
+	/**
+	 * A Menu is opened, the mouse runs over its items and those of
+	 * the Menus beside it, and one of them is chosen. Every item is
+	 * chosen once.
+	 */
+	void menu(Workbench &bench)
+	{
+		for(std::size_t i = 0; i < bench.items.size(); ++i)
+		{
+			bench.moveTo(bench.menus[0]);
+			bench.step();
+			bench.click();
+
+			for(std::size_t m = 0; m < bench.menus.size(); ++m)
+			{
+				bench.moveTo(bench.menus[m]);
+				bench.step();
+				for(std::size_t j = 0; j < 6; ++j)
+				{
+					bench.moveTo(bench.items[m * 6 + j]);
+					bench.step();
+				}
+			}
+
+			const std::size_t m = i / 6;
+			bench.moveTo(bench.menus[m]);
+			bench.step();
+			bench.moveTo(bench.items[i]);
+			bench.step();
+			bench.click();
+		}
+	}
+
+	/**
+	 * The Dialog is dragged by its TitleBar around a circle of
+	 * sorts, and let go again, a few times.
+	 */
+	void drag(Workbench &bench)
+	{
+		for(int i = 0; i < 4; ++i)
+		{
+			ui::util::Point start = bench.dialog->getTitleBar()->getLocationOnScreen();
+			start += ui::util::Point(8,4);
+			bench.gui.importMouseMotion(start.x,start.y);
+			bench.step();
+			bench.gui.importMousePressed(ui::event::MouseEvent::MOUSE_BUTTON1);
+			bench.step();
+
+			for(int j = 0; j < 120; ++j)
+			{
+				const int x = j < 60 ? j : 120 - j;
+				const int y = (j * 3) % 40;
+				bench.gui.importMouseMotion(start.x - x * 4,start.y + y + i * 10);
+				bench.step();
+			}
+
+			bench.gui.importMouseReleased(ui::event::MouseEvent::MOUSE_BUTTON1);
+			bench.step();
+		}
+	}
+
+	/**
+	 * The buttons of the vertical Scrollbar are held down, to the
+	 * end of the List and back a few times.
+	 */
+	void scroll(Workbench &bench)
+	{
+		ui::Scrollbar *scrollbar = bench.scrollPane->getVerticalScrollbar();
+		for(int i = 0; i < 5; ++i)
+		{
+			ui::Button *button = i % 2 == 0 ? scrollbar->getIncrementButton() : scrollbar->getDecrementButton();
+			bench.moveTo(button);
+			bench.step();
+			bench.gui.importMousePressed(ui::event::MouseEvent::MOUSE_BUTTON1);
+			for(int j = 0; j < 40; ++j)
+			{
+				bench.step();
+			}
+			bench.gui.importMouseReleased(ui::event::MouseEvent::MOUSE_BUTTON1);
+			bench.step();
+		}
+	}
+
+	struct Scenario
+	{
+		const char *name;
+		void (*run)(Workbench &bench);
+	};
+
+	const Scenario scenarios[] =
+	{
+		{ "hover", &hover },
+		{ "click", &click },
+		{ "typing", &typing },
+		{ "menu", &menu },
+		{ "drag", &drag },
+		{ "scroll", &scroll }
+	};
+
+	/**
+	 * Replays log on a new Workbench, prints the timings and
+	 * returns the state it ends up in.
+	 */
+	std::string replay(test::OffscreenContext &offscreen, test::TestFontFactory &factory, const std::string &name, const ui::InputLog &log)
+	{
+		Workbench bench(offscreen,factory);
+		bench.gui.setProfiling(true);
+
+		// InputLog::replay paints every frame, the projection set
+		// here stays for all of them.
+		ui::FrameTimingList timings;
+		offscreen.beginFrame();
+		log.replay(bench.gui,&timings);
+
+		ui::FrameTiming sum;
+		for(std::size_t i = 0; i < timings.size(); ++i)
+		{
+			sum.layout += timings[i].layout;
+			sum.picking += timings[i].picking;
+			sum.text += timings[i].text;
+			sum.paint += timings[i].paint;
+			sum.total += timings[i].total;
+		}
+
+		const double scale = timings.empty() ? 0.0 : 1e6 / timings.size();
+		std::printf("%-12s %5lu frames, us per frame: layout %7.2f picking %7.2f text %7.2f paint %7.2f total %7.2f\n",
+			name.c_str(),static_cast<unsigned long>(timings.size()),
+			sum.layout * scale,sum.picking * scale,sum.text * scale,sum.paint * scale,sum.total * scale);
+
+		return bench.getState();
+	}
+}
+
+int main(int argc, char **argv)
+{
+	test::OffscreenContext offscreen(screenWidth,screenHeight);
+	if(!offscreen.isValid())
+	{
+		std::printf("no OpenGL context, nothing picked\n");
+		return 0;
+	}
+
+	test::TestFontFactory factory;
+	bool save = false;
+	std::vector<std::string> files;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(std::strcmp(argv[i],"-save") == 0)
+		{
+			save = true;
+		}
+		else
+		{
+			files.push_back(argv[i]);
+		}
+	}
+
+	int errors = 0;
+
+	if(!files.empty())
+	{
+		for(std::size_t i = 0; i < files.size(); ++i)
+		{
+			ui::InputLog log;
+			std::ifstream in(files[i].c_str(),std::ios::binary);
+			if(!log.load(in))
+			{
+				std::printf("%s is not an input log\n",files[i].c_str());
+				++errors;
+				continue;
+			}
+			replay(offscreen,factory,files[i],log);
+		}
+		return errors == 0 ? 0 : 1;
+	}
+
+	for(std::size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); ++i)
+	{
+		const Scenario &scenario = scenarios[i];
+
+		ui::InputLog recorded;
+		std::string expected, initial;
+		{
+			Workbench bench(offscreen,factory);
+			initial = bench.getState();
+			bench.gui.setInputLog(&recorded);
+			scenario.run(bench);
+			bench.gui.setInputLog(0);
+			expected = bench.getState();
+		}
+
+		// hovering changes nothing that is kept, the others must.
+		if(expected == initial && std::strcmp(scenario.name,"hover") != 0)
+		{
+			std::printf("%s: the scenario changes nothing\n",scenario.name);
+			++errors;
+		}
+
+		// through the binary form, as a log from a file would be.
+		std::stringstream stream;
+		ui::InputLog log;
+		if(!recorded.save(stream) || !log.load(stream) || log.size() != recorded.size())
+		{
+			std::printf("%s: the log does not load again\n",scenario.name);
+			++errors;
+			continue;
+		}
+
+		if(save)
+		{
+			std::string fileName = std::string(scenario.name) + ".uilg";
+			std::ofstream out(fileName.c_str(),std::ios::binary);
+			if(!log.save(out))
+			{
+				std::printf("%s: could not write %s\n",scenario.name,fileName.c_str());
+				++errors;
+			}
+		}
+
+		const std::string state = replay(offscreen,factory,scenario.name,log);
+		if(state != expected)
+		{
+			std::printf("%s: replayed into %s\n%s: recorded into %s\n",scenario.name,state.c_str(),scenario.name,expected.c_str());
+			++errors;
+		}
+	}
+
+	return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "./TestFont.h"
+#include "../Include/Gui.h"
+#include "../Include/component/Frame.h"
+#include "../Include/component/Table.h"
+#include "../Include/component/TableModel.h"
+#include "../Include/component/TableSorter.h"
+#include "../Include/component/ScrollPane.h"
+#include "../Include/component/Scrollbar.h"
+#include "../Include/util/Clock.h"
+#include <cstdio>
+
+/**
+ * Scrolls a Table of 100000 rows and 20 columns in a ScrollPane,
+ * up and down and sideways, straight from the model and through a
+ * TableSorter. Only the visible cells are asked for their value,
+ * measured and painted, so a frame costs about the same anywhere
+ * in the Table.
+ */
+
+static const int rowCount = 100000;
+static const int columnCount = 20;
+
+class GridModel : public ui::AbstractTableModel
+{
+public:
+	int getRowCount() const
+	{
+		return rowCount;
+	}
+
+	int getColumnCount() const
+	{
+		return columnCount;
+	}
+
+	void getValueAt(int row, int column, std::string &value) const
+	{
+		char text[32];
+		std::sprintf(text,"%d.%d",(row * 7919) % rowCount,column);
+		value = text;
+	}
+};
+
+static void run(const char *name, ui::Gui &gui, ui::TableModel *model)
+{
+	ui::Table table(model);
+	ui::ScrollPane scrollPane(&table);
+	ui::Frame frame(0,0,800,600);
+	frame.setContentPane(&scrollPane);
+	frame.setVisible(true);
+	gui.addFrame(&frame);
+	gui.paint();
+
+	ui::Scrollbar *vertical = scrollPane.getVerticalScrollbar();
+	ui::Scrollbar *horizontal = scrollPane.getHorizontalScrollbar();
+
+	const int frames = 1000;
+	const double start = ui::util::Clock::getSeconds();
+	for(int i = 0; i < frames; ++i)
+	{
+		// down in steps of a few rows, and jumping now and then.
+		vertical->setValue(i % 50 == 0 ? static_cast<float>((i * 37) % 101) : vertical->getValue() + 0.01f);
+		horizontal->setValue(static_cast<float>((i * 3) % 101));
+		gui.importUpdate(1.0f / 60.0f);
+		gui.paint();
+	}
+	const double elapsed = ui::util::Clock::getSeconds() - start;
+
+	std::printf("%s: %8.2f us per frame\n",name,elapsed * 1e6 / frames);
+
+	gui.removeFrame(&frame);
+}
+
+int main()
+{
+	test::TestFontFactory factory;
+	ui::Gui gui;
+	gui.setFontFactory(&factory);
+
+	GridModel model;
+	run("model ",gui,&model);
+
+	ui::TableSorter sorter(&model);
+	const double start = ui::util::Clock::getSeconds();
+	sorter.setSortColumn(3);
+	std::printf("sorting %d rows: %8.2f ms\n",rowCount,(ui::util::Clock::getSeconds() - start) * 1e3);
+	run("sorted",gui,&sorter);
+	return 0;
+}
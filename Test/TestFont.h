@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TESTFONT_H
+#define TESTFONT_H
+
+#include "../Include/Font.h"
+#include "../Include/GlyphContext.h"
+#include <string>
+
+namespace test
+{
+	/**
+	 * A Font with fixed metrics, so the tests run without a font
+	 * engine. Every character is 7 pixels wide, except 'W' and 'M'.
+	 */
+	class TestFont : public ui::Font
+	{
+	public:
+		TestFont(const std::string &fontName, std::size_t fontSize)
+			:	name(fontName),
+				size(fontSize)
+		{
+		}
+
+		const std::string getFontName() const
+		{
+			return name;
+		}
+
+		std::size_t getSize() const
+		{
+			return size;
+		}
+
+		ui::util::Dimension getStringBoundingBox(const std::string &text) const
+		{
+			int width = 0;
+			for(std::size_t i = 0; i < text.length(); ++i)
+			{
+				width += getAdvance(text[i]);
+			}
+			return ui::util::Dimension(width,static_cast<int>(size));
+		}
+
+		void drawString(int x, int y, const std::string &text)
+		{
+		}
+
+		static int getAdvance(char c)
+		{
+			return (c == 'W' || c == 'M') ? 11 : 7;
+		}
+	private:
+		std::string name;
+		std::size_t size;
+	};
+
+	class TestFontFactory : public ui::AbstractFontFactory
+	{
+	public:
+		ui::Font * createFont(const std::string &name, std::size_t size)
+		{
+			return new TestFont(name,size);
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "./TestFont.h"
+#include "../Include/Gui.h"
+#include "../Include/Graphics.h"
+#include "../Include/component/Frame.h"
+#include "../Include/component/Panel.h"
+#include "../Include/component/Label.h"
+#include "../Include/layout/GridLayout.h"
+#include "../Include/util/Clock.h"
+#include <cstdio>
+#include <vector>
+
+/**
+ * Measures batched text with Labels side by side, where all text
+ * is drawn with one call per page, and with Labels stacked on top
+ * of each other, where the text of a Label has to be drawn before
+ * the next Label covers it. Every Label paints an opaque background,
+ * so the stacked case needs a draw per Label. The dense case has so
+ * many strings queued that it shows what finding overlaps costs.
+ */
+
+class BitmapFont : public test::TestFont
+{
+public:
+	BitmapFont(const std::string &name, std::size_t size)
+		:	test::TestFont(name,size)
+	{
+	}
+
+	bool getGlyphBitmap(unsigned int codepoint, ui::GlyphBitmap &bitmap) const
+	{
+		bitmap.width = getAdvance(static_cast<char>(codepoint)) - 1;
+		bitmap.height = static_cast<int>(getSize());
+		bitmap.left = 0;
+		bitmap.top = 0;
+		bitmap.pixels.assign(bitmap.width * bitmap.height,255);
+		return true;
+	}
+};
+
+class BitmapFontFactory : public ui::AbstractFontFactory
+{
+public:
+	ui::Font * createFont(const std::string &name, std::size_t size)
+	{
+		return new BitmapFont(name,size);
+	}
+};
+
+static void run(const char *name, ui::Frame &frame)
+{
+	ui::Graphics g;
+	const int frames = 1000;
+
+	// the first frame packs the glyphs.
+	g.beginFrame();
+	frame.paint(g);
+	g.flush();
+
+	std::size_t draws = g.getGlyphAtlas().getTotalDrawCount();
+	const double start = ui::util::Clock::getSeconds();
+
+	for(int i = 0; i < frames; ++i)
+	{
+		g.beginFrame();
+		frame.paint(g);
+		g.flush();
+	}
+
+	const double elapsed = ui::util::Clock::getSeconds() - start;
+	draws = g.getGlyphAtlas().getTotalDrawCount() - draws;
+	std::printf("%s: %8.2f us per frame, %6.2f text draw calls per frame\n",name,elapsed * 1e6 / frames,static_cast<double>(draws) / frames);
+}
+
+int main()
+{
+	BitmapFontFactory factory;
+
+	ui::Gui gui;
+	gui.setFontFactory(&factory);
+
+	ui::Frame grid(0,0,800,600);
+	ui::Panel gridContent;
+	gridContent.setLayout(new ui::layout::GridLayout(10,10));
+	grid.setContentPane(&gridContent);
+
+	ui::Frame stack(0,0,800,600);
+	ui::Panel stackContent(0);
+	stack.setContentPane(&stackContent);
+
+	// enough strings that looking for overlaps one by one would
+	// cost more than painting them.
+	ui::Frame dense(0,0,2560,1280);
+	ui::Panel denseContent;
+	denseContent.setLayout(new ui::layout::GridLayout(40,40));
+	dense.setContentPane(&denseContent);
+
+	std::vector<ui::Label*> labels;
+	for(int i = 0; i < 1600; ++i)
+	{
+		ui::Label *label = new ui::Label("Label");
+		labels.push_back(label);
+		denseContent.add(label);
+	}
+
+	for(int i = 0; i < 100; ++i)
+	{
+		ui::Label *label = new ui::Label("Label");
+		labels.push_back(label);
+		gridContent.add(label);
+
+		// every Label covers half of the one before it.
+		label = new ui::Label("Label");
+		labels.push_back(label);
+		stackContent.add(label);
+		label->setBounds(i * 6,i * 6,80,32);
+	}
+	gui.addFrame(&grid);
+	gui.addFrame(&stack);
+	gui.addFrame(&dense);
+	grid.setVisible(true);
+	stack.setVisible(true);
+	dense.setVisible(true);
+	grid.validate();
+	stack.validate();
+	dense.validate();
+
+	run("side by side",grid);
+	run("stacked     ",stack);
+	run("dense       ",dense);
+
+	gridContent.removeAll();
+	stackContent.removeAll();
+	denseContent.removeAll();
+	for(std::size_t i = 0; i < labels.size(); ++i)
+	{
+		delete labels[i];
+	}
+	return 0;
+}
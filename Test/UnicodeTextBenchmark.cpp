@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2003-2006, Bram Stein
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without 
+ * modification, are permitted provided that the following conditions 
+ * are met:
+ * 
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ *  2. Redistributions in binary form must reproduce the above copyright 
+ *     notice, this list of conditions and the following disclaimer in the 
+ *     documentation and/or other materials provided with the distribution. 
+ *  3. The name of the author may not be used to endorse or promote products 
+ *     derived from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED 
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO 
+ * EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, 
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY 
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING 
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "./DistanceFieldAtlas.h"
+#include "../Include/DistanceFieldFont.h"
+#include "../Include/GlyphContext.h"
+#include "../Include/theme/MeasuredText.h"
+#include "../Include/theme/TextUtil.h"
+#include "../Include/util/Clock.h"
+#include "../Include/util/DecodedText.h"
+#include "../Include/util/Utf8.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * Measures text in several scripts, each about 4 KB of UTF-8:
+ * ASCII, accented Latin, CJK ideographs, and a mix of Latin words,
+ * ideographs, combining marks and emoji sequences. For each it
+ * times decoding into a DecodedText, asking it again with the same
+ * revision, which should cost nothing, the glyph advances of a
+ * DistanceFieldFont, measuring a MeasuredText and wrapping that to
+ * a width. The times are per KB, so the scripts can be compared even
+ * though their characters take one to four bytes.
+ */
+
+static const char *atlasName = "UnicodeTextBenchmark.udf";
+
+static std::string repeat(const std::string &pattern, std::size_t size)
+{
+	std::string text;
+	while(text.length() < size)
+	{
+		text += pattern;
+	}
+	return text;
+}
+
+static std::string encode(const unsigned int *codepoints, std::size_t count)
+{
+	std::string text;
+	for(std::size_t i = 0; i < count; ++i)
+	{
+		ui::util::Utf8::encode(codepoints[i],text);
+	}
+	return text;
+}
+
+static void run(const char *name, const std::string &text, ui::GlyphContext &glyphs, ui::Font *font)
+{
+	const int calls = 200;
+	const double kb = text.length() / 1024.0;
+
+	ui::util::DecodedText decoded;
+	double start = ui::util::Clock::getSeconds();
+	for(int i = 0; i < calls; ++i)
+	{
+		decoded.decode(text);
+	}
+	const double decode = ui::util::Clock::getSeconds() - start;
+
+	start = ui::util::Clock::getSeconds();
+	for(int i = 0; i < calls; ++i)
+	{
+		decoded.update(text,1);
+	}
+	const double cached = ui::util::Clock::getSeconds() - start;
+
+	std::vector<int> advances;
+	start = ui::util::Clock::getSeconds();
+	for(int i = 0; i < calls; ++i)
+	{
+		font->getGlyphAdvances(text,advances);
+	}
+	const double advance = ui::util::Clock::getSeconds() - start;
+
+	ui::theme::MeasuredText measured;
+	start = ui::util::Clock::getSeconds();
+	for(int i = 0; i < calls; ++i)
+	{
+		measured.measure(glyphs,text,font);
+	}
+	const double measure = ui::util::Clock::getSeconds() - start;
+
+	ui::theme::WordWrapAlgorithm wrapping;
+	ui::theme::LineSpanBuffer lines;
+	std::size_t count = 0;
+	start = ui::util::Clock::getSeconds();
+	for(int i = 0; i < calls; ++i)
+	{
+		count = wrapping.wrapSpans(text,measured,300,lines,0);
+	}
+	const double wrap = ui::util::Clock::getSeconds() - start;
+
+	const double scale = 1e6 / (calls * kb);
+	std::printf("%-9s %5lu code points %4lu lines, us per KB: decode %7.2f again %5.2f advances %7.2f measure %7.2f wrap %7.2f\n",
+		name,static_cast<unsigned long>(decoded.getLength()),static_cast<unsigned long>(count),
+		decode * scale,cached * scale,advance * scale,measure * scale,wrap * scale);
+}
+
+int main()
+{
+	test::DistanceFieldAtlas atlas(32,4);
+	ui::DistanceFieldFontFactory factory;
+	if(!atlas.write(atlasName) || !factory.addFace("Test",atlasName))
+	{
+		std::printf("could not write %s\n",atlasName);
+		return 1;
+	}
+	ui::Font *font = factory.createFont("Test",12);
+	ui::GlyphContext &glyphs = ui::UiContext::getCurrent().getGlyphContext();
+
+	const unsigned int accented[] = { 'C', 0xE9, 't', 0xE9, ' ', 'n', 0xE4, 'h', 'e', 'r', ' ', 0xFC, 'b', 'e', 'r', ' ', 'S', 0xE3, 'o', ' ' };
+
+	std::vector<unsigned int> ideographs;
+	for(unsigned int i = 0; i < 40; ++i)
+	{
+		ideographs.push_back(test::DistanceFieldAtlas::ideographs + (i * 7) % test::DistanceFieldAtlas::ideographCount);
+		if(i % 13 == 12)
+		{
+			// an ideographic full stop.
+			ideographs.push_back(0x3002);
+		}
+	}
+
+	// a combining acute accent, a family joined from three emoji,
+	// and a flag of two regional indicators.
+	const unsigned int marks[] = { 'e', 0x301, ' ', 0x1F468, 0x200D, 0x1F469, 0x200D, 0x1F467, ' ', 0x1F1F3, 0x1F1F1, ' ' };
+
+	const std::string cjk = encode(&ideographs[0],ideographs.size());
+	const std::string mixed = std::string("Text in ") + encode(&ideographs[0],8) + " with " + encode(marks,sizeof(marks) / sizeof(marks[0])) + "and more words ";
+
+	const std::size_t size = 4096;
+	run("ASCII",repeat("The quick brown fox jumps over the lazy dog. ",size),glyphs,font);
+	run("accented",repeat(encode(accented,sizeof(accented) / sizeof(accented[0])),size),glyphs,font);
+	run("CJK",repeat(cjk,size),glyphs,font);
+	run("mixed",repeat(mixed,size),glyphs,font);
+
+	std::remove(atlasName);
+	return 0;
+}